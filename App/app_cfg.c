@@ -1,39 +1,202 @@
+#include "app_cfg.h"
+#include "app_prof.h"
+#include <string.h>
+#if !defined( __linux__ )
 #include "main.h"
-#include "dig_in.h"
-#include "dig_out.h"
-#include "dig_mix.h"
-#include "mb_rtu_slave.h"
+#endif
+
+static void _cfg_link( psCfgMap_t psOld );
+
+/**
+ * Layout of sCfgMap_t for the store, which migrates the older images by these offsets.
+ */
+static const sCFG_Layout_t sLayout = {
+    .Version   = CFG_MAP_VERSION,
+    .MapSize   = sizeof( sCfgMap_t ),
+    .ScanOff   = offsetof( sCfgMap_t, sDimCfg ) + offsetof( sDIM_Cfg_t, aScan ),
+    .MixOff    = offsetof( sCfgMap_t, sMixCfg ),
+    .DomEndOff = offsetof( sCfgMap_t, sDomCfg ) + sizeof( sDOM_Cfg_t ),
+    .CntsOff   = offsetof( sCfgMap_t, aDimCnts ),
+    .CntsQntt  = DI_QNTT,
+};
+
+_Static_assert( offsetof( sCfgMap_t, uMapVer ) == 0U && offsetof( sCfgMap_t, MapSize ) == 2U,
+                "The store stamps the version and MapSize at the start of the map" );
+
+static sCfgMap_t asCfgMap[ 2 ];     // Active and shadow, swapped by the commit
+psCfgMap_t       psCfgMap    = &asCfgMap[ 0 ];
+psCfgMap_t       psCfgShadow = &asCfgMap[ 1 ];
+volatile bool    isCfgCommitPending;
 
 /** ---------------------------------------------------------------------------
- * @brief Version of the configuration map
+ * @brief   Load the newest stored configuration and link it to the modules.
+ * @note    Call after DIM_Init( ), MIX_Init( ), DOM_Init( ), CNT_Init( ) and SOE_Init( ),
+ *          which set the defaults, and before MB_RTU_Slave_Init( ). The load time is profiled as
+ *          PROF_ID_CFG_LOAD.
+ * @return  CFG_ERR_NONE, or why the defaults are used.
  */
-typedef union _map_version {
-  uint16_t Reg16;      // 0x0100 = version 1.0
-  struct {             // little endian
-    uint8_t Minor;     // Low byte
-    uint8_t Major;     // High byte
-  };
-} uMapVer_t, *puMapVer_t;     // 2 bytes
+eCFG_Err_t App_Cfg_Init( void ) {
+  //
+  psCfgMap->uMapVer.Reg16 = CFG_MAP_VERSION;
+  psCfgMap->MapSize       = sizeof( sCfgMap_t );
+  psCfgMap->sMbRtuSlvCfg  = *psMbRtuSlvCfg;
+  psCfgMap->sDimCfg       = *phDIM->psCfg;
+  psCfgMap->sMixCfg       = *phMIX->psCfg;
+  psCfgMap->sDomCfg       = *phDOM->psCfg;
+  psCfgMap->sCntCfg       = *phCNT->psCfg;
+  psCfgMap->sSoeCfg       = *phSOE->psCfg;
 
-/**
- * @brief Complete configuration map structure
- * @note  Size must be 8 + 34 + 56 + 98 + 32 + 2 = 230 bytes
+  uint32_t   Start = Prof_Start( );
+  eCFG_Err_t Err   = CfgStore_Load( &sLayout, (uint8_t *) psCfgMap );
+  Prof_Stop( PROF_ID_CFG_LOAD, Start );
+
+  CNT_Load( phCNT, psCfgMap->aDimCnts );
+  _cfg_link( NULL );     // The modules work on the map from now on
+  return Err;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   Request to make the shadow map the active one.
+ * @note    The swap is done by the next App_Cfg_Apply( ), between two module updates.
+ */
+void App_Cfg_Commit( void ) {
+  //
+  isCfgCommitPending = true;
+  return;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   Swap the active and shadow maps, see App_Cfg_Apply( ).
+ * @note    The modules are linked to the new map and compile their derived tables once.
+ *          The new shadow starts as a copy of the new active map.
  */
-typedef struct _cfg_map {
-  uMapVer_t         uMapVer;                 // Version of this configuration map
-  uint16_t          MapSize;                 // Size of this structure in bytes, including CRC16
-  sMB_RTU_Slv_Cfg_t sMbRtuSlvCfg;            //
-  sDIM_Cfg_t        sDimCfg;                 // 18 bytes max
-  sMIX_Cfg_t        sMixCfg;                 // TODO: change field in this struct
-  sDOM_Cfg_t        sDomCfg;                 //
-  uint16_t          aDimCnts[ DI_QNTT ];     //
-  uint16_t          CRC16;                   // CRC16 of all previous bytes
-} sCfgMap_t;
+void App_Cfg_Swap( void ) {
+  //
+  isCfgCommitPending = false;
+  psCfgMap_t psNew   = psCfgShadow;
+  psCfgShadow        = psCfgMap;
+  psCfgMap           = psNew;
+  _cfg_link( psCfgShadow );
+  return;
+}
 
-void App_Cfg_Init( void ) {
+/** ---------------------------------------------------------------------------
+ * @brief   Read a word of the shadow map image.
+ * @note    The CRC16 word is computed on read, so a read image is a valid upload.
+ * @param   Idx Word index, below CFG_IMAGE_WORDS.
+ */
+uint16_t App_Cfg_ImageRead( uint16_t Idx ) {
+  //
+  uint16_t Val;
+  if ( Idx == CFG_IMAGE_WORDS - 1U )
+    psCfgShadow->CRC16 =
+        CfgStore_Crc16( (const uint8_t *) psCfgShadow, offsetof( sCfgMap_t, CRC16 ) );
+  memcpy( &Val, (const uint8_t *) psCfgShadow + Idx * sizeof( uint16_t ), sizeof( Val ) );
+  return Val;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   Write a word of the shadow map image.
+ * @note    The words are staged like the holding register writes. The CRC16 word, written
+ *          last, checks the version, size and CRC16 of the whole shadow. A valid image is
+ *          committed, an invalid one is dropped with all staged writes.
+ * @param   Idx Word index, below CFG_IMAGE_WORDS.
+ * @return  false if the CRC16 word completed an invalid image.
+ */
+bool App_Cfg_ImageWrite( uint16_t Idx, uint16_t Val ) {
   //
-  sCfgMap_t sMap     = { 0 };
-  sMap.uMapVer.Reg16 = 0x0100;     // Version 1.0
+  memcpy( (uint8_t *) psCfgShadow + Idx * sizeof( uint16_t ), &Val, sizeof( Val ) );
+  if ( Idx != CFG_IMAGE_WORDS - 1U ) return true;
+
+  if ( psCfgShadow->uMapVer.Reg16 == CFG_MAP_VERSION && psCfgShadow->MapSize == sizeof( sCfgMap_t )
+       && CfgStore_Crc16( (const uint8_t *) psCfgShadow, offsetof( sCfgMap_t, CRC16 ) ) == Val ) {
+    App_Cfg_Commit( );
+    return true;
+  }
+  *psCfgShadow = *psCfgMap;
+  return false;
+}
 
+/** ---------------------------------------------------------------------------
+ * @brief   Append the active configuration map to the flash store.
+ * @note    Nothing is written if the newest record holds the same image. The flash stalls
+ *          the core while it erases a bank, so call it from the main loop.
+ */
+eCFG_Err_t App_Cfg_Save( void ) {
+  //
+  CNT_Store( phCNT, psCfgMap->aDimCnts );
+  return CfgStore_Save( (uint8_t *) psCfgMap );
+}
+
+/**
+ * @brief   Link the modules to the active map and copy it to the shadow map.
+ * @param   psOld  Previous active map, NULL at start. The counters and the event recorder
+ *                 mask their EXTI lines and restart the gates in their SetCfg( ), so with an
+ *                 unchanged configuration they are only pointed at the new map.
+ */
+static void _cfg_link( psCfgMap_t psOld ) {
+  //
+  bool isCntSame = psOld && !memcmp( &psOld->sCntCfg, &psCfgMap->sCntCfg, sizeof( sCNT_Cfg_t ) );
+  bool isSoeSame =     // SOE_SetCfg( ) also depends on the counted inputs
+      isCntSame && !memcmp( &psOld->sSoeCfg, &psCfgMap->sSoeCfg, sizeof( sSOE_Cfg_t ) );
+
+  psMbRtuSlvCfg = &psCfgMap->sMbRtuSlvCfg;
+  DIM_SetCfg( phDIM, &psCfgMap->sDimCfg );
+  MIX_SetCfg( phMIX, &psCfgMap->sMixCfg );
+  DOM_SetCfg( phDOM, &psCfgMap->sDomCfg );
+  if ( isCntSame ) phCNT->psCfg = &psCfgMap->sCntCfg;
+  else CNT_SetCfg( phCNT, &psCfgMap->sCntCfg );
+  if ( isSoeSame ) phSOE->psCfg = &psCfgMap->sSoeCfg;
+  else SOE_SetCfg( phSOE, &psCfgMap->sSoeCfg );
+  *psCfgShadow = *psCfgMap;
   return;
-}
\ No newline at end of file
+}
+
+#if !defined( __linux__ )
+
+/** ---------------------------------------------------------------------------
+ * @brief   Flash backend of the store, see cfg_store.h.
+ */
+const uint8_t *CfgFlash_Base( void ) {
+  //
+  return (const uint8_t *) CFG_STORE_ADDR;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   Erase the pages of the bank.
+ */
+bool CfgFlash_Erase( uint8_t Bank ) {
+  //
+  FLASH_EraseInitTypeDef sErase = {
+      .TypeErase   = FLASH_TYPEERASE_PAGES,
+      .Banks       = FLASH_BANK_1,
+      .PageAddress = CFG_STORE_ADDR + Bank * CFG_STORE_BANK_SIZE,
+      .NbPages     = CFG_STORE_BANK_SIZE / FLASH_PAGE_SIZE,
+  };
+  uint32_t PageError = 0;
+
+  HAL_FLASH_Unlock( );
+  HAL_StatusTypeDef Res = HAL_FLASHEx_Erase( &sErase, &PageError );
+  HAL_FLASH_Lock( );
+  return Res == HAL_OK;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   Program half-words, the F1 flash has no wider access.
+ * @param   Len Even number of bytes.
+ */
+bool CfgFlash_Program( uint32_t Off, const void *pData, uint16_t Len ) {
+  //
+  const uint16_t   *pSrc = pData;
+  HAL_StatusTypeDef Res  = HAL_OK;
+
+  HAL_FLASH_Unlock( );
+  for ( uint16_t i = 0; i < Len / 2U && Res == HAL_OK; i++ ) {
+    Res = HAL_FLASH_Program( FLASH_TYPEPROGRAM_HALFWORD, CFG_STORE_ADDR + Off + 2U * i,     //
+                             pSrc[ i ] );
+  }
+  HAL_FLASH_Lock( );
+  return Res == HAL_OK;
+}
+
+#endif
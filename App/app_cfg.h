@@ -0,0 +1,88 @@
+#ifndef __APP_CFG_H__
+#define __APP_CFG_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "dig_in.h"
+#include "dig_out.h"
+#include "dig_mix.h"
+#include "dig_cnt.h"
+#include "dig_soe.h"
+#include "mb_rtu_slave.h"
+#include "cfg_store.h"
+
+/** @defgroup CFG_Version_define Version of the configuration map
+ * @note  New fields are added in front of CRC16 with a new minor version. An older image
+ *        of the same major version is loaded over the defaults, so the new fields keep
+ *        their defaults. Changing the layout of existing fields needs a new major version.
+ */
+#define CFG_MAP_VERSION 0x0300U     // Version 3.0, 1.x and 2.x images are migrated
+
+  /** ---------------------------------------------------------------------------
+   * @brief Version of the configuration map
+   */
+  typedef union _map_version {
+    uint16_t Reg16;      // 0x0200 = version 2.0
+    struct {             // little endian
+      uint8_t Minor;     // Low byte
+      uint8_t Major;     // High byte
+    };
+  } uMapVer_t, *puMapVer_t;     // 2 bytes
+
+  /**
+   * @brief Complete configuration map structure
+   * @note  Stored as one image. Size is 4 + 4 + 34 + 2 (padding) + 384 + 98 + 2 (padding)
+   *        + 64 + 34 + 4 + 2 = 632 bytes, CRC16 is the last field with no padding behind it.
+   *        Version 1.x had 16-bit aDimCnts and no sCntCfg, 2.0 no sSoeCfg, 2.x no
+   *        sDimCfg.aScan.
+   */
+  typedef struct _cfg_map {
+    uMapVer_t         uMapVer;                 // Version of this configuration map
+    uint16_t          MapSize;                 // Size of this structure in bytes, including CRC16
+    sMB_RTU_Slv_Cfg_t sMbRtuSlvCfg;            //
+    sDIM_Cfg_t        sDimCfg;                 // 34 bytes
+    sMIX_Cfg_t        sMixCfg;                 //
+    sDOM_Cfg_t        sDomCfg;                 //
+    uint32_t          aDimCnts[ DI_QNTT ];     // Pulse counters, see CNT_Store( )
+    sCNT_Cfg_t        sCntCfg;                 //
+    sSOE_Cfg_t        sSoeCfg;                 //
+    uint16_t          CRC16;                   // CRC16 of all previous bytes
+  } sCfgMap_t, *psCfgMap_t;
+
+  _Static_assert( sizeof( sCfgMap_t ) == offsetof( sCfgMap_t, CRC16 ) + sizeof( uint16_t ),
+                  "CRC16 must be the last bytes of sCfgMap_t" );
+
+/** @defgroup CFG_Image_define Map image as 16-bit words, the CRC16 is the last one
+ * @note  Transferred as one file of records by FC20/FC21, see App_Cfg_ImageWrite( ).
+ */
+#define CFG_IMAGE_WORDS ( sizeof( sCfgMap_t ) / sizeof( uint16_t ) )
+
+  eCFG_Err_t App_Cfg_Init( void );
+  eCFG_Err_t App_Cfg_Save( void );
+  void       App_Cfg_Commit( void );
+  void       App_Cfg_Swap( void );
+  uint16_t   App_Cfg_ImageRead( uint16_t Idx );
+  bool       App_Cfg_ImageWrite( uint16_t Idx, uint16_t Val );
+
+  extern psCfgMap_t    psCfgMap;        // Active map, the modules are linked to it
+  extern psCfgMap_t    psCfgShadow;     // Staged by the Modbus writes until the commit
+  extern volatile bool isCfgCommitPending;
+
+  /**
+   * @brief   Swap in the committed shadow map.
+   * @note    Call at a tick boundary, before the module updates. Without a pending commit
+   *          it costs one flag test.
+   */
+  __STATIC_FORCEINLINE void App_Cfg_Apply( void ) {
+    if ( isCfgCommitPending ) App_Cfg_Swap( );
+  }
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __APP_CFG_H__
@@ -0,0 +1,102 @@
+#include "app_idle.h"
+#include "app_prof.h"
+#if defined( __linux__ )
+#include <pthread.h>
+#include <time.h>
+#else
+#include "main.h"
+#endif
+
+static volatile bool     isStamped;     // WakeStamp holds the first unserved signal
+static volatile uint32_t WakeStamp;     // Profiler time stamp of that signal
+
+#if defined( __linux__ )
+static pthread_mutex_t Mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  Cond  = PTHREAD_COND_INITIALIZER;
+static bool            isSignaled;
+#endif
+
+static void Idle_WakeServed( void );
+
+/** -------------------------------------------------------------------------
+ * @brief   Signal that an interrupt created work for the main loop.
+ * @note    Call from the interrupt handlers. On the target every interrupt wakes the core
+ *          anyway, so it only time stamps the wake-up for the latency statistics.
+ */
+void Idle_Signal( void ) {
+  //
+#if defined( __linux__ )
+  pthread_mutex_lock( &Mutex );
+#endif
+  if ( !isStamped ) {
+    WakeStamp = Prof_Start( );
+    isStamped = true;
+  }
+#if defined( __linux__ )
+  isSignaled = true;
+  pthread_cond_signal( &Cond );
+  pthread_mutex_unlock( &Mutex );
+#endif
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Sleep until the next interrupt, if there is no work.
+ * @param   HasWork Reports the pending work of all subsystems. It is called with the
+ *                  interrupts disabled, so a signal can't get lost between the check
+ *                  and the sleep.
+ * @note    Call once per main loop iteration. The time from Idle_Signal( ) until the
+ *          return of this function is profiled as the wake-to-service latency.
+ */
+void Idle_Sleep( IDLE_HasWork_t HasWork ) {
+  //
+#if IDLE_SLEEP_ENABLE
+#if defined( __linux__ )
+  pthread_mutex_lock( &Mutex );
+  if ( !isSignaled && !HasWork( ) ) {
+    struct timespec ts;
+    clock_gettime( CLOCK_REALTIME, &ts );
+    ts.tv_nsec += IDLE_SLEEP_MAX_MS * 1000000L;
+    if ( ts.tv_nsec >= 1000000000L ) {
+      ts.tv_nsec -= 1000000000L;
+      ++ts.tv_sec;
+    }
+    uint32_t SleepStart = Prof_Start( );
+    while ( !isSignaled ) {
+      if ( pthread_cond_timedwait( &Cond, &Mutex, &ts ) ) break;     // Timeout
+    }
+    Prof_Stop( PROF_ID_SLEEP, SleepStart );
+  }
+  isSignaled = false;
+  Idle_WakeServed( );
+  pthread_mutex_unlock( &Mutex );
+#else
+  __disable_irq( );     // A pending interrupt still ends WFI, but runs after __enable_irq( )
+  if ( !HasWork( ) ) {
+    uint32_t SleepStart = Prof_Start( );
+    __DSB( );
+    __WFI( );
+    Prof_Resync( );     // The cycle counter stopped, before any handler takes a time stamp
+    Prof_Stop( PROF_ID_SLEEP, SleepStart );
+  }
+  __enable_irq( );
+  Idle_WakeServed( );
+#endif
+#else
+  ( void ) HasWork;
+  Idle_WakeServed( );
+#endif
+  return;
+}
+
+/**
+ * @brief   Profile the latency from the first unserved signal until now.
+ */
+static void Idle_WakeServed( void ) {
+  //
+  if ( isStamped ) {
+    Prof_Stop( PROF_ID_WAKE, WakeStamp );
+    isStamped = false;
+  }
+  return;
+}
@@ -0,0 +1,29 @@
+#ifndef __APP_IDLE_H__
+#define __APP_IDLE_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** Sleep the core in the main loop while there is no work. 0 keeps the loop spinning.
+ */
+#ifndef IDLE_SLEEP_ENABLE
+#define IDLE_SLEEP_ENABLE 1
+#endif
+
+/** Longest sleep on the Linux host build [ms]. On the target the 1 ms TIM4 tick bounds it.
+ */
+#define IDLE_SLEEP_MAX_MS 1U
+
+  typedef bool ( *IDLE_HasWork_t )( void );
+
+  void Idle_Signal( void );
+  void Idle_Sleep( IDLE_HasWork_t HasWork );
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __APP_IDLE_H__
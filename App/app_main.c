@@ -3,12 +3,19 @@
 #include "swo_dbg.h"
 #include <stdbool.h>
 #include "app_ticks.h"
+#include "app_prof.h"
+#include "app_idle.h"
 #include "led_ctrl.h"
+#include "led_bank.h"
 #include "microtbx.h"
 #include "microtbxmodbus.h"
 #include "dig_in.h"
 #include "dig_mix.h"
 #include "dig_out.h"
+#include "dig_cnt.h"
+#include "dig_soe.h"
+#include "dig_snap.h"
+#include "app_cfg.h"
 
 // #include "EventRecorder.h"
 // EventRecorderInitialize( EventID( EventLevelDetail, EvtStatistics_No, 0 ), 1 );
@@ -24,9 +31,19 @@ extern void MB_RTU_Slave_Init( void);
 __STATIC_INLINE void LedTggl( void *pArgs );
 
 static void Button_Serve( void *pArgs );
-static void Led_Serve( void *pArgs );
 static void DIDO_Serve( void *pArgs );
+static void DIM_FastServe( void *pArgs );
+static void KPB_TickServe( void *pArgs );
+static void Cfg_Serve( void *pArgs );
 static void Button_EventCB( bool evt );
+static bool App_HasWork( void );
+
+_Static_assert( DIM_UPDATE_MS == CNT_SERVE_MS, "DIDO_Serve( ) runs DIM and CNT" );
+#if DIM_DMA_ENABLE && DOM_DMA_ENABLE
+#error "DIM_DMA_ENABLE and DOM_DMA_ENABLE take the same DMA requests of TIM4"
+#endif
+
+static sATT_t sTaskButton, sTaskKPB, sTaskDIDO, sTaskDIM, sTaskCfg;
 
 /** -------------------------------------------------------------------------
  * @brief   Application main loop.
@@ -37,40 +54,112 @@ int app_main( void ) {
 
   // EventRecorderInitialize( EventID( EventLevelDetail, EvtStatistics_No, 0 ), 1 );
 
-  MX_LC_Init( );
-  LC_Background( phLedGreen, &LC_SPD_M1000 );
+  Prof_Init( );
+
+  MX_LCB_Init( );     // The LEDs step in the LCB_TIM interrupt, no AppTick task
+  LCB_Background( phLedBank, LedGreenId, &LC_SPD_M1000 );
 
   MX_KPB_Init( );
 
   AppTick_Init( );
-  AppTick_Add( phAppTicks, 10, Button_Serve, NULL );
-  AppTick_Add( phAppTicks, 40, Led_Serve, phLedGreen );
-  AppTick_Add( phAppTicks, KPB_TICK_PERIOD, KPB_Tick, phKPB );
-  AppTick_Add( phAppTicks, 10, DIDO_Serve, phDIM );
+  // Different phases, so the 10 ms tasks don't run in the same tick
+  AppTick_Add( phAppTicks, &sTaskButton, 10, 0, Button_Serve, NULL );
+  AppTick_Add( phAppTicks, &sTaskKPB, KPB_TICK_PERIOD, KPB_TICK_PERIOD / 2, KPB_TickServe, phKPB );
+  AppTick_Add( phAppTicks, &sTaskDIDO, CNT_SERVE_MS, 5, DIDO_Serve, phDIM );
+  AppTick_Add( phAppTicks, &sTaskDIM, DIM_FAST_MS, 0, DIM_FastServe, phDIM );
+  AppTick_Add( phAppTicks, &sTaskCfg, 1000, 7, Cfg_Serve, NULL );
   
   DIM_Init( );
   MIX_Init( ); 
   DOM_Init( );
+  CNT_Init( );
+  SOE_Init( );
+  App_Cfg_Init( );     // Stored configuration over the defaults of the modules
   MB_RTU_Slave_Init( );
 
   for ( ;; ) {
+    uint32_t LoopStart = Prof_Start( );
+    bool     isIdle    = !phAppTicks->psReadyHead;     // No AppTick task released
     AppTick_Serve( phAppTicks );
+
+    uint32_t StageStart = Prof_Start( );
     KPB_Serve( phKPB );
-		TbxMbEventTask( );
+    Prof_Stop( PROF_ID_KPB_SERVE, StageStart );
+
+    StageStart = Prof_Start( );
+    MB_RTU_Slave_Task( );     // One snapshot of the module states per request
+    Prof_Stop( PROF_ID_TBXMB_TASK, StageStart );
+
+    Idle_Sleep( App_HasWork );     // Until the next interrupt, if there is no work
+    Prof_LoopEnd( LoopStart, isIdle );
     // EventStartA( 0 );
     // EventStopA( 0 );
   }
 }
 
+/** -------------------------------------------------------------------------
+ * @brief   Check if any subsystem has work for the main loop.
+ * @note    Called with interrupts disabled by Idle_Sleep( ).
+ */
+static bool App_HasWork( void ) {
+  //
+  return phAppTicks->psReadyHead ||        // Released AppTick tasks
+         KPB_IsPending( phKPB ) ||         // Tick or conversion complete
+         TBX_FALSE == TbxMbEventIsIdle( );     // Modbus events or active pollers
+}
+
 /** -------------------------------------------------------------------------
  * @brief   Serve the digital input, mixer and output modules.
  */ 
 static void DIDO_Serve( void *pArgs ) {
   //
   UNUSED( pArgs );
+  uint32_t Start = Prof_Start( );
+  App_Cfg_Apply( );     // Committed configuration, never in the middle of an update
   DIM_Update( phDIM );
   MIX_Update( phMIX );
   DOM_Update( phDOM );
+  SNAP_Publish( phSNAP );     // The states of this tick for the Modbus readers
+  CNT_Serve( phCNT );
+  SOE_Serve( phSOE );     // After DIM_Update( ), for its debounced edges
+  Prof_Stop( PROF_ID_DIDO, Start );
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Scan the DIM_SCAN_1MS inputs between two DIDO_Serve( ).
+ */
+static void DIM_FastServe( void *pArgs ) {
+  //
+  uint32_t Start = Prof_Start( );
+  DIM_ScanFast( pArgs );
+  Prof_Stop( PROF_ID_DIM_FAST, Start );
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Save the changed pulse counters every CNT_SAVE_PERIOD_S.
+ */
+static void Cfg_Serve( void *pArgs ) {
+  //
+  UNUSED( pArgs );
+#if CNT_SAVE_PERIOD_S
+  static uint32_t Secs;
+  if ( ++Secs < CNT_SAVE_PERIOD_S ) return;
+  Secs = 0;
+  if ( CNT_Store( phCNT, psCfgMap->aDimCnts ) ) App_Cfg_Save( );
+#endif
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   AppTick callback fn to tick the KPB.
+ */
+static void KPB_TickServe( void *pArgs ) {
+  //
+  uint32_t Start = Prof_Start( );
+  KPB_Tick( pArgs );
+  Prof_Stop( PROF_ID_KPB_TICK, Start );
   return;
 }
 
@@ -96,11 +185,11 @@ static void Button_EventCB( bool evt ) {
         LC_SPD_ON,    LC_SPD_OFF };
 
   if ( !evt ) {
-    LC_Background( phLedGreen, &asPat[ id ] );
+    LCB_Background( phLedBank, LedGreenId, &asPat[ id ] );
     if ( ++id >= sizeof( asPat ) / sizeof( asPat[ 0 ] ) ) id = 0;
   }
   else
-    LC_Event( phLedGreen, 1, &LC_SPD_M80 );
+    LCB_Event( phLedBank, LedGreenId, 1, &LC_SPD_M80 );
 
   return;
 }
@@ -111,21 +200,14 @@ static void Button_EventCB( bool evt ) {
 static void Button_Serve( void *pArgs ) {
   // static uint16_t MsgNum   = 0;
   static bool BtnState = 0, BtnPrev = 0;
-  BtnState = B1_IsPushed( );
+  uint32_t    Start    = Prof_Start( );
+  BtnState             = B1_IsPushed( );
   if ( BtnState != BtnPrev ) {
     swo_msg( "%06u: B1 %s!\n", HAL_GetTick( ), BtnState ? "pushed" : "released" );
     BtnPrev = BtnState;
     Button_EventCB( BtnState );
   }
-  return;
-}
-
-/** -------------------------------------------------------------------------
- * @brief   AppTick callback fn to serve the LED.
- */
-static void Led_Serve( void *pArgs ) {
-  //
-  LC_Serve( (phLC_t) pArgs );
+  Prof_Stop( PROF_ID_BUTTON, Start );
   return;
 }
 
@@ -137,22 +219,22 @@ void KPB_KeyEventCallback( phKPB_t ph, eKPB_Key_t eKey, eKPB_Evt_t eEvt ) {
   switch ( (int32_t) eEvt ) {
     default: break;
     case (int32_t) KPB_EVT_PRESS: {
-      LC_Background( phLedGreen, &LC_SPD_OFF );
-      LC_Event( phLedGreen, 1, &LC_SPD_M80 );
+      LCB_Background( phLedBank, LedGreenId, &LC_SPD_OFF );
+      LCB_Event( phLedBank, LedGreenId, 1, &LC_SPD_M80 );
       break;
     }
     case (int32_t) KPB_EVT_REPEATE: {
-      LC_Event( phLedGreen, 1, &LC_SPD_M80 );
+      LCB_Event( phLedBank, LedGreenId, 1, &LC_SPD_M80 );
       break;
     }
     case (int32_t) KPB_EVT_HELD_TIME_1:
     case (int32_t) KPB_EVT_HELD_TIME_2:
     case (int32_t) KPB_EVT_HELD_TIME_3: {
-      LC_Event( phLedGreen, 1, &LC_SPD_OFF );
+      LCB_Event( phLedBank, LedGreenId, 1, &LC_SPD_OFF );
       break;
     }
     case (int32_t) KPB_EVT_RELEASE: {
-      LC_Background( phLedGreen, &LC_SPD_M1000 );
+      LCB_Background( phLedBank, LedGreenId, &LC_SPD_M1000 );
       break;
     }
   }
@@ -0,0 +1,232 @@
+#include "app_prof.h"
+#include <string.h>
+#include "microtbx.h"
+#if defined( __linux__ )
+#include <time.h>
+#else
+#include "main.h"
+#endif
+
+/**
+ * Time stamps come from the DWT cycle counter on the target and from the monotonic clock
+ * in ns on Linux. Both wrap around at 32 bits, which is fine for durations below 59 s.
+ * The cycle counter stops while the core sleeps in WFI. SleepTicks adds the time the core
+ * slept, see Prof_Resync( ).
+ */
+#if defined( __linux__ )
+#define PROF_TIMESTAMP( )   ( Prof_HostTimestamp( ) )
+#define PROF_CLZ( x )       ( (uint32_t) __builtin_clz( x ) )
+#define PROF_TICKS_PER_US( ) 1000U
+#else
+#define PROF_TIMESTAMP( )   ( DWT->CYCCNT + SleepTicks )
+#define PROF_CLZ( x )       ( __CLZ( x ) )
+#define PROF_TICKS_PER_US( ) ( SystemCoreClock / 1000000U )
+#define PROF_SLEEP_TIM      TIM4     // HAL time base, 1 MHz counter, update every 1 ms
+#endif
+
+static void     Prof_Add( ePROF_ID_t id, uint32_t ticks );
+static uint16_t Prof_ToMicros( uint64_t ticks );
+
+static sPROF_Stat_t asStats[ PROF_ID_NUM ];
+static uint64_t     IdleSum;          // Time of idle loop iterations [time stamp ticks]
+static uint32_t     TicksPerUs = 1;
+#if !defined( __linux__ )
+static volatile uint32_t SleepTicks;     // Time the core slept [time stamp ticks]
+static uint32_t          SleepBase;      // Time base minus the time stamp [time stamp ticks]
+
+/**
+ * @brief   Time of the HAL time base [us], which keeps running while the core sleeps.
+ * @note    Call with the interrupts disabled, so the millisecond tick can't change.
+ */
+static uint32_t Prof_SleepTimeUs( void ) {
+  //
+  uint32_t Ms  = HAL_GetTick( );
+  uint32_t Cnt = READ_REG( PROF_SLEEP_TIM->CNT );
+  if ( READ_BIT( PROF_SLEEP_TIM->SR, TIM_SR_UIF ) ) {     // The tick is not counted yet
+    ++Ms;
+    Cnt = READ_REG( PROF_SLEEP_TIM->CNT );
+  }
+  return Ms * 1000U + Cnt;
+}
+#endif
+
+#if defined( __linux__ )
+/**
+ * @brief   Monotonic host clock in ns, truncated to 32 bits.
+ */
+static uint32_t Prof_HostTimestamp( void ) {
+  //
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+  return (uint32_t) ts.tv_sec * 1000000000U + (uint32_t) ts.tv_nsec;
+}
+#endif
+
+/** -------------------------------------------------------------------------
+ * @brief   Start the time stamp counter and clear the statistics.
+ * @note    Call after the system clock is configured.
+ */
+void Prof_Init( void ) {
+  //
+#if !defined( __linux__ )
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;     // Enable the DWT unit
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+  TicksPerUs = PROF_TICKS_PER_US( );
+  if ( !TicksPerUs ) TicksPerUs = 1;
+#if !defined( __linux__ )
+  uint32_t _Primask = __get_PRIMASK( );
+  __disable_irq( );
+  SleepTicks = 0;
+  SleepBase  = Prof_SleepTimeUs( ) * TicksPerUs - DWT->CYCCNT;
+  __set_PRIMASK( _Primask );
+#endif
+  Prof_Reset( );
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Add the time the core slept to the time stamps.
+ * @note    WFI stops the core clock and with it the DWT cycle counter. The HAL time base
+ *          keeps running, so the time stamps catch up with it, but never go backwards.
+ *          They stay within 1 us of the time base and the error does not add up.
+ *          Call right after the wake-up, while the interrupts are still disabled, so no
+ *          handler takes a time stamp before it is caught up.
+ *          A flash erase stalls the tick handler and the HAL tick loses the updates
+ *          meanwhile, the cycle counter does not. The time base is then moved up to the
+ *          time stamps, so the next sleep is not taken for the lost ticks.
+ */
+void Prof_Resync( void ) {
+  //
+#if !defined( __linux__ )
+  uint32_t Ref = Prof_SleepTimeUs( ) * TicksPerUs - SleepBase;
+  uint32_t Now = PROF_TIMESTAMP( );
+  if ( (int32_t) ( Ref - Now ) > 0 )
+    SleepTicks += Ref - Now;
+  else if ( Now - Ref > TicksPerUs * 1000U )     // The HAL tick lost updates, see the note
+    SleepBase -= Now - Ref;
+#endif
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Clear the statistics of all stages.
+ */
+void Prof_Reset( void ) {
+  //
+  TbxCriticalSectionEnter( );     // The LED stage is updated in the LCB_TIM interrupt
+  memset( asStats, 0, sizeof( asStats ) );
+  for ( size_t i = 0; i < PROF_ID_NUM; i++ ) asStats[ i ].Min = UINT32_MAX;
+  IdleSum = 0;
+  TbxCriticalSectionExit( );
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Time stamp to pass to Prof_Stop( ) or Prof_LoopEnd( ).
+ * @note    On the target it counts the core cycles, including the ones that the core
+ *          slept. The SOE time stamps and the counter gates use it too.
+ */
+uint32_t Prof_Start( void ) {
+  //
+  return PROF_TIMESTAMP( );
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Add the time since start to the statistics of the stage.
+ */
+void Prof_Stop( ePROF_ID_t id, uint32_t start ) {
+  //
+  if ( id < PROF_ID_NUM ) Prof_Add( id, PROF_TIMESTAMP( ) - start );
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Add the time of a main loop iteration to the statistics.
+ * @param   isIdle  true if no scheduled work was done in this iteration. Its time then
+ *                  counts for the idle ratio, including the polling of the other stages.
+ */
+void Prof_LoopEnd( uint32_t start, bool isIdle ) {
+  //
+  uint32_t ticks = PROF_TIMESTAMP( ) - start;
+  if ( isIdle ) IdleSum += ticks;
+  Prof_Add( PROF_ID_LOOP, ticks );
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Read an exported register.
+ * @param   offset  Register offset, see @defgroup PROF_Registers_define.
+ * @return  false if the offset is out of range.
+ */
+bool Prof_ReadReg( uint16_t offset, uint16_t *pVal ) {
+  //
+  if ( !pVal || offset >= PROF_REG_NUM ) return false;
+
+  *pVal = 0;
+  if ( offset < PROF_REG_STAGE_BASE ) {
+    switch ( offset ) {
+      default: break;
+      case PROF_REG_STAGES_NUM: *pVal = PROF_ID_NUM; break;
+      case PROF_REG_CLOCK_MHZ: *pVal = (uint16_t) TicksPerUs; break;
+      case PROF_REG_IDLE_RATIO: {
+        TbxCriticalSectionEnter( );     // One snapshot, like the stage statistics below
+        uint64_t LoopSum = asStats[ PROF_ID_LOOP ].Sum;
+        uint64_t Idle    = IdleSum;
+        TbxCriticalSectionExit( );
+        *pVal = LoopSum ? (uint16_t) ( Idle * 10000U / LoopSum ) : 0U;
+        break;
+      }
+    }
+    return true;
+  }
+
+  offset -= PROF_REG_STAGE_BASE;
+  sPROF_Stat_t s;
+  uint16_t     reg = offset % PROF_REG_STAGE_SIZE;
+  TbxCriticalSectionEnter( );     // The LED stage is updated in the LCB_TIM interrupt
+  s = asStats[ offset / PROF_REG_STAGE_SIZE ];
+  TbxCriticalSectionExit( );
+  switch ( reg ) {
+    default:
+      if ( reg >= PROF_REG_HIST && reg < PROF_REG_HIST + PROF_HIST_BINS )
+        *pVal = s.aHist[ reg - PROF_REG_HIST ];
+      break;
+    case PROF_REG_CNT_LO: *pVal = (uint16_t) s.Cnt; break;
+    case PROF_REG_CNT_HI: *pVal = (uint16_t) ( s.Cnt >> 16 ); break;
+    case PROF_REG_MIN: *pVal = s.Cnt ? Prof_ToMicros( s.Min ) : 0U; break;
+    case PROF_REG_AVG: *pVal = s.Cnt ? Prof_ToMicros( s.Sum / s.Cnt ) : 0U; break;
+    case PROF_REG_MAX: *pVal = Prof_ToMicros( s.Max ); break;
+    case PROF_REG_LAST: *pVal = Prof_ToMicros( s.Last ); break;
+  }
+  return true;
+}
+
+/**
+ * @brief   Convert time stamp ticks to us, saturated to 16 bits.
+ */
+static uint16_t Prof_ToMicros( uint64_t ticks ) {
+  //
+  uint64_t us = ticks / TicksPerUs;
+  return us < UINT16_MAX ? (uint16_t) us : UINT16_MAX;
+}
+
+/**
+ * @brief   Add an execution time to the statistics of the stage.
+ */
+static void Prof_Add( ePROF_ID_t id, uint32_t ticks ) {
+  //
+  psPROF_Stat_t ps = &asStats[ id ];
+  ++ps->Cnt;
+  ps->Sum += ticks;
+  ps->Last = ticks;
+  if ( ticks < ps->Min ) ps->Min = ticks;
+  if ( ticks > ps->Max ) ps->Max = ticks;
+
+  uint32_t us  = ticks / TicksPerUs;
+  uint32_t bin = us ? 32U - PROF_CLZ( us ) : 0U;     // log2 bins, no loop
+  if ( bin >= PROF_HIST_BINS ) bin = PROF_HIST_BINS - 1U;
+  if ( ps->aHist[ bin ] < UINT16_MAX ) ++ps->aHist[ bin ];
+  return;
+}
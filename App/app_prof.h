@@ -0,0 +1,67 @@
+#ifndef __APP_PROF_H__
+#define __APP_PROF_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @defgroup PROF_Registers_define Offsets of the exported registers
+ * @note  Global registers first, then one block of PROF_REG_STAGE_SIZE registers per stage.
+ */
+#define PROF_REG_STAGES_NUM  0U      // Number of profiled stages
+#define PROF_REG_IDLE_RATIO  1U      // Idle ratio [0.01 %]
+#define PROF_REG_CLOCK_MHZ   2U      // Time stamp clock [MHz]
+#define PROF_REG_STAGE_BASE  32U     // Block of the first stage
+#define PROF_REG_STAGE_SIZE  32U     //
+#define PROF_REG_CNT_LO      0U      // Number of runs, bits 0..15
+#define PROF_REG_CNT_HI      1U      // Number of runs, bits 16..31
+#define PROF_REG_MIN         2U      // Shortest execution time [us]
+#define PROF_REG_AVG         3U      // Average execution time [us]
+#define PROF_REG_MAX         4U      // Longest execution time [us]
+#define PROF_REG_LAST        5U      // Last execution time [us]
+#define PROF_REG_HIST        6U      // Histogram, PROF_HIST_BINS registers
+#define PROF_REG_NUM         ( PROF_REG_STAGE_BASE + PROF_ID_NUM * PROF_REG_STAGE_SIZE )
+
+/** Histogram bin n counts the runs of 2^(n-1) to 2^n - 1 us. Bin 0 counts runs below 1 us.
+ */
+#define PROF_HIST_BINS 16U
+
+  typedef enum _ePROF_ID {
+    PROF_ID_LOOP,            // Main loop iteration
+    PROF_ID_BUTTON,          // AppTick callback Button_Serve
+    PROF_ID_LED,             // LED bank step, LCB_TIM interrupt
+    PROF_ID_KPB_TICK,        // AppTick callback KPB_Tick
+    PROF_ID_DIDO,            // AppTick callback DIDO_Serve
+    PROF_ID_KPB_SERVE,       // Main loop stage KPB_Serve
+    PROF_ID_TBXMB_TASK,      // Main loop stage MB_RTU_Slave_Task
+    PROF_ID_SLEEP,           // Core sleeping in Idle_Sleep
+    PROF_ID_WAKE,            // Latency from Idle_Signal until the main loop serves it
+    PROF_ID_CFG_LOAD,        // Boot load of the configuration, App_Cfg_Init
+    PROF_ID_DIM_FAST,        // AppTick callback DIM_ScanFast
+    PROF_ID_NUM
+  } ePROF_ID_t;
+
+  typedef struct _sPROF_Stat {
+    uint32_t Cnt;                         // Number of runs
+    uint32_t Min;                         // [time stamp ticks]
+    uint32_t Max;                         // [time stamp ticks]
+    uint32_t Last;                        // [time stamp ticks]
+    uint64_t Sum;                         // [time stamp ticks]
+    uint16_t aHist[ PROF_HIST_BINS ];     // Saturating counters
+  } sPROF_Stat_t, *psPROF_Stat_t;
+
+  void     Prof_Init( void );
+  void     Prof_Reset( void );
+  void     Prof_Resync( void );
+  uint32_t Prof_Start( void );
+  void     Prof_Stop( ePROF_ID_t id, uint32_t start );
+  void     Prof_LoopEnd( uint32_t start, bool isIdle );
+  bool     Prof_ReadReg( uint16_t offset, uint16_t *pVal );
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __APP_PROF_H__
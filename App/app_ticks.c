@@ -1,5 +1,15 @@
 #include "main.h"
 #include "app_ticks.h"
+#include "microtbx.h"
+#include "app_idle.h"
+
+#define is_due( tick, now ) ( (int32_t) ( ( now ) - ( tick ) ) >= 0 )     // wrap-around safe
+#define _slot( tick )       ( ( tick ) & ( AT_WHEEL_SLOTS - 1U ) )
+
+_Static_assert( ( AT_WHEEL_SLOTS & ( AT_WHEEL_SLOTS - 1U ) ) == 0U,
+                "AT_WHEEL_SLOTS must be a power of two" );
+
+static void AppTick_InsertDue( phAT_t ph, psATT_t psTask );
 
 hAT_t  hAppTicks;
 phAT_t phAppTicks = NULL;
@@ -9,60 +19,158 @@ phAT_t phAppTicks = NULL;
  */
 phAT_t AppTick_Init( void ) {
   //
-  phAppTicks = &hAppTicks;
+  for ( size_t i = 0; i < AT_WHEEL_SLOTS; i++ ) {
+    hAppTicks.apsDueHead[ i ] = NULL;
+    hAppTicks.apsDueTail[ i ] = NULL;
+  }
+  hAppTicks.LastTick    = HAL_GetTick( );
+  hAppTicks.psReadyHead = NULL;
+  hAppTicks.psReadyTail = NULL;
+  hAppTicks.CntTasks    = 0;
+  phAppTicks            = &hAppTicks;
   return phAppTicks;
 }
 
 /**
- * @brief   Add application tick period and callback.
+ * @brief   Add application tick task with its period, phase and callback.
+ * @param   psTask  Storage for the task. It must stay valid while the scheduler runs.
+ * @param   period  Release period [ms].
+ * @param   phase   Delay of the first release [ms], less than the period. Giving tasks with
+ *                  the same period a different phase keeps them out of the same tick.
  */
-eATE_t AppTick_Add( phAT_t ph, uint16_t period, AT_CB_t CallBackFn, void *pArgs ) {
+eATE_t AppTick_Add( phAT_t ph, psATT_t psTask, uint16_t period, uint16_t phase,     //
+                    AT_CB_t CallBackFn, void *pArgs ) {
   //
   if ( !ph ) return AT_ERR_HANDLE;
+  if ( !psTask ) return AT_ERR_TASK;
   if ( !period ) return AT_ERR_PERIOD;
+  if ( phase >= period ) return AT_ERR_PHASE;
   if ( !CallBackFn ) return AT_ERR_CALLBACK;
-  if ( ph->CntFlags >= APP_TICKS_MAX ) return AT_ERR_TICKSMAX;
 
-  ph->aPeriods[ ph->CntFlags ]    = period;
-  ph->aCallBackFn[ ph->CntFlags ] = CallBackFn;
-  ph->apArgs[ ph->CntFlags ]      = pArgs;
-  ++ph->CntFlags;
+  psTask->psNextDue   = NULL;
+  psTask->psNextReady = NULL;
+  psTask->Period      = period;
+  psTask->IsReady     = 0;
+  psTask->CallBackFn  = CallBackFn;
+  psTask->pArgs       = pArgs;
+  AppTick_StatsReset( psTask );
+
+  TbxCriticalSectionEnter( );     // AppTick_Handle( ) walks the timing wheel
+  psTask->DueTick = HAL_GetTick( ) + phase;
+  AppTick_InsertDue( ph, psTask );
+  ++ph->CntTasks;
+  TbxCriticalSectionExit( );
 
   return AT_ERR_NONE;
 }
 
 /**
- * @brief   Set the flags of app ticks.
+ * @brief   Release the tasks that are due.
  * @note    Place AppTick_Handle( ) in function that handles System tick timer.
+ *          Only the slot of each elapsed tick is visited and a task is put back in O(1), so
+ *          the time spent does not grow with the number of tasks.
  */
 eATE_t AppTick_Handle( phAT_t ph ) {
   //
   if ( !ph ) return AT_ERR_HANDLE;
 
   uint32_t SysTickValue = HAL_GetTick( );
-  for ( size_t i = 0; i < ph->CntFlags; i++ ) {
-    if ( 0 == SysTickValue % ph->aPeriods[ i ] ) SET_BIT( ph->RegFlags, 1U << i );
+  if ( SysTickValue - ph->LastTick > AT_WHEEL_SLOTS ) {     // visit each slot once at most
+    ph->LastTick = SysTickValue - AT_WHEEL_SLOTS;
+  }
+  while ( ph->LastTick != SysTickValue ) {
+    uint32_t Slot   = _slot( ++ph->LastTick );
+    psATT_t  psTask = ph->apsDueHead[ Slot ];     // Take the slot, its tasks are put back
+    ph->apsDueHead[ Slot ] = NULL;
+    ph->apsDueTail[ Slot ] = NULL;
+    while ( psTask ) {
+      psATT_t psNext = psTask->psNextDue;
+      if ( is_due( psTask->DueTick, SysTickValue ) ) {
+        if ( psTask->IsReady ) {     // previous release not served yet
+          if ( psTask->OverrunCnt < UINT16_MAX ) ++psTask->OverrunCnt;
+        }
+        else {
+          psTask->IsReady     = 1;
+          psTask->ReadyTick   = psTask->DueTick;
+          psTask->psNextReady = NULL;
+          if ( ph->psReadyTail )
+            ph->psReadyTail->psNextReady = psTask;
+          else
+            ph->psReadyHead = psTask;
+          ph->psReadyTail = psTask;
+          Idle_Signal( );
+        }
+
+        psTask->DueTick += psTask->Period;
+        while ( is_due( psTask->DueTick, SysTickValue ) ) {     // ticks were skipped
+          psTask->DueTick += psTask->Period;
+          if ( psTask->OverrunCnt < UINT16_MAX ) ++psTask->OverrunCnt;
+        }
+      }
+      AppTick_InsertDue( ph, psTask );     // Due in a later turn of the wheel, or rescheduled
+      psTask = psNext;
+    }
   }
 
   return AT_ERR_NONE;
 }
 
 /**
- * @brief   Clear the flags of app ticks and call callbacks.
+ * @brief   Call the callbacks of the released tasks, in order of release.
  * @note    Place AppTick_Serve( ) in main loop.
  */
 eATE_t AppTick_Serve( phAT_t ph ) {
   //
   if ( !ph ) return AT_ERR_HANDLE;
 
-  if ( ph->RegFlags ) {
-    for ( size_t i = 0; i < ph->CntFlags; i++ ) {
-      if ( READ_BIT( ph->RegFlags, 1U << i ) ) {
-        CLEAR_BIT( ph->RegFlags, 1U << i );
-        ph->aCallBackFn[ i ]( ph->apArgs[ i ] );
-      }
-    }
+  while ( ph->psReadyHead ) {
+    TbxCriticalSectionEnter( );     // AppTick_Handle( ) appends to the ready FIFO
+    psATT_t  psTask    = ph->psReadyHead;
+    uint32_t ReadyTick = psTask->ReadyTick;
+    ph->psReadyHead    = psTask->psNextReady;
+    if ( !ph->psReadyHead ) ph->psReadyTail = NULL;
+    psTask->IsReady = 0;
+    TbxCriticalSectionExit( );
+
+    uint32_t Jitter    = HAL_GetTick( ) - ReadyTick;
+    psTask->JitterLast = Jitter < UINT16_MAX ? (uint16_t) Jitter : UINT16_MAX;
+    if ( psTask->JitterLast > psTask->JitterMax ) psTask->JitterMax = psTask->JitterLast;
+    ++psTask->RunCnt;
+    psTask->CallBackFn( psTask->pArgs );
   }
 
   return AT_ERR_NONE;
 }
+
+/**
+ * @brief   Clear the statistics of the task.
+ */
+eATE_t AppTick_StatsReset( psATT_t psTask ) {
+  //
+  if ( !psTask ) return AT_ERR_TASK;
+
+  psTask->RunCnt     = 0;
+  psTask->OverrunCnt = 0;
+  psTask->JitterLast = 0;
+  psTask->JitterMax  = 0;
+
+  return AT_ERR_NONE;
+}
+
+/**
+ * @brief   Append the task to the slot of its due tick, behind the tasks with the same due
+ *          tick. A task that is due already goes to the slot of the next tick.
+ * @note    Caller must prevent concurrent access to the timing wheel.
+ */
+static void AppTick_InsertDue( phAT_t ph, psATT_t psTask ) {
+  //
+  uint32_t Tick     = is_due( psTask->DueTick, ph->LastTick ) ? ph->LastTick + 1U : psTask->DueTick;
+  uint32_t Slot     = _slot( Tick );
+  psTask->psNextDue = NULL;
+  if ( ph->apsDueTail[ Slot ] )
+    ph->apsDueTail[ Slot ]->psNextDue = psTask;
+  else
+    ph->apsDueHead[ Slot ] = psTask;
+  ph->apsDueTail[ Slot ] = psTask;
+  return;
+}
@@ -5,7 +5,13 @@ extern "C"
 {
 #endif     // __cplusplus)
 
-#define APP_TICKS_MAX 4
+/** Slots of the timing wheel, a power of two. A task is kept in the slot of its due tick, so
+ * AppTick_Handle( ) only visits the slot of the current tick. Tasks with a longer period
+ * are visited once per turn of the wheel.
+ */
+#ifndef AT_WHEEL_SLOTS
+#define AT_WHEEL_SLOTS 32U
+#endif
 
   typedef void ( *AT_CB_t )( void *pArgs );
 
@@ -14,21 +20,46 @@ extern "C"
     AT_ERR_HANDLE,
     AT_ERR_PERIOD,
     AT_ERR_CALLBACK,
-    AT_ERR_TICKSMAX,
+    AT_ERR_TASK,
+    AT_ERR_PHASE,
   } eATE_t;
 
+  /**
+   * @brief   Application tick task. The storage is provided by the caller of AppTick_Add( ),
+   *          so there is no limit on the number of tasks.
+   * @note    The fields are private, except for the statistics.
+   */
+  typedef struct _sAppTickTask {
+    struct _sAppTickTask *psNextDue;       // Next task in the same slot of the timing wheel
+    struct _sAppTickTask *psNextReady;     // Next task in the ready FIFO
+    uint32_t              DueTick;         // Absolute tick of the next release
+    uint32_t              ReadyTick;       // Due tick of the release waiting to be served
+    uint16_t              Period;          // Release period [ms]
+    volatile uint8_t      IsReady;         // Released, but callback not called yet
+    AT_CB_t               CallBackFn;      //
+    void                 *pArgs;           //
+    // Statistics
+    uint32_t RunCnt;          // Number of callback calls
+    uint16_t OverrunCnt;      // Number of releases lost, because the previous one was not served yet
+    uint16_t JitterLast;      // Delay from due tick to callback call of the last release [ms]
+    uint16_t JitterMax;       // Highest delay from due tick to callback call [ms]
+  } sATT_t, *psATT_t;
+
   typedef struct _hAppTick {
-    uint16_t RegFlags;
-    uint16_t CntFlags;     // mask of used flags
-    uint16_t aPeriods[ APP_TICKS_MAX ];
-    AT_CB_t  aCallBackFn[ APP_TICKS_MAX ];
-    void    *apArgs[ APP_TICKS_MAX ];
+    psATT_t          apsDueHead[ AT_WHEEL_SLOTS ];     // First task of each slot
+    psATT_t          apsDueTail[ AT_WHEEL_SLOTS ];     // Last task of each slot
+    uint32_t         LastTick;                         // Last tick whose slot was visited
+    psATT_t volatile psReadyHead;                      // Oldest released task
+    psATT_t          psReadyTail;                      // Newest released task
+    uint16_t         CntTasks;                         // Number of added tasks
   } hAT_t, *phAT_t;
 
   phAT_t AppTick_Init( void );
-  eATE_t AppTick_Add( phAT_t ph, uint16_t period, AT_CB_t CallBackFn, void *pArgs );
+  eATE_t AppTick_Add( phAT_t ph, psATT_t psTask, uint16_t period, uint16_t phase,     //
+                      AT_CB_t CallBackFn, void *pArgs );
   eATE_t AppTick_Handle( phAT_t ph );
   eATE_t AppTick_Serve( phAT_t ph );
+  eATE_t AppTick_StatsReset( psATT_t psTask );
 
   extern phAT_t phAppTicks;
 
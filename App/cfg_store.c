@@ -0,0 +1,360 @@
+/***************************************************************************
+ * @file  cfg_store.c
+ * @note  Flash store of the configuration map: bank walk, CRC and migration. Builds
+ *        without the HAL, the flash backend is CfgFlash_*( ).
+ * ************************************************************************* */
+
+#include "cfg_store.h"
+#include <string.h>
+#if defined( __linux__ )
+#include <stdio.h>
+#endif
+
+/**
+ * Flash layout of one bank:
+ *   sCFG_Bank_t header, written right after the erase.
+ *   Records: sCFG_Rec_t header, then Len bytes of the map image, padded to 4 bytes.
+ *   Erased flash (0xFF) behind the last record.
+ * The records are only walked by their headers. The CRC is checked for the newest one
+ * only, and for the older ones only when a power loss broke the newest.
+ */
+#define CFG_BANK_MAGIC 0x31474643U     // "CFG1"
+#define CFG_REC_TAG    0x5AC3U         //
+#define CFG_ERASED16   0xFFFFU         //
+#define CFG_REC_MAX    ( CFG_STORE_BANK_SIZE / 64U )     // Records walked per bank
+#define CFG_REC_LEN( len ) ( sizeof( sCFG_Rec_t ) + ( ( ( len ) + 3U ) & ~3U ) )
+#define CFG_V2_MIX_OFF     28U     // Offset of sMixCfg in 1.x and 2.x, 18 bytes of sDimCfg
+
+typedef struct _cfg_bank_header {
+  uint32_t Magic;     // CFG_BANK_MAGIC
+  uint32_t Seq;       // Incremented at every bank change, the higher one is newer
+} sCFG_Bank_t;
+
+typedef struct _cfg_record_header {
+  uint16_t Tag;     // CFG_REC_TAG, written first
+  uint16_t Len;     // Length of the image, sCfgMap_t::MapSize of its version
+} sCFG_Rec_t;
+
+typedef struct _cfg_store {
+  uint32_t Seq;          // Highest sequence number of both banks
+  uint16_t FreeOff;      // First free byte in the active bank
+  uint16_t RecOff;       // Newest valid record in the active bank, 0 for none
+  uint8_t  Bank;         // Active bank
+  uint8_t  isActive;     // The active bank has a valid header
+} sCFG_Store_t;
+
+static uint8_t            _bank_walk( uint8_t Bank, uint16_t *aOff, uint16_t *pFreeOff );
+static eCFG_Err_t         _image_load( uint8_t *pMap, const uint8_t *pImg, uint16_t Len );
+static void               _map_stamp( uint8_t *pMap );
+static eCFG_Err_t         _bank_switch( void );
+static const sCFG_Bank_t *_bank_header( uint8_t Bank );
+
+static const sCFG_Layout_t *psLayout;     // Set by CfgStore_Load( )
+static sCFG_Store_t         sStore;
+
+#if defined( __linux__ )
+static uint8_t aHostFlash[ 2U * CFG_STORE_BANK_SIZE ];     // Mirror of CFG_STORE_FILE
+static FILE   *pHostFile;
+#endif
+
+/**
+ * CRC16-CCITT-FALSE, the same as TbxChecksumCrc16Calculate( ), one table look-up per byte.
+ */
+static const uint16_t aCrc16Table[ 256 ] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0,
+};
+
+/** ---------------------------------------------------------------------------
+ * @brief   Load the newest valid image over the defaults in the map, from the newer bank
+ *          first.
+ * @param   psMapLayout  Layout of the map, must stay valid for CfgStore_Save( ).
+ * @param   pMap         Map with the defaults, MapSize bytes.
+ * @return  CFG_ERR_NONE, or why the defaults are kept.
+ */
+eCFG_Err_t CfgStore_Load( const sCFG_Layout_t *psMapLayout, uint8_t *pMap ) {
+  //
+  psLayout                       = psMapLayout;
+  const sCFG_Bank_t *apsHdr[ 2 ] = { _bank_header( 0 ), _bank_header( 1 ) };
+  uint8_t            Newer       = 0;
+  if ( apsHdr[ 1 ] && ( !apsHdr[ 0 ] || apsHdr[ 1 ]->Seq > apsHdr[ 0 ]->Seq ) ) Newer = 1;
+  sStore.Seq      = apsHdr[ Newer ] ? apsHdr[ Newer ]->Seq : 0;
+  sStore.Bank     = Newer;
+  sStore.isActive = apsHdr[ Newer ] != NULL;
+  sStore.RecOff   = 0;
+  sStore.FreeOff  = sizeof( sCFG_Bank_t );
+
+  eCFG_Err_t Err = CFG_ERR_EMPTY;
+  for ( uint8_t i = 0; i < 2; i++ ) {
+    uint8_t Bank = Newer ^ i;
+    if ( !apsHdr[ Bank ] ) continue;
+
+    uint16_t       aOff[ CFG_REC_MAX ];
+    uint16_t       FreeOff;
+    uint8_t        Cnt   = _bank_walk( Bank, aOff, &FreeOff );
+    const uint8_t *pBank = CfgFlash_Base( ) + Bank * CFG_STORE_BANK_SIZE;
+    if ( !i ) sStore.FreeOff = FreeOff;
+
+    while ( Cnt-- ) {     // Newest first, older ones only after a power loss
+      const sCFG_Rec_t *psRec = (const sCFG_Rec_t *) ( pBank + aOff[ Cnt ] );
+      const uint8_t    *pImg  = (const uint8_t *) ( psRec + 1 );
+      if ( psRec->Len < sizeof( uint32_t ) + sizeof( uint16_t ) ) continue;
+      uint16_t Crc = pImg[ psRec->Len - 2 ] | ( pImg[ psRec->Len - 1 ] << 8 );
+      if ( CfgStore_Crc16( pImg, psRec->Len - sizeof( uint16_t ) ) != Crc ) continue;
+
+      Err = _image_load( pMap, pImg, psRec->Len );
+      if ( Bank == sStore.Bank ) sStore.RecOff = aOff[ Cnt ];
+      else {     // The newer bank holds no valid record, keep appending to this one
+        sStore.Bank    = Bank;
+        sStore.FreeOff = FreeOff;
+        sStore.RecOff  = aOff[ Cnt ];
+      }
+      return Err;
+    }
+  }
+  _map_stamp( pMap );
+  return Err;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   Append the map to the flash store.
+ * @note    The version, MapSize and CRC16 of the map are set first. Nothing is written if
+ *          the newest record holds the same image. The flash stalls the core while it
+ *          erases a bank, so call it from the main loop. Call CfgStore_Load( ) once before.
+ */
+eCFG_Err_t CfgStore_Save( uint8_t *pMap ) {
+  //
+  if ( !psLayout ) return CFG_ERR_FLASH;
+
+  const uint16_t Len = psLayout->MapSize;
+  _map_stamp( pMap );
+  uint16_t Crc = CfgStore_Crc16( pMap, Len - sizeof( uint16_t ) );
+  memcpy( pMap + Len - sizeof( uint16_t ), &Crc, sizeof( Crc ) );
+
+  const uint8_t *pBank = CfgFlash_Base( ) + sStore.Bank * CFG_STORE_BANK_SIZE;
+  if ( sStore.RecOff ) {
+    const sCFG_Rec_t *psRec = (const sCFG_Rec_t *) ( pBank + sStore.RecOff );
+    if ( psRec->Len == Len && !memcmp( psRec + 1, pMap, Len ) ) return CFG_ERR_NONE;
+  }
+
+  if ( !sStore.isActive || sStore.FreeOff + CFG_REC_LEN( Len ) > CFG_STORE_BANK_SIZE ) {
+    eCFG_Err_t Err = _bank_switch( );
+    if ( Err ) return Err;
+    pBank = CfgFlash_Base( ) + sStore.Bank * CFG_STORE_BANK_SIZE;
+  }
+
+  uint16_t   RecOff = sStore.FreeOff;
+  uint32_t   Off    = sStore.Bank * CFG_STORE_BANK_SIZE + RecOff;
+  sCFG_Rec_t sRec   = { .Tag = CFG_REC_TAG, .Len = Len };     // Header first, see _bank_walk( )
+  bool       isOk   = CfgFlash_Program( Off, &sRec, sizeof( sRec ) );
+  isOk              = isOk && CfgFlash_Program( Off + sizeof( sRec ), pMap, Len );
+  sStore.FreeOff += CFG_REC_LEN( Len );     // A broken record is skipped by its header
+  if ( !isOk ) return CFG_ERR_FLASH;
+  if ( memcmp( pBank + RecOff + sizeof( sRec ), pMap, Len ) ) return CFG_ERR_VERIFY;
+  sStore.RecOff = RecOff;
+
+  return CFG_ERR_NONE;
+}
+
+/** ---------------------------------------------------------------------------
+ * @brief   CRC16 of the data, see aCrc16Table.
+ */
+uint16_t CfgStore_Crc16( const uint8_t *pData, uint16_t Len ) {
+  //
+  uint16_t Crc = 0xFFFFU;
+  while ( Len-- ) Crc = (uint16_t) ( Crc << 8 ) ^ aCrc16Table[ ( Crc >> 8 ) ^ *pData++ ];
+  return Crc;
+}
+
+/**
+ * @brief   Walk the record headers of the bank.
+ * @param   aOff      Offsets of the records, oldest first.
+ * @param   pFreeOff  First free byte, the bank size if a broken header ends the walk.
+ * @return  Number of records in aOff.
+ */
+static uint8_t _bank_walk( uint8_t Bank, uint16_t *aOff, uint16_t *pFreeOff ) {
+  //
+  const uint8_t *pBank = CfgFlash_Base( ) + Bank * CFG_STORE_BANK_SIZE;
+  uint16_t       Off   = sizeof( sCFG_Bank_t );
+  uint8_t        Cnt   = 0;
+
+  while ( Off + sizeof( sCFG_Rec_t ) <= CFG_STORE_BANK_SIZE ) {
+    const sCFG_Rec_t *psRec = (const sCFG_Rec_t *) ( pBank + Off );
+    if ( psRec->Tag == CFG_ERASED16 ) break;
+    if ( psRec->Tag != CFG_REC_TAG || Off + CFG_REC_LEN( psRec->Len ) > CFG_STORE_BANK_SIZE ) {
+      Off = CFG_STORE_BANK_SIZE;     // Don't append behind garbage
+      break;
+    }
+    if ( Cnt == CFG_REC_MAX ) {     // Keep the newest ones
+      memmove( aOff, aOff + 1, ( CFG_REC_MAX - 1U ) * sizeof( *aOff ) );
+      --Cnt;
+    }
+    aOff[ Cnt++ ] = Off;
+    Off += CFG_REC_LEN( psRec->Len );
+  }
+
+  *pFreeOff = Off;
+  return Cnt;
+}
+
+/**
+ * @brief   Copy a valid image over the defaults in the map.
+ * @note    An image of an older minor version is shorter, the fields behind it keep their
+ *          defaults. A newer minor version is cut to this map. Older major versions are
+ *          migrated field by field.
+ */
+static eCFG_Err_t _image_load( uint8_t *pMap, const uint8_t *pImg, uint16_t Len ) {
+  //
+  uint8_t  Major  = pImg[ 1 ];     // High byte of the little endian version
+  uint16_t CrcOff = psLayout->MapSize - sizeof( uint16_t );
+
+  if ( Major == 1U || Major == 2U ) {     // No sDimCfg.aScan, then the same layout
+    uint16_t Head = psLayout->ScanOff;
+    uint16_t Tail = CrcOff - psLayout->MixOff;
+    uint16_t Cnts = 0;
+    if ( Major == 1U ) {     // 16-bit counters right behind sDomCfg
+      Tail = psLayout->DomEndOff - psLayout->MixOff;
+      Cnts = psLayout->CntsQntt * sizeof( uint16_t );
+    }
+    uint16_t Size = CFG_V2_MIX_OFF + Cnts + sizeof( uint16_t );     // Without the tail
+    if ( Len < Size ) return CFG_ERR_VERSION;
+    if ( Tail > Len - Size ) {     // Older minor version
+      if ( Cnts ) return CFG_ERR_VERSION;
+      Tail = Len - Size;
+    }
+    memcpy( pMap, pImg, Head );
+    memcpy( pMap + psLayout->MixOff, pImg + CFG_V2_MIX_OFF, Tail );
+    for ( uint8_t i = 0; i < Cnts / sizeof( uint16_t ); i++ ) {
+      uint16_t Cnt;
+      memcpy( &Cnt, pImg + CFG_V2_MIX_OFF + Tail + i * sizeof( Cnt ), sizeof( Cnt ) );
+      uint32_t Cnt32 = Cnt;
+      memcpy( pMap + psLayout->CntsOff + i * sizeof( Cnt32 ), &Cnt32, sizeof( Cnt32 ) );
+    }
+  }
+  else {
+    if ( Major != ( psLayout->Version >> 8 ) ) return CFG_ERR_VERSION;
+    uint16_t Size = Len - sizeof( uint16_t );     // Without CRC16
+    if ( Size > CrcOff ) Size = CrcOff;
+    memcpy( pMap, pImg, Size );
+  }
+  _map_stamp( pMap );
+
+  return CFG_ERR_NONE;
+}
+
+/**
+ * @brief   Set the version and MapSize of this layout in the map.
+ */
+static void _map_stamp( uint8_t *pMap ) {
+  //
+  memcpy( pMap, &psLayout->Version, sizeof( uint16_t ) );
+  memcpy( pMap + sizeof( uint16_t ), &psLayout->MapSize, sizeof( uint16_t ) );
+  return;
+}
+
+/**
+ * @brief   Erase the inactive bank and make it the active one.
+ */
+static eCFG_Err_t _bank_switch( void ) {
+  //
+  uint8_t     Bank = sStore.isActive ? sStore.Bank ^ 1U : sStore.Bank;
+  sCFG_Bank_t sHdr = { .Magic = CFG_BANK_MAGIC, .Seq = sStore.Seq + 1U };
+
+  if ( !CfgFlash_Erase( Bank ) ) return CFG_ERR_FLASH;
+  if ( !CfgFlash_Program( Bank * CFG_STORE_BANK_SIZE, &sHdr, sizeof( sHdr ) ) )     //
+    return CFG_ERR_FLASH;
+
+  sStore.Seq      = sHdr.Seq;
+  sStore.Bank     = Bank;
+  sStore.isActive = 1;
+  sStore.FreeOff  = sizeof( sCFG_Bank_t );
+  sStore.RecOff   = 0;
+
+  return CFG_ERR_NONE;
+}
+
+/**
+ * @brief   Header of the bank, NULL if the bank is not valid.
+ */
+static const sCFG_Bank_t *_bank_header( uint8_t Bank ) {
+  //
+  const uint8_t     *pBank = CfgFlash_Base( ) + Bank * CFG_STORE_BANK_SIZE;
+  const sCFG_Bank_t *psHdr = (const sCFG_Bank_t *) pBank;
+  return psHdr->Magic == CFG_BANK_MAGIC ? psHdr : NULL;
+}
+
+#if defined( __linux__ )
+
+/**
+ * @brief   RAM mirror of the backing file, read at the first access.
+ */
+const uint8_t *CfgFlash_Base( void ) {
+  //
+  if ( !pHostFile ) {
+    memset( aHostFlash, 0xFF, sizeof( aHostFlash ) );
+    pHostFile = fopen( CFG_STORE_FILE, "r+b" );
+    if ( pHostFile ) {
+      size_t Cnt = fread( aHostFlash, 1, sizeof( aHostFlash ), pHostFile );
+      ( void ) Cnt;     // A short file reads as erased
+    }
+    else {
+      pHostFile = fopen( CFG_STORE_FILE, "w+b" );
+      if ( pHostFile ) fwrite( aHostFlash, 1, sizeof( aHostFlash ), pHostFile );
+    }
+  }
+  return aHostFlash;
+}
+
+bool CfgFlash_Erase( uint8_t Bank ) {
+  //
+  uint8_t *pBank = (uint8_t *) CfgFlash_Base( ) + Bank * CFG_STORE_BANK_SIZE;
+  memset( pBank, 0xFF, CFG_STORE_BANK_SIZE );
+  if ( !pHostFile || fseek( pHostFile, Bank * CFG_STORE_BANK_SIZE, SEEK_SET ) ) return false;
+  bool isOk = fwrite( pBank, 1, CFG_STORE_BANK_SIZE, pHostFile ) == CFG_STORE_BANK_SIZE;
+  return !fflush( pHostFile ) && isOk;
+}
+
+/**
+ * @brief   Program like NOR flash, bits can only be cleared.
+ */
+bool CfgFlash_Program( uint32_t Off, const void *pData, uint16_t Len ) {
+  //
+  uint8_t       *pDst = (uint8_t *) CfgFlash_Base( ) + Off;
+  const uint8_t *pSrc = pData;
+  for ( uint16_t i = 0; i < Len; i++ ) pDst[ i ] &= pSrc[ i ];
+  if ( !pHostFile || fseek( pHostFile, (long) Off, SEEK_SET ) ) return false;
+  bool isOk = fwrite( pDst, 1, Len, pHostFile ) == Len;
+  return !fflush( pHostFile ) && isOk;
+}
+
+#endif
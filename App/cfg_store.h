@@ -0,0 +1,69 @@
+#ifndef __CFG_STORE_H__
+#define __CFG_STORE_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/** @defgroup CFG_Store_define Flash store of the configuration map
+ * @note  Two banks of CFG_STORE_BANK_SIZE bytes take turns. Saved images are appended to
+ *        the active bank, and only when it is full the other bank is erased and becomes
+ *        the active one. The linker script must keep this area out of the code region.
+ *        The store only sees the map as bytes described by sCFG_Layout_t, so it builds
+ *        without the HAL, on the Linux host with a file as flash.
+ */
+#ifndef CFG_STORE_ADDR
+#define CFG_STORE_ADDR 0x0801E000U     // Last 8 KB of the 128 KB flash
+#endif
+#ifndef CFG_STORE_BANK_SIZE
+#define CFG_STORE_BANK_SIZE 4096U     // 4 flash pages of 1 KB
+#endif
+#ifndef CFG_STORE_FILE     // Backing file of the flash on the Linux host build
+#define CFG_STORE_FILE "cfg_store.bin"
+#endif
+
+  typedef enum _eCFG_Errors {     //
+    CFG_ERR_NONE = 0,
+    CFG_ERR_EMPTY,       // No valid image stored, defaults used
+    CFG_ERR_VERSION,     // Image of another major version, defaults used
+    CFG_ERR_FLASH,       // Erase or program failed
+    CFG_ERR_VERIFY       // Read back differs from the map
+  } eCFG_Err_t;
+
+  /**
+   * @brief Layout of the configuration map, for the migration of older images
+   * @note  The map starts with the 16-bit version and the 16-bit MapSize, and ends with
+   *        the CRC16 of all previous bytes. Versions 1.x and 2.x had no sDimCfg.aScan,
+   *        1.x had 16-bit counters right behind sDomCfg.
+   */
+  typedef struct _cfg_layout {
+    uint16_t Version;       // @defgroup CFG_Version_define
+    uint16_t MapSize;       // sizeof( sCfgMap_t ), including CRC16
+    uint16_t ScanOff;       // Offset of sDimCfg.aScan, the end of the 1.x and 2.x head
+    uint16_t MixOff;        // Offset of sMixCfg
+    uint16_t DomEndOff;     // Offset of the end of sDomCfg, where 1.x had its counters
+    uint16_t CntsOff;       // Offset of aDimCnts, 32-bit counters
+    uint8_t  CntsQntt;      // Number of counters
+  } sCFG_Layout_t, *psCFG_Layout_t;
+
+  eCFG_Err_t CfgStore_Load( const sCFG_Layout_t *psLayout, uint8_t *pMap );
+  eCFG_Err_t CfgStore_Save( uint8_t *pMap );
+  uint16_t   CfgStore_Crc16( const uint8_t *pData, uint16_t Len );
+
+  /**
+   * @brief   Flash backend, NOR like: erased bytes read 0xFF, programming only clears bits.
+   * @note    cfg_store.c implements it with CFG_STORE_FILE on the Linux host, app_cfg.c with
+   *          the HAL on the target. Off is relative to the start of bank 0.
+   */
+  const uint8_t *CfgFlash_Base( void );
+  bool           CfgFlash_Erase( uint8_t Bank );
+  bool           CfgFlash_Program( uint32_t Off, const void *pData, uint16_t Len );
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __CFG_STORE_H__
@@ -0,0 +1,325 @@
+/***************************************************************************
+ * @file  dig_cnt.c
+ * @note  Pulse counters and rate measurement of the digital inputs.
+ * ************************************************************************* */
+
+#include "dig_cnt.h"
+#include "dig_soe.h"
+#include "app_prof.h"
+#include "tbx_conf.h"
+
+_Static_assert( ( CNT_IRQ_PRIORITY << ( 8U - __NVIC_PRIO_BITS ) ) < TBX_CONF_CRITSECT_MASK_LEVEL,
+                "The EXTI time stamps must not wait for the critical sections" );
+
+#define _pin_mask( Pin ) ( ( ( Pin ) >> GPIO_PIN_MASK_POS ) & 0xFFFFU )     // LL pin to bit mask
+
+static void _exti_start( phCNT_t ph, uint8_t id, uint32_t Line );
+static void _tim_start( void );
+static void _tim_fold( psCNT_Ch_t ps, uint32_t Now );
+static void _ch_read( psCNT_Ch_t ps, uint32_t *pCnt, uint32_t *pStamp );
+
+static sCNT_Cfg_t sCfg;
+
+hCNT_t  hCNT;
+phCNT_t phCNT = &hCNT;
+
+/** --------------------------------------------------------------------------
+ * @brief   Set the default configuration, nothing is counted.
+ * @note    Call after DIM_Init( ), the counters use the pins of the inputs.
+ */
+void CNT_Init( void ) {
+  //
+  sCfg.Inputs = 0;
+  for ( size_t i = 0; i < DI_QNTT; i++ ) sCfg.aGateMs[ i ] = CNT_GATE_MS;
+
+  SET_BIT( CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk );     // Cycle counter time stamps
+  SET_BIT( DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk );
+  CNT_SetCfg( phCNT, &sCfg );
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Link the configuration and set up the counting of its inputs.
+ * @note    The counts of the inputs that stay counted are kept. Their gates restart.
+ *          An input whose EXTI line is taken by another input or gpio.c is not counted.
+ */
+void CNT_SetCfg( phCNT_t ph, psCNT_Cfg_t psCfg ) {
+  //
+  if ( !ph || !psCfg ) return;
+
+  uint32_t Now = Prof_Start( );
+  for ( uint8_t id = 0; id < DI_QNTT; id++ ) {     // Keep the edges the timer counted so far
+    if ( ph->asCh[ id ].Src == CNT_SRC_TIM ) _tim_fold( &ph->asCh[ id ], Now );
+  }
+  uint16_t _PrevLines = ph->ExtiLines;
+  CLEAR_BIT( EXTI->IMR, _PrevLines );     // Edges meanwhile stay pending
+  CLEAR_BIT( CNT_TIM->CR1, TIM_CR1_CEN );
+
+  uint16_t _Prev = ph->Active;
+  ph->psCfg       = psCfg;
+  ph->ExtiLines   = 0;
+  ph->Active      = 0;
+  for ( uint8_t id = 0; id < DI_QNTT; id++ ) {
+    psCNT_Ch_t ps    = &ph->asCh[ id ];
+    psPin_t    psPin = &phDIM->asPin[ id ];
+    ps->Src          = CNT_SRC_NONE;
+    ps->Freq         = 0;
+    ps->Period       = 0;
+    if ( !READ_BIT( psCfg->Inputs, 1U << id ) || !psPin->psPort ) continue;
+
+    if ( psPin->psPort == CNT_TIM_PORT && psPin->Pin == CNT_TIM_PIN ) {
+      _tim_start( );
+      ps->Src     = CNT_SRC_TIM;
+      ps->TimLast = (uint16_t) CNT_TIM->CNT;
+    }
+    else {
+      uint32_t Line = POSITION_VAL( _pin_mask( psPin->Pin ) );
+      if ( READ_BIT( ph->ExtiLines | CNT_EXTI_LINES_USED, 1U << Line ) ) continue;
+      _exti_start( ph, id, Line );
+      ps->Src = CNT_SRC_EXTI;
+    }
+    ps->Stamp     = Now;
+    ps->GateStamp = Now;
+    ps->GateCnt   = ps->Cnt;
+    SET_BIT( ph->Active, 1U << id );
+  }
+
+  WRITE_REG( EXTI->PR, _PrevLines ^ ph->ExtiLines );     // Keep the edges of the lines that stay
+  SET_BIT( EXTI->IMR, ph->ExtiLines );
+  DIM_SetInputOnly( phDIM, ( phDIM->InputOnly & ~_Prev ) | ph->Active );     // No LED edges
+
+  if ( READ_BIT( ph->ExtiLines, 0x0010U ) ) {
+    HAL_NVIC_SetPriority( EXTI4_IRQn, CNT_IRQ_PRIORITY, 0 );
+    HAL_NVIC_EnableIRQ( EXTI4_IRQn );
+  }
+  if ( READ_BIT( ph->ExtiLines, 0x03E0U ) ) {
+    HAL_NVIC_SetPriority( EXTI9_5_IRQn, CNT_IRQ_PRIORITY, 0 );
+    HAL_NVIC_EnableIRQ( EXTI9_5_IRQn );
+  }
+  if ( READ_BIT( ph->ExtiLines, 0xFC00U ) ) {     // Shared with gpio.c, which sets priority 0
+    HAL_NVIC_SetPriority( EXTI15_10_IRQn, CNT_IRQ_PRIORITY, 0 );
+    HAL_NVIC_EnableIRQ( EXTI15_10_IRQn );
+  }
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Extend the timer count and close the gates that are due.
+ * @note    Call every CNT_SERVE_MS. An EXTI input measures from edge to edge, so the rate
+ *          has the resolution of the cycle counter. The timer input measures the edges
+ *          within the gate time.
+ */
+void CNT_Serve( phCNT_t ph ) {
+  //
+  if ( !ph || !ph->Active ) return;
+
+  uint32_t Now         = Prof_Start( );
+  uint32_t CyclesPerMs = SystemCoreClock / 1000U;
+  uint32_t CyclesPerUs = SystemCoreClock / 1000000U;
+
+  for ( uint32_t _Chs = ph->Active; _Chs; _Chs &= _Chs - 1U ) {
+    uint8_t    id = POSITION_VAL( _Chs );
+    psCNT_Ch_t ps = &ph->asCh[ id ];
+    if ( ps->Src == CNT_SRC_TIM ) _tim_fold( ps, Now );
+
+    uint32_t _Gate = ph->psCfg->aGateMs[ id ];
+    if ( _Gate < CNT_SERVE_MS ) _Gate = CNT_SERVE_MS;
+    if ( _Gate > CNT_GATE_MAX_MS ) _Gate = CNT_GATE_MAX_MS;
+    uint32_t _Elapsed = Now - ps->GateStamp;
+    if ( _Elapsed < _Gate * CyclesPerMs ) continue;
+
+    uint32_t _Cnt, _Stamp;
+    _ch_read( ps, &_Cnt, &_Stamp );
+    uint32_t _Edges = _Cnt - ps->GateCnt;
+    uint32_t _Span  = _Stamp - ps->GateStamp;
+    if ( _Edges && _Span ) {
+      ps->Freq   = (uint32_t) ( (uint64_t) _Edges * SystemCoreClock * 100U / _Span );
+      ps->Period = _Span / _Edges / CyclesPerUs;
+    }
+    else {     // No edge yet, the gate stays open from the last edge
+      uint32_t _Timeout = 2U * _Gate * CyclesPerMs;
+      if ( ps->Period < CNT_GATE_MAX_MS * 1000U / 2U && 2U * ps->Period * CyclesPerUs > _Timeout )
+        _Timeout = 2U * ps->Period * CyclesPerUs;
+      if ( _Elapsed >= _Timeout ) ps->Freq = 0;
+      if ( _Elapsed < CNT_GATE_MAX_MS * CyclesPerMs ) continue;
+      _Stamp = Now;     // Restart before the cycle counter wraps
+    }
+    ps->GateCnt   = _Cnt;
+    ps->GateStamp = _Stamp;
+  }
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Set the counters, e.g. to the counts loaded from the config store.
+ * @param   aCnts   array[ DI_QNTT ]
+ */
+void CNT_Load( phCNT_t ph, const uint32_t *aCnts ) {
+  //
+  if ( !ph || !aCnts ) return;
+
+  uint32_t _Primask = __get_PRIMASK( );
+  __disable_irq( );
+  for ( uint8_t id = 0; id < DI_QNTT; id++ ) {
+    ph->asCh[ id ].Cnt     = aCnts[ id ];
+    ph->asCh[ id ].GateCnt = aCnts[ id ];
+  }
+  __set_PRIMASK( _Primask );
+
+  return;
+}
+
+/**
+ * @brief   Copy the counters, e.g. to the map of the config store.
+ * @param   aCnts   array[ DI_QNTT ]
+ * @return  true if any count differs from aCnts.
+ */
+bool CNT_Store( phCNT_t ph, uint32_t *aCnts ) {
+  //
+  if ( !ph || !aCnts ) return false;
+
+  bool isChanged = false;
+  for ( uint8_t id = 0; id < DI_QNTT; id++ ) {
+    uint32_t _Cnt = ph->asCh[ id ].Cnt;
+    if ( aCnts[ id ] != _Cnt ) isChanged = true;
+    aCnts[ id ] = _Cnt;
+  }
+
+  return isChanged;
+}
+
+/**
+ * @brief   Clear the counters of the inputs.
+ * @param   Inputs  Bit n for input n.
+ */
+void CNT_Clear( phCNT_t ph, uint16_t Inputs ) {
+  //
+  if ( !ph ) return;
+
+  uint32_t _Primask = __get_PRIMASK( );
+  __disable_irq( );     // The EXTI handlers increment Cnt
+  for ( uint8_t id = 0; id < DI_QNTT; id++ ) {
+    if ( !READ_BIT( Inputs, 1U << id ) ) continue;
+    ph->asCh[ id ].Cnt     = 0;
+    ph->asCh[ id ].GateCnt = 0;
+  }
+  __set_PRIMASK( _Primask );
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Read an exported register.
+ * @param   offset  @defgroup CNT_Registers_define
+ * @return  false if there is no register at the offset.
+ */
+bool CNT_ReadReg( phCNT_t ph, uint16_t offset, uint16_t *pVal ) {
+  //
+  if ( !ph || !pVal || offset >= CNT_REG_NUM ) return false;
+
+  uint8_t id  = offset / CNT_REG_CH_SIZE;
+  uint8_t reg = offset % CNT_REG_CH_SIZE;
+  if ( reg > CNT_REG_PERIOD_HI ) return false;
+
+  if ( reg == CNT_REG_CNT_LO || ph->LatchCh != id ) {     // Both halves from one snapshot
+    uint32_t _Stamp;
+    _ch_read( &ph->asCh[ id ], &ph->aLatch[ 0 ], &_Stamp );
+    ph->aLatch[ 1 ] = ph->asCh[ id ].Freq;
+    ph->aLatch[ 2 ] = ph->asCh[ id ].Period;
+    ph->LatchCh     = id;
+  }
+  uint32_t _Val = ph->aLatch[ reg / 2U ];
+  *pVal         = (uint16_t) ( reg & 1U ? _Val >> 16 : _Val );
+
+  return true;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Count the pending EXTI lines of the counted inputs.
+ * @note    Call from the EXTI interrupt handlers. The lines of other users are left
+ *          pending for their handlers.
+ */
+void CNT_EXTI_IRQHandler( void ) {
+  //
+  uint32_t _Pend  = READ_REG( EXTI->PR ) & hCNT.ExtiLines;
+  uint32_t _Stamp = Prof_Start( );
+  WRITE_REG( EXTI->PR, _Pend );
+  for ( ; _Pend; _Pend &= _Pend - 1U ) {
+    psCNT_Ch_t ps = &hCNT.asCh[ hCNT.aLineCh[ POSITION_VAL( _Pend ) ] ];
+    ps->Stamp     = _Stamp;     // Before Cnt, see _ch_read( )
+    ps->Cnt++;
+  }
+  return;
+}
+
+/**
+ * @brief   Route the pin to its EXTI line and select the rising edge, CNT_SetCfg( ) unmasks it.
+ */
+static void _exti_start( phCNT_t ph, uint8_t id, uint32_t Line ) {
+  //
+  GPIO_TypeDef *psPort = phDIM->asPin[ id ].psPort;
+  uint32_t      _Src   = ( (uint32_t) psPort - GPIOA_BASE ) / ( GPIOB_BASE - GPIOA_BASE );
+  uint32_t      _Shift = 4U * ( Line & 3U );
+
+  __HAL_RCC_AFIO_CLK_ENABLE( );
+  MODIFY_REG( AFIO->EXTICR[ Line >> 2 ], 0xFU << _Shift, _Src << _Shift );
+  SET_BIT( EXTI->RTSR, 1U << Line );
+  CLEAR_BIT( EXTI->FTSR, 1U << Line );
+
+  ph->aLineCh[ Line ] = id;
+  SET_BIT( ph->ExtiLines, 1U << Line );
+
+  return;
+}
+
+/**
+ * @brief   Count the rising edges of TI1 with CNT_TIM in external clock mode 1.
+ */
+static void _tim_start( void ) {
+  //
+  if ( CNT_TIM == TIM1 ) __HAL_RCC_TIM1_CLK_ENABLE( );
+
+  WRITE_REG( CNT_TIM->CR1, 0 );
+  WRITE_REG( CNT_TIM->PSC, 0 );
+  WRITE_REG( CNT_TIM->ARR, 0xFFFFU );
+  WRITE_REG( CNT_TIM->CCER, 0 );                                                  // Rising edge
+  WRITE_REG( CNT_TIM->CCMR1, TIM_CCMR1_CC1S_0 | ( 3U << TIM_CCMR1_IC1F_Pos ) );     // 8 samples
+  WRITE_REG( CNT_TIM->SMCR, TIM_SMCR_TS_2 | TIM_SMCR_TS_0 | TIM_SMCR_SMS );         // TI1FP1
+  WRITE_REG( CNT_TIM->EGR, TIM_EGR_UG );
+  SET_BIT( CNT_TIM->CR1, TIM_CR1_CEN );
+
+  return;
+}
+
+/**
+ * @brief   Add the edges the timer counted since the last call.
+ * @note    The 16-bit timer must be read before it wraps, CNT_Serve( ) does it every
+ *          CNT_SERVE_MS.
+ */
+static void _tim_fold( psCNT_Ch_t ps, uint32_t Now ) {
+  //
+  uint16_t _Tim = (uint16_t) CNT_TIM->CNT;
+  ps->Stamp     = Now;
+  ps->Cnt += (uint16_t) ( _Tim - ps->TimLast );
+  ps->TimLast = _Tim;
+  return;
+}
+
+/**
+ * @brief   Read count and time stamp of one edge, without masking the EXTI handler.
+ * @note    The handler writes Stamp before Cnt, so an unchanged Cnt means both belong
+ *          together.
+ */
+static void _ch_read( psCNT_Ch_t ps, uint32_t *pCnt, uint32_t *pStamp ) {
+  //
+  uint32_t _Cnt;
+  do {
+    _Cnt    = ps->Cnt;
+    *pStamp = ps->Stamp;
+  } while ( _Cnt != ps->Cnt );
+  *pCnt = _Cnt;
+  return;
+}
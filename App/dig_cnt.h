@@ -0,0 +1,106 @@
+#ifndef __DIG_CNT_H__
+#define __DIG_CNT_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include "main.h"
+#include <stdbool.h>
+#include "dig_com.h"
+#include "dig_in.h"
+
+/** @defgroup CNT_Config_define Pulse counters
+ * @note  Counted inputs are taken out of the DI/LED pin sharing and stay inputs. An input
+ *        on the TI1 pin of CNT_TIM is counted by the timer in external clock mode, the
+ *        others by their EXTI line. Rising edges are counted.
+ */
+#ifndef CNT_TIM     // TIM2 runs the LED bank, TIM3 the Modbus timing, TIM4 the HAL time base
+#define CNT_TIM      TIM1
+#define CNT_TIM_PORT GPIOA     // TI1 of CNT_TIM, TIM1_CH1
+#define CNT_TIM_PIN  LL_GPIO_PIN_8
+#endif
+
+#ifndef CNT_EXTI_LINES_USED     // EXTI lines of gpio.c, not available for counting
+#define CNT_EXTI_LINES_USED ( GPIO_PIN_12 | B1_Pin )
+#endif
+
+#ifndef CNT_IRQ_PRIORITY     // EXTI4, EXTI9_5 and EXTI15_10 once an input uses them
+#define CNT_IRQ_PRIORITY 1U
+#endif
+
+/** A gate closes at its first edge after the gate time, so slow pulses still get a rate. The
+ * rate reads 0 when no edge came for twice the gate time and twice the last period, the
+ * period keeps its last value.
+ */
+#define CNT_SERVE_MS    10U        // Call period of CNT_Serve( )
+#define CNT_GATE_MS     1000U      // Default gate time
+#define CNT_GATE_MAX_MS 20000U     // Longest gate, well below the wrap of the cycle counter
+
+/** Period of saving changed counters to the config store [s]. A flash erase stalls the core,
+ * so the EXTI lines can miss edges while it runs. 0 saves them with App_Cfg_Save( ) only.
+ */
+#ifndef CNT_SAVE_PERIOD_S
+#define CNT_SAVE_PERIOD_S 3600U
+#endif
+
+/** @defgroup CNT_Registers_define Offsets of the exported registers
+ * @note  One block of CNT_REG_CH_SIZE registers per input. Reading CNT_REG_CNT_LO latches
+ *        the values of the input, the other registers of the block return the latch.
+ */
+#define CNT_REG_CH_SIZE   8U     //
+#define CNT_REG_CNT_LO    0U     // Counter, bits 0..15
+#define CNT_REG_CNT_HI    1U     // Counter, bits 16..31
+#define CNT_REG_FREQ_LO   2U     // Rate [0.01 Hz], bits 0..15
+#define CNT_REG_FREQ_HI   3U     // Rate [0.01 Hz], bits 16..31
+#define CNT_REG_PERIOD_LO 4U     // Period [us], bits 0..15
+#define CNT_REG_PERIOD_HI 5U     // Period [us], bits 16..31
+#define CNT_REG_NUM       ( DI_QNTT * CNT_REG_CH_SIZE )
+
+  typedef enum _eCNT_Source {     //
+    CNT_SRC_NONE = 0,
+    CNT_SRC_EXTI,     // EXTI line, edges time stamped by the cycle counter
+    CNT_SRC_TIM       // CNT_TIM external clock, extended to 32 bits by CNT_Serve( )
+  } eCNT_Src_t;
+
+  typedef struct _cnt_config {       // Configuration structure for CNT
+    uint16_t Inputs;                 // Counted inputs, bit n for input n
+    uint16_t aGateMs[ DI_QNTT ];     // Gate time of the rate [ms], CNT_SERVE_MS resolution
+  } sCNT_Cfg_t, *psCNT_Cfg_t;        // 34 bytes
+
+  typedef struct _cnt_channel {
+    volatile uint32_t Cnt;           // Edges, written by the EXTI handler or CNT_Serve( )
+    volatile uint32_t Stamp;         // Cycle time stamp at the last edge or timer read
+    uint32_t          GateCnt;       // Cnt at the gate start
+    uint32_t          GateStamp;     // Stamp at the gate start
+    uint32_t          Freq;          // [0.01 Hz]
+    uint32_t          Period;        // [us]
+    uint16_t          TimLast;       // Last CNT_TIM->CNT, CNT_SRC_TIM only
+    uint8_t           Src;           // eCNT_Src_t
+  } sCNT_Ch_t, *psCNT_Ch_t;
+
+  typedef struct _cnt_module_handler {
+    psCNT_Cfg_t psCfg;                // Pointer to configuration structure
+    sCNT_Ch_t   asCh[ DI_QNTT ];      //
+    uint8_t     aLineCh[ 16 ];        // Input of every EXTI line
+    uint16_t    ExtiLines;            // EXTI lines in use, bit n for line n
+    uint16_t    Active;               // Counted inputs, bit n for input n
+    uint32_t    aLatch[ 3 ];          // Cnt, Freq, Period of the latched input
+    uint8_t     LatchCh;              // Input of aLatch
+  } hCNT_t, *phCNT_t;
+
+  extern phCNT_t phCNT;
+
+  void CNT_Init( void );
+  void CNT_SetCfg( phCNT_t ph, psCNT_Cfg_t psCfg );
+  void CNT_Serve( phCNT_t ph );
+  void CNT_Load( phCNT_t ph, const uint32_t *aCnts );
+  bool CNT_Store( phCNT_t ph, uint32_t *aCnts );
+  void CNT_Clear( phCNT_t ph, uint16_t Inputs );
+  bool CNT_ReadReg( phCNT_t ph, uint16_t offset, uint16_t *pVal );
+  void CNT_EXTI_IRQHandler( void );
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __DIG_CNT_H__
@@ -7,13 +7,30 @@
  *****************************************************************************/
 
 #include "dig_in.h"
+#include "app_prof.h"
+#include <string.h>
+
+#define _pin_mask( Pin ) ( ( ( Pin ) >> GPIO_PIN_MASK_POS ) & 0x0000FFFFU )     // LL pin to bit
+
+#define DIM_CR_NIBBLE_MASK 0xFU     // CNF[1:0] MODE[1:0] of one pin
+#define DIM_CR_INPUT_PULL  0x8U     // CNF 10: input with pull-up/down, MODE 00: input
+#define DIM_CR_OUTPUT_PP   0x2U     // CNF 00: push-pull, MODE 10: output 2 MHz
 
 __STATIC_FORCEINLINE uint8_t     //
             _debounce_via_filter( bool Raw, uint8_t Prev, uint8_t Tau );
 static bool _signal_update( psDI_Sig_t ps, bool RawNew, uint8_t Tau );
+static bool _debounce( phDIM_t ph, uint16_t Inputs, uint16_t Raw );
+#if DIM_DMA_ENABLE
+static void _dma_init( phDIM_t ph );
+static void _dma_collect( phDIM_t ph );
+static void _dma_vote( phDIM_t ph, uint16_t Inputs, uint8_t Cls );
+#else
+static void _scan( phDIM_t ph, uint16_t Inputs, uint8_t Ports );
+static void _settle_delay( void );
+#endif
 static void _init_all_di_pins( phDIM_t ph );
-static void _set_pin_to_input( psPin_t ps );
-static void _set_pin_to_output( psPin_t ps, bool PinState );
+static void _set_ports_to_input( phDIM_t ph, uint8_t Ports );
+static void _set_ports_to_output( phDIM_t ph, uint8_t Ports, uint16_t States );
 static void _set_pins_cfg( void );
 static void _set_cfg( void );
 
@@ -21,6 +38,24 @@ static sDIM_Cfg_t sCfg;
 static sDI_Sig_t  asSigs[ DI_QNTT ];
 static sPin_t     asPins[ DI_QNTT ];
 
+#if DIM_DMA_ENABLE
+static uint16_t aDmaBuf[ DIM_DMA_PORTS_MAX ][ DIM_DMA_SAMPLES ];     // IDR 15:0 of every port
+
+/** ---------------------------------------------------------------------------
+ * @brief   DMA requests of DIM_DMA_TIM, one per port, the same as for DOM_DMA_ENABLE.
+ *
+ * TIM4_CH1 is left out, its DMA1 channel 1 serves the ADC of the KPB.
+ */
+static const struct {
+  DMA_Channel_TypeDef *psCh;     // DMA1 channel of the request
+  uint32_t             DIER;     // DMA request enable in DIM_DMA_TIM->DIER
+} asDmaReq[ DIM_DMA_PORTS_MAX ] = {
+    { DMA1_Channel7, TIM_DIER_UDE },       // TIM4_UP
+    { DMA1_Channel4, TIM_DIER_CC2DE },     // TIM4_CH2
+    { DMA1_Channel5, TIM_DIER_CC3DE },     // TIM4_CH3
+};
+#endif
+
 hDIM_t hDIM = {
     .psCfg     = &sCfg,
     .asSig     = asSigs,
@@ -38,7 +73,14 @@ void DIM_Init( void ) {
   //
   _set_cfg( );
   _set_pins_cfg( );
+#if DIM_DMA_ENABLE
+  phDIM->InputOnly = UINT16_MAX;     // Sampled by the DMA all the time
+#endif
   _init_all_di_pins( phDIM );
+  DIM_SetCfg( phDIM, &sCfg );
+#if DIM_DMA_ENABLE
+  _dma_init( phDIM );
+#endif
 
   return;
 }
@@ -47,22 +89,21 @@ void DIM_Init( void ) {
  * @brief   Perform a full update cycle for the digital input module.
  *
  * This function executes the complete service routine for digital inputs:
- *   1. Configures all associated pins as inputs before reading.
- *   2. Reads the current raw logic levels from all input pins into @ref hDIM_t::RawStates.
- *   3. Applies debounce filtering to produce stable states, stored in @ref hDIM_t::StableStates.
- *   4. Detects signal transitions and updates:
- *        - @ref hDIM_t::EdgeRise : bits with a 0 → 1 transition
- *        - @ref hDIM_t::EdgeFall : bits with a 1 → 0 transition
- *        - @ref hDIM_t::EdgeAny  : bits that changed in any direction
- *   5. Updates output pins (e.g., LEDs) according to the stable states and
- *      the mask @ref sDIM_Params_t::MaskForLED.
+ *   1. Scans the inputs of DIM_SCAN_10MS, and of DIM_SCAN_100MS at every
+ *      DIM_SLOW_MS, see _scan( ). The DIM_SCAN_1MS inputs are scanned by
+ *      DIM_ScanFast( ) in between.
+ *   2. Publishes the debounced states of all scans in @ref hDIM_t::sOutsDIM:
+ *        - @ref sMOS_t::EdgesRise : bits with a 0 → 1 transition
+ *        - @ref sMOS_t::EdgesFall : bits with a 1 → 0 transition
+ *        - @ref sMOS_t::EdgesAny  : bits that changed in any direction
+ *      A DIM_SCAN_1MS input can show both edges, if it pulsed since the last call.
  *
  * @param   pArgs   Pointer to the digital input module handler structure
  *                  (of type @ref hDIM_t).
  *
  * @note
- * - Debounce timing for each input is taken from @ref sDIM_Params_t::aTau.
- * - The number of inputs processed is defined by @ref hDIM_t::QnttDIs.
+ * - Call every DIM_UPDATE_MS.
+ * - Debounce timing for each input is taken from @ref sDIM_Cfg_t::aTau.
  */
 void DIM_Update( void *pArgs ) {
   //
@@ -70,45 +111,298 @@ void DIM_Update( void *pArgs ) {
 
   if ( !ph ) return;
 
-  // --- Step 1: Configure all pins as inputs before reading ---
-  for ( uint8_t id = 0; id < ph->QnttDIs; id++ )     //
-    _set_pin_to_input( &ph->asPin[ id ] );
+  // --- Step 1: Scan the classes due in this call ---
+#if DIM_DMA_ENABLE
+  _dma_collect( ph );
+  _dma_vote( ph, ph->aScanMask[ DIM_SCAN_10MS ], DIM_SCAN_10MS );
+  if ( ++ph->SlowCnt >= DIM_SLOW_MS / DIM_UPDATE_MS ) {
+    ph->SlowCnt = 0;
+    _dma_vote( ph, ph->aScanMask[ DIM_SCAN_100MS ], DIM_SCAN_100MS );
+  }
+#else
+  uint16_t _Inputs = ph->aScanMask[ DIM_SCAN_10MS ];
+  uint8_t  _Ports  = ph->aScanPorts[ DIM_SCAN_10MS ];
+  if ( ++ph->SlowCnt >= DIM_SLOW_MS / DIM_UPDATE_MS ) {
+    ph->SlowCnt = 0;
+    _Inputs |= ph->aScanMask[ DIM_SCAN_100MS ];
+    _Ports |= ph->aScanPorts[ DIM_SCAN_100MS ];
+  }
+  if ( _Inputs ) _scan( ph, _Inputs, _Ports );
+#endif
+
+  // --- Step 2: Publish the states and the edges of all scans since the last call ---
+  ph->sOutsDIM.EdgesRise = ph->ScanRise;
+  ph->sOutsDIM.EdgesFall = ph->ScanFall;
+  ph->sOutsDIM.EdgesAny  = ph->ScanRise | ph->ScanFall;
+  ph->sOutsDIM.States    = ph->ScanStates;
+  ph->ScanRise           = 0;
+  ph->ScanFall           = 0;
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Scan the DIM_SCAN_1MS inputs.
+ * @param   pArgs   Pointer to the digital input module handler structure.
+ * @note    Call every DIM_FAST_MS from the same context as DIM_Update( ). Without
+ *          DIM_SCAN_1MS inputs it returns at once. With DIM_DMA_ENABLE DIM_Update( )
+ *          filters them sample by sample, and it always returns at once.
+ */
+void DIM_ScanFast( void *pArgs ) {
+  //
+  phDIM_t ph = (phDIM_t) pArgs;
+
+#if DIM_DMA_ENABLE
+  UNUSED( ph );
+#else
+  if ( !ph || !ph->aScanMask[ DIM_SCAN_1MS ] ) return;
+  _scan( ph, ph->aScanMask[ DIM_SCAN_1MS ], ph->aScanPorts[ DIM_SCAN_1MS ] );
+#endif
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Link the configuration and sort the inputs into their scan classes.
+ * @note    Unknown classes are scanned as DIM_SCAN_10MS. The filters keep their state, so
+ *          an input changing its class goes on from its current value.
+ */
+void DIM_SetCfg( phDIM_t ph, psDIM_Cfg_t psCfg ) {
+  //
+  if ( !ph || !psCfg ) return;
+  ph->psCfg = psCfg;
+
+  memset( ph->aScanMask, 0, sizeof( ph->aScanMask ) );
+  memset( ph->aScanPorts, 0, sizeof( ph->aScanPorts ) );
+  for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
+    uint8_t _Cls = psCfg->aScan[ id ] < DIM_SCAN_QNTT ? psCfg->aScan[ id ] : DIM_SCAN_10MS;
+    if ( !ph->asPin[ id ].psPort ) continue;
+    SET_BIT( ph->aScanMask[ _Cls ], 1U << id );
+    SET_BIT( ph->aScanPorts[ _Cls ], 1U << ph->aPortId[ id ] );
+  }
+#if DIM_DMA_ENABLE
+  memset( ph->aHigh, 0, sizeof( ph->aHigh ) );     // Majority from the next samples on
+  memset( ph->aClsSamples, 0, sizeof( ph->aClsSamples ) );
+#endif
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Keep inputs out of the DI/LED pin sharing.
+ * @param   Inputs  Bit n for input n. These pins stay inputs with pull-down and show no
+ *                  LED, e.g. for the pulse counters. The others share their pin again.
+ */
+void DIM_SetInputOnly( phDIM_t ph, uint16_t Inputs ) {
+  //
+#if DIM_DMA_ENABLE
+  Inputs = UINT16_MAX;     // Sampled by the DMA, all pins stay inputs
+#endif
+  if ( !ph || ph->InputOnly == Inputs ) return;
+  ph->InputOnly = Inputs;
+  _init_all_di_pins( ph );
+  _set_ports_to_output( ph, DIM_PORTS_ALL, ph->ScanStates ^ ph->psCfg->MaskForLED );
+
+  return;
+}
+
+#if !DIM_DMA_ENABLE
+/** --------------------------------------------------------------------------
+ * @brief   Sample and debounce the inputs of the due scan classes.
+ * @param   ph      Pointer to the digital input module handler structure.
+ * @param   Inputs  Inputs to scan, bit n for input n.
+ * @param   Ports   Ports of these inputs, bit n for asPort[ n ]. The other shared pins of
+ *                  these ports are switched with them, their LEDs go dark for the settle time.
+ * @note    The LEDs follow the new states at once.
+ */
+static void _scan( phDIM_t ph, uint16_t Inputs, uint8_t Ports ) {
+  //
+  // Configure the pins as inputs before reading, one write per register
+  _set_ports_to_input( ph, Ports );
+  _settle_delay( );
+
+  // Read raw digital input states, all pins of a port at once
+  uint32_t _aIDR[ DIM_PORTS_MAX ];
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ )     //
+    if ( READ_BIT( Ports, 1U << id ) ) _aIDR[ id ] = ph->asPort[ id ].psPort->IDR;
+
+  _set_ports_to_output( ph, Ports, ph->ScanStates ^ ph->psCfg->MaskForLED );     // LEDs back on
 
-  // --- Step 2: Read raw digital input states ---
   uint16_t _NewRaw = 0;
   for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
-    psPin_t psPin = &ph->asPin[ id ];
-    if ( psPin->psPort ) {
-      if ( LL_GPIO_IsInputPinSet( psPin->psPort, psPin->Pin ) )     //
-        SET_BIT( _NewRaw, 1U << id );
-    }
+    if ( READ_BIT( Inputs, 1U << id ) &&
+         ( _aIDR[ ph->aPortId[ id ] ] & _pin_mask( ph->asPin[ id ].Pin ) ) )     //
+      SET_BIT( _NewRaw, 1U << id );
   }
 
-  // --- Step 3: Apply debounce and calculate new stable states ---
+  // Update outputs (LEDs or other indicators) on a change
+  // Output = StableStates XOR MaskForLED
+  if ( _debounce( ph, Inputs, _NewRaw ) )     //
+    _set_ports_to_output( ph, Ports, ph->ScanStates ^ ph->psCfg->MaskForLED );
+
+  return;
+}
+
+#endif
+
+/** --------------------------------------------------------------------------
+ * @brief   Apply debounce and calculate the new stable states of the scanned inputs.
+ * @param   Inputs  Scanned inputs, bit n for input n.
+ * @param   Raw     Their raw states.
+ * @note    The edges are collected in ScanRise and ScanFall until DIM_Update( ) publishes
+ *          them.
+ * @return  true if a stable state changed.
+ */
+static bool _debounce( phDIM_t ph, uint16_t Inputs, uint16_t Raw ) {
+  //
   uint16_t _NewStable = 0;
   for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
     uint16_t _Mask = 1U << id;
-    if ( _signal_update( &ph->asSig[ id ], READ_BIT( _NewRaw, _Mask ) != 0,     //
-                         ph->psCfg->aTau[ id ] ) )                              //
+    if ( !READ_BIT( Inputs, _Mask ) ) continue;
+    if ( _signal_update( &ph->asSig[ id ], READ_BIT( Raw, _Mask ) != 0,     //
+                         ph->psCfg->aTau[ id ] ) )                          //
       SET_BIT( _NewStable, _Mask );
   }
+  ph->RawStates = ( ph->RawStates & ~Inputs ) | ( Raw & Inputs );
 
-  // Step 4: Detect edges and save new states
-  ph->sOutsDIM.EdgesRise = ( ~ph->sOutsDIM.States ) & _NewStable;     // 0 -> 1
-  ph->sOutsDIM.EdgesFall = ph->sOutsDIM.States & ( ~_NewStable );     // 1 -> 0
-  ph->sOutsDIM.EdgesAny  = _NewStable ^ ph->sOutsDIM.States;          // 0 -> 1 or 1 -> 0
-  ph->sOutsDIM.States    = _NewStable;
-  ph->RawStates          = _NewRaw;
+  uint16_t _States = ( ph->ScanStates & ~Inputs ) | _NewStable;
+  if ( _States == ph->ScanStates ) return false;
+  ph->ScanRise |= ~ph->ScanStates & _States;     // 0 -> 1
+  ph->ScanFall |= ph->ScanStates & ~_States;     // 1 -> 0
+  ph->ScanStates = _States;
 
-  // --- Step 5: Update outputs (LEDs or other indicators) ---
-  // Output = StableStates XOR MaskForLED
+  return true;
+}
+
+#if DIM_DMA_ENABLE
+/** --------------------------------------------------------------------------
+ * @brief   Let the DMA copy the IDR of every port to aDmaBuf at every update of DIM_DMA_TIM.
+ * @note    The compare channels match at 0, so all requests come with the update.
+ */
+static void _dma_init( phDIM_t ph ) {
+  //
+  __HAL_RCC_DMA1_CLK_ENABLE( );
+  for ( uint8_t id = 0; id < ph->QnttPorts && id < DIM_DMA_PORTS_MAX; id++ ) {
+    DMA_Channel_TypeDef *psCh = asDmaReq[ id ].psCh;
+    CLEAR_BIT( psCh->CCR, DMA_CCR_EN );
+    WRITE_REG( psCh->CPAR, (uint32_t) &ph->asPort[ id ].psPort->IDR );
+    WRITE_REG( psCh->CMAR, (uint32_t) aDmaBuf[ id ] );
+    WRITE_REG( psCh->CNDTR, DIM_DMA_SAMPLES );
+    WRITE_REG( psCh->CCR, DMA_CCR_PL_1 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_1 |     // IDR 15:0
+                              DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_EN );
+  }
+  ph->DmaTail  = 0;
+  ph->DmaStamp = Prof_Start( );
+
+  WRITE_REG( DIM_DMA_TIM->CCR2, 0 );     // Match with the update
+  WRITE_REG( DIM_DMA_TIM->CCR3, 0 );
+  for ( uint8_t id = 0; id < ph->QnttPorts && id < DIM_DMA_PORTS_MAX; id++ )     //
+    SET_BIT( DIM_DMA_TIM->DIER, asDmaReq[ id ].DIER );
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Filter the samples of the DMA since the last call.
+ * @note    The DIM_SCAN_1MS inputs are debounced at every sample. The high samples of the
+ *          other inputs are counted for all pins of a port at once, with one bit-sliced
+ *          counter per port: bit n of aCnt[ k ] is bit k of the count of pin n.
+ * @note    A main loop stall of DIM_DMA_SAMPLES ms or more, e.g. a flash erase, lets the
+ *          DMA overwrite samples that were not filtered yet. The ring index alone can't
+ *          tell, so the time since DmaTail is compared with the new samples. On an overrun
+ *          only the newest half of the ring is filtered and DmaLost counts the rest.
+ *          The HAL tick can't be used, its handler is stalled by the flash erase too.
+ */
+static void _dma_collect( phDIM_t ph ) {
+  //
+  const uint8_t _Ports = ph->QnttPorts < DIM_DMA_PORTS_MAX ? ph->QnttPorts : DIM_DMA_PORTS_MAX;
+  if ( !_Ports ) return;
+
+  // Samples written by all channels, the requests of one update come one after the other
+  uint8_t _Qntt = DIM_DMA_SAMPLES - 1U;
+  for ( uint8_t id = 0; id < _Ports; id++ ) {
+    uint8_t _Head = ( DIM_DMA_SAMPLES - asDmaReq[ id ].psCh->CNDTR ) & ( DIM_DMA_SAMPLES - 1U );
+    uint8_t _New  = ( _Head - ph->DmaTail ) & ( DIM_DMA_SAMPLES - 1U );
+    if ( _New < _Qntt ) _Qntt = _New;
+  }
+  // Updates since DmaTail from the time stamps, which run on in a stall. One less at most,
+  // DmaStamp may even be ahead by less than 1 ms.
+  uint32_t _CyclesPerMs = SystemCoreClock / 1000U;
+  uint32_t _Now         = Prof_Start( );
+  int32_t  _Elapsed     = (int32_t) ( _Now - ph->DmaStamp ) / (int32_t) _CyclesPerMs;
+  if ( _Elapsed > (int32_t) _Qntt + 1 ) {     // Overrun. One more is a channel that lags.
+    // Filter the newest half, but the last sample, which a lagging channel may not have yet
+    uint8_t  _Keep = DIM_DMA_SAMPLES / 2U;
+    uint32_t _Lost = (uint32_t) _Elapsed - _Keep;
+    ph->DmaLost    = ph->DmaLost + _Lost < UINT16_MAX ? ph->DmaLost + _Lost : UINT16_MAX;
+    ph->DmaTail    = ( ph->DmaTail + _Qntt - _Keep - 1U ) & ( DIM_DMA_SAMPLES - 1U );
+    ph->DmaStamp   = _Now - ( _Keep + 1U ) * _CyclesPerMs;
+    _Qntt          = _Keep;
+  }
+  if ( !_Qntt ) return;
+
+  uint16_t _aCnt[ DIM_DMA_PORTS_MAX ][ DIM_DMA_CNT_BITS ] = { 0 };
+  uint16_t _Fast = ph->aScanMask[ DIM_SCAN_1MS ];
+  for ( uint8_t i = 0; i < _Qntt; i++ ) {
+    uint8_t _Idx = ( ph->DmaTail + i ) & ( DIM_DMA_SAMPLES - 1U );
+    for ( uint8_t id = 0; id < _Ports; id++ ) {     // Add the sample to the counts of all pins
+      uint16_t _Carry = aDmaBuf[ id ][ _Idx ];
+      for ( uint8_t k = 0; k < DIM_DMA_CNT_BITS && _Carry; k++ ) {
+        uint16_t _Next = _aCnt[ id ][ k ] & _Carry;
+        _aCnt[ id ][ k ] ^= _Carry;
+        _Carry = _Next;
+      }
+    }
+    if ( !_Fast ) continue;
+
+    uint16_t _Raw = 0;
+    for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
+      if ( READ_BIT( _Fast, 1U << id ) && ph->aPortId[ id ] < _Ports &&
+           ( aDmaBuf[ ph->aPortId[ id ] ][ _Idx ] & _pin_mask( ph->asPin[ id ].Pin ) ) )     //
+        SET_BIT( _Raw, 1U << id );
+    }
+    _debounce( ph, _Fast, _Raw );
+  }
+  ph->DmaTail = ( ph->DmaTail + _Qntt ) & ( DIM_DMA_SAMPLES - 1U );
+  ph->DmaStamp += _Qntt * _CyclesPerMs;
+
+  for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
+    if ( !ph->asPin[ id ].psPort || READ_BIT( _Fast, 1U << id ) ) continue;
+    uint8_t  _Port = ph->aPortId[ id ];
+    uint32_t _Pos  = POSITION_VAL( _pin_mask( ph->asPin[ id ].Pin ) );
+    if ( _Port >= _Ports ) continue;
+    for ( uint8_t k = 0; k < DIM_DMA_CNT_BITS; k++ )     //
+      ph->aHigh[ id ] += ( ( _aCnt[ _Port ][ k ] >> _Pos ) & 1U ) << k;
+  }
+  ph->aClsSamples[ DIM_SCAN_10MS ] += _Qntt;
+  ph->aClsSamples[ DIM_SCAN_100MS ] += _Qntt;
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Debounce the inputs of the due scan classes by the majority of their samples.
+ * @param   Inputs  Inputs to scan, bit n for input n.
+ * @param   Cls     DIM_SCAN_10MS, or DIM_SCAN_100MS at every DIM_SLOW_MS.
+ * @note    Without a new sample the inputs keep their states.
+ */
+static void _dma_vote( phDIM_t ph, uint16_t Inputs, uint8_t Cls ) {
+  //
+  uint16_t _Samples = ph->aClsSamples[ Cls ];
+  if ( !_Samples ) return;
+
+  uint16_t _Raw = 0;
   for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
-    bool _OutState = ( ( _NewStable ^ ph->psCfg->MaskForLED ) & ( 1U << id ) ) != 0;
-    _set_pin_to_output( &ph->asPin[ id ], _OutState );
+    if ( !READ_BIT( Inputs, 1U << id ) ) continue;
+    if ( 2U * ph->aHigh[ id ] > _Samples ) SET_BIT( _Raw, 1U << id );
+    ph->aHigh[ id ] = 0;
   }
+  _debounce( ph, Inputs, _Raw );
+  ph->aClsSamples[ Cls ] = 0;
 
   return;
 }
+#endif
 
 /** --------------------------------------------------------------------------
  * @brief   Set configuration parameters in the config structure.
@@ -116,7 +410,8 @@ void DIM_Update( void *pArgs ) {
 static void _set_cfg( void ) {
   //
   for ( size_t i = 0; i < DI_QNTT; i++ ) {
-    sCfg.aTau[ i ] = 50;     // 50 update cycles ~ 500 ms @ 100 Hz
+    sCfg.aTau[ i ]  = 50;                // 50 update cycles ~ 500 ms @ 100 Hz
+    sCfg.aScan[ i ] = DIM_SCAN_10MS;     //
   }
   sCfg.MaskForLED = 0x000F;     // Invert first 4 inputs on output
   return;
@@ -144,9 +439,11 @@ static void _set_pins_cfg( void ) {
  * @brief   Initialize all digital input pins as inputs with pulldown.
  * @param   ph  Pointer to the digital input module handler structure
  *               (of type @ref hDIM_t).
+ * @note    Groups the pins by port and precomputes the CRL/CRH mode nibbles.
  */
 static void _init_all_di_pins( phDIM_t ph ) {
   //
+  ph->QnttPorts = 0;
   for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
     psPin_t psPin = &ph->asPin[ id ];
     switch ( (uint32_t) psPin->psPort ) {
@@ -154,49 +451,118 @@ static void _init_all_di_pins( phDIM_t ph ) {
       case ( (uint32_t) GPIOB ): LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_GPIOB ); break;
       case ( (uint32_t) GPIOC ): LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_GPIOC ); break;
       case ( (uint32_t) GPIOD ): LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_GPIOD ); break;
-      default: break;
+      default: psPin->psPort = NULL; break;     // Unused or unsupported
+    }
+    if ( !psPin->psPort ) continue;
+
+    uint8_t port = 0;
+    while ( port < ph->QnttPorts && ph->asPort[ port ].psPort != psPin->psPort ) ++port;
+    if ( port >= DIM_PORTS_MAX ) {
+      psPin->psPort = NULL;
+      continue;
+    }
+    psDIM_Port_t ps = &ph->asPort[ port ];
+    if ( port == ph->QnttPorts ) {
+      memset( ps, 0, sizeof( sDIM_Port_t ) );
+      ps->psPort = psPin->psPort;
+      ph->QnttPorts++;
+    }
+    ph->aPortId[ id ] = port;
+
+    uint16_t _Mask  = _pin_mask( psPin->Pin );
+    uint32_t _Shift = ( POSITION_VAL( _Mask ) & 7U ) * 4U;     // Nibble in CRL or CRH
+    if ( READ_BIT( ph->InputOnly, 1U << id ) ) {                // Input now, not switched
+      WRITE_REG( psPin->psPort->BRR, _Mask );
+      if ( _Mask & 0x00FFU )
+        MODIFY_REG( psPin->psPort->CRL, DIM_CR_NIBBLE_MASK << _Shift, DIM_CR_INPUT_PULL << _Shift );
+      else
+        MODIFY_REG( psPin->psPort->CRH, DIM_CR_NIBBLE_MASK << _Shift, DIM_CR_INPUT_PULL << _Shift );
+      continue;
+    }
+    SET_BIT( ps->Pins, _Mask );
+    if ( _Mask & 0x00FFU ) {
+      SET_BIT( ps->MaskCRL, DIM_CR_NIBBLE_MASK << _Shift );
+      SET_BIT( ps->InCRL, DIM_CR_INPUT_PULL << _Shift );
+      SET_BIT( ps->OutCRL, DIM_CR_OUTPUT_PP << _Shift );
+    }
+    else {
+      SET_BIT( ps->MaskCRH, DIM_CR_NIBBLE_MASK << _Shift );
+      SET_BIT( ps->InCRH, DIM_CR_INPUT_PULL << _Shift );
+      SET_BIT( ps->OutCRH, DIM_CR_OUTPUT_PP << _Shift );
     }
-    _set_pin_to_input( psPin );
   }
 
+#if DIM_SETTLE_US
+  SET_BIT( CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk );     // Cycle counter for the delay
+  SET_BIT( DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk );
+#endif
+
+  _set_ports_to_input( ph, DIM_PORTS_ALL );
+
   return;
 }
 
 /** --------------------------------------------------------------------------
- * @brief   Change pin mode to input with pulldown.
- * @param   ps  Pointer to the pin structure (of type @ref sPin_t).
+ * @brief   Change the mode of the shared pins of the ports to input with pulldown.
+ * @param   Ports   Bit n for asPort[ n ].
+ * @note    The pull direction is the ODR bit, so the pins are reset first.
  */
-static void _set_pin_to_input( psPin_t ps ) {
+static void _set_ports_to_input( phDIM_t ph, uint8_t Ports ) {
   //
-  if ( ps->psPort ) {
-    LL_GPIO_SetPinPull( ps->psPort, ps->Pin, LL_GPIO_PULL_DOWN );
-    LL_GPIO_SetPinMode( ps->psPort, ps->Pin, LL_GPIO_MODE_INPUT );
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ ) {
+    if ( !READ_BIT( Ports, 1U << id ) ) continue;
+    psDIM_Port_t  ps     = &ph->asPort[ id ];
+    GPIO_TypeDef *psPort = ps->psPort;
+    WRITE_REG( psPort->BRR, ps->Pins );
+    if ( ps->MaskCRL ) MODIFY_REG( psPort->CRL, ps->MaskCRL, ps->InCRL );
+    if ( ps->MaskCRH ) MODIFY_REG( psPort->CRH, ps->MaskCRH, ps->InCRH );
   }
 
   return;
 }
 
 /** --------------------------------------------------------------------------
- * @brief   Change pin mode to output with push-pull.
- * @param   ps        Pointer to the pin structure (of type @ref sPin_t).
- * @param   PinState  true/false == set/reset
+ * @brief   Change the mode of the shared pins of the ports to output with push-pull.
+ * @param   Ports   Bit n for asPort[ n ].
+ * @param   States  Output state for every input, bit n for input n.
+ * @note    The output states are written first, so the pins switch straight to them.
  */
-static void _set_pin_to_output( psPin_t ps, bool PinState ) {
-  /**
-   * Set initial output state before switching to output mode
-   * Configure as output, push-pull, low speed
-   */
-  if ( ps->psPort ) {
-    PinState ? LL_GPIO_SetOutputPin( ps->psPort, ps->Pin ) :
-               LL_GPIO_ResetOutputPin( ps->psPort, ps->Pin );
-    LL_GPIO_SetPinSpeed( ps->psPort, ps->Pin, LL_GPIO_SPEED_FREQ_LOW );
-    LL_GPIO_SetPinOutputType( ps->psPort, ps->Pin, LL_GPIO_OUTPUT_PUSHPULL );
-    LL_GPIO_SetPinMode( ps->psPort, ps->Pin, LL_GPIO_MODE_OUTPUT );
+static void _set_ports_to_output( phDIM_t ph, uint8_t Ports, uint16_t States ) {
+  //
+  uint16_t _aSet[ DIM_PORTS_MAX ] = { 0 };
+  for ( uint8_t id = 0; id < ph->QnttDIs; id++ ) {
+    psPin_t psPin = &ph->asPin[ id ];
+    if ( psPin->psPort && READ_BIT( States, 1U << id ) )     //
+      SET_BIT( _aSet[ ph->aPortId[ id ] ], _pin_mask( psPin->Pin ) );
+  }
+
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ ) {
+    if ( !READ_BIT( Ports, 1U << id ) ) continue;
+    psDIM_Port_t  ps     = &ph->asPort[ id ];
+    GPIO_TypeDef *psPort = ps->psPort;
+    WRITE_REG( psPort->BSRR, ( (uint32_t) ( ps->Pins & ~_aSet[ id ] ) << 16 ) | _aSet[ id ] );
+    if ( ps->MaskCRL ) MODIFY_REG( psPort->CRL, ps->MaskCRL, ps->OutCRL );
+    if ( ps->MaskCRH ) MODIFY_REG( psPort->CRH, ps->MaskCRH, ps->OutCRH );
   }
 
   return;
 }
 
+#if !DIM_DMA_ENABLE
+/** --------------------------------------------------------------------------
+ * @brief   Wait DIM_SETTLE_US for the inputs to settle.
+ */
+static void _settle_delay( void ) {
+  //
+#if DIM_SETTLE_US
+  uint32_t _Cycles = DIM_SETTLE_US * ( SystemCoreClock / 1000000U );
+  uint32_t _Start  = DWT->CYCCNT;
+  while ( DWT->CYCCNT - _Start < _Cycles ) {}
+#endif
+  return;
+}
+#endif
+
 /** --------------------------------------------------------------------------
  * @brief   Update signal state with debounce and hysteresis.
  *
@@ -12,6 +12,46 @@ extern "C"
 #define DI_QNTT            16U      // Number of digital inputs, max 16
 #define DI_THRESHOLD_TRUE  160U     // 160 ~ 2/3 of 256
 #define DI_THRESHOLD_FALSE 96U      // 96 ~ 1/3 of 256
+#define DIM_PORTS_MAX      4U       // GPIOA .. GPIOD
+
+/** Delay between switching the shared pins to input and sampling them [us]. The pull-down
+ * has to discharge the LED and trace capacitance. 0 samples right after switching.
+ */
+#ifndef DIM_SETTLE_US
+#define DIM_SETTLE_US 5U
+#endif
+
+/** Scan classes. DIM_Update( ) scans the 10 ms class at every call and the 100 ms class at
+ * every 10th, DIM_ScanFast( ) the 1 ms class. Only the ports with inputs of a due class are
+ * switched to input. sDIM_Cfg_t::aTau counts the scans of the class of the input.
+ */
+#define DIM_UPDATE_MS 10U       // Call period of DIM_Update( )
+#define DIM_FAST_MS   1U        // Call period of DIM_ScanFast( )
+#define DIM_SLOW_MS   100U      // Scan period of DIM_SCAN_100MS, a multiple of DIM_UPDATE_MS
+#define DIM_PORTS_ALL 0xFFU     // All ports of asPort
+
+/** Input sampling by DMA. One DMA request of DIM_DMA_TIM per port copies the IDR into a
+ * circular buffer every DIM_FAST_MS, on the timer edge whatever the main loop does.
+ * DIM_Update( ) filters the samples since its last call as one block: the DIM_SCAN_1MS
+ * inputs sample by sample, the others by the majority of the samples since their last scan.
+ * A longer main loop stall, e.g. a flash erase, loses samples, which DmaLost counts.
+ * The pins stay inputs, so the DI/LED sharing is off. It takes the TIM4 requests of
+ * DOM_DMA_ENABLE. 0 reads the pins in DIM_Update( ) and DIM_ScanFast( ).
+ */
+#ifndef DIM_DMA_ENABLE
+#define DIM_DMA_ENABLE 0
+#endif
+#define DIM_DMA_TIM       TIM4     // HAL time base, 1 MHz counter, update every 1 ms
+#define DIM_DMA_PORTS_MAX 3U       // One DMA request per port, inputs of further ports read 0
+#define DIM_DMA_SAMPLES   64U      // Power of 2, up to 63 ms between DIM_Update( ), then DmaLost
+#define DIM_DMA_CNT_BITS  6U       // Bit-sliced sample counter, up to DIM_DMA_SAMPLES - 1
+
+  typedef enum _eDIM_Scan {     //
+    DIM_SCAN_10MS = 0,          // Default, every DIM_Update( )
+    DIM_SCAN_1MS,               // Every DIM_ScanFast( ), e.g. for short pulses
+    DIM_SCAN_100MS,             // Every DIM_SLOW_MS, e.g. door contacts and level switches
+    DIM_SCAN_QNTT
+  } eDIM_Scan_t;
 
   typedef struct _dig_input {              // Digital input structure
     union {                                //
@@ -28,10 +68,27 @@ extern "C"
     uint8_t DebounceDuration;       // Duration of the ongoing debounce in update cycles
   } sDI_Sig_t, *psDI_Sig_t;
 
+  /**
+   * @brief   Shared DI/LED pins of one GPIO port.
+   * The mode nibbles of the CRL/CRH registers are precomputed, so switching all shared pins
+   * of the port between input and output is one write per register.
+   */
+  typedef struct _dig_in_port {
+    GPIO_TypeDef *psPort;      // GPIOA, GPIOB ...
+    uint32_t      MaskCRL;     // Mode nibbles of the shared pins 0..7
+    uint32_t      MaskCRH;     // Mode nibbles of the shared pins 8..15
+    uint32_t      InCRL;       // Input with pull-down
+    uint32_t      InCRH;       //
+    uint32_t      OutCRL;      // Push-pull output, low speed
+    uint32_t      OutCRH;      //
+    uint16_t      Pins;        // Bit mask of the shared pins
+  } sDIM_Port_t, *psDIM_Port_t;
+
   typedef struct _dig_in_module_config {     // Configuration structure for DIM
-    uint8_t  aTau[ DI_QNTT ];
-    uint16_t MaskForLED;
-  } sDIM_Cfg_t, *psDIM_Cfg_t;     // 18 bytes max
+    uint8_t  aTau[ DI_QNTT ];                 // Debounce, in scans of the class of the input
+    uint16_t MaskForLED;                      //
+    uint8_t  aScan[ DI_QNTT ];                // eDIM_Scan_t of every input
+  } sDIM_Cfg_t, *psDIM_Cfg_t;                 // 34 bytes
 
   /**
    * @brief   Digital Input Module Handler
@@ -46,12 +103,32 @@ extern "C"
     uint16_t    RawStates;     // Read the pins and update sDI_Sig_t after
     sMOS_t      sOutsDIM;      // Module Output Signals structure
     uint8_t     QnttDIs;       // Total number of digital inputs, max 16
+    sDIM_Port_t asPort[ DIM_PORTS_MAX ];         // Ports with digital inputs
+    uint8_t     aPortId[ DI_QNTT ];              // Index in asPort for every input
+    uint8_t     QnttPorts;                       // Used entries of asPort
+    uint16_t    InputOnly;                       // Inputs kept out of the LED sharing
+    uint16_t    aScanMask[ DIM_SCAN_QNTT ];      // Inputs of every scan class
+    uint8_t     aScanPorts[ DIM_SCAN_QNTT ];     // Ports of the inputs, bit n for asPort[ n ]
+    uint8_t     SlowCnt;                         // DIM_Update( ) calls since the last slow scan
+    uint16_t    ScanStates;                      // Debounced states of the last scans
+    uint16_t    ScanRise;                        // Edges of the scans since the last DIM_Update( )
+    uint16_t    ScanFall;                        //
+#if DIM_DMA_ENABLE
+    uint16_t    aHigh[ DI_QNTT ];                // High samples since the last scan of the input
+    uint16_t    aClsSamples[ DIM_SCAN_QNTT ];    // Samples since the last scan of the class
+    uint8_t     DmaTail;                         // Next sample to filter
+    uint16_t    DmaLost;                         // Samples overwritten before they were filtered
+    uint32_t    DmaStamp;                        // Prof_Start( ) when DmaTail was the next sample
+#endif
   } hDIM_t, *phDIM_t;
 
   extern phDIM_t phDIM;
 
   void DIM_Init( void );
   void DIM_Update( void *pArgs );
+  void DIM_ScanFast( void *pArgs );
+  void DIM_SetCfg( phDIM_t ph, psDIM_Cfg_t psCfg );
+  void DIM_SetInputOnly( phDIM_t ph, uint16_t Inputs );
 
 #ifdef __cplusplus
 }
@@ -14,11 +14,7 @@ __STATIC_FORCEINLINE uint16_t _mix_apply_masks( psMOS_t psOuts, psMIX_MosMasks_t
 hMIX_t  hMIX;
 phMIX_t phMIX;
 
-sMIX_ChCfg_t asChannelCfg[ MIX_QNTT ];
-
-sMIX_Cfg_t sCfgMIX = {
-    .asChCfgs = asChannelCfg,
-};
+sMIX_Cfg_t sCfgMIX;
 uint32_t aChannelsInput[ MIX_QNTT ];
 
 /** ---------------------------------------------------------------------------
@@ -26,15 +22,15 @@ uint32_t aChannelsInput[ MIX_QNTT ];
  */
 void MIX_Init( void ) {
   //
-  for ( size_t i = 0; i < sizeof( asChannelCfg ); i++ ) ( (uint8_t *) asChannelCfg )[ i ] = 0;
+  psMIX_ChCfg_t _as = sCfgMIX.asChCfgs;
+  for ( size_t i = 0; i < sizeof( sCfgMIX ); i++ ) ( (uint8_t *) &sCfgMIX )[ i ] = 0;
   for ( size_t i = 0; i < MIX_QNTT; i++ ) {
-    asChannelCfg[ i ].eLogicOperation = MIX_LO_AND;
-    asChannelCfg[ i ].sMasksDIM.State = 1U << i;
-    asChannelCfg[ i ].MaskUsage       = 1U << i;
-    aChannelsInput[ i ]               = 0;
+    _as[ i ].eLogicOperation = MIX_LO_AND;
+    _as[ i ].sMasksDIM.State = 1U << i;
+    _as[ i ].MaskUsage       = 1U << i;
+    aChannelsInput[ i ]      = 0;
   }
 
-  hMIX.psCfg          = &sCfgMIX;
   hMIX.aChannelsInput = aChannelsInput;
   hMIX.psOutsDIM      = &phDIM->sOutsDIM;
   // Clear output signals
@@ -42,6 +38,7 @@ void MIX_Init( void ) {
   for ( uint8_t i; i < 4; i++ ) _ptr[ i ] = 0;
   hMIX.ChQntt = MIX_QNTT;
   phMIX       = &hMIX;
+  MIX_SetCfg( phMIX, &sCfgMIX );
 
   return;
 }
@@ -75,6 +72,33 @@ void MIX_Update( phMIX_t ph ) {
   return;
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief   Link the configuration and compile the channel masks from it.
+ *
+ * A channel without used inputs ( MaskUsage = 0 ) has a constant output. It is
+ * calculated once here, and MIX_Update( ) only visits the channels in ChCalc.
+ *
+ * @param[in,out] ph      Pointer to the mixer handle structure (@ref hMIX_t).
+ * @param[in]     psCfg   Configuration, must stay valid while the module runs.
+ */
+void MIX_SetCfg( phMIX_t ph, psMIX_Cfg_t psCfg ) {
+  //
+  if ( !ph || !psCfg ) return;
+  ph->psCfg   = psCfg;
+  ph->ChCalc  = 0;
+  ph->ChConst = 0;
+  for ( uint8_t _Ch = 0; _Ch < ph->ChQntt; _Ch++ ) {
+    if ( psCfg->asChCfgs[ _Ch ].MaskUsage ) {
+      SET_BIT( ph->ChCalc, 1U << _Ch );
+      continue;
+    }
+    ph->aChannelsInput[ _Ch ] = 0;
+    if ( _mix_channel_calc( ph, _Ch ) ) SET_BIT( ph->ChConst, 1U << _Ch );
+  }
+
+  return;
+}
+
 /** ---------------------------------------------------------------------------
  * @brief   Apply configured masks to module output signals.
  * @param   psOuts  Pointer to the module output signals structure (psMOS_t).
@@ -114,8 +138,9 @@ __STATIC_FORCEINLINE void _mix_inputs_update( phMIX_t ph ) {
   psMOS_t          psOuts;
   uint16_t         _InDIM, _InMIX;
 
-  /* Loop through all configured mixer channels */
-  for ( size_t _Ch = 0; _Ch < ph->ChQntt; _Ch++ ) {
+  /* Loop through the mixer channels with used inputs */
+  for ( uint32_t _Chs = ph->ChCalc; _Chs; _Chs &= _Chs - 1U ) {
+    uint8_t _Ch = POSITION_VAL( _Chs );
     // get inputs from DIM
     psMasks = &ph->psCfg->asChCfgs[ _Ch ].sMasksDIM;
     psOuts  = ph->psOutsDIM;
@@ -139,8 +164,9 @@ __STATIC_FORCEINLINE void _mix_inputs_update( phMIX_t ph ) {
  */
 __STATIC_FORCEINLINE void _mix_outputs_update( phMIX_t ph ) {
   //
-  uint16_t _NewOut = 0;
-  for ( uint8_t _Ch = 0; _Ch < ph->ChQntt; _Ch++ ) {
+  uint16_t _NewOut = ph->ChConst;
+  for ( uint32_t _Chs = ph->ChCalc; _Chs; _Chs &= _Chs - 1U ) {
+    uint8_t _Ch = POSITION_VAL( _Chs );
     if ( _mix_channel_calc( ph, _Ch ) )     //
       SET_BIT( _NewOut, 1U << _Ch );
   }
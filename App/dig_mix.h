@@ -38,7 +38,7 @@ extern "C"
   } sMIX_ChCfg_t, *psMIX_ChCfg_t;
 
   typedef struct _mix_config {
-    psMIX_ChCfg_t asChCfgs;     // array[ MIX_QNTT ]
+    sMIX_ChCfg_t asChCfgs[ MIX_QNTT ];     // Held by value, so it can be stored as an image
   } sMIX_Cfg_t, *psMIX_Cfg_t;
 
   /**
@@ -49,11 +49,14 @@ extern "C"
     uint32_t   *aChannelsInput;     // array[ MIX_QNTT ]
     psMOS_t     psOutsDIM;
     sMOS_t      sOutsMIX;
-    uint8_t     ChQntt;     // Total number of channels quantity, max 16
+    uint16_t    ChCalc;      // Channels with used inputs, compiled by MIX_SetCfg( )
+    uint16_t    ChConst;     // Outputs of the other channels, compiled by MIX_SetCfg( )
+    uint8_t     ChQntt;      // Total number of channels quantity, max 16
   } hMIX_t, *phMIX_t;
 
   void MIX_Init( void );
   void MIX_Update( phMIX_t ph );
+  void MIX_SetCfg( phMIX_t ph, psMIX_Cfg_t psCfg );
 
   extern phMIX_t phMIX;
 
@@ -33,26 +33,47 @@
  * - On deactivation signal → immediate output deactivation and both timers are reset.
  * - If activation and deactivation are assigned to the same signal type,
  *   the sequence leading to state change is executed.
+ *
+ * ## Signal routing:
+ * - ::DOM_SetCfg() compiles the signal sources of all channels into routing entries,
+ *   one per used signal word and distance between input bit and channel.
+ * - ::DOM_Update() gathers the activation and deactivation bits of all channels with
+ *   one rotate, AND and OR per entry, and only processes the channels with a signal
+ *   or a counting timer.
+ *
+ * ## Output commit:
+ * - The new states are composed into one BSRR word per port.
+ * - Without ::DOM_DMA_ENABLE the words are written by ::DOM_Update().
+ * - With ::DOM_DMA_ENABLE one DMA request of ::DOM_DMA_TIM per port copies them to
+ *   the ports at every timer update, so all outputs switch on the same tick edge.
  ***************************************************************************************/
 
 #include "dig_out.h"
 #include "dig_in.h"
 #include "dig_mix.h"
 
+#define _pin_mask( Pin ) ( ( ( Pin ) >> GPIO_PIN_MASK_POS ) & 0x0000FFFFU )     // LL pin to bit
+
 /** Static function prototypes ***********************************************/
 
-static void          _dom_all_pins_init( phDOM_t ph );
-static void          _dom_all_pins_update( phDOM_t ph );
-static void          _dom_set_pins_cfg( void );
-static void          _dom_set_cfg( void );
-__STATIC_INLINE bool _dom_tim_expired( psDOM_TimSt_t ps );
-__STATIC_INLINE void _dom_tim_start( psDOM_TimSt_t ps, puDOM_TimCfg_t puCfg );
-__STATIC_INLINE void _dom_tim_reset( psDOM_TimSt_t ps );
-__STATIC_INLINE bool _dom_tim_is_counting( psDOM_TimSt_t ps );
-__STATIC_INLINE bool _dom_tim_is_configured( puDOM_TimCfg_t pu );
-__STATIC_INLINE bool _dom_get_signal( phDOM_t ph, uint8_t Ch, eDOM_InSig_t InSigType );
-__STATIC_INLINE bool _dom_process_channel( hDOM_t *ph, uint8_t ChID,     //
-                                           bool Activate, bool Deactivate );
+static void              _dom_all_pins_init( phDOM_t ph );
+static void              _dom_all_pins_update( phDOM_t ph );
+#if DOM_DMA_ENABLE
+static void              _dom_dma_init( phDOM_t ph );
+static void              _dom_dma_store( phDOM_t ph, const uint32_t *aBSRR );
+#endif
+static void              _dom_set_pins_cfg( void );
+static void              _dom_set_cfg( void );
+__STATIC_INLINE bool     _dom_tim_expired( psDOM_TimSt_t ps );
+__STATIC_INLINE void     _dom_tim_start( psDOM_TimSt_t ps, puDOM_TimCfg_t puCfg );
+__STATIC_INLINE void     _dom_tim_reset( psDOM_TimSt_t ps );
+__STATIC_INLINE bool     _dom_tim_is_counting( psDOM_TimSt_t ps );
+__STATIC_INLINE bool     _dom_tim_is_configured( puDOM_TimCfg_t pu );
+static uint8_t           _dom_route_compile( phDOM_t ph, eDOM_InSig_t eInSigType,     //
+                                             psDOM_Route_t asRoute, uint16_t *pProt );
+__STATIC_INLINE uint16_t _dom_route_gather( psDOM_Route_t asRoute, uint8_t Qntt );
+__STATIC_INLINE bool     _dom_process_channel( hDOM_t *ph, uint8_t ChID,     //
+                                               bool Activate, bool Deactivate );
 
 /** Variables ***************************************************************/
 
@@ -77,6 +98,23 @@ static sPin_t asPins[ DO_QNTT ];
  */
 static sDOM_Cfg_t sCfg;
 
+#if DOM_DMA_ENABLE
+/** ---------------------------------------------------------------------------
+ * @brief   DMA requests of DOM_DMA_TIM, one per port.
+ *
+ * TIM4_CH1 is left out, its DMA1 channel 1 serves the ADC of the KPB. The compare
+ * channels match at 0, so all requests come with the update.
+ */
+static const struct {
+  DMA_Channel_TypeDef *psCh;     // DMA1 channel of the request
+  uint32_t             DIER;     // DMA request enable in DOM_DMA_TIM->DIER
+} asDmaReq[ DOM_PORTS_MAX ] = {
+    { DMA1_Channel7, TIM_DIER_UDE },       // TIM4_UP
+    { DMA1_Channel4, TIM_DIER_CC2DE },     // TIM4_CH2
+    { DMA1_Channel5, TIM_DIER_CC3DE },     // TIM4_CH3
+};
+#endif
+
 hDOM_t  hDOM;
 hDOM_t *phDOM = NULL;
 
@@ -104,10 +142,11 @@ void DOM_Init( void ) {
   hDOM.psOutsMIX = &phMIX->sOutsMIX;     // link to MIX outputs
   hDOM.OutStates = 0;                    // all outputs off
   hDOM.QnttOuts  = DO_QNTT;              // total number of outputs
+  hDOM.TimLive   = 0;                    // no timer counting
 
   phDOM = &hDOM;                     // make global pointer
   _dom_all_pins_init( phDOM );       // init all pins as outputs, low state
-  _dom_all_pins_update( phDOM );     // apply initial states to pins
+  DOM_SetCfg( phDOM, &sCfg );        // compile the routing, apply initial states to pins
 
   return;
 }
@@ -119,8 +158,9 @@ void DOM_Init( void ) {
  *
  * @details
  * This function must be called periodically (cyclic task or timer tick).
- * It performs the following operations for each configured output channel:
- *  - Evaluates activation and deactivation signals.
+ * It gathers the activation and deactivation signals of all channels at once,
+ * and performs the following operations for each channel with a signal or a
+ * counting timer, the others keep their state:
  *  - Starts or processes the Activation Delay Timer (TDA).
  *  - If TDA expires, sets the output active and starts the Hold Timer (THO).
  *  - If THO expires, resets the output (unless THO=0 → latch until deactivation).
@@ -134,21 +174,30 @@ void DOM_Init( void ) {
  */
 void DOM_Update( hDOM_t *ph ) {
   /**
-   *  Loop through all configured output channels
-   *    Get input signals for the channel
+   *  Gather the input signals of all channels through the routing entries
+   *  Add the protocol commands of the channels with a signal source
+   *  Loop through the channels with a signal or a counting timer
    *    Process channel logic
    *  Clear protocol control signals after processing: Activate, Deactivate
    *  Apply protocol control signals: KeepActive, KeepInactive
    *  Update outputs
    *  Apply to GPIO pins
    */
-  uint16_t _NewOuts = 0;
-
-  for ( uint8_t _Ch = 0; _Ch < ph->QnttOuts; _Ch++ ) {
-    bool _Act = _dom_get_signal( ph, _Ch, DOM_IN_SIG_ACTIVATION );
-    bool _Dea = _dom_get_signal( ph, _Ch, DOM_IN_SIG_DEACTIVATION );
-    if ( _dom_process_channel( ph, _Ch, _Act, _Dea ) )     //
-      _NewOuts |= ( 1U << _Ch );
+  uint16_t _Act = _dom_route_gather( ph->asRouteAct, ph->QnttRouteAct ) |     //
+                  ( ph->sProtCtrl.Activate & ph->ProtAct );
+  uint16_t _Dea = _dom_route_gather( ph->asRouteDea, ph->QnttRouteDea ) |     //
+                  ( ph->sProtCtrl.Deactivate & ph->ProtDea );
+  uint16_t _NewOuts = ph->OutStates;
+
+  for ( uint32_t _Chs = _Act | _Dea | ph->TimLive; _Chs; _Chs &= _Chs - 1U ) {
+    uint8_t      _Ch  = POSITION_VAL( _Chs );
+    uint16_t     _Bit = 1U << _Ch;
+    psDOM_ChSt_t _ps  = &ph->aChState[ _Ch ];
+    _dom_process_channel( ph, _Ch, _Act & _Bit, _Dea & _Bit ) ? SET_BIT( _NewOuts, _Bit ) :
+                                                                CLEAR_BIT( _NewOuts, _Bit );
+    _dom_tim_is_counting( &_ps->sTDA ) || _dom_tim_is_counting( &_ps->sTHO ) ?
+        SET_BIT( ph->TimLive, _Bit ) :
+        CLEAR_BIT( ph->TimLive, _Bit );
   }
   ph->sProtCtrl.Activate = ph->sProtCtrl.Deactivate = 0;
   SET_BIT( _NewOuts, ph->sProtCtrl.KeepActive );
@@ -160,6 +209,29 @@ void DOM_Update( hDOM_t *ph ) {
   return;
 }
 
+/** ---------------------------------------------------------------------------
+ * @brief Link another configuration structure, e.g. the one loaded from flash.
+ *
+ * @param[in,out] ph      Pointer to DOM handle (::hDOM_t).
+ * @param[in]     psCfg   Configuration, must stay valid while the module runs.
+ *
+ * @note The signal routing is compiled from the configuration once here. The pins
+ * are updated at once, so a changed ::sDOM_Cfg_t.OutsMaskXOR is applied without
+ * waiting for the next ::DOM_Update().
+ */
+void DOM_SetCfg( hDOM_t *ph, psDOM_Cfg_t psCfg ) {
+  //
+  if ( !ph || !psCfg ) return;
+  ph->psCfg        = psCfg;
+  ph->QnttRouteAct = _dom_route_compile( ph, DOM_IN_SIG_ACTIVATION,     //
+                                         ph->asRouteAct, &ph->ProtAct );
+  ph->QnttRouteDea = _dom_route_compile( ph, DOM_IN_SIG_DEACTIVATION,     //
+                                         ph->asRouteDea, &ph->ProtDea );
+  _dom_all_pins_update( ph );
+
+  return;
+}
+
 /** Static functions *********************************************************/
 
 /** ---------------------------------------------------------------------------
@@ -230,6 +302,7 @@ static void _dom_set_pins_cfg( void ) {
  * @brief   Initialize all digital output pins.
  * @param   ph  Pointer to the digital output module handler structure
  *               (of type @ref hDOM_t).
+ * @note    Groups the pins by port. Pins of more than DOM_PORTS_MAX ports are not used.
  */
 static void _dom_all_pins_init( phDOM_t ph ) {
   /**
@@ -237,6 +310,7 @@ static void _dom_all_pins_init( phDOM_t ph ) {
    * Set initial output state before switching to output mode.
    * Configure as output, push-pull, low speed.
    */
+  ph->QnttPorts = 0;
   for ( uint8_t id = 0; id < ph->QnttOuts; id++ ) {
     GPIO_TypeDef *_psPort = ph->asPinDO[ id ].psPort;
     if ( _psPort ) {
@@ -246,8 +320,23 @@ static void _dom_all_pins_init( phDOM_t ph ) {
         case ( (uint32_t) GPIOB ): LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_GPIOB ); break;
         case ( (uint32_t) GPIOC ): LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_GPIOC ); break;
         case ( (uint32_t) GPIOD ): LL_APB2_GRP1_EnableClock( LL_APB2_GRP1_PERIPH_GPIOD ); break;
-        default: continue;
+        default: ph->asPinDO[ id ].psPort = NULL; continue;
+      }
+
+      uint8_t _Port = 0;
+      while ( _Port < ph->QnttPorts && ph->apsPorts[ _Port ] != _psPort ) ++_Port;
+      if ( _Port >= DOM_PORTS_MAX ) {
+        ph->asPinDO[ id ].psPort = NULL;
+        continue;
       }
+      if ( _Port == ph->QnttPorts ) {
+        ph->apsPorts[ _Port ]  = _psPort;
+        ph->aPortPins[ _Port ] = 0;
+        ph->QnttPorts++;
+      }
+      ph->aPortId[ id ] = _Port;
+      SET_BIT( ph->aPortPins[ _Port ], _pin_mask( _Pin ) );
+
       LL_GPIO_ResetOutputPin( _psPort, _Pin );
       LL_GPIO_SetPinSpeed( _psPort, _Pin, LL_GPIO_SPEED_FREQ_LOW );
       LL_GPIO_SetPinOutputType( _psPort, _Pin, LL_GPIO_OUTPUT_PUSHPULL );
@@ -255,6 +344,10 @@ static void _dom_all_pins_init( phDOM_t ph ) {
     }
   }
 
+#if DOM_DMA_ENABLE
+  _dom_dma_init( ph );
+#endif
+
   return;
 }
 
@@ -262,59 +355,146 @@ static void _dom_all_pins_init( phDOM_t ph ) {
  * @brief   Update all digital output pins to match current states.
  * @param   ph  Pointer to the digital output module handler structure
  *               (of type @ref hDOM_t).
+ * @note    One BSRR word per port, written here or by the DMA at the next tick.
  */
 static void _dom_all_pins_update( phDOM_t ph ) {
   /**
-   * Apply XOR mask and set/reset GPIO pins accordingly
+   * Apply XOR mask and compose the set/reset word of every port
    */
   uint16_t _outs = ph->OutStates ^ ph->psCfg->OutsMaskXOR;
+  uint16_t _aSet[ DOM_PORTS_MAX ] = { 0 };
   for ( uint8_t id = 0; id < ph->QnttOuts; id++ ) {
-    GPIO_TypeDef *_psPort = ph->asPinDO[ id ].psPort;
-    if ( _psPort ) {
-      uint32_t _Pin   = ph->asPinDO[ id ].Pin;
-      bool     _State = 0 != ( _outs & ( 1U << id ) );
-      _State ? LL_GPIO_SetOutputPin( _psPort, _Pin ) :     //
-               LL_GPIO_ResetOutputPin( _psPort, _Pin );
-    }
+    psPin_t _psPin = &ph->asPinDO[ id ];
+    if ( _psPin->psPort && ( _outs & ( 1U << id ) ) )     //
+      SET_BIT( _aSet[ ph->aPortId[ id ] ], _pin_mask( _psPin->Pin ) );
+  }
+
+  uint32_t _aBSRR[ DOM_PORTS_MAX ];
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ ) {
+    uint16_t _Pins = ph->aPortPins[ id ];
+    _aBSRR[ id ]   = ( (uint32_t) ( _Pins & ~_aSet[ id ] ) << 16 ) | _aSet[ id ];
+  }
+
+#if DOM_DMA_ENABLE
+  _dom_dma_store( ph, _aBSRR );
+#else
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ ) {
+    ph->aBSRR[ id ] = _aBSRR[ id ];
+    WRITE_REG( ph->apsPorts[ id ]->BSRR, _aBSRR[ id ] );
   }
+#endif
 
   return;
 }
 
+#if DOM_DMA_ENABLE
 /** --------------------------------------------------------------------------
- * @brief   Retrieve the current state of a specified input signal.
- * @param   ph         Pointer to the DOM handler structure (hDOM_t).
- * @param   Ch         Channel index (0 to QnttOuts-1).
- * @param   InSigType  Type of input signal (activation or deactivation).
- *
- * @return  true if the specified signal is active, false otherwise.
+ * @brief   Let the DMA copy aBSRR to the ports at every update of DOM_DMA_TIM.
+ * @note    The channels run circular with one word each. Writing the same word again
+ *          does not change the pins, so no channel has to be armed per change.
  */
-__STATIC_INLINE bool _dom_get_signal( phDOM_t ph, uint8_t Ch, eDOM_InSig_t eInSigType ) {
+static void _dom_dma_init( phDOM_t ph ) {
   //
-  puDOM_SigID_t _puSig = ( DOM_IN_SIG_ACTIVATION == eInSigType ) ?     //
-                             &ph->psCfg->asChCfg[ Ch ].uAct :
-                             &ph->psCfg->asChCfg[ Ch ].uDeact;
-  psMOS_t       _psOut = ( DOM_SRC_DI == _puSig->SourceID )  ? ph->psOutsDIM :
-                         ( DOM_SRC_MIX == _puSig->SourceID ) ? ph->psOutsMIX :
-                                                               NULL;
-  uint16_t      _Sigs  = 0;
-
-  if ( _psOut )
-    _Sigs = ( DOM_SIG_GR_EDGE_RISE == _puSig->GroupID ) ? _psOut->EdgesRise :
-            ( DOM_SIG_GR_EDGE_FALL == _puSig->GroupID ) ? _psOut->EdgesFall :
-            ( DOM_SIG_GR_EDGE_ANY == _puSig->GroupID )  ? _psOut->EdgesAny :
-                                                          _psOut->States;
+  __HAL_RCC_DMA1_CLK_ENABLE( );
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ ) {
+    DMA_Channel_TypeDef *psCh = asDmaReq[ id ].psCh;
+    ph->aBSRR[ id ]           = (uint32_t) ph->aPortPins[ id ] << 16;     // As reset by init
+    CLEAR_BIT( psCh->CCR, DMA_CCR_EN );
+    WRITE_REG( psCh->CPAR, (uint32_t) &ph->apsPorts[ id ]->BSRR );
+    WRITE_REG( psCh->CMAR, (uint32_t) &ph->aBSRR[ id ] );
+    WRITE_REG( psCh->CNDTR, 1U );
+    WRITE_REG( psCh->CCR, DMA_CCR_PL_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 |     //
+                              DMA_CCR_CIRC | DMA_CCR_DIR | DMA_CCR_EN );
+  }
+
+  WRITE_REG( DOM_DMA_TIM->CCR2, 0 );     // Match with the update
+  WRITE_REG( DOM_DMA_TIM->CCR3, 0 );
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ )     //
+    SET_BIT( DOM_DMA_TIM->DIER, asDmaReq[ id ].DIER );
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Hand the composed words to the DMA, all of them before the same tick.
+ * @note    The stores take a few cycles with the interrupts disabled. Within
+ *          DOM_DMA_GUARD_CNT counts of the update, or while the DMA reads at count 0,
+ *          they wait for the next count, so no tick splits them.
+ */
+static void _dom_dma_store( phDOM_t ph, const uint32_t *aBSRR ) {
   //
-  bool _Res = 0 != ( _Sigs & ( 1U << _puSig->ChanID ) );     //
+  uint32_t _Primask = __get_PRIMASK( );
+  uint32_t _Arr     = DOM_DMA_TIM->ARR;
+  __disable_irq( );
+  while ( DOM_DMA_TIM->CNT - 1U >= _Arr - DOM_DMA_GUARD_CNT ) {}
+  for ( uint8_t id = 0; id < ph->QnttPorts; id++ ) ph->aBSRR[ id ] = aBSRR[ id ];
+  __set_PRIMASK( _Primask );
 
-  // Add protocol control signals if assigned to this channel.
-  if ( DOM_SRC_NONE != _puSig->SourceID )                             //
-    _Res |= 0U != READ_BIT( DOM_IN_SIG_ACTIVATION == eInSigType ?     //
-                                ph->sProtCtrl.Activate :
-                                ph->sProtCtrl.Deactivate,
-                            1U << Ch );
+  return;
+}
+#endif
 
-  return _Res;
+/** --------------------------------------------------------------------------
+ * @brief   Compile the signal sources of all channels into routing entries.
+ * @param   ph          Pointer to the DOM handler structure (hDOM_t).
+ * @param   eInSigType  Type of input signal (activation or deactivation).
+ * @param   asRoute     Routing entries, array[ DO_QNTT ].
+ * @param   pProt       Channels with a signal source, they take the protocol commands.
+ *
+ * Channels reading the same signal word with the same distance between ChanID and
+ * channel share one entry, so a one to one routing is one entry per signal word.
+ *
+ * @return  Number of used entries in asRoute.
+ */
+static uint8_t _dom_route_compile( phDOM_t ph, eDOM_InSig_t eInSigType,     //
+                                   psDOM_Route_t asRoute, uint16_t *pProt ) {
+  //
+  uint8_t _Qntt = 0;
+  *pProt        = 0;
+  for ( uint8_t _Ch = 0; _Ch < ph->QnttOuts; _Ch++ ) {
+    puDOM_SigID_t _puSig = ( DOM_IN_SIG_ACTIVATION == eInSigType ) ?     //
+                               &ph->psCfg->asChCfg[ _Ch ].uAct :
+                               &ph->psCfg->asChCfg[ _Ch ].uDeact;
+    if ( DOM_SRC_NONE == _puSig->SourceID ) continue;
+    SET_BIT( *pProt, 1U << _Ch );
+
+    psMOS_t _psOut = ( DOM_SRC_DI == _puSig->SourceID )  ? ph->psOutsDIM :
+                     ( DOM_SRC_MIX == _puSig->SourceID ) ? ph->psOutsMIX :
+                                                           NULL;
+    if ( !_psOut ) continue;     // Protocol only
+
+    const uint16_t *_pSig = ( DOM_SIG_GR_EDGE_RISE == _puSig->GroupID ) ? &_psOut->EdgesRise :
+                            ( DOM_SIG_GR_EDGE_FALL == _puSig->GroupID ) ? &_psOut->EdgesFall :
+                            ( DOM_SIG_GR_EDGE_ANY == _puSig->GroupID )  ? &_psOut->EdgesAny :
+                                                                          &_psOut->States;
+    uint8_t _Rot = ( _Ch - _puSig->ChanID ) & 0x0FU;
+    uint8_t _Id  = 0;
+    while ( _Id < _Qntt && ( asRoute[ _Id ].pSig != _pSig || asRoute[ _Id ].Rot != _Rot ) ) _Id++;
+    if ( _Id == _Qntt ) {
+      asRoute[ _Id ] = ( sDOM_Route_t ){ .pSig = _pSig, .Mask = 0, .Rot = _Rot };
+      _Qntt++;
+    }
+    SET_BIT( asRoute[ _Id ].Mask, 1U << _Ch );
+  }
+
+  return _Qntt;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Gather the signals of all channels through the routing entries.
+ * @param   asRoute  Routing entries compiled by _dom_route_compile().
+ * @param   Qntt     Number of used entries.
+ * @return  Signal of channel n in bit n.
+ */
+__STATIC_INLINE uint16_t _dom_route_gather( psDOM_Route_t asRoute, uint8_t Qntt ) {
+  //
+  uint16_t _Sigs = 0;
+  for ( uint8_t _Id = 0; _Id < Qntt; _Id++ ) {
+    uint32_t _Word = *asRoute[ _Id ].pSig;
+    uint8_t  _Rot  = asRoute[ _Id ].Rot;
+    _Sigs |= (uint16_t) ( ( _Word << _Rot ) | ( _Word >> ( 16U - _Rot ) ) ) & asRoute[ _Id ].Mask;
+  }
+  return _Sigs;
 }
 
 /** --------------------------------------------------------------------------
@@ -9,7 +9,18 @@ extern "C"
 #include <stdbool.h>
 #include "dig_com.h"
 
-#define DO_QNTT ( 16U )     // Number of digital outputs, max 16
+#define DO_QNTT       ( 16U )     // Number of digital outputs, max 16
+#define DOM_PORTS_MAX ( 3U )      // Ports with outputs, one DMA request per port
+
+/** Output commit by DMA. DOM_Update( ) only composes one BSRR word per port, and DMA copies
+ * them to the ports at every update of DOM_DMA_TIM. All outputs then switch at the same
+ * timer tick, whatever the main loop is doing. 0 writes the ports in DOM_Update( ).
+ */
+#ifndef DOM_DMA_ENABLE
+#define DOM_DMA_ENABLE 0
+#endif
+#define DOM_DMA_TIM       TIM4     // HAL time base, 1 MHz counter, update every 1 ms
+#define DOM_DMA_GUARD_CNT 4U       // Counts before the update without a change of the words
 
 /**
  * @defgroup Timer restart behavior
@@ -91,6 +102,18 @@ extern "C"
     sDOM_TimSt_t sTHO;     ///< THO countdown
   } sDOM_ChSt_t, *psDOM_ChSt_t;
 
+  /**
+   * @brief Routing entry of the channel signals, compiled by ::DOM_SetCfg()
+   *
+   * The signal word rotated left by Rot and masked with Mask gives the signals of all
+   * channels that use this word with the same distance between ChanID and channel.
+   */
+  typedef struct _dom_route {
+    const uint16_t *pSig;     // Signal word of a source module, a field of sMOS_t
+    uint16_t        Mask;     // Channels fed by this entry
+    uint8_t         Rot;      // Left rotation from ChanID to the channel
+  } sDOM_Route_t, *psDOM_Route_t;
+
   /**
    * @brief Protocol control signals for Digital Output Module
    */
@@ -116,20 +139,35 @@ extern "C"
    * - `psOutsMIX` → pointer to Mixer Module signals.
    * - `OutStates` → current output states (bitfield, one bit per channel).
    * - `QnttOuts`  → total number of configured outputs (max 16).
+   * - `aBSRR[]`   → composed BSRR word per port, read by the DMA with ::DOM_DMA_ENABLE.
+   * - `asRoute..` → signal routing compiled from the configuration by ::DOM_SetCfg().
    */
   typedef struct {
-    psDOM_Cfg_t     psCfg;                   ///< Pointer to configuration structure
-    sDOM_ChSt_t     aChState[ DO_QNTT ];     ///< Array of per-channel state
-    psPin_t         asPinDO;                 ///< Array of output pin configurations
-    psMOS_t         psOutsDIM;               ///< Digital Input Module outputs
-    psMOS_t         psOutsMIX;               ///< Mixer Module outputs
-    sDOM_ProtCtrl_t sProtCtrl;               ///< Protocol control signals
-    uint16_t        OutStates;               ///< Current output states (bitfield)
-    uint8_t         QnttOuts;                ///< Total number of digital outputs (max 16)
+    psDOM_Cfg_t       psCfg;                          ///< Pointer to configuration structure
+    sDOM_ChSt_t       aChState[ DO_QNTT ];            ///< Array of per-channel state
+    psPin_t           asPinDO;                        ///< Array of output pin configurations
+    psMOS_t           psOutsDIM;                      ///< Digital Input Module outputs
+    psMOS_t           psOutsMIX;                      ///< Mixer Module outputs
+    sDOM_ProtCtrl_t   sProtCtrl;                      ///< Protocol control signals
+    uint16_t          OutStates;                      ///< Current output states (bitfield)
+    uint8_t           QnttOuts;                       ///< Total number of digital outputs (max 16)
+    uint8_t           QnttPorts;                      ///< Used entries of apsPorts
+    uint8_t           aPortId[ DO_QNTT ];             ///< Index in apsPorts for every output
+    uint16_t          aPortPins[ DOM_PORTS_MAX ];     ///< Output pins of every port
+    GPIO_TypeDef     *apsPorts[ DOM_PORTS_MAX ];      ///< Ports with outputs
+    volatile uint32_t aBSRR[ DOM_PORTS_MAX ];         ///< Last composed words, see DOM_DMA_ENABLE
+    sDOM_Route_t      asRouteAct[ DO_QNTT ];          ///< Activation routing
+    sDOM_Route_t      asRouteDea[ DO_QNTT ];          ///< Deactivation routing
+    uint8_t           QnttRouteAct;                   ///< Used entries of asRouteAct
+    uint8_t           QnttRouteDea;                   ///< Used entries of asRouteDea
+    uint16_t          ProtAct;                        ///< Channels taking sProtCtrl.Activate
+    uint16_t          ProtDea;                        ///< Channels taking sProtCtrl.Deactivate
+    uint16_t          TimLive;                        ///< Channels with a counting timer
   } hDOM_t, *phDOM_t;
 
   void DOM_Init( void );
   void DOM_Update( hDOM_t *ph );
+  void DOM_SetCfg( hDOM_t *ph, psDOM_Cfg_t psCfg );
 
   extern hDOM_t *phDOM;
 
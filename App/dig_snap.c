@@ -0,0 +1,50 @@
+/***************************************************************************
+ * @file  dig_snap.c
+ * @note  Coherent snapshot of the digital module states for the Modbus readers.
+ * ************************************************************************* */
+
+#include "dig_snap.h"
+#include "dig_in.h"
+#include "dig_mix.h"
+#include "dig_out.h"
+
+static hSNAP_t hSNAP;
+phSNAP_t       phSNAP = &hSNAP;
+
+/** --------------------------------------------------------------------------
+ * @brief   Publish the states of this tick.
+ * @note    Call from DIDO_Serve( ) after DOM_Update( ), the only writer.
+ */
+void SNAP_Publish( phSNAP_t ph ) {
+  //
+  sSNAP_t _s = { .sOutsDIM  = phDIM->sOutsDIM,     //
+                 .sOutsMIX  = phMIX->sOutsMIX,     //
+                 .OutStates = phDOM->OutStates };
+
+  ph->Seq++;     // Odd, the readers take asCopy[ 1 ]
+  __DMB( );
+  ph->asCopy[ 0 ] = _s;
+  __DMB( );
+  ph->Seq++;     // Even, the readers take asCopy[ 0 ]
+  __DMB( );
+  ph->asCopy[ 1 ] = _s;
+
+  return;
+}
+
+/**
+ * @brief   Copy the newest complete states.
+ * @note    Retries only if SNAP_Publish( ) ran in between, so at most once per preemption.
+ */
+void SNAP_Read( phSNAP_t ph, psSNAP_t ps ) {
+  //
+  uint32_t _Seq;
+  do {
+    _Seq = ph->Seq;
+    __DMB( );
+    *ps = ph->asCopy[ _Seq & 1U ];
+    __DMB( );
+  } while ( ph->Seq != _Seq );
+
+  return;
+}
@@ -0,0 +1,41 @@
+#ifndef __DIG_SNAP_H__
+#define __DIG_SNAP_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include "main.h"
+#include "dig_com.h"
+
+/** @defgroup SNAP_Config_define Snapshot of the module states
+ * @note  SNAP_Publish( ) copies the states once per tick, after DOM_Update( ). It writes two
+ *        copies in turn and bumps Seq in front of each, so one copy is always complete. A
+ *        reader takes the copy selected by Seq and retries if Seq moved meanwhile. It never
+ *        blocks the writer, and never spins on a writer it preempted, e.g. the Modbus task
+ *        of an RTOS build over the I/O task.
+ */
+
+  /**
+   * @brief States of one tick
+   */
+  typedef struct _snap_states {
+    sMOS_t   sOutsDIM;      // phDIM->sOutsDIM
+    sMOS_t   sOutsMIX;      // phMIX->sOutsMIX
+    uint16_t OutStates;     // phDOM->OutStates
+  } sSNAP_t, *psSNAP_t;     // 18 bytes
+
+  typedef struct _snap_module_handler {
+    volatile uint32_t Seq;             // Odd while asCopy[ 0 ] is written, even for [ 1 ]
+    sSNAP_t           asCopy[ 2 ];     //
+  } hSNAP_t, *phSNAP_t;
+
+  extern phSNAP_t phSNAP;
+
+  void SNAP_Publish( phSNAP_t ph );
+  void SNAP_Read( phSNAP_t ph, psSNAP_t ps );
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __DIG_SNAP_H__
@@ -0,0 +1,380 @@
+/***************************************************************************
+ * @file  dig_soe.c
+ * @note  Sequence of events recorder of the digital inputs.
+ * ************************************************************************* */
+
+#include "dig_soe.h"
+#include "dig_cnt.h"
+#include "app_prof.h"
+#include "rtc.h"
+
+#define _pin_mask( Pin ) ( ( ( Pin ) >> GPIO_PIN_MASK_POS ) & 0xFFFFU )     // LL pin to bit mask
+
+#define SOE_RTC_TIMEOUT_MS 10U     // RTC write operation, a few RTC clocks
+
+static void _exti_start( phSOE_t ph, uint8_t id, uint32_t Line );
+static void _raw_drain( phSOE_t ph, uint32_t Head );
+static void _log_add( phSOE_t ph, uint32_t Idx, uint32_t Cyc, uint8_t id, uint8_t Flags );
+static void _stable_mark( phSOE_t ph, uint16_t Edges );
+static void _anchor( phSOE_t ph );
+static bool _rtc_wait( void );
+
+static sSOE_Cfg_t sCfg;
+
+hSOE_t  hSOE;
+phSOE_t phSOE = &hSOE;
+
+/** --------------------------------------------------------------------------
+ * @brief   Start the RTC and set the default configuration, nothing is recorded.
+ * @note    Call after CNT_Init( ), the counted inputs are not recorded.
+ */
+void SOE_Init( void ) {
+  //
+  sCfg.Inputs   = 0;
+  sCfg.FirstOut = 0;
+  hSOE.FirstOut = SOE_NONE;
+
+  MX_RTC_Init( );     // The clock source is selected by SystemClock_Config( )
+  hSOE.RtcHz = HAL_RCCEx_GetPeriphCLKFreq( RCC_PERIPHCLK_RTC );
+
+  SET_BIT( CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk );     // Cycle counter time stamps
+  SET_BIT( DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk );
+  SOE_SetCfg( phSOE, &sCfg );
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Link the configuration and set up the EXTI lines of its inputs.
+ * @note    Call after CNT_SetCfg( ). Counted inputs and inputs whose EXTI line is taken
+ *          are not recorded. The log and the first-out are kept.
+ */
+void SOE_SetCfg( phSOE_t ph, psSOE_Cfg_t psCfg ) {
+  //
+  if ( !ph || !psCfg ) return;
+
+  uint16_t _Free = ph->ExtiLines & ~phCNT->ExtiLines;     // Not taken over by the counters
+  CLEAR_BIT( EXTI->IMR, _Free );                           // Edges meanwhile stay pending
+
+  uint16_t _Prev = ph->Active;
+  ph->psCfg      = psCfg;
+  ph->ExtiLines  = 0;
+  ph->Active     = 0;
+  for ( uint8_t id = 0; id < DI_QNTT; id++ ) {
+    psPin_t psPin = &phDIM->asPin[ id ];
+    if ( !READ_BIT( psCfg->Inputs & ~phCNT->Active, 1U << id ) || !psPin->psPort ) continue;
+
+    uint32_t Line = POSITION_VAL( _pin_mask( psPin->Pin ) );
+    if ( READ_BIT( ph->ExtiLines | phCNT->ExtiLines | CNT_EXTI_LINES_USED, 1U << Line ) )
+      continue;
+    _exti_start( ph, id, Line );
+    SET_BIT( ph->Active, 1U << id );
+  }
+
+  uint16_t _Gone = _Free & ~ph->ExtiLines;
+  CLEAR_BIT( EXTI->RTSR, _Gone );
+  CLEAR_BIT( EXTI->FTSR, _Gone );
+  WRITE_REG( EXTI->PR, _Free ^ ph->ExtiLines );     // Keep the edges of the lines that stay
+  SET_BIT( EXTI->IMR, ph->ExtiLines );
+  DIM_SetInputOnly( phDIM, ( phDIM->InputOnly & ~_Prev ) | ph->Active );     // No LED edges
+
+  if ( READ_BIT( ph->ExtiLines, 0x0010U ) ) {     // The vectors are shared with the counters
+    HAL_NVIC_SetPriority( EXTI4_IRQn, CNT_IRQ_PRIORITY, 0 );
+    HAL_NVIC_EnableIRQ( EXTI4_IRQn );
+  }
+  if ( READ_BIT( ph->ExtiLines, 0x03E0U ) ) {
+    HAL_NVIC_SetPriority( EXTI9_5_IRQn, CNT_IRQ_PRIORITY, 0 );
+    HAL_NVIC_EnableIRQ( EXTI9_5_IRQn );
+  }
+  if ( READ_BIT( ph->ExtiLines, 0xFC00U ) ) {     // Shared with gpio.c, which sets priority 0
+    HAL_NVIC_SetPriority( EXTI15_10_IRQn, CNT_IRQ_PRIORITY, 0 );
+    HAL_NVIC_EnableIRQ( EXTI15_10_IRQn );
+  }
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Move the captured edges to the log and mark the ones the debounce followed.
+ * @note    Call every tick right after DIM_Update( ). With quiet inputs it returns after
+ *          two compares.
+ */
+void SOE_Serve( phSOE_t ph ) {
+  //
+  if ( !ph ) return;
+
+  uint32_t Head = ph->RawHead;
+  if ( Head != ph->RawTail ) _raw_drain( ph, Head );
+
+  uint16_t Edges = phDIM->sOutsDIM.EdgesAny & ph->Active;
+  if ( Edges ) _stable_mark( ph, Edges );
+
+  return;
+}
+
+/**
+ * @brief   Remove the oldest records from the log, e.g. after they were read.
+ */
+void SOE_Ack( phSOE_t ph, uint16_t Records ) {
+  //
+  if ( !ph ) return;
+
+  uint32_t Cnt = ph->LogHead - ph->LogTail;
+  ph->LogTail += Records < Cnt ? Records : Cnt;
+  return;
+}
+
+/**
+ * @brief   Arm the first-out detection again.
+ */
+void SOE_Rearm( phSOE_t ph ) {
+  //
+  if ( !ph ) return;
+
+  ph->FirstOut = SOE_NONE;
+  return;
+}
+
+/**
+ * @brief   Set the RTC counter, the wall time of the records.
+ * @return  false if the RTC did not accept the write.
+ */
+bool SOE_SetTime( phSOE_t ph, uint32_t Sec ) {
+  //
+  if ( !ph || !_rtc_wait( ) ) return false;
+
+  SET_BIT( RTC->CRL, RTC_CRL_CNF );
+  WRITE_REG( RTC->CNTH, Sec >> 16 );
+  WRITE_REG( RTC->CNTL, Sec & 0xFFFFU );
+  CLEAR_BIT( RTC->CRL, RTC_CRL_CNF );
+  ph->isAnchored = 0;
+
+  return _rtc_wait( );
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Read an exported register.
+ * @param   offset  @defgroup SOE_Registers_define
+ * @return  false if there is no register at the offset.
+ * @note    The log is changed by SOE_Serve( ) in the main loop only, so the records of one
+ *          Modbus request are consistent.
+ */
+bool SOE_ReadReg( phSOE_t ph, uint16_t offset, uint16_t *pVal ) {
+  //
+  if ( !ph || !pVal || offset >= SOE_REG_NUM ) return false;
+
+  uint32_t Cnt = ph->LogHead - ph->LogTail;
+  *pVal        = 0;
+  switch ( offset ) {
+    case SOE_REG_COUNT: *pVal = (uint16_t) Cnt; break;
+    case SOE_REG_SEQ:
+      *pVal = Cnt ? ph->asLog[ ph->LogTail & ( SOE_LOG_SIZE - 1U ) ].Seq : (uint16_t) ph->RawTail;
+      break;
+    case SOE_REG_LOST: *pVal = ph->Lost; break;
+    case SOE_REG_FIRST_OUT: *pVal = ph->FirstOut; break;
+    default: {     // Reserved or a record
+      if ( offset < SOE_REG_REC ) break;
+      uint16_t k = ( offset - SOE_REG_REC ) / SOE_REC_REGS;
+      if ( k >= Cnt ) break;
+      psSOE_Rec_t ps = &ph->asLog[ ( ph->LogTail + k ) & ( SOE_LOG_SIZE - 1U ) ];
+      switch ( ( offset - SOE_REG_REC ) % SOE_REC_REGS ) {     // clang-format off
+        case 0:  *pVal = (uint16_t) ps->Sec;                          break;
+        case 1:  *pVal = (uint16_t) ( ps->Sec >> 16 );                break;
+        case 2:  *pVal = (uint16_t) ps->Us;                           break;
+        case 3:  *pVal = (uint16_t) ( ps->Us >> 16 );                 break;
+        case 4:  *pVal = ps->Input | ( (uint16_t) ps->Flags << 8 );   break;
+        default: *pVal = ps->Seq;                                     break;
+      }     // clang-format on
+      break;
+    }
+  }
+
+  return true;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Capture the pending EXTI lines of the recorded inputs.
+ * @note    Call from the EXTI interrupt handlers, before CNT_EXTI_IRQHandler( ). The
+ *          handlers run at two priorities, so a slot is reserved with LDREX/STREX and
+ *          published by its Tag.
+ */
+void SOE_EXTI_IRQHandler( void ) {
+  //
+  uint32_t _Cyc  = Prof_Start( );     // First, it is the time of the edge
+  uint32_t _Pend = READ_REG( EXTI->PR ) & hSOE.ExtiLines;
+  if ( !_Pend ) return;
+  WRITE_REG( EXTI->PR, _Pend );
+
+  for ( ; _Pend; _Pend &= _Pend - 1U ) {
+    uint8_t  id    = hSOE.aLineIn[ POSITION_VAL( _Pend ) ];
+    psPin_t  psPin = &phDIM->asPin[ id ];
+    uint32_t Idx;
+    do {
+      Idx = __LDREXW( &hSOE.RawHead );
+    } while ( __STREXW( Idx + 1U, &hSOE.RawHead ) );
+
+    psSOE_Raw_t ps = &hSOE.asRaw[ Idx & ( SOE_RAW_SIZE - 1U ) ];
+    ps->Tag        = 0;     // Invalid while it is written, see _raw_drain( )
+    __DMB( );
+    ps->Cyc   = _Cyc;
+    ps->Input = id;
+    ps->Level = READ_BIT( psPin->psPort->IDR, _pin_mask( psPin->Pin ) ) != 0;
+    __DMB( );
+    ps->Tag = Idx + 1U;
+  }
+  return;
+}
+
+/**
+ * @brief   Route the pin to its EXTI line and select both edges, SOE_SetCfg( ) unmasks it.
+ */
+static void _exti_start( phSOE_t ph, uint8_t id, uint32_t Line ) {
+  //
+  GPIO_TypeDef *psPort = phDIM->asPin[ id ].psPort;
+  uint32_t      _Src   = ( (uint32_t) psPort - GPIOA_BASE ) / ( GPIOB_BASE - GPIOA_BASE );
+  uint32_t      _Shift = 4U * ( Line & 3U );
+
+  __HAL_RCC_AFIO_CLK_ENABLE( );
+  MODIFY_REG( AFIO->EXTICR[ Line >> 2 ], 0xFU << _Shift, _Src << _Shift );
+  SET_BIT( EXTI->RTSR, 1U << Line );
+  SET_BIT( EXTI->FTSR, 1U << Line );
+
+  ph->aLineIn[ Line ] = id;
+  SET_BIT( ph->ExtiLines, 1U << Line );
+
+  return;
+}
+
+/**
+ * @brief   Move the raw slots up to Head to the log.
+ * @note    A slot is taken when its Tag is the expected one before and after the copy.
+ *          A newer Tag means the handlers lapped the ring, a missing one that the slot is
+ *          still being written, it is taken by the next call.
+ */
+static void _raw_drain( phSOE_t ph, uint32_t Head ) {
+  //
+  if ( !ph->isAnchored || HAL_GetTick( ) - ph->AnchorTick >= SOE_RESYNC_MS ) _anchor( ph );
+
+  uint8_t  _Lost = 0;
+  uint32_t _Skip = Head - ph->RawTail;
+  if ( _Skip > SOE_RAW_SIZE ) {     // Overrun, the oldest slots are overwritten
+    _Skip -= SOE_RAW_SIZE;
+    ph->Lost = ph->Lost + _Skip < UINT16_MAX ? ph->Lost + _Skip : UINT16_MAX;
+    ph->RawTail += _Skip;
+    _Lost = SOE_FLAG_LOST;
+  }
+
+  for ( ; ph->RawTail != Head; ph->RawTail++ ) {
+    psSOE_Raw_t ps   = &ph->asRaw[ ph->RawTail & ( SOE_RAW_SIZE - 1U ) ];
+    uint32_t    _Tag = ps->Tag;
+    __DMB( );
+    uint32_t _Cyc   = ps->Cyc;
+    uint8_t  id     = ps->Input;
+    uint8_t  _Level = ps->Level;
+    __DMB( );
+    if ( _Tag == ph->RawTail + 1U && ps->Tag == _Tag ) {
+      _log_add( ph, ph->RawTail, _Cyc, id, _Lost | ( _Level ? SOE_FLAG_RISE : 0 ) );
+      _Lost = 0;
+    }
+    else if ( (int32_t) ( ps->Tag - ph->RawTail - 1U ) > 0 ) {     // Lapped
+      if ( ph->Lost < UINT16_MAX ) ph->Lost++;
+      _Lost = SOE_FLAG_LOST;
+    }
+    else
+      break;
+  }
+
+  return;
+}
+
+/**
+ * @brief   Add a record with the wall time of the cycle counter stamp.
+ * @note    Overwrites the oldest record when the log is full.
+ */
+static void _log_add( phSOE_t ph, uint32_t Idx, uint32_t Cyc, uint8_t id, uint8_t Flags ) {
+  //
+  if ( ph->LogHead - ph->LogTail >= SOE_LOG_SIZE ) ph->LogTail++;
+
+  int32_t _Us  = (int32_t) ph->AnchorUs +     // The anchor is younger than SOE_RESYNC_MS
+                (int32_t) ( Cyc - ph->AnchorCyc ) / (int32_t) ( SystemCoreClock / 1000000U );
+  int32_t _Sec = _Us / 1000000;
+  _Us -= _Sec * 1000000;
+  if ( _Us < 0 ) {
+    _Us += 1000000;
+    _Sec--;
+  }
+
+  if ( READ_BIT( Flags, SOE_FLAG_RISE ) && ph->FirstOut == SOE_NONE &&
+       READ_BIT( ph->psCfg->FirstOut, 1U << id ) ) {
+    ph->FirstOut = id;
+    SET_BIT( Flags, SOE_FLAG_FIRST_OUT );
+  }
+
+  psSOE_Rec_t ps = &ph->asLog[ ph->LogHead & ( SOE_LOG_SIZE - 1U ) ];
+  ps->Sec        = ph->AnchorSec + _Sec;
+  ps->Us         = (uint32_t) _Us;
+  ps->Seq        = (uint16_t) Idx;
+  ps->Input      = id;
+  ps->Flags      = Flags;
+  ph->aLast[ id ] = ++ph->LogHead;
+
+  return;
+}
+
+/**
+ * @brief   Mark the last record of every input whose debounced state changed, if its
+ *          level is the new state.
+ */
+static void _stable_mark( phSOE_t ph, uint16_t Edges ) {
+  //
+  for ( ; Edges; Edges &= Edges - 1U ) {
+    uint8_t  id    = POSITION_VAL( Edges );
+    uint32_t _Last = ph->aLast[ id ];
+    if ( !_Last || ph->LogHead - _Last >= ph->LogHead - ph->LogTail ) continue;     // Gone
+
+    psSOE_Rec_t ps     = &ph->asLog[ ( _Last - 1U ) & ( SOE_LOG_SIZE - 1U ) ];
+    bool        _State = READ_BIT( phDIM->sOutsDIM.States, 1U << id ) != 0;
+    if ( _State == ( READ_BIT( ps->Flags, SOE_FLAG_RISE ) != 0 ) )
+      SET_BIT( ps->Flags, SOE_FLAG_STABLE );
+  }
+  return;
+}
+
+/**
+ * @brief   Take the RTC time and the cycle counter at the same moment.
+ * @note    The RTC and the core run from the same HSE, so the anchor stays valid until the
+ *          cycle counter gets close to its wrap. The prescaler divider gives the fraction
+ *          of the second with the resolution of the RTC clock.
+ */
+static void _anchor( phSOE_t ph ) {
+  //
+  uint32_t _Sec, _Div, _Cyc;
+  uint32_t _Primask = __get_PRIMASK( );
+  __disable_irq( );     // A handler between the reads would shift the anchor
+  do {
+    _Sec = ( READ_REG( RTC->CNTH ) << 16 ) | READ_REG( RTC->CNTL );
+    _Div = ( ( READ_REG( RTC->DIVH ) & RTC_DIVH_RTC_DIV ) << 16 ) | READ_REG( RTC->DIVL );
+    _Cyc = Prof_Start( );
+  } while ( _Sec != ( ( READ_REG( RTC->CNTH ) << 16 ) | READ_REG( RTC->CNTL ) ) );
+  __set_PRIMASK( _Primask );
+
+  ph->AnchorSec  = _Sec;
+  ph->AnchorUs   = (uint32_t) ( (uint64_t) ( ph->RtcHz - 1U - _Div ) * 1000000U / ph->RtcHz );
+  ph->AnchorCyc  = _Cyc;
+  ph->AnchorTick = HAL_GetTick( );
+  ph->isAnchored = 1;
+
+  return;
+}
+
+/**
+ * @brief   Wait for the end of the last RTC write operation.
+ */
+static bool _rtc_wait( void ) {
+  //
+  uint32_t Start = HAL_GetTick( );
+  while ( !READ_BIT( RTC->CRL, RTC_CRL_RTOFF ) ) {
+    if ( HAL_GetTick( ) - Start > SOE_RTC_TIMEOUT_MS ) return false;
+  }
+  return true;
+}
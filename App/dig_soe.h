@@ -0,0 +1,105 @@
+#ifndef __DIG_SOE_H__
+#define __DIG_SOE_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include "main.h"
+#include <stdbool.h>
+#include "dig_com.h"
+#include "dig_in.h"
+
+/** @defgroup SOE_Config_define Sequence of events recorder
+ * @note  Both edges of a recorded input raise its EXTI line. The handler only stores the
+ *        input, its level and the cycle counter in the raw ring, SOE_Serve( ) adds the RTC
+ *        wall time and moves them to the log. Quiet inputs cost no interrupt and one
+ *        compare per SOE_Serve( ). Recorded inputs stay inputs like the counted ones,
+ *        counted inputs are not recorded.
+ */
+#ifndef SOE_RAW_SIZE
+#define SOE_RAW_SIZE 32U     // Edges between two SOE_Serve( ), power of 2
+#endif
+#ifndef SOE_LOG_SIZE
+#define SOE_LOG_SIZE 128U     // Records until the oldest is overwritten, power of 2
+#endif
+#define SOE_RESYNC_MS 10000U     // Age of the RTC anchor of the cycle counter, below its wrap
+#define SOE_NONE      0xFFU      // No input, e.g. no first-out yet
+
+/** @defgroup SOE_Flags_define Flags of a record
+ */
+#define SOE_FLAG_RISE      0x01U     // Level after the edge is high
+#define SOE_FLAG_STABLE    0x02U     // The debounced state of DIM_Update( ) followed this edge
+#define SOE_FLAG_FIRST_OUT 0x04U     // First edge to high of the sSOE_Cfg_t::FirstOut inputs
+#define SOE_FLAG_LOST      0x08U     // Edges were lost in front of this one
+
+/** @defgroup SOE_Registers_define Offsets of the exported registers
+ * @note  The records start with the oldest one in the log. SOE_Ack( ) removes the read ones,
+ *        so the next read starts behind them. Registers behind the last record read 0.
+ */
+#define SOE_REG_COUNT     0U      // Records in the log
+#define SOE_REG_SEQ       1U      // Sequence number of the oldest record
+#define SOE_REG_LOST      2U      // Edges lost by raw ring overruns, saturated
+#define SOE_REG_FIRST_OUT 3U      // Input of the first-out, SOE_NONE until a trip
+#define SOE_REG_REC       8U      // Oldest record, SOE_REC_REGS registers per record
+#define SOE_REC_REGS      6U      // Sec lo/hi, Us lo/hi, Input | Flags << 8, Seq
+#define SOE_REC_READ_MAX  20U     // Records in the register window, 120 registers
+#define SOE_REG_NUM       ( SOE_REG_REC + SOE_REC_READ_MAX * SOE_REC_REGS )
+
+  typedef struct _soe_config {     // Configuration structure for SOE
+    uint16_t Inputs;               // Recorded inputs, bit n for input n
+    uint16_t FirstOut;             // Recorded inputs taking part in the first-out detection
+  } sSOE_Cfg_t, *psSOE_Cfg_t;      // 4 bytes
+
+  typedef struct _soe_record {
+    uint32_t Sec;       // RTC counter [s]
+    uint32_t Us;        // [us] within Sec
+    uint16_t Seq;       // Order of the edges, gaps show lost edges
+    uint8_t  Input;     //
+    uint8_t  Flags;     // @defgroup SOE_Flags_define
+  } sSOE_Rec_t, *psSOE_Rec_t;     // 12 bytes
+
+  typedef struct _soe_raw {       // Written by the EXTI handler
+    uint32_t          Cyc;        // Cycle time stamp at the handler entry, Prof_Start( )
+    volatile uint32_t Tag;        // Ring index + 1, written last
+    uint8_t           Input;      //
+    uint8_t           Level;      // Pin level read by the handler
+  } sSOE_Raw_t, *psSOE_Raw_t;
+
+  typedef struct _soe_module_handler {
+    psSOE_Cfg_t       psCfg;                     // Pointer to configuration structure
+    sSOE_Raw_t        asRaw[ SOE_RAW_SIZE ];     // Lock-free, filled by the EXTI handlers
+    volatile uint32_t RawHead;                   // Reserved by the handlers with LDREX/STREX
+    uint32_t          RawTail;                   // Next raw slot of SOE_Serve( )
+    sSOE_Rec_t        asLog[ SOE_LOG_SIZE ];     //
+    uint32_t          LogHead;                   // Records ever written
+    uint32_t          LogTail;                   // Oldest record not acknowledged
+    uint32_t          aLast[ DI_QNTT ];          // LogHead behind the last record per input
+    uint32_t          AnchorSec;                 // RTC time at AnchorCyc
+    uint32_t          AnchorUs;                  //
+    uint32_t          AnchorCyc;                 //
+    uint32_t          AnchorTick;                // HAL tick of the anchor
+    uint32_t          RtcHz;                     // RTC clock, the prescaler is write only
+    uint16_t          Lost;                      //
+    uint16_t          ExtiLines;                 // EXTI lines in use, bit n for line n
+    uint16_t          Active;                    // Recorded inputs, bit n for input n
+    uint8_t           aLineIn[ 16 ];             // Input of every EXTI line
+    uint8_t           FirstOut;                  // SOE_NONE while armed
+    uint8_t           isAnchored;                //
+  } hSOE_t, *phSOE_t;
+
+  extern phSOE_t phSOE;
+
+  void SOE_Init( void );
+  void SOE_SetCfg( phSOE_t ph, psSOE_Cfg_t psCfg );
+  void SOE_Serve( phSOE_t ph );
+  void SOE_Ack( phSOE_t ph, uint16_t Records );
+  void SOE_Rearm( phSOE_t ph );
+  bool SOE_SetTime( phSOE_t ph, uint32_t Sec );
+  bool SOE_ReadReg( phSOE_t ph, uint16_t offset, uint16_t *pVal );
+  void SOE_EXTI_IRQHandler( void );
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __DIG_SOE_H__
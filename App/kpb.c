@@ -4,7 +4,7 @@
  * ************************************************************************* */
 
 #include "kpb.h"
-#include <math.h>       // for round
+#include "app_idle.h"
 #include <string.h>     //
 // #include "EventRecorder.h"
 
@@ -12,42 +12,74 @@ hKPB_t  hKPB;
 phKPB_t phKPB = NULL;
 
 extern ADC_HandleTypeDef hadc1;
-
-static void   _ADC_Init( phKPB_t phkpb );
-static void   _ADC_MspInit( ADC_HandleTypeDef *ph );
-static void   _ADC_ConvCpltCallback( ADC_HandleTypeDef *ph );
-static float  _DecodeResistorCode( uint16_t code );
-static int8_t _CalcDividerLimits( psLimits_t psResult,                    //
-                                  uint16_t R1_code, uint16_t R2_code,     //
-                                  float Tolerance, uint8_t Resolution );
-static void   _KeyRecognition( phKPB_t ph );
-static void   _KeyProcess( phKPB_t ph );
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+static DMA_HandleTypeDef hdma_adc1;
+#endif
+
+static void     _ADC_Init( phKPB_t phkpb );
+static void     _ADC_MspInit( ADC_HandleTypeDef *ph );
+static void     _ADC_ConvCpltCallback( ADC_HandleTypeDef *ph );
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+static void     _ADC_LevelOutOfWindowCallback( ADC_HandleTypeDef *ph );
+static void     _ADC_WatchdogArm( phKPB_t ph );
+static bool     _KeysReleased( phKPB_t ph );
+#endif
+static uint32_t _DecodeResistorCode( uint16_t code );
+static int8_t   _CalcDividerLimits( psLimits_t psResult,                  //
+                                    uint32_t R1_nom, uint32_t R2_nom,     //
+                                    uint8_t Tolerance, uint8_t Resolution );
+static void     _BuildLUT( phKPB_t ph );
+static void     _KeyRecognition( phKPB_t ph );
+static void     _KeyProcess( phKPB_t ph );
+
+#define KPB_X_LADDER( name, channel, port, pin, pullup ) { channel, pullup },
+#define KPB_X_KEY( name, ladder, code )                  { ladder, code },
+#define KPB_X_CHORD( name, keyA, keyB )                  { keyA, keyB },
+#define KPB_X_GPIO( name, channel, port, pin, pullup )                                         \
+  HAL_GPIO_Init( port, &( GPIO_InitTypeDef ){ .Pin = pin, .Mode = GPIO_MODE_ANALOG } );
+
+static const struct {
+  uint32_t Channel;
+  uint16_t PullUp;     // Resistor code
+} asLadderCfg[] = { KPB_LADDERS( KPB_X_LADDER ) };
+
+static const struct {
+  uint8_t  Ladder;
+  uint16_t Code;     // Resistor code
+} asKeyCfg[] = { KPB_KEYS( KPB_X_KEY ) };
+
+#if KPB_CHORDS_CNT
+static const struct {
+  uint8_t KeyA, KeyB;
+} asChordCfg[] = { KPB_CHORDS( KPB_X_CHORD ) };
+#endif
 
 /** --------------------------------------------------------------------------
  * @brief   Initializing resources for the key-press board
  */
 void MX_KPB_Init( void ) {
   //
-  uint16_t aResCodes[] = { KPB_R_DOWN, KPB_R_RIGHT, KPB_R_UP,     //
-                           KPB_R_LEFT, KPB_R_ENTER };
-
   _ADC_Init( &hKPB );
 
-  hKPB.Flags         = 0;
-  hKPB.RawData       = KPB_ADC_FULL;
-  hKPB.KeyRecognized = KPB_KEY_NONE;
-
-  for ( size_t i = 0; i < KPB_KEYS_NUM; i++ ) {
-    //
-    psKPB_Key psKey = &hKPB.asKeys[ i ];
-    memset( psKey, 0, sizeof( sKPB_Key ) );
-    if ( -1 == _CalcDividerLimits( &psKey->sLim, KPB_R_PULLUP, aResCodes[ i ],     //
-                                   KPB_R_TOLERANCE, KPB_ADC_RESOLUTION ) )
-      Error_Handler( );
-  }
+  hKPB.Flags          = 0;
+  hKPB.KeysRecognized = 0;
+  hKPB.isReleased     = true;
+  for ( size_t i = 0; i < KPB_LADDERS_NUM; i++ ) hKPB.aRawData[ i ] = KPB_ADC_FULL;
+  memset( hKPB.asKeys, 0, sizeof( hKPB.asKeys ) );
+  _BuildLUT( &hKPB );
 
   phKPB = &hKPB;
 
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+  size_t len = KPB_ADC_DMA_LEN * KPB_LADDERS_NUM;
+  for ( size_t i = 0; i < len; i++ ) hKPB.aSamples[ i ] = KPB_ADC_FULL;
+  if ( HAL_OK != HAL_ADC_Start_DMA( hKPB.phADC, (uint32_t *) hKPB.aSamples, len ) )
+    Error_Handler( );
+  // The buffer is read when needed, no DMA interrupts
+  __HAL_DMA_DISABLE_IT( hKPB.phADC->DMA_Handle, DMA_IT_TC | DMA_IT_HT | DMA_IT_TE );
+  _ADC_WatchdogArm( &hKPB );
+#endif
+
   return;
 }
 
@@ -58,6 +90,9 @@ void KPB_Tick( void *ptr ) {
   //
   if ( ptr ) {
     phKPB_t phkpb = (phKPB_t) ptr;
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+    if ( !READ_BIT( phkpb->Flags, KPB_FLAG_ACTIVE ) ) return;     // Watchdog is armed
+#endif
     SET_BIT( phkpb->Flags, KPB_FLAG_TICK );
   }
 
@@ -70,6 +105,19 @@ void KPB_Tick( void *ptr ) {
 void KPB_Serve( phKPB_t phKPB ) {
   //
   if ( phKPB ) {
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+    if ( READ_BIT( phKPB->Flags, KPB_FLAG_TICK ) ) {
+      CLEAR_BIT( phKPB->Flags, KPB_FLAG_TICK );
+      for ( size_t l = 0; l < KPB_LADDERS_NUM; l++ ) {     // Scan sequence is interleaved
+        uint32_t sum = 0;
+        for ( size_t i = l; i < KPB_ADC_DMA_LEN * KPB_LADDERS_NUM; i += KPB_LADDERS_NUM )
+          sum += phKPB->aSamples[ i ];
+        phKPB->aRawData[ l ] = (uint16_t) ( sum / KPB_ADC_DMA_LEN );
+      }
+      _KeyProcess( phKPB );
+      if ( _KeysReleased( phKPB ) ) _ADC_WatchdogArm( phKPB );     // Back to zero CPU
+    }
+#else
     if ( READ_BIT( phKPB->Flags, KPB_FLAG_TICK ) ) {        //
       if ( HAL_OK == HAL_ADC_Start_IT( phKPB->phADC ) )     //
         CLEAR_BIT( phKPB->Flags, KPB_FLAG_TICK );           //
@@ -81,11 +129,37 @@ void KPB_Serve( phKPB_t phKPB ) {
       _KeyProcess( phKPB );                                   // Tavg = 17.4 us
                                                               // EventStopA( 0 );
     }
+#endif
   }
 
   return;
 }
 
+/** --------------------------------------------------------------------------
+ * @brief   Check if KPB_Serve( ) has work: a tick to start a conversion or a
+ *          completed conversion to process.
+ */
+bool KPB_IsPending( phKPB_t phKPB ) {
+  //
+  return phKPB && READ_BIT( phKPB->Flags, KPB_FLAG_TICK | KPB_FLAG_CONV_CPLT );
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Bit mask of the keys in the debounced pressed state, 1UL << eKPB_Key_t.
+ * @note    Chords show up as several bits, also for keys of different ladders.
+ */
+uint32_t KPB_GetPressed( phKPB_t phKPB ) {
+  //
+  uint32_t keys = 0;
+  if ( phKPB ) {
+    for ( size_t id = 0; id < KPB_KEYS_NUM; id++ ) {
+      if ( READ_BIT( phKPB->asKeys[ id ].Flags, KPB_KEY_FLAG_STATE ) ) SET_BIT( keys, 1UL << id );
+    }
+  }
+
+  return keys;
+}
+
 /** --------------------------------------------------------------------------
  * @brief   >|<
  */
@@ -99,13 +173,13 @@ __WEAK void KPB_KeyEventCallback( phKPB_t ph, eKPB_Key_t eKey, eKPB_Evt_t eEvt )
  */
 static void _KeyProcess( phKPB_t ph ) {
   //
-  _KeyRecognition( phKPB );
+  _KeyRecognition( ph );
 
   for ( size_t id = 0; id < KPB_KEYS_NUM; id++ ) {
     //
     psKPB_Key psKey = &ph->asKeys[ id ];
     psKey->Debounce <<= 1;
-    SET_BIT( psKey->Debounce, ( id == ph->KeyRecognized ) ? 1 : 0 );
+    SET_BIT( psKey->Debounce, READ_BIT( ph->KeysRecognized, 1UL << id ) ? 1 : 0 );
     uint32_t maskedval = psKey->Debounce & KPB_DEBOUNCE_MASK;
     if ( maskedval == KPB_DEBOUNCE_MASK ) {                      // The key is pressed.
       if ( !READ_BIT( psKey->Flags, KPB_KEY_FLAG_STATE ) ) {     // The key was pushed.
@@ -150,19 +224,82 @@ static void _KeyProcess( phKPB_t ph ) {
 }
 
 /** --------------------------------------------------------------------------
- * @brief   >|<
+ * @brief   Translate the ADC code of every ladder to the keys pressed on it.
+ * @note    One table load per ladder, independent of the number of keys and chords.
  */
 static void _KeyRecognition( phKPB_t ph ) {
   //
-  uint16_t val = ph->RawData;
+  uint32_t keys     = 0;
+  bool     released = true;
+  for ( size_t l = 0; l < KPB_LADDERS_NUM; l++ ) {
+    uint8_t state = ph->aLUT[ l ][ ( ph->aRawData[ l ] & KPB_ADC_FULL ) >> KPB_LUT_SHIFT ];
+    keys |= ph->aStateKeys[ state ];
+    if ( KPB_STATE_NONE != state ) released = false;
+  }
+  ph->KeysRecognized = keys;
+  ph->isReleased     = released;
 
-  ph->KeyRecognized = KPB_KEY_NOISE_DETECTED;
-  if ( val > ( KPB_ADC_FULL - KPB_ADC_1D32 ) ) { ph->KeyRecognized = KPB_KEY_NONE; }
-  else {
-    for ( size_t id = 0; id < KPB_KEYS_NUM; id++ ) {
-      psLimits_t psLim = &ph->asKeys[ id ].sLim;
-      if ( val >= psLim->min && val < psLim->max )     //
-        ph->KeyRecognized = (eKPB_Key_t) id;
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Fill the ADC code lookup table of every ladder from the resistor values.
+ * @note    A table entry gets a key or chord only if all its codes are inside the band of
+ *          that key or chord alone. Entries between the bands, or in overlapping bands,
+ *          read as noise and release the keys.
+ */
+static void _BuildLUT( phKPB_t ph ) {
+  //
+  sLimits_t asLim[ KPB_STATES_NUM ];
+  uint8_t   aLadder[ KPB_STATES_NUM ];
+
+  ph->aStateKeys[ KPB_STATE_NONE ]  = 0;
+  ph->aStateKeys[ KPB_STATE_NOISE ] = 0;
+
+  for ( size_t id = 0; id < KPB_KEYS_NUM; id++ ) {
+    size_t   state = KPB_STATE_KEY0 + id;
+    uint8_t  l     = asKeyCfg[ id ].Ladder;
+    uint32_t R     = _DecodeResistorCode( asKeyCfg[ id ].Code );
+    aLadder[ state ]        = l;
+    ph->aStateKeys[ state ] = 1UL << id;
+    if ( -1 == _CalcDividerLimits( &asLim[ state ], _DecodeResistorCode( asLadderCfg[ l ].PullUp ),
+                                   R, KPB_R_TOLERANCE, KPB_ADC_RESOLUTION ) )
+      Error_Handler( );
+  }
+
+#if KPB_CHORDS_CNT
+  for ( size_t id = 0; id < KPB_CHORDS_NUM; id++ ) {
+    size_t   state = KPB_STATE_KEY0 + KPB_KEYS_NUM + id;
+    uint8_t  a = asChordCfg[ id ].KeyA, b = asChordCfg[ id ].KeyB;
+    uint8_t  l = asKeyCfg[ a ].Ladder;
+    uint32_t Ra = _DecodeResistorCode( asKeyCfg[ a ].Code ),
+             Rb = _DecodeResistorCode( asKeyCfg[ b ].Code );
+    if ( l != asKeyCfg[ b ].Ladder ) Error_Handler( );     // Chord across ladders
+    aLadder[ state ]        = l;
+    ph->aStateKeys[ state ] = ( 1UL << a ) | ( 1UL << b );
+    uint32_t Rpar = ( Ra + Rb ) ? (uint32_t) ( (uint64_t) Ra * Rb / ( Ra + Rb ) ) : 0U;
+    if ( -1 == _CalcDividerLimits( &asLim[ state ], _DecodeResistorCode( asLadderCfg[ l ].PullUp ),
+                                   Rpar, KPB_R_TOLERANCE, KPB_ADC_RESOLUTION ) )
+      Error_Handler( );
+  }
+#endif
+
+  for ( size_t l = 0; l < KPB_LADDERS_NUM; l++ ) {
+    for ( size_t i = 0; i < KPB_LUT_LEN; i++ ) {
+      uint32_t lo = i << KPB_LUT_SHIFT, hi = lo + ( 1U << KPB_LUT_SHIFT ) - 1U;
+      uint8_t  state = KPB_STATE_NOISE;
+      size_t   hits  = 0;
+      if ( lo >= KPB_ADC_NONE_MIN ) state = KPB_STATE_NONE;
+      else {
+        for ( size_t s = KPB_STATE_KEY0; s < KPB_STATES_NUM; s++ ) {
+          if ( aLadder[ s ] == l && lo >= asLim[ s ].min && hi < asLim[ s ].max ) {
+            state = (uint8_t) s;
+            ++hits;
+          }
+        }
+        if ( hits > 1 ) state = KPB_STATE_NOISE;     // Overlapping bands
+      }
+      ph->aLUT[ l ][ i ] = state;
     }
   }
 
@@ -192,27 +329,48 @@ static void _ADC_Init( phKPB_t phkpb ) {
 
   do {     // Common config
     phadc->Instance                   = ADC1;
-    phadc->Init.ScanConvMode          = ADC_SCAN_DISABLE;
+    phadc->Init.ScanConvMode          = ( KPB_LADDERS_NUM > 1 ) ? ADC_SCAN_ENABLE :     //
+                                                                  ADC_SCAN_DISABLE;
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+    phadc->Init.ContinuousConvMode    = ENABLE;
+#else
     phadc->Init.ContinuousConvMode    = DISABLE;
+#endif
     phadc->Init.DiscontinuousConvMode = DISABLE;
     phadc->Init.ExternalTrigConv      = ADC_SOFTWARE_START;
     phadc->Init.DataAlign             = ADC_DATAALIGN_RIGHT;
-    phadc->Init.NbrOfConversion       = 1;
+    phadc->Init.NbrOfConversion       = KPB_LADDERS_NUM;
   } while ( 0 );
   if ( HAL_OK != HAL_ADC_Init( phadc ) )     //
     Error_Handler( );
 
-  // Configure Regular Channel
-  ADC_ChannelConfTypeDef sCfg = {
-      .Channel      = ADC_CHANNEL_4,
-      .Rank         = ADC_REGULAR_RANK_1,
-      .SamplingTime = ADC_SAMPLETIME_239CYCLES_5,
-  };
-  if ( HAL_OK != HAL_ADC_ConfigChannel( phadc, &sCfg ) )     //
-    Error_Handler( );
+  // Configure Regular Channels, one rank per ladder
+  for ( size_t l = 0; l < KPB_LADDERS_NUM; l++ ) {
+    ADC_ChannelConfTypeDef sCfg = {
+        .Channel      = asLadderCfg[ l ].Channel,
+        .Rank         = ADC_REGULAR_RANK_1 + l,
+        .SamplingTime = ADC_SAMPLETIME_239CYCLES_5,
+    };
+    if ( HAL_OK != HAL_ADC_ConfigChannel( phadc, &sCfg ) )     //
+      Error_Handler( );
+  }
 
   HAL_ADC_RegisterCallback( phadc, HAL_ADC_CONVERSION_COMPLETE_CB_ID, _ADC_ConvCpltCallback );
 
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+  // Out of window below the "no key" band on any ladder. Enabled by _ADC_WatchdogArm( )
+  ADC_AnalogWDGConfTypeDef sWdg = {
+      .WatchdogMode  = ADC_ANALOGWATCHDOG_ALL_REG,
+      .ITMode        = DISABLE,
+      .HighThreshold = KPB_ADC_FULL,
+      .LowThreshold  = KPB_ADC_NONE_MIN,
+  };
+  if ( HAL_OK != HAL_ADC_AnalogWDGConfig( phadc, &sWdg ) )     //
+    Error_Handler( );
+  HAL_ADC_RegisterCallback( phadc, HAL_ADC_LEVEL_OUT_OF_WINDOW_CB_ID,
+                            _ADC_LevelOutOfWindowCallback );
+#endif
+
   HAL_ADCEx_Calibration_Start( phadc );
 
   phkpb->phADC = phadc;
@@ -226,16 +384,30 @@ static void _ADC_Init( phKPB_t phkpb ) {
 static void _ADC_MspInit( ADC_HandleTypeDef *ph ) {
   //
   if ( ph->Instance == ADC1 ) {
-    // ADC1 GPIO Configuration: PA4 --> ADC1_IN4
+    // ADC1 GPIO Configuration: the ladder inputs, on the ports with ADC1 channels
     __HAL_RCC_GPIOA_CLK_ENABLE( );
-    HAL_GPIO_Init( GPIOA, &( GPIO_InitTypeDef ){
-                              .Pin  = GPIO_PIN_4,
-                              .Mode = GPIO_MODE_ANALOG,
-                          } );
+    __HAL_RCC_GPIOB_CLK_ENABLE( );
+    __HAL_RCC_GPIOC_CLK_ENABLE( );
+    KPB_LADDERS( KPB_X_GPIO )
 
     __HAL_RCC_ADC1_CLK_ENABLE( );     // ADC1 clock enable
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+    // ADC1 DMA Init: DMA1 channel 1, circular, interrupts stay disabled in NVIC
+    __HAL_RCC_DMA1_CLK_ENABLE( );
+    hdma_adc1.Instance                 = DMA1_Channel1;
+    hdma_adc1.Init.Direction           = DMA_PERIPH_TO_MEMORY;
+    hdma_adc1.Init.PeriphInc           = DMA_PINC_DISABLE;
+    hdma_adc1.Init.MemInc              = DMA_MINC_ENABLE;
+    hdma_adc1.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_adc1.Init.MemDataAlignment    = DMA_MDATAALIGN_HALFWORD;
+    hdma_adc1.Init.Mode                = DMA_CIRCULAR;
+    hdma_adc1.Init.Priority            = DMA_PRIORITY_LOW;
+    if ( HAL_OK != HAL_DMA_Init( &hdma_adc1 ) )     //
+      Error_Handler( );
+    __HAL_LINKDMA( ph, DMA_Handle, hdma_adc1 );
+#endif
     // ADC1 interrupt Init
-    HAL_NVIC_SetPriority( ADC1_2_IRQn, 0, 0 );
+    HAL_NVIC_SetPriority( ADC1_2_IRQn, 6, 0 );     // Below USART2, so Modbus preempts it
     HAL_NVIC_EnableIRQ( ADC1_2_IRQn );
   }
   return;
@@ -247,65 +419,115 @@ static void _ADC_MspInit( ADC_HandleTypeDef *ph ) {
 static void _ADC_ConvCpltCallback( ADC_HandleTypeDef *ph ) {
   //
   if ( ph->Instance == phKPB->phADC->Instance ) {
-    phKPB->RawData = HAL_ADC_GetValue( ph );     // Tavg = 10.2us
+    phKPB->aRawData[ 0 ] = HAL_ADC_GetValue( ph );     // Tavg = 10.2us
     SET_BIT( phKPB->Flags, KPB_FLAG_CONV_CPLT );
+    Idle_Signal( );
+  }
+
+  return;
+}
+
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+/** --------------------------------------------------------------------------
+ * @brief   The analog watchdog saw the ladder voltage leave the "no key" band.
+ * @note    The watchdog interrupt is disabled until all keys are released, otherwise it
+ *          would fire on every conversion while a key is held.
+ */
+static void _ADC_LevelOutOfWindowCallback( ADC_HandleTypeDef *ph ) {
+  //
+  __HAL_ADC_DISABLE_IT( ph, ADC_IT_AWD );
+  if ( phKPB && ph->Instance == phKPB->phADC->Instance ) {
+    SET_BIT( phKPB->Flags, KPB_FLAG_ACTIVE | KPB_FLAG_TICK );     // Recognise right away
+    Idle_Signal( );
   }
 
   return;
 }
 
+/** --------------------------------------------------------------------------
+ * @brief   Stop the key processing and wait for the analog watchdog.
+ * @note    A key pressed meanwhile sets the watchdog flag on the next conversion, so the
+ *          interrupt fires as soon as it is enabled.
+ */
+static void _ADC_WatchdogArm( phKPB_t ph ) {
+  //
+  CLEAR_BIT( ph->Flags, KPB_FLAG_ACTIVE | KPB_FLAG_TICK );
+  __HAL_ADC_CLEAR_FLAG( ph->phADC, ADC_FLAG_AWD );
+  __HAL_ADC_ENABLE_IT( ph->phADC, ADC_IT_AWD );
+
+  return;
+}
+
+/** --------------------------------------------------------------------------
+ * @brief   Check that no key is pressed or still debounced.
+ */
+static bool _KeysReleased( phKPB_t ph ) {
+  //
+  if ( !ph->isReleased ) return false;
+  for ( size_t id = 0; id < KPB_KEYS_NUM; id++ ) {
+    psKPB_Key psKey = &ph->asKeys[ id ];
+    if ( READ_BIT( psKey->Flags, KPB_KEY_FLAG_STATE ) ||     //
+         ( psKey->Debounce & KPB_DEBOUNCE_MASK ) )
+      return false;
+  }
+
+  return true;
+}
+#endif
+
 /** -------------------------------------------------------------------------
  * @brief Decode 3- or 4-digit resistor code to resistance in Ohms.
  * @param code  Resistor code as uint16_t (e.g., 103, 472, 1002, 4703).
- * @return      Resistance in Ohms as float. Returns -1.0f on error.
+ * @return      Resistance in Ohms. Returns UINT32_MAX on error.
  */
-static float _DecodeResistorCode( uint16_t code ) {
+static uint32_t _DecodeResistorCode( uint16_t code ) {
   //
-  if ( ( code < 100 && code != 0 ) || code > 9999 ) return -1.0f;
+  if ( ( code < 100 && code != 0 ) || code > 9999 ) return UINT32_MAX;
 
-  uint16_t base       = code / 10;
+  uint32_t ohms       = code / 10;
   uint8_t  multiplier = code % 10;
 
-  return (float) base * powf( 10.0f, multiplier );
+  while ( multiplier-- ) {
+    if ( ohms > UINT32_MAX / 10U / 200U ) return UINT32_MAX;     // Keep room for the tolerance
+    ohms *= 10U;
+  }
+
+  return ohms;
 }
 
 /** -------------------------------------------------------------------------
  * @brief   Calculate the output voltage divider limits for the ADC.
  * @param   psResult     Pointer to result structure.
- * @param   R1_code      Top resistor value (3-digit resistor code).
- * @param   R2_code      Bottom resistor value (3-digit resistor code).
- * @param   Tolerance    Resistor tolerance in percent (e.g., 5.0 for ±5%).
+ * @param   R1_nom       Top resistor value [Ohm].
+ * @param   R2_nom       Bottom resistor value [Ohm].
+ * @param   Tolerance    Resistor tolerance in percent (e.g., 5 for ±5%).
  * @param   Resolution   ADC resolution in bits.
  * @return  0 on success, -1 on error.
+ * @note    Integer only, the limits are rounded to the nearest ADC code.
  */
-static int8_t _CalcDividerLimits( psLimits_t psResult, uint16_t R1_code, uint16_t R2_code,     //
-                                  float Tolerance, uint8_t Resolution ) {
+static int8_t _CalcDividerLimits( psLimits_t psResult, uint32_t R1_nom, uint32_t R2_nom,     //
+                                  uint8_t Tolerance, uint8_t Resolution ) {
   //
   if ( psResult == NULL || Resolution < 6 || Resolution > 16 ||     //
-       Tolerance < 0.0f || Tolerance >= 100.0f )                    // Invalid input
+       Tolerance >= 100U )                                          // Invalid input
     return -1;
-
-  float                                                //
-      R1_nom = _DecodeResistorCode( R1_code ),         //
-      R2_nom = _DecodeResistorCode( R2_code );         //
-  if ( R1_nom < 0.0f || R2_nom < 0.0f ) return -1;     //
-
-  float                                                        //
-      TolFactor = Tolerance / 100.0f,                          //
-      R1_min    = R1_nom * ( 1.0f - TolFactor ),               //
-      R1_max    = R1_nom * ( 1.0f + TolFactor ),               //
-      R2_min    = R2_nom * ( 1.0f - TolFactor ),               //
-      R2_max    = R2_nom * ( 1.0f + TolFactor ),               //
-      denom_max = R2_max + R1_min,                             //
-      denom_min = R2_min + R1_max;                             //
-  if ( denom_max == 0.0f || denom_min == 0.0f ) return -1;     //
-
-  uint32_t                                                               //
-      ADC_full = ( 1U << Resolution ) - 1,                               //
-      ADC_1d16 = ADC_full >> 4,                                          //
-      ADC_1d32 = ADC_full >> 5,                                          //
-      Vmax     = (uint32_t) roundf( ADC_full * R2_max / denom_max ),     //
-      Vmin     = (uint32_t) roundf( ADC_full * R2_min / denom_min );
+  if ( R1_nom == UINT32_MAX || R2_nom == UINT32_MAX ) return -1;
+
+  uint64_t                                                 // [Ohm / 100]
+      R1_min    = (uint64_t) R1_nom * ( 100U - Tolerance ),     //
+      R1_max    = (uint64_t) R1_nom * ( 100U + Tolerance ),     //
+      R2_min    = (uint64_t) R2_nom * ( 100U - Tolerance ),     //
+      R2_max    = (uint64_t) R2_nom * ( 100U + Tolerance ),     //
+      denom_max = R2_max + R1_min,                              //
+      denom_min = R2_min + R1_max;                              //
+  if ( denom_max == 0U || denom_min == 0U ) return -1;          //
+
+  uint32_t                                                                                //
+      ADC_full = ( 1U << Resolution ) - 1,                                                //
+      ADC_1d16 = ADC_full >> 4,                                                           //
+      ADC_1d32 = ADC_full >> 5,                                                           //
+      Vmax     = (uint32_t) ( ( 2U * ADC_full * R2_max + denom_max ) / ( 2U * denom_max ) ),     //
+      Vmin     = (uint32_t) ( ( 2U * ADC_full * R2_min + denom_min ) / ( 2U * denom_min ) );
 
   if ( Vmax < ( ADC_1d16 ) ) Vmax = ADC_1d16;
   if ( Vmin < ( ADC_1d16 ) ) Vmin = 0;
@@ -6,26 +6,68 @@ extern "C"
 #endif     // __cplusplus
 
 #include "main.h"
+#include <stdbool.h>
 
 #define KPB_TICK_PERIOD 25U     // 25 mSec
 
-#define KPB_R_PULLUP    223U      // 22 kOhm
-#define KPB_R_DOWN      471U      // 470 Ohm
-#define KPB_R_RIGHT     682U      // 6.8 kOhm
-#define KPB_R_UP        153U      // 15 kOhm
-#define KPB_R_LEFT      273U      // 27 kOhm
-#define KPB_R_ENTER     453U      // 45 kOhm
-#define KPB_R_TOLERANCE 10.0f     // +/- 10%
+/** @defgroup KPB_ADC_Mode_define How the ladder voltage is sampled
+ * @note  KPB_ADC_MODE_IT starts one interrupt driven conversion per tick.
+ *        KPB_ADC_MODE_DMA keeps ADC1 converting into a circular DMA buffer and averages it.
+ *        The analog watchdog wakes the module when the voltage leaves the "no key" band,
+ *        so nothing runs while no key is pressed.
+ */
+#define KPB_ADC_MODE_IT  0U
+#define KPB_ADC_MODE_DMA 1U
+#ifndef KPB_ADC_MODE
+#define KPB_ADC_MODE KPB_ADC_MODE_DMA
+#endif
+
+#define KPB_ADC_DMA_LEN 32U     // Averaged samples per ladder, ~0.9 ms at 28 us per conversion
+
+/** @defgroup KPB_Ladders_define Resistor ladders, keys and chords
+ * @note  Resistors are given as 3- or 4-digit resistor codes. Every ladder has a pull-up to
+ *        the full scale and every key switches its own resistor to ground.
+ *        KPB_LADDERS: X( name, ADC channel, GPIO port, GPIO pin, pull-up code )
+ *        KPB_KEYS:    X( name, ladder, resistor code )
+ *        KPB_CHORDS:  X( name, key A, key B ) - two keys of the same ladder pressed together.
+ *                     They are recognised by the parallel resistance and reported as both
+ *                     keys pressed. Keys of different ladders need no chord entry.
+ *        Multiple ladders need KPB_ADC_MODE_DMA, they are converted in one scan sequence.
+ */
+#define KPB_LADDERS( X ) X( KPB_LADDER_OSD, ADC_CHANNEL_4, GPIOA, GPIO_PIN_4, 223U )     // 22k
+
+#define KPB_KEYS( X )                                                                          \
+  X( KPB_KEY_DOWN_ID, KPB_LADDER_OSD, 471U )      /* 470 Ohm */                                \
+  X( KPB_KEY_RIGHT_ID, KPB_LADDER_OSD, 682U )     /* 6.8 kOhm */                               \
+  X( KPB_KEY_UP_ID, KPB_LADDER_OSD, 153U )        /* 15 kOhm */                                \
+  X( KPB_KEY_LEFT_ID, KPB_LADDER_OSD, 273U )      /* 27 kOhm */                                \
+  X( KPB_KEY_ENTER_ID, KPB_LADDER_OSD, 453U )     /* 45 kOhm */
+
+#define KPB_CHORDS( X )     // e.g. X( KPB_CHORD_UP_LEFT, KPB_KEY_UP_ID, KPB_KEY_LEFT_ID )
+
+#define KPB_R_TOLERANCE 10U     // +/- 10%
+
+/** The ADC code is translated by a table indexed by its top bits, one entry per
+ * 2^KPB_LUT_SHIFT codes. Entries that are not completely inside one band read as noise.
+ */
+#define KPB_LUT_SHIFT 4U
+#define KPB_LUT_LEN   ( 1U << ( KPB_ADC_RESOLUTION - KPB_LUT_SHIFT ) )
 
 #define KPB_ADC_RESOLUTION 12U
 #define KPB_ADC_FULL       ( ( 1U << KPB_ADC_RESOLUTION ) - 1U )
 #define KPB_ADC_1D16       ( KPB_ADC_FULL >> 4 )
 #define KPB_ADC_1D32       ( KPB_ADC_FULL >> 5 )
+/** Lowest "no key" value, rounded up to a lookup table entry, so the table and the analog
+ * watchdog agree.
+ */
+#define KPB_ADC_NONE_MIN                                                                           \
+  ( ( ( KPB_ADC_FULL - KPB_ADC_1D32 ) | ( ( 1U << KPB_LUT_SHIFT ) - 1U ) ) + 1U )
 
 #define KPB_DEBOUNCE_MASK 0x03U
 
 #define KPB_FLAG_TICK      0x01
 #define KPB_FLAG_CONV_CPLT 0x02
+#define KPB_FLAG_ACTIVE    0x04     // Analog watchdog saw a key, DMA mode only
 
 #define KPB_KEY_FLAG_STATE    0x01
 #define KPB_KEY_FLAG_CB_FIRST 0x02
@@ -46,17 +88,46 @@ extern "C"
         ( ( ( sec ) * 1000 - KPB_TIME_SLOW ) / ( KPB_TICK_PERIOD * KPB_REPEATE_SKIP_FAST ) +       \
           KPB_REPEATE_NUM_SLOW ) )
 
+#define KPB_X_ENUM( name, ... ) name,
+
+  typedef enum _eKPB_LadderID {
+    KPB_LADDERS( KPB_X_ENUM )     //
+    KPB_LADDERS_NUM               // number of ladders
+  } eKPB_Ladder_t;
+
   typedef enum _eKPB_KeyID {
     KPB_KEY_NOISE_DETECTED = -2,     //
     KPB_KEY_NONE           = -1,     //
-    KPB_KEY_DOWN_ID        = 0,      //
-    KPB_KEY_RIGHT_ID,                //
-    KPB_KEY_UP_ID,                   //
-    KPB_KEY_LEFT_ID,                 //
-    KPB_KEY_ENTER_ID,                //
+    KPB_KEYS( KPB_X_ENUM )           //
     KPB_KEYS_NUM                     // number of keys
   } eKPB_Key_t;
 
+  typedef enum _eKPB_ChordID {
+    KPB_CHORDS( KPB_X_ENUM )     //
+    KPB_CHORDS_NUM               // number of chords
+  } eKPB_Chord_t;
+
+/** Entries of the lookup table: the two fixed states, then the keys, then the chords.
+ */
+#define KPB_STATE_NONE  0U     // "no key" band
+#define KPB_STATE_NOISE 1U     // Between the bands
+#define KPB_STATE_KEY0  2U
+#define KPB_STATES_NUM  ( KPB_STATE_KEY0 + KPB_KEYS_NUM + KPB_CHORDS_NUM )
+
+/** Same numbers for the preprocessor, which can't see the enums.
+ */
+#define KPB_X_COUNT( ... ) +1U
+#define KPB_LADDERS_CNT    ( 0U KPB_LADDERS( KPB_X_COUNT ) )
+#define KPB_KEYS_CNT       ( 0U KPB_KEYS( KPB_X_COUNT ) )
+#define KPB_CHORDS_CNT     ( 0U KPB_CHORDS( KPB_X_COUNT ) )
+
+#if KPB_KEYS_CNT > 32U
+#error "KPB: at most 32 keys, they are recognised as a bit mask"
+#endif
+#if KPB_LADDERS_CNT > 1U && KPB_ADC_MODE != KPB_ADC_MODE_DMA
+#error "KPB: multiple ladders need KPB_ADC_MODE_DMA"
+#endif
+
   typedef enum _eKPB_Evt {
     KPB_EVT_NONE = 0,
     KPB_EVT_PRESS,
@@ -75,26 +146,33 @@ extern "C"
   // typedef struct _sKPB_Data {} sKPB_Data_t, *psKPB_Data_t;
 
   typedef struct _sKPB_Key {
-    sLimits_t sLim;
-    uint8_t   Debounce;
-    uint8_t   Flags;     // 1- pressed
-    uint8_t   SkipCnt;
-    uint8_t   RepeateCnt;
+    uint8_t Debounce;
+    uint8_t Flags;     // 1- pressed
+    uint8_t SkipCnt;
+    uint8_t RepeateCnt;
   } sKPB_Key, *psKPB_Key;
 
   typedef struct _hKPB {
     ADC_HandleTypeDef *phADC;
     uint16_t           Flags;
-    uint16_t           RawData;
-    eKPB_Key_t         KeyRecognized;
+    uint16_t           aRawData[ KPB_LADDERS_NUM ];
+#if KPB_ADC_MODE == KPB_ADC_MODE_DMA
+    volatile uint16_t  aSamples[ KPB_ADC_DMA_LEN * KPB_LADDERS_NUM ];     // Written by DMA
+#endif
+    uint32_t           KeysRecognized;     // Bit mask of eKPB_Key_t
+    bool               isReleased;         // All ladders in the "no key" band
+    uint8_t            aLUT[ KPB_LADDERS_NUM ][ KPB_LUT_LEN ];     // ADC code -> KPB_STATE_*
+    uint32_t           aStateKeys[ KPB_STATES_NUM ];             // KPB_STATE_* -> keys
     sKPB_Key           asKeys[ KPB_KEYS_NUM ];
     // debounce filter;
   } hKPB_t, *phKPB_t;
 
-  void MX_KPB_Init( void );
-  void KPB_Tick( void *ptr );
-  void KPB_Serve( phKPB_t ph );
-  void KPB_KeyEventCallback( phKPB_t ph, eKPB_Key_t eKey, eKPB_Evt_t eEvt );
+  void     MX_KPB_Init( void );
+  void     KPB_Tick( void *ptr );
+  void     KPB_Serve( phKPB_t ph );
+  bool     KPB_IsPending( phKPB_t ph );
+  uint32_t KPB_GetPressed( phKPB_t ph );
+  void     KPB_KeyEventCallback( phKPB_t ph, eKPB_Key_t eKey, eKPB_Evt_t eEvt );
 
   extern phKPB_t phKPB;
 
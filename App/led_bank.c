@@ -0,0 +1,359 @@
+/***************************************************************************
+ * @file  led_bank.c
+ * @note  LED bank: the patterns of many LEDs, stepped by one timer interrupt.
+ * ************************************************************************* */
+
+#include "led_bank.h"
+#include "microtbx.h"
+#include <stddef.h>     // for offsetof
+#include <string.h>
+
+#define is_mask( n )   ( ( n ) != 0 && ( ( ( n ) + 1 ) & ( n ) ) == 0 )
+#define is_onebit( n ) ( ( n ) != 0 && ( ( n ) & ( ( n ) - 1 ) ) == 0 )
+
+#define LCB_FROM_TIM( phtim ) ( (phLCB_t) ( (uint8_t *) ( phtim ) - offsetof( hLCB_t, hTim ) ) )
+
+static void LCB_SetPat( psLCB_Led_t psLed, uint8_t Repeates, psLC_LPat_t psPat );
+static void LCB_WritePorts( phLCB_t ph, const uint32_t *aBSRR );
+static void LCB_TIM_MspInit( TIM_HandleTypeDef *phtim );
+static void LCB_TIM_PeriodElapsedCallback( TIM_HandleTypeDef *phtim );
+#if LCB_DIM_ENABLE
+static void LCB_TIM_OC_DelayElapsedCallback( TIM_HandleTypeDef *phtim );
+#endif
+
+static phLCB_t phLcbTim = NULL;     // Bank stepped by LCB_TIM
+
+hLCB_t  hLedBank;
+phLCB_t phLedBank  = NULL;     // == &hLedBank after MX_LCB_Init( )
+uint8_t LedGreenId = 0;        // LD2 in hLedBank
+
+/** -------------------------------------------------------------------------
+ * @brief   Custom implementation to initialize the bank with all used LEDs and start it.
+ */
+void MX_LCB_Init( void ) {
+  //
+  if ( LCB_ERR_NONE == LCB_Init( &hLedBank ) &&     //
+       LCB_ERR_NONE == LCB_Add( &hLedBank,
+                                &( sLC_Pin_t ){
+                                    .psPort    = LD2_GPIO_Port,         //
+                                    .Pin       = LD2_Pin,               //
+                                    .IsInverse = LC_PIN_ACTIVE_HIGH     //
+                                },
+                                false, &LedGreenId ) &&     //
+       LCB_ERR_NONE == LCB_Start( &hLedBank ) ) {
+    phLedBank = &hLedBank;
+  }
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Init LED bank structure, without LEDs.
+ */
+eLCB_Err_t LCB_Init( phLCB_t ph ) {
+  //
+  if ( !ph ) return LCB_ERR_ARGS;
+
+  memset( ph, 0, sizeof( hLCB_t ) );
+
+  return LCB_ERR_NONE;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Add a LED to the bank and init its GPIO pin. The LED starts off.
+ * @param   IsDimmed  Switch the LED with the PWM duty of LCB_Dim( ).
+ * @param   pId       Receives the LED id for LCB_Set( ), may be NULL.
+ * @note    Add all LEDs before LCB_Start( ).
+ */
+eLCB_Err_t LCB_Add( phLCB_t ph, psLC_Pin_t psPin, bool IsDimmed, uint8_t *pId ) {
+  //
+  if ( !ph || !psPin ||               //
+       !is_onebit( psPin->Pin ) )     //
+    return LCB_ERR_ARGS;
+  if ( ph->CntLeds >= LCB_LEDS_MAX ) return LCB_ERR_FULL;
+
+  uint8_t port = 0;
+  while ( port < ph->CntPorts && ph->apsPorts[ port ] != psPin->psPort ) ++port;
+  if ( port >= LCB_PORTS_MAX ) return LCB_ERR_FULL;
+
+  switch ( (uint32_t) psPin->psPort ) {     // clang-format off
+    case (uint32_t) GPIOA: { __HAL_RCC_GPIOA_CLK_ENABLE( ); break; }
+    case (uint32_t) GPIOB: { __HAL_RCC_GPIOB_CLK_ENABLE( ); break; }
+    case (uint32_t) GPIOC: { __HAL_RCC_GPIOC_CLK_ENABLE( ); break; }
+    case (uint32_t) GPIOD: { __HAL_RCC_GPIOD_CLK_ENABLE( ); break; }
+    case (uint32_t) GPIOE: { __HAL_RCC_GPIOE_CLK_ENABLE( ); break; }
+    default: return LCB_ERR_ARGS;
+  }     // clang-format on
+
+  if ( port == ph->CntPorts ) ph->apsPorts[ ph->CntPorts++ ] = psPin->psPort;
+
+  psLCB_Led_t psLed = &ph->asLeds[ ph->CntLeds ];
+  memset( psLed, 0, sizeof( sLCB_Led_t ) );
+  psLed->Pin       = psPin->Pin;
+  psLed->Port      = port;
+  psLed->IsInverse = psPin->IsInverse;
+  psLed->IsDimmed  = IsDimmed;
+  psLed->sPatBG    = LCB_LPAT( &psLed->aShort[ 0 ], 32U );     // LC_SPD_OFF
+
+  // set the pin to inactive state (LED off)
+  psPin->psPort->BSRR = psPin->IsInverse ? psPin->Pin : (uint32_t) psPin->Pin << 16;
+
+  HAL_GPIO_Init( psPin->psPort,
+                 &( GPIO_InitTypeDef ){
+                     .Pin   = psPin->Pin,                                 //
+                     .Mode  = psPin->IsInverse == LC_PIN_ACTIVE_LOW ?     //
+                                 GPIO_MODE_OUTPUT_OD :                   //
+                                 GPIO_MODE_OUTPUT_PP,                    //
+                     .Pull  = GPIO_NOPULL,                                //
+                     .Speed = GPIO_SPEED_FREQ_LOW                         //
+                 } );
+
+  if ( pId ) *pId = ph->CntLeds;
+  ++ph->CntLeds;
+
+  return LCB_ERR_NONE;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Start LCB_TIM to step the bank, every LCB_STEP_MS or every PWM period.
+ * @note    One bank per timer. Without LCB_Start( ), LCB_Step( ) can be called
+ *          periodically (every LCB_STEP_MS) from an AppTick callback instead.
+ */
+eLCB_Err_t LCB_Start( phLCB_t ph ) {
+  //
+  if ( !ph ) return LCB_ERR_ARGS;
+
+  TIM_HandleTypeDef *phtim = &ph->hTim;
+  phtim->Instance          = LCB_TIM;
+  HAL_TIM_RegisterCallback( phtim, HAL_TIM_BASE_MSPINIT_CB_ID, LCB_TIM_MspInit );
+
+  /**
+   * Timer clock: PCLK of its APB bus, twice that behind an APB prescaler.
+   * TIM1 is on APB2, others on APB1 for STM32F103RB.
+   */
+  uint32_t timFreq;
+  if ( LCB_TIM == TIM1 ) {
+    timFreq = HAL_RCC_GetPCLK2Freq( );
+    if ( RCC_CFGR_PPRE2_DIV1 != READ_BIT( RCC->CFGR, RCC_CFGR_PPRE2 ) ) timFreq *= 2U;
+  }
+  else {
+    timFreq = HAL_RCC_GetPCLK1Freq( );
+    if ( RCC_CFGR_PPRE1_DIV1 != READ_BIT( RCC->CFGR, RCC_CFGR_PPRE1 ) ) timFreq *= 2U;
+  }
+
+  do {     // Common config
+#if LCB_DIM_ENABLE
+    phtim->Init.Prescaler = ( timFreq / 1000000U ) - 1U;     // 1 us
+    phtim->Init.Period    = LCB_DIM_PERIOD_US - 1U;
+#else
+    phtim->Init.Prescaler = ( timFreq / 10000U ) - 1U;     // 100 us
+    phtim->Init.Period    = LCB_STEP_MS * 10U - 1U;
+#endif
+    phtim->Init.CounterMode       = TIM_COUNTERMODE_UP;
+    phtim->Init.ClockDivision     = TIM_CLOCKDIVISION_DIV1;
+    phtim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  } while ( 0 );
+  if ( HAL_OK != HAL_TIM_Base_Init( phtim ) ) return LCB_ERR_TIM;
+
+  HAL_TIM_RegisterCallback( phtim, HAL_TIM_PERIOD_ELAPSED_CB_ID, LCB_TIM_PeriodElapsedCallback );
+
+#if LCB_DIM_ENABLE
+  TIM_OC_InitTypeDef sOC = {
+      .OCMode = TIM_OCMODE_TIMING,     // No output, compare interrupt only
+      .Pulse  = LCB_DIM_PERIOD_US,     // 100 %, never matches
+  };
+  if ( HAL_OK != HAL_TIM_OC_ConfigChannel( phtim, &sOC, TIM_CHANNEL_1 ) ) return LCB_ERR_TIM;
+  HAL_TIM_RegisterCallback( phtim, HAL_TIM_OC_DELAY_ELAPSED_CB_ID,
+                            LCB_TIM_OC_DelayElapsedCallback );
+  __HAL_TIM_ENABLE_IT( phtim, TIM_IT_CC1 );
+#endif
+
+  phLcbTim = ph;
+  if ( HAL_OK != HAL_TIM_Base_Start_IT( phtim ) ) return LCB_ERR_TIM;
+
+  return LCB_ERR_NONE;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Set pattern with more than 32 steps for LED.
+ * @param   Repeates  0 will set a pattern for the background behavior,
+ *                    otherwise - for event.
+ * @param   psPat     Use @defgroup LCB_LPat_define. The bits are not copied, they must
+ *                    stay valid while the pattern is set.
+ */
+eLCB_Err_t LCB_SetLong( phLCB_t ph, uint8_t id, uint8_t Repeates, psLC_LPat_t psPat ) {
+  //
+  if ( !ph || id >= ph->CntLeds ||      //
+       !psPat || !psPat->pBits || !psPat->Len )     //
+    return LCB_ERR_ARGS;
+
+  TbxCriticalSectionEnter( );     // LCB_Step( ) runs in the timer interrupt
+  LCB_SetPat( &ph->asLeds[ id ], Repeates, psPat );
+  TbxCriticalSectionExit( );
+
+  return LCB_ERR_NONE;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Set pattern for LED.
+ * @param   Repeates  0 will set a pattern for the background behavior,
+ *                    otherwise - for event.
+ * @param   psPat     Use @defgroup LC_SPD_define
+ */
+eLCB_Err_t LCB_Set( phLCB_t ph, uint8_t id, uint8_t Repeates, psLC_Pat_t psPat ) {
+  //
+  if ( !ph || id >= ph->CntLeds || !psPat ||     //
+       !is_mask( psPat->DurationMask ) )         //
+    return LCB_ERR_ARGS;
+
+  uint16_t len = 0;
+  for ( uint32_t mask = psPat->DurationMask; mask; mask >>= 1 ) ++len;
+
+  psLCB_Led_t psLed = &ph->asLeds[ id ];
+  uint32_t   *pBits = &psLed->aShort[ Repeates ? 1 : 0 ];
+
+  TbxCriticalSectionEnter( );     // LCB_Step( ) runs in the timer interrupt
+  *pBits = psPat->Pattern;
+  LCB_SetPat( psLed, Repeates, &LCB_LPAT( pBits, len ) );
+  TbxCriticalSectionExit( );
+
+  return LCB_ERR_NONE;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Set the PWM duty of the LEDs added with IsDimmed.
+ * @param   Percent  Brightness, 0 .. 100 [%].
+ */
+eLCB_Err_t LCB_Dim( phLCB_t ph, uint8_t Percent ) {
+  //
+#if LCB_DIM_ENABLE
+  if ( !ph || Percent > 100U ) return LCB_ERR_ARGS;
+
+  __HAL_TIM_SET_COMPARE( &ph->hTim, TIM_CHANNEL_1, LCB_DIM_PERIOD_US * Percent / 100U );
+
+  return LCB_ERR_NONE;
+#else
+  UNUSED( ph );
+  UNUSED( Percent );
+  return LCB_ERR_ARGS;
+#endif
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Advance the patterns of all LEDs and write one BSRR value per port.
+ * @note    Called from the timer interrupt after LCB_Start( ). With LCB_DIM_ENABLE it is
+ *          called every PWM period, which only switches the dimmed LEDs on again.
+ */
+void LCB_Step( phLCB_t ph ) {
+  //
+  if ( !ph ) return;
+
+#if LCB_DIM_ENABLE
+  if ( ph->DimCnt ) {
+    --ph->DimCnt;
+    LCB_WritePorts( ph, ph->aBSRR );
+    return;
+  }
+  ph->DimCnt = LCB_DIM_STEP_CNT - 1U;
+#endif
+
+  uint32_t aBSRR[ LCB_PORTS_MAX ]    = { 0 };
+  uint32_t aBSRRDim[ LCB_PORTS_MAX ] = { 0 };
+  for ( size_t id = 0; id < ph->CntLeds; id++ ) {
+    //
+    psLCB_Led_t psLed = &ph->asLeds[ id ];
+    psLC_LPat_t psPat = psLed->EvtRepeateCnt ? &psLed->sPatEvt : &psLed->sPatBG;
+    if ( psLed->Cursor >= psPat->Len ) {
+      psLed->Cursor = 0;
+      if ( psLed->EvtRepeateCnt ) --psLed->EvtRepeateCnt;
+      psPat = psLed->EvtRepeateCnt ? &psLed->sPatEvt : &psLed->sPatBG;
+    }
+    bool isOn = ( psPat->pBits[ psLed->Cursor >> 5 ] >> ( psLed->Cursor & 31U ) ) & 1U;
+    ++psLed->Cursor;
+
+    uint32_t set = psLed->Pin, reset = (uint32_t) psLed->Pin << 16;
+    aBSRR[ psLed->Port ] |= ( isOn != psLed->IsInverse ) ? set : reset;
+    if ( isOn && psLed->IsDimmed ) aBSRRDim[ psLed->Port ] |= psLed->IsInverse ? set : reset;
+  }
+
+  memcpy( ph->aBSRR, aBSRR, sizeof( aBSRR ) );
+  memcpy( ph->aBSRRDim, aBSRRDim, sizeof( aBSRRDim ) );
+  LCB_WritePorts( ph, ph->aBSRR );
+
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Copy the pattern, the same way as LC_Set( ).
+ */
+static void LCB_SetPat( psLCB_Led_t psLed, uint8_t Repeates, psLC_LPat_t psPat ) {
+  //
+  psLC_LPat_t psPattern = Repeates ? &psLed->sPatEvt : &psLed->sPatBG;
+  memcpy( psPattern, psPat, sizeof( sLC_LPat_t ) );
+  if ( Repeates ) {
+    psLed->EvtRepeateCnt = Repeates;
+    psLed->Cursor        = 0;
+  }
+  if ( !psLed->EvtRepeateCnt ) psLed->Cursor = 0;
+
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   One BSRR write per port, the pins of a port change at the same time.
+ */
+static void LCB_WritePorts( phLCB_t ph, const uint32_t *aBSRR ) {
+  //
+  for ( size_t port = 0; port < ph->CntPorts; port++ ) {
+    if ( aBSRR[ port ] ) ph->apsPorts[ port ]->BSRR = aBSRR[ port ];
+  }
+
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   LCB_TIM clock and interrupt.
+ */
+static void LCB_TIM_MspInit( TIM_HandleTypeDef *phtim ) {
+  //
+  switch ( (uint32_t) phtim->Instance ) {     // clang-format off
+    case (uint32_t) TIM1: { __HAL_RCC_TIM1_CLK_ENABLE( ); break; }
+    case (uint32_t) TIM2: { __HAL_RCC_TIM2_CLK_ENABLE( ); break; }
+    case (uint32_t) TIM3: { __HAL_RCC_TIM3_CLK_ENABLE( ); break; }
+    case (uint32_t) TIM4: { __HAL_RCC_TIM4_CLK_ENABLE( ); break; }
+    default: return;
+  }     // clang-format on
+  HAL_NVIC_SetPriority( LCB_TIM_IRQn, 15, 0 );     // Lowest, masked by TbxCriticalSectionEnter
+  HAL_NVIC_EnableIRQ( LCB_TIM_IRQn );
+
+  return;
+}
+
+/** -------------------------------------------------------------------------
+ * @brief   Step period, or PWM period with LCB_DIM_ENABLE.
+ */
+static void LCB_TIM_PeriodElapsedCallback( TIM_HandleTypeDef *phtim ) {
+  //
+  LCB_Step( LCB_FROM_TIM( phtim ) );
+  return;
+}
+
+#if LCB_DIM_ENABLE
+/** -------------------------------------------------------------------------
+ * @brief   End of the PWM duty, switch the dimmed LEDs off.
+ */
+static void LCB_TIM_OC_DelayElapsedCallback( TIM_HandleTypeDef *phtim ) {
+  //
+  phLCB_t ph = LCB_FROM_TIM( phtim );
+  LCB_WritePorts( ph, ph->aBSRRDim );
+  return;
+}
+#endif
+
+/** -------------------------------------------------------------------------
+ * @brief   LCB_TIM interrupt, call from its handler in stm32f1xx_it.c.
+ */
+void LCB_IRQHandler( void ) {
+  //
+  if ( phLcbTim ) HAL_TIM_IRQHandler( &phLcbTim->hTim );
+  return;
+}
@@ -0,0 +1,112 @@
+#ifndef __LED_BANK_H__
+#define __LED_BANK_H__
+#ifdef __cplusplus
+extern "C"
+{
+#endif     // __cplusplus
+
+#include "main.h"
+#include "led_ctrl.h"
+#include <stdbool.h>
+
+/** @defgroup LCB_Config_define LED bank
+ * @note  All LEDs of a bank are stepped by one timer interrupt. Every step composes one BSRR
+ *        value per GPIO port and writes it once, so the cost does not grow with a tick
+ *        slot per LED.
+ */
+#define LCB_LEDS_MAX  32U     // LEDs per bank
+#define LCB_PORTS_MAX 5U      // GPIOA .. GPIOE
+#define LCB_STEP_MS   40U     // Pattern step, the same as LC_Serve( )
+
+#ifndef LCB_TIM     // TIM3 runs the Modbus timing, TIM4 the HAL time base. The handler of
+                    // LCB_TIM_IRQn is in stm32f1xx_it.c and calls LCB_IRQHandler( ).
+#define LCB_TIM            TIM2
+#define LCB_TIM_IRQn       TIM2_IRQn
+#define LCB_TIM_IRQHandler TIM2_IRQHandler
+#endif
+
+/** PWM dimming of the LEDs added with IsDimmed. The timer then runs at the PWM period and
+ * switches the dimmed LEDs off at the compare match. The pattern still steps every
+ * LCB_STEP_MS. 0 runs the timer at the step period only.
+ */
+#ifndef LCB_DIM_ENABLE
+#define LCB_DIM_ENABLE 0
+#endif
+#define LCB_DIM_PERIOD_US 2000U     // 500 Hz
+#define LCB_DIM_STEP_CNT  ( LCB_STEP_MS * 1000U / LCB_DIM_PERIOD_US )
+
+/** @defgroup LCB_LPat_define Pattern with more than 32 steps
+ * @param   aWords  uint32_t array, step n is bit ( n % 32 ) of word ( n / 32 ).
+ * @param   len     Number of steps.
+ */
+#define LCB_LPAT( aWords, len ) ( sLC_LPat_t ) { .pBits = ( aWords ), .Len = ( len ) }
+
+  typedef enum _eLCB_Errors {     //
+    LCB_ERR_NONE = 0,
+    LCB_ERR_ARGS,
+    LCB_ERR_FULL,     // LCB_LEDS_MAX or LCB_PORTS_MAX reached
+    LCB_ERR_TIM
+  } eLCB_Err_t;
+
+  typedef struct _sLC_LongPattern {     //
+    const uint32_t *pBits;              // @defgroup LCB_LPat_define
+    uint16_t        Len;                // Number of steps
+  } sLC_LPat_t, *psLC_LPat_t;
+
+  typedef struct _sLCB_Led {     //
+    sLC_LPat_t sPatBG;           // Background pattern
+    sLC_LPat_t sPatEvt;          // Event pattern
+    uint32_t   aShort[ 2 ];      // Storage of 32-step patterns: background, event
+    uint16_t   Cursor;           // Step in the current pattern
+    uint16_t   Pin;              // @defgroup GPIO_pins_define
+    uint8_t    Port;             // Index in apsPorts
+    uint8_t    EvtRepeateCnt;    //
+    uint8_t    IsInverse : 1;    // @defgroup LC_PinInversion_define
+    uint8_t    IsDimmed : 1;     // Switched off at the compare match, LCB_DIM_ENABLE only
+  } sLCB_Led_t, *psLCB_Led_t;
+
+  typedef struct _hLCB {                           //
+    sLCB_Led_t        asLeds[ LCB_LEDS_MAX ];        //
+    GPIO_TypeDef     *apsPorts[ LCB_PORTS_MAX ];     //
+    uint32_t          aBSRR[ LCB_PORTS_MAX ];        // Written at the step or PWM period
+    uint32_t          aBSRRDim[ LCB_PORTS_MAX ];     // Written at the compare match
+    uint8_t           CntLeds;                       //
+    uint8_t           CntPorts;                      //
+    uint8_t           DimCnt;                        // PWM periods until the next step
+    TIM_HandleTypeDef hTim;                          //
+  } hLCB_t, *phLCB_t;
+
+  void       MX_LCB_Init( void );
+  eLCB_Err_t LCB_Init( phLCB_t ph );
+  eLCB_Err_t LCB_Add( phLCB_t ph, psLC_Pin_t psPin, bool IsDimmed, uint8_t *pId );
+  eLCB_Err_t LCB_Start( phLCB_t ph );
+  eLCB_Err_t LCB_SetLong( phLCB_t ph, uint8_t id, uint8_t Repeates, psLC_LPat_t psPat );
+  eLCB_Err_t LCB_Set( phLCB_t ph, uint8_t id, uint8_t Repeates, psLC_Pat_t psPat );
+  eLCB_Err_t LCB_Dim( phLCB_t ph, uint8_t Percent );
+  void       LCB_Step( phLCB_t ph );
+  void       LCB_IRQHandler( void );
+
+  /**
+   * @brief   Blinking background pattern
+   * @param   psPat Use @defgroup LC_SPD_define
+   */
+  __STATIC_FORCEINLINE eLCB_Err_t LCB_Background( phLCB_t ph, uint8_t id, psLC_Pat_t psPat ) {
+    return LCB_Set( ph, id, 0, psPat );
+  }
+
+  /**
+   * @brief   Blinking event pattern
+   * @param   psPat Use @defgroup LC_SPD_define
+   */
+  __STATIC_FORCEINLINE eLCB_Err_t LCB_Event( phLCB_t ph, uint8_t id, uint8_t Repeates,     //
+                                             psLC_Pat_t psPat ) {
+    return LCB_Set( ph, id, Repeates, psPat );
+  }
+
+  extern phLCB_t phLedBank;
+  extern uint8_t LedGreenId;
+
+#ifdef __cplusplus
+}
+#endif     // __cplusplus
+#endif     // __LED_BANK_H__
@@ -15,6 +15,30 @@
 | Input          | FC04 (Read)     | `30001`         | R      | `phDIM->sOutsDIM.States`   |
 | Registers      |                 | `30002`         | R      | `phMIX->sOutsMIX.States`   |
 |                |                 | `30003`         | R      | `phDOM->OutStates`         |
+|                |                 | `30004`         | R      | `phDIM->DmaLost`, with     |
+|                |                 |                 |        | DIM_DMA_ENABLE only        |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+| Counter n      | FC04 (Read)     | `30100 + 8*n`   | R      | `phCNT->asCh[ n ]`         |
+| (dig_cnt.h)    |                 | `+0, +1`        | R      | Count, low and high word   |
+|                |                 | `+2, +3`        | R      | Rate [0.01 Hz], low, high  |
+|                |                 | `+4, +5`        | R      | Period [us], low and high  |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+| SOE            | FC04 (Read)     | `30300`         | R      | Records in the log         |
+| (dig_soe.h)    |                 | `30301`         | R      | Seq of the oldest record   |
+|                |                 | `30302`         | R      | Lost edges                 |
+|                |                 | `30303`         | R      | First-out input            |
+|                |                 | `30308 + 6*k`   | R      | Record k, oldest first:    |
+|                |                 |                 |        | Sec lo/hi, Us lo/hi,       |
+|                |                 |                 |        | Input | Flags << 8, Seq    |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+| Profiler       | FC04 (Read)     | `31000`         | R      | Number of stages           |
+| (app_prof.h)   |                 | `31001`         | R      | Idle ratio [0.01 %]        |
+|                |                 | `31002`         | R      | Time stamp clock [MHz]     |
+| Stage n        | FC04 (Read)     | `31032 + 32*n`  | R      | `ePROF_ID_t` order         |
+|                |                 | `+0, +1`        | R      | Runs, low and high word    |
+|                |                 | `+2, +3, +4`    | R      | Min, avg, max [us]         |
+|                |                 | `+5`            | R      | Last [us]                  |
+|                |                 | `+6 – +21`      | R      | Histogram, log2 [us] bins  |
 | -------------- | --------------- | --------------- | ------ | -------------------------- |
 | Holding        | FC03 (Read),    | `40000 - 40003` | R/W    | `phDOM->sProtCtrl`         |
 | Registers      | FC06 (Write),   | `40000`         | R/W    | `.KeepInactive`            |
@@ -29,10 +53,20 @@
 |                |                 | `40054`         | R/W    | `sMbRtuSlvCfg.StopBitsID`  |
 |                |                 | `40055`         | R/W    | `sMbRtuSlvCfg.ParityID`    |
 | -------------- | --------------- | --------------- | ------ | -------------------------- |
+| Config store   | FC06 (Write)    | `40060`         | W      | Non-zero saves to flash    |
+| (app_cfg.h)    | FC06 (Write)    | `40061`         | W      | Non-zero commits shadow    |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+| Profiler       | FC06 (Write)    | `40070`         | W      | Non-zero clears statistics |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+| Config image   | FC20 (Read),    | File `1`        | R/W    | `psCfgShadow` as words     |
+| (app_cfg.h)    | FC21 (Write)    | Rec. `0 – 315`  |        | Last record is the CRC16,  |
+|                |                 |                 |        | it commits a valid image   |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
 | DIM Block      | FC03/FC06/FC16  | `40100 – 40115` | R/W    | `phDIM->aTau[0..3]`        |
 |                |                 | `40116`         | R/W    | `phDIM->MaskForLED`        |
+|                |                 | `40120 – 40135` | R/W    | `phDIM->aScan[0..15]`      |
 | -------------- | --------------- | --------------- | ------ | -------------------------- |
-| MIX Block      |                 |                 |        | `phMIX->psCfg`             |
+| MIX Block      |                 |                 |        | `psCfgShadow->sMixCfg`     |
 | MIX Channel 0  | FC03/FC06/FC16  | `40200 – 40210` | R/W    | `->asChCfgs[ 0 ]`          |
 |                |                 | `40200`         | R/W    | `.sMasksDIM.StXOR`         |
 |                |                 | `40201`         | R/W    | `.sMasksDIM.State`         |
@@ -61,7 +95,7 @@
 | MIX Channel 14 | FC03/FC06/FC16  | `40480 – 40490` | R/W    | `same layout as Channel 0` |
 | MIX Channel 15 | FC03/FC06/FC16  | `40500 – 40510` | R/W    | `same layout as Channel 0` |
 | -------------- | --------------- | --------------- | ------ | -------------------------- |
-| DOM Block      |                 |                 |        | `phDOM->psCfg`             |
+| DOM Block      |                 |                 |        | `psCfgShadow->sDomCfg`     |
 | DOM Channel 0  | FC03/FC06/FC16  | `40600 – 40603` | R/W    | `->asChCfg[ 0 ]`           |
 |                |                 | `40600`         | R/W    | `.uAct.RegSrcID`           |
 |                |                 | `40601`         | R/W    | `.uDeact.RegSrcID`         |
@@ -84,6 +118,22 @@
 | DOM Channel 15 | FC03/FC06/FC16  | `40660 – 40663` | R/W    | `same layout as Channel 0` |
 |                |                 | `40664`         | R/W    | `->OutsMaskXOR[0..3]`      |
 | -------------- | --------------- | --------------- | ------ | -------------------------- |
+| CNT Block      | FC03/FC06/FC16  | `40700`         | R/W    | `psCfgShadow->sCntCfg`     |
+|                |                 |                 |        | `.Inputs`                  |
+|                |                 | `40701 – 40716` | R/W    | `.aGateMs[0..15]`          |
+|                | FC06 (Write)    | `40720`         | W      | Clears counters of mask    |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+| SOE Block      | FC03/FC06/FC16  | `40725`         | R/W    | `psCfgShadow->sSoeCfg`     |
+|                |                 |                 |        | `.Inputs`                  |
+|                |                 | `40726`         | R/W    | `.FirstOut`                |
+|                | FC06 (Write)    | `40730`         | W      | Acknowledges n records     |
+|                |                 | `40731`         | W      | Re-arms the first-out      |
+|                | FC16 (Wr.Mult.) | `40732 – 40733` | W      | RTC [s], high, low word    |
+| -------------- | --------------- | --------------- | ------ | -------------------------- |
+ * The MB RTU, DIM, MIX and DOM config blocks are read from and written to psCfgShadow. The
+ * modules run on psCfgMap, so the written values take effect together at the commit ( 40061 ).
+ * The coils 00000 - 00003, discrete inputs and registers 30000 - 30002 are read from one
+ * snapshot per request, see dig_snap.h, so a request never mixes the states of two ticks.
  */
 
 #include "main.h"
@@ -92,7 +142,17 @@
 #include "dig_in.h"
 #include "dig_mix.h"
 #include "dig_out.h"
+#include "dig_cnt.h"
+#include "dig_soe.h"
+#include "dig_snap.h"
 #include "mb_rtu_slave.h"
+#include "app_prof.h"
+#include "app_cfg.h"
+
+#define MB_PROF_INPUT_REG_BASE 31000U     // Profiler registers, see app_prof.h
+#define MB_CNT_INPUT_REG_BASE  30100U     // Pulse counter registers, see dig_cnt.h
+#define MB_SOE_INPUT_REG_BASE  30300U     // Sequence of events registers, see dig_soe.h
+#define MB_CFG_FILE            1U         // Config image file, see App_Cfg_ImageWrite( )
 
 sMB_RTU_Slv_Cfg_t sMbRtuSlvCfg = {
     .SlaveID    = 10U,                        //
@@ -114,10 +174,15 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
 static FnRes_t _FC04_ReadInputReg( tTbxMbServer channel, uint16_t addr, uint16_t *value );
 static FnRes_t _FC05_WriteCoil( tTbxMbServer channel, uint16_t addr, uint8_t value );
 static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer channel, uint16_t addr, uint16_t value );
+static FnRes_t _FC20_ReadFileRecord( tTbxMbServer ph, uint16_t File, uint16_t Rec, uint16_t *pVal );
+static FnRes_t _FC21_WriteFileRecord( tTbxMbServer ph, uint16_t File, uint16_t Rec, uint16_t Val );
+static psSNAP_t _snap( void );
 
 /** Local data declarations. --------------------------------------------------------- */
 static tTbxMbTp     phTpMB;      // Modbus RTU transport layer handle.
 static tTbxMbServer phSrvMB;     // Modbus server channel handle.
+static sSNAP_t      sSnap;       // States of the request in progress
+static bool         isSnap;      // sSnap is taken, cleared after every request
 
 /** -------------------------------------------------------------------------
  * @brief   Initializes the Modbus RTU slave.
@@ -134,8 +199,11 @@ void MB_RTU_Slave_Init( void ) {
    * Construct a Modbus server object.
    * Set the callbacks for accessing the Modbus data tables.
    */
-  phTpMB = TbxMbRtuCreate( 10U, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS,     //
-                           TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY );
+  phTpMB = TbxMbRtuCreate( psMbRtuSlvCfg->SlaveID,                              //
+                           (tTbxMbUartPort) psMbRtuSlvCfg->PortID,               //
+                           (tTbxMbUartBaudrate) psMbRtuSlvCfg->BaudrateID,       //
+                           (tTbxMbUartStopbits) psMbRtuSlvCfg->StopBitsID,       //
+                           (tTbxMbUartParity) psMbRtuSlvCfg->ParityID );
   TBX_ASSERT( phTpMB );
   if ( !phTpMB ) return;
 
@@ -149,10 +217,25 @@ void MB_RTU_Slave_Init( void ) {
   TbxMbServerSetCallbackReadInputReg( phSrvMB, _FC04_ReadInputReg );
   TbxMbServerSetCallbackWriteCoil( phSrvMB, _FC05_WriteCoil );
   TbxMbServerSetCallbackWriteHoldingReg( phSrvMB, _FC06_WriteHoldingReg );
+  TbxMbServerSetCallbackReadFileRecord( phSrvMB, _FC20_ReadFileRecord );
+  TbxMbServerSetCallbackWriteFileRecord( phSrvMB, _FC21_WriteFileRecord );
 
   return;
 }
 
+/** -------------------------------------------------------------------------
+ * @brief   Run the Modbus stack event task.
+ * @details Call it instead of TbxMbEventTask( ), from the main loop or from the Modbus task
+ *          of an RTOS build. TbxMbEventTask( ) handles one event, so at most one request,
+ *          and the next request takes a new snapshot.
+ */
+void MB_RTU_Slave_Task( void ) {
+  //
+  TbxMbEventTask( );
+  isSnap = false;
+  return;
+}
+
 /** -------------------------------------------------------------------------------------
  * @brief     Reads a data element from the coils data table.
  * @details   Note that the element is specified by its zero-based address in the range
@@ -173,7 +256,7 @@ static FnRes_t _FC01_ReadCoil( tTbxMbServer ph, uint16_t Addr, uint8_t *pVal ) {
     case 0U:
     case 1U:
     case 2U:
-    case 3U: *pVal = ( 0 != READ_BIT( phDOM->OutStates, 1U << ( Addr ) ) ); break;
+    case 3U: *pVal = ( 0 != READ_BIT( _snap( )->OutStates, 1U << ( Addr ) ) ); break;
     default:     // Unsupported coil address.
       _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
       break;
@@ -261,7 +344,7 @@ static FnRes_t _FC02_ReadInput( tTbxMbServer ph, uint16_t Addr, uint8_t *pVal )
     case 10013U:
     case 10014U:
     case 10015U:
-      *pVal = ( 0 != READ_BIT( phDIM->sOutsDIM.States, 1U << ( Addr - 10000U ) ) );
+      *pVal = ( 0 != READ_BIT( _snap( )->sOutsDIM.States, 1U << ( Addr - 10000U ) ) );
       break;
     default:     // Unsupported discrete input address.
       _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
@@ -291,11 +374,24 @@ static FnRes_t _FC04_ReadInputReg( tTbxMbServer ph, uint16_t Addr, uint16_t *pVa
   FnRes_t _Err = TBX_MB_SERVER_OK;
   TBX_UNUSED_ARG( ph );
   switch ( Addr ) {
-    case 30000U: *pVal = phDIM->sOutsDIM.States; break;
-    case 30001U: *pVal = phMIX->sOutsMIX.States; break;
-    case 30002U: *pVal = phDOM->OutStates; break;
-    default:     // Unsupported input register address.
-      _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    case 30000U: *pVal = _snap( )->sOutsDIM.States; break;
+    case 30001U: *pVal = _snap( )->sOutsMIX.States; break;
+    case 30002U: *pVal = _snap( )->OutStates; break;
+#if DIM_DMA_ENABLE
+    case 30003U: *pVal = phDIM->DmaLost; break;
+#endif
+    default:     // Counter, SOE, profiler or unsupported input register address.
+      if ( Addr >= MB_PROF_INPUT_REG_BASE ) {
+        if ( !Prof_ReadReg( Addr - MB_PROF_INPUT_REG_BASE, pVal ) )
+          _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      else if ( Addr >= MB_SOE_INPUT_REG_BASE ) {
+        if ( !SOE_ReadReg( phSOE, Addr - MB_SOE_INPUT_REG_BASE, pVal ) )
+          _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      else if ( Addr < MB_CNT_INPUT_REG_BASE ||     //
+                !CNT_ReadReg( phCNT, Addr - MB_CNT_INPUT_REG_BASE, pVal ) )
+        _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
       break;
   }
 
@@ -327,12 +423,12 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40003U: *pVal = phDOM->sProtCtrl.Activate; break;
 
     /* Modbus config registers --------------------------------------------- */
-    case 40050U: *pVal = psMbRtuSlvCfg->SlaveID; break;
-    case 40051U: *pVal = psMbRtuSlvCfg->PortID; break;
-    case 40052U: *pVal = psMbRtuSlvCfg->BaudrateID; break;
-    case 40053U: *pVal = psMbRtuSlvCfg->DatabitsID; break;
-    case 40054U: *pVal = psMbRtuSlvCfg->StopBitsID; break;
-    case 40055U: *pVal = psMbRtuSlvCfg->ParityID; break;
+    case 40050U: *pVal = psCfgShadow->sMbRtuSlvCfg.SlaveID; break;
+    case 40051U: *pVal = psCfgShadow->sMbRtuSlvCfg.PortID; break;
+    case 40052U: *pVal = psCfgShadow->sMbRtuSlvCfg.BaudrateID; break;
+    case 40053U: *pVal = psCfgShadow->sMbRtuSlvCfg.DatabitsID; break;
+    case 40054U: *pVal = psCfgShadow->sMbRtuSlvCfg.StopBitsID; break;
+    case 40055U: *pVal = psCfgShadow->sMbRtuSlvCfg.ParityID; break;
 
     /* DIM config registers ------------------------------------------------ */
     case 40100U:     // DIM channel 0
@@ -351,9 +447,27 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40113U:     // DIM channel 13
     case 40114U:     // DIM channel 14
     case 40115U:     // DIM channel 15
-      *pVal = phDIM->psCfg->aTau[ Addr - 40100 ];
+      *pVal = psCfgShadow->sDimCfg.aTau[ Addr - 40100 ];
+      break;
+    case 40116U: *pVal = psCfgShadow->sDimCfg.MaskForLED; break;
+    case 40120U:     // DIM channel 0
+    case 40121U:     // DIM channel 1
+    case 40122U:     // DIM channel 2
+    case 40123U:     // DIM channel 3
+    case 40124U:     // DIM channel 4
+    case 40125U:     // DIM channel 5
+    case 40126U:     // DIM channel 6
+    case 40127U:     // DIM channel 7
+    case 40128U:     // DIM channel 8
+    case 40129U:     // DIM channel 9
+    case 40130U:     // DIM channel 10
+    case 40131U:     // DIM channel 11
+    case 40132U:     // DIM channel 12
+    case 40133U:     // DIM channel 13
+    case 40134U:     // DIM channel 14
+    case 40135U:     // DIM channel 15
+      *pVal = psCfgShadow->sDimCfg.aScan[ Addr - 40120 ];
       break;
-    case 40116U: *pVal = phDIM->psCfg->MaskForLED; break;
 
     /* MIX config registers ------------------------------------------------ */
     case 40200U:     // MIX channel 0
@@ -372,7 +486,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40460U:     // MIX channel 13
     case 40480U:     // MIX channel 14
     case 40500U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.StXOR;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.StXOR;
       break;
     case 40201U:     // MIX channel 0
     case 40221U:     // MIX channel 1
@@ -390,7 +504,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40461U:     // MIX channel 13
     case 40481U:     // MIX channel 14
     case 40501U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.State;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.State;
       break;
     case 40202U:     // MIX channel 0
     case 40222U:     // MIX channel 1
@@ -408,7 +522,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40462U:     // MIX channel 13
     case 40482U:     // MIX channel 14
     case 40502U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Rise;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Rise;
       break;
     case 40203U:     // MIX channel 0
     case 40223U:     // MIX channel 1
@@ -426,7 +540,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40463U:     // MIX channel 13
     case 40483U:     // MIX channel 14
     case 40503U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Fall;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Fall;
       break;
     case 40204U:     // MIX channel 0
     case 40224U:     // MIX channel 1
@@ -444,7 +558,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40464U:     // MIX channel 13
     case 40484U:     // MIX channel 14
     case 40504U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.StXOR;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.StXOR;
       break;
     case 40205U:     // MIX channel 0
     case 40225U:     // MIX channel 1
@@ -462,7 +576,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40465U:     // MIX channel 13
     case 40485U:     // MIX channel 14
     case 40505U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.State;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.State;
       break;
     case 40206U:     // MIX channel 0
     case 40226U:     // MIX channel 1
@@ -480,7 +594,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40466U:     // MIX channel 13
     case 40486U:     // MIX channel 14
     case 40506U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Rise;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Rise;
       break;
     case 40207U:     // MIX channel 0
     case 40227U:     // MIX channel 1
@@ -498,7 +612,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40467U:     // MIX channel 13
     case 40487U:     // MIX channel 14
     case 40507U:     // MIX channel 15
-      *pVal = phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Fall;
+      *pVal = psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Fall;
       break;
     case 40208U:     // MIX channel 0
     case 40228U:     // MIX channel 1
@@ -516,7 +630,8 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40468U:     // MIX channel 13
     case 40488U:     // MIX channel 14
     case 40508U:     // MIX channel 15
-      *pVal = ( (uint16_t *) &phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 0 ];
+      *pVal =     //
+          ( (uint16_t *) &psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 0 ];
       break;
     case 40209U:     // MIX channel 0
     case 40229U:     // MIX channel 1
@@ -534,7 +649,8 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40469U:     // MIX channel 13
     case 40489U:     // MIX channel 14
     case 40509U:     // MIX channel 15
-      *pVal = ( (uint16_t *) &phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 1 ];
+      *pVal =     //
+          ( (uint16_t *) &psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 1 ];
       break;
     case 40210U:     // MIX channel 0
     case 40230U:     // MIX channel 1
@@ -552,7 +668,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40470U:     // MIX channel 13
     case 40490U:     // MIX channel 14
     case 40510U:     // MIX channel 15
-      *pVal = (uint16_t) phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].eLogicOperation;
+      *pVal = (uint16_t) psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].eLogicOperation;
       break;
 
     /* DOM config registers ------------------------------------------------ */
@@ -572,7 +688,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40652U:     // DOM channel 13
     case 40656U:     // DOM channel 14
     case 40660U:     // DOM channel 15
-      *pVal = phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uAct.RegSrcID;
+      *pVal = psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uAct.RegSrcID;
       break;
     case 40601U:     // DOM channel 0
     case 40605U:     // DOM channel 1
@@ -590,7 +706,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40653U:     // DOM channel 13
     case 40657U:     // DOM channel 14
     case 40661U:     // DOM channel 15
-      *pVal = phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uDeact.RegSrcID;
+      *pVal = psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uDeact.RegSrcID;
       break;
     case 40602U:     // DOM channel 0
     case 40606U:     // DOM channel 1
@@ -608,7 +724,7 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40654U:     // DOM channel 13
     case 40658U:     // DOM channel 14
     case 40662U:     // DOM channel 15
-      *pVal = phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uCfgTDA.RegTimCgf;
+      *pVal = psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uCfgTDA.RegTimCgf;
       break;
     case 40603U:     // DOM channel 0
     case 40607U:     // DOM channel 1
@@ -626,10 +742,35 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
     case 40655U:     // DOM channel 13
     case 40659U:     // DOM channel 14
     case 40663U:     // DOM channel 15
-      *pVal = phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uCfgTHO.RegTimCgf;
+      *pVal = psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uCfgTHO.RegTimCgf;
       break;
     // DOM out pins mask
-    case 40664U: *pVal = phDOM->psCfg->OutsMaskXOR; break;
+    case 40664U: *pVal = psCfgShadow->sDomCfg.OutsMaskXOR; break;
+
+    /* CNT config registers ------------------------------------------------ */
+    case 40700U: *pVal = psCfgShadow->sCntCfg.Inputs; break;
+    case 40701U:     // CNT channel 0
+    case 40702U:     // CNT channel 1
+    case 40703U:     // CNT channel 2
+    case 40704U:     // CNT channel 3
+    case 40705U:     // CNT channel 4
+    case 40706U:     // CNT channel 5
+    case 40707U:     // CNT channel 6
+    case 40708U:     // CNT channel 7
+    case 40709U:     // CNT channel 8
+    case 40710U:     // CNT channel 9
+    case 40711U:     // CNT channel 10
+    case 40712U:     // CNT channel 11
+    case 40713U:     // CNT channel 12
+    case 40714U:     // CNT channel 13
+    case 40715U:     // CNT channel 14
+    case 40716U:     // CNT channel 15
+      *pVal = psCfgShadow->sCntCfg.aGateMs[ Addr - 40701 ];
+      break;
+
+    /* SOE config registers ------------------------------------------------ */
+    case 40725U: *pVal = psCfgShadow->sSoeCfg.Inputs; break;
+    case 40726U: *pVal = psCfgShadow->sSoeCfg.FirstOut; break;
 
     /* Unsupported input register address. --------------------------------- */
     default: _Err = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR; break;
@@ -653,7 +794,8 @@ static FnRes_t _FC03_ReadHoldingRegs( tTbxMbServer ph, uint16_t Addr, uint16_t *
  */
 static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t Val ) {
   //
-  FnRes_t _Res = TBX_MB_SERVER_OK;
+  static uint16_t _SecHi;     // RTC high word until the low word is written
+  FnRes_t         _Res = TBX_MB_SERVER_OK;
   TBX_UNUSED_ARG( ph );
   switch ( Addr ) {
     /* Modbus control registers -------------------------------------------- */
@@ -663,12 +805,25 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40003U: phDOM->sProtCtrl.Activate = Val; break;
 
     /* Modbus config registers --------------------------------------------- */
-    case 40050U: psMbRtuSlvCfg->SlaveID = Val; break;
-    case 40051U: psMbRtuSlvCfg->PortID = Val; break;
-    case 40052U: psMbRtuSlvCfg->BaudrateID = Val; break;
-    case 40053U: psMbRtuSlvCfg->DatabitsID = Val; break;
-    case 40054U: psMbRtuSlvCfg->StopBitsID = Val; break;
-    case 40055U: psMbRtuSlvCfg->ParityID = Val; break;
+    case 40050U: psCfgShadow->sMbRtuSlvCfg.SlaveID = Val; break;
+    case 40051U: psCfgShadow->sMbRtuSlvCfg.PortID = Val; break;
+    case 40052U: psCfgShadow->sMbRtuSlvCfg.BaudrateID = Val; break;
+    case 40053U: psCfgShadow->sMbRtuSlvCfg.DatabitsID = Val; break;
+    case 40054U: psCfgShadow->sMbRtuSlvCfg.StopBitsID = Val; break;
+    case 40055U: psCfgShadow->sMbRtuSlvCfg.ParityID = Val; break;
+
+    /* Config store control registers -------------------------------------- */
+    case 40060U:
+      if ( Val && App_Cfg_Save( ) ) _Res = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+      break;
+    case 40061U:
+      if ( Val ) App_Cfg_Commit( );
+      break;
+
+    /* Profiler control registers ------------------------------------------ */
+    case 40070U:
+      if ( Val ) Prof_Reset( );
+      break;
 
     /* DIM config registers ------------------------------------------------ */
     case 40100U:     // DIM channel 0
@@ -687,9 +842,27 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40113U:     // DIM channel 13
     case 40114U:     // DIM channel 14
     case 40115U:     // DIM channel 15
-      phDIM->psCfg->aTau[ Addr - 40100 ] = Val;
+      psCfgShadow->sDimCfg.aTau[ Addr - 40100 ] = Val;
+      break;
+    case 40116U: psCfgShadow->sDimCfg.MaskForLED = Val; break;
+    case 40120U:     // DIM channel 0
+    case 40121U:     // DIM channel 1
+    case 40122U:     // DIM channel 2
+    case 40123U:     // DIM channel 3
+    case 40124U:     // DIM channel 4
+    case 40125U:     // DIM channel 5
+    case 40126U:     // DIM channel 6
+    case 40127U:     // DIM channel 7
+    case 40128U:     // DIM channel 8
+    case 40129U:     // DIM channel 9
+    case 40130U:     // DIM channel 10
+    case 40131U:     // DIM channel 11
+    case 40132U:     // DIM channel 12
+    case 40133U:     // DIM channel 13
+    case 40134U:     // DIM channel 14
+    case 40135U:     // DIM channel 15
+      psCfgShadow->sDimCfg.aScan[ Addr - 40120 ] = Val;
       break;
-    case 40116U: phDIM->psCfg->MaskForLED = Val; break;
 
     /* MIX config registers ------------------------------------------------ */
     case 40200U:     // MIX channel 0
@@ -708,7 +881,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40460U:     // MIX channel 13
     case 40480U:     // MIX channel 14
     case 40500U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.StXOR = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.StXOR = Val;
       break;
     case 40201U:     // MIX channel 0
     case 40221U:     // MIX channel 1
@@ -726,7 +899,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40461U:     // MIX channel 13
     case 40481U:     // MIX channel 14
     case 40501U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.State = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.State = Val;
       break;
     case 40202U:     // MIX channel 0
     case 40222U:     // MIX channel 1
@@ -744,7 +917,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40462U:     // MIX channel 13
     case 40482U:     // MIX channel 14
     case 40502U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Rise = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Rise = Val;
       break;
     case 40203U:     // MIX channel 0
     case 40223U:     // MIX channel 1
@@ -762,7 +935,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40463U:     // MIX channel 13
     case 40483U:     // MIX channel 14
     case 40503U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Fall = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksDIM.Fall = Val;
       break;
     case 40204U:     // MIX channel 0
     case 40224U:     // MIX channel 1
@@ -780,7 +953,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40464U:     // MIX channel 13
     case 40484U:     // MIX channel 14
     case 40504U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.StXOR = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.StXOR = Val;
       break;
     case 40205U:     // MIX channel 0
     case 40225U:     // MIX channel 1
@@ -798,7 +971,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40465U:     // MIX channel 13
     case 40485U:     // MIX channel 14
     case 40505U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.State = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.State = Val;
       break;
     case 40206U:     // MIX channel 0
     case 40226U:     // MIX channel 1
@@ -816,7 +989,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40466U:     // MIX channel 13
     case 40486U:     // MIX channel 14
     case 40506U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Rise = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Rise = Val;
       break;
     case 40207U:     // MIX channel 0
     case 40227U:     // MIX channel 1
@@ -834,7 +1007,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40467U:     // MIX channel 13
     case 40487U:     // MIX channel 14
     case 40507U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Fall = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].sMasksMIX.Fall = Val;
       break;
     case 40208U:     // MIX channel 0
     case 40228U:     // MIX channel 1
@@ -852,7 +1025,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40468U:     // MIX channel 13
     case 40488U:     // MIX channel 14
     case 40508U:     // MIX channel 15
-      ( (uint16_t *) &phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 0 ] = Val;
+      ( (uint16_t *) &psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 0 ] = Val;
       break;
     case 40209U:     // MIX channel 0
     case 40229U:     // MIX channel 1
@@ -870,7 +1043,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40469U:     // MIX channel 13
     case 40489U:     // MIX channel 14
     case 40509U:     // MIX channel 15
-      ( (uint16_t *) &phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 1 ] = Val;
+      ( (uint16_t *) &psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].MaskUsage )[ 1 ] = Val;
       break;
     case 40210U:     // MIX channel 0
     case 40230U:     // MIX channel 1
@@ -888,7 +1061,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40470U:     // MIX channel 13
     case 40490U:     // MIX channel 14
     case 40510U:     // MIX channel 15
-      phMIX->psCfg->asChCfgs[ ( Addr - 40200 ) / 20 ].eLogicOperation = Val;
+      psCfgShadow->sMixCfg.asChCfgs[ ( Addr - 40200 ) / 20 ].eLogicOperation = Val;
       break;
 
     /* DOM config registers ------------------------------------------------ */
@@ -908,7 +1081,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40652U:     // DOM channel 13
     case 40656U:     // DOM channel 14
     case 40660U:     // DOM channel 15
-      phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uAct.RegSrcID = Val;
+      psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uAct.RegSrcID = Val;
       break;
     case 40601U:     // DOM channel 0
     case 40605U:     // DOM channel 1
@@ -926,7 +1099,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40653U:     // DOM channel 13
     case 40657U:     // DOM channel 14
     case 40661U:     // DOM channel 15
-      phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uDeact.RegSrcID = Val;
+      psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uDeact.RegSrcID = Val;
       break;
     case 40602U:     // DOM channel 0
     case 40606U:     // DOM channel 1
@@ -944,7 +1117,7 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40654U:     // DOM channel 13
     case 40658U:     // DOM channel 14
     case 40662U:     // DOM channel 15
-      phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uCfgTDA.RegTimCgf = Val;
+      psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uCfgTDA.RegTimCgf = Val;
       break;
     case 40603U:     // DOM channel 0
     case 40607U:     // DOM channel 1
@@ -962,10 +1135,43 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
     case 40655U:     // DOM channel 13
     case 40659U:     // DOM channel 14
     case 40663U:     // DOM channel 15
-      phDOM->psCfg->asChCfg[ ( Addr - 40500 ) / 4 ].uCfgTHO.RegTimCgf = Val;
+      psCfgShadow->sDomCfg.asChCfg[ ( Addr - 40600 ) / 4 ].uCfgTHO.RegTimCgf = Val;
       break;
     // DOM out pins mask
-    case 40664U: phDOM->psCfg->OutsMaskXOR = Val; break;
+    case 40664U: psCfgShadow->sDomCfg.OutsMaskXOR = Val; break;
+
+    /* CNT config registers ------------------------------------------------ */
+    case 40700U: psCfgShadow->sCntCfg.Inputs = Val; break;
+    case 40701U:     // CNT channel 0
+    case 40702U:     // CNT channel 1
+    case 40703U:     // CNT channel 2
+    case 40704U:     // CNT channel 3
+    case 40705U:     // CNT channel 4
+    case 40706U:     // CNT channel 5
+    case 40707U:     // CNT channel 6
+    case 40708U:     // CNT channel 7
+    case 40709U:     // CNT channel 8
+    case 40710U:     // CNT channel 9
+    case 40711U:     // CNT channel 10
+    case 40712U:     // CNT channel 11
+    case 40713U:     // CNT channel 12
+    case 40714U:     // CNT channel 13
+    case 40715U:     // CNT channel 14
+    case 40716U:     // CNT channel 15
+      psCfgShadow->sCntCfg.aGateMs[ Addr - 40701 ] = Val;
+      break;
+    case 40720U: CNT_Clear( phCNT, Val ); break;
+
+    /* SOE config registers ------------------------------------------------ */
+    case 40725U: psCfgShadow->sSoeCfg.Inputs = Val; break;
+    case 40726U: psCfgShadow->sSoeCfg.FirstOut = Val; break;
+    case 40730U: SOE_Ack( phSOE, Val ); break;
+    case 40731U: SOE_Rearm( phSOE ); break;
+    case 40732U: _SecHi = Val; break;     // Written first by FC16
+    case 40733U:
+      if ( !SOE_SetTime( phSOE, ( (uint32_t) _SecHi << 16 ) | Val ) )
+        _Res = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+      break;
 
     /* Unsupported holding register address. ------------------------------- */
     default: _Res = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR; break;
@@ -973,3 +1179,53 @@ static FnRes_t _FC06_WriteHoldingReg( tTbxMbServer ph, uint16_t Addr, uint16_t V
 
   return _Res;
 }
+
+/** -------------------------------------------------------------------------------------
+ * @brief     Reads a record of a file.
+ * @details   File MB_CFG_FILE holds the image of the shadow configuration map, one record
+ *            per 16-bit word in your CPUs native endianess.
+ * @param     ph    Handle to the Modbus server channel object that triggered the callback.
+ * @param     File  File number (1..65535).
+ * @param     Rec   Record number inside the file (0..9999).
+ * @param     pVal  Pointer to write the value of the record to.
+ * @return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *            specific file or record is not supported by this server.
+ */
+static FnRes_t _FC20_ReadFileRecord( tTbxMbServer ph, uint16_t File, uint16_t Rec,
+                                     uint16_t *pVal ) {
+  //
+  TBX_UNUSED_ARG( ph );
+  if ( File != MB_CFG_FILE || Rec >= CFG_IMAGE_WORDS ) return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  *pVal = App_Cfg_ImageRead( Rec );
+  return TBX_MB_SERVER_OK;
+}
+
+/** -------------------------------------------------------------------------------------
+ * @brief     Writes a record of a file.
+ * @details   File MB_CFG_FILE stages the image of the configuration map in psCfgShadow.
+ *            Writing the last record, the CRC16, commits the image if it is valid.
+ * @param     ph    Handle to the Modbus server channel object that triggered the callback.
+ * @param     File  File number (1..65535).
+ * @param     Rec   Record number inside the file (0..9999).
+ * @param     Val   Value of the record.
+ * @return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *            specific file or record is not supported by this server,
+ *            TBX_MB_SERVER_ERR_DEVICE_FAILURE if the image is invalid.
+ */
+static FnRes_t _FC21_WriteFileRecord( tTbxMbServer ph, uint16_t File, uint16_t Rec, uint16_t Val ) {
+  //
+  TBX_UNUSED_ARG( ph );
+  if ( File != MB_CFG_FILE || Rec >= CFG_IMAGE_WORDS ) return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  if ( !App_Cfg_ImageWrite( Rec, Val ) ) return TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+  return TBX_MB_SERVER_OK;
+}
+
+/**
+ * @brief   States of the request in progress, taken by its first read.
+ */
+static psSNAP_t _snap( void ) {
+  //
+  if ( !isSnap ) SNAP_Read( phSNAP, &sSnap );
+  isSnap = true;
+  return &sSnap;
+}
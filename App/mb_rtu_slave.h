@@ -26,6 +26,8 @@ extern "C"
   } sMB_RTU_Slv_Cfg_t, *psMB_RTU_Slv_Cfg_t;     // 4 bytes
   
   void MB_RTU_Slave_Init( void );
+  void MB_RTU_Slave_Task( void );
+  void TbxMbPortDeferredHandler( void );
 
   extern psMB_RTU_Slv_Cfg_t psMbRtuSlvCfg;
 
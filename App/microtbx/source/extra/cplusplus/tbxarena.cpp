@@ -0,0 +1,112 @@
+/************************************************************************************//**
+* \file         tbxarena.cpp
+* \brief        Arena allocator C++ polymorphic memory resource source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include <cstdlib>
+#include "tbxarena.hpp"
+
+/* The polymorphic memory resource requires a C++17 compiler. */
+#if (__cplusplus >= 201703L)
+
+/************************************************************************************//**
+** \brief     Allocates memory from the arena.
+** \param     bytes Size of the memory to allocate.
+** \param     alignment Alignment of the memory's address.
+** \return    Pointer to the allocated memory.
+**
+****************************************************************************************/
+void * TbxArenaResource::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+  void * result;
+
+  /* The arena does not accept zero sized allocations, yet a memory resource must. */
+  if (bytes == 0U)
+  {
+    bytes = 1U;
+  }
+  /* Allocate from the arena. */
+  result = TbxArenaAllocateAligned(&m_Arena, bytes, alignment);
+  /* Verify the allocation result. */
+  if (result == nullptr)
+  {
+    /* Since exceptions aren't used, call abort directly to indicate an abnormal end to
+     * the program, since a memory resource is not allowed to return a nullptr.
+     */
+    std::abort();
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of do_allocate ***/
+
+
+/************************************************************************************//**
+** \brief     Deallocates memory. This does nothing, because memory is released from the
+**            arena as a whole.
+** \param     p Pointer to the memory.
+** \param     bytes Size of the memory.
+** \param     alignment Alignment of the memory's address.
+**
+****************************************************************************************/
+void TbxArenaResource::do_deallocate(void * p, std::size_t bytes, std::size_t alignment)
+{
+  /* Memory is only released with the arena's mark. */
+  TBX_UNUSED_ARG(p);
+  TBX_UNUSED_ARG(bytes);
+  TBX_UNUSED_ARG(alignment);
+} /*** end of do_deallocate ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if memory allocated by this resource can be deallocated by the
+**            other resource and vice versa. Like with the standard library's buffer
+**            resources, this is only the case for the same object. This also avoids the
+**            need for run-time type information.
+** \param     other The other resource.
+** \return    True if it is the same resource, false otherwise.
+**
+****************************************************************************************/
+bool TbxArenaResource::do_is_equal(std::pmr::memory_resource const & other) const noexcept
+{
+  /* Only the same resource is equal. */
+  return (this == &other);
+} /*** end of do_is_equal ***/
+
+#endif /* __cplusplus >= 201703L */
+
+
+/*********************************** end of tbxarena.cpp *******************************/
@@ -0,0 +1,109 @@
+/************************************************************************************//**
+* \file         tbxarena.hpp
+* \brief        Arena allocator C++ polymorphic memory resource header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXARENA_HPP
+#define TBXARENA_HPP
+
+/* The polymorphic memory resource requires a C++17 compiler. */
+#if (__cplusplus >= 201703L)
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include <memory_resource>                       /* Polymorphic memory resources       */
+#include "microtbx.h"                            /* MicroTBX library                   */
+
+
+/****************************************************************************************
+*                          T B X A R E N A R E S O U R C E
+****************************************************************************************/
+/** \brief Polymorphic memory resource that allocates from a MicroTBX arena. It makes it
+ *         possible to use the std::pmr containers with an arena. Deallocation does
+ *         nothing. The memory is released with the arena's mark, or with TbxArenaScope.
+ *         Example:
+ *
+ *           TbxArenaResource resource(arena);
+ *           {
+ *             TbxArenaScope scope(arena);
+ *             std::pmr::vector<uint16_t> regs(&resource);
+ *             ...
+ *           }
+ */
+class TbxArenaResource : public std::pmr::memory_resource
+{
+public:
+  /* Constructors and destructor. */
+  explicit TbxArenaResource(tTbxArena & arena) : m_Arena(arena) { }
+  TbxArenaResource(TbxArenaResource const &) = delete;
+  TbxArenaResource & operator=(TbxArenaResource const &) = delete;
+  /* Methods. */
+  tTbxArena & arena() const { return m_Arena; }
+
+private:
+  /* Methods. */
+  void * do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void * p, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override;
+  /* Members. */
+  tTbxArena & m_Arena;
+};
+
+
+/****************************************************************************************
+*                            T B X A R E N A S C O P E
+****************************************************************************************/
+/** \brief Marks the arena upon construction and releases all memory that was allocated
+ *         since then upon destruction. Scopes can be nested.
+ */
+class TbxArenaScope
+{
+public:
+  /* Constructors and destructor. */
+  explicit TbxArenaScope(tTbxArena & arena) 
+    : m_Arena(arena), m_Mark(TbxArenaGetMark(&arena)) { }
+  ~TbxArenaScope() { TbxArenaRelease(&m_Arena, m_Mark); }
+  TbxArenaScope(TbxArenaScope const &) = delete;
+  TbxArenaScope & operator=(TbxArenaScope const &) = delete;
+
+private:
+  /* Members. */
+  tTbxArena   & m_Arena;
+  tTbxArenaMark m_Mark;
+};
+
+#endif /* __cplusplus >= 201703L */
+
+#endif /* TBXARENA_HPP */
+/*********************************** end of tbxarena.hpp *******************************/
@@ -59,7 +59,8 @@
  * memory allocation and release using memory pools automatically. That's the purpose of
  * this file. By compiling and linking this source file with your project, the global new
  * and delete operators are overloaded, such that they by default always use the memory
- * pools module of MicroTBX.
+ * pools module of MicroTBX. When the TLSF heap is enabled with TBX_CONF_HEAP_TLSF_ENABLE,
+ * they use the heap module directly instead, as it supports freeing memory too.
  */
 
 
@@ -79,11 +80,16 @@ void * operator new(size_t size)
 {
   void * result;
   
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+  /* Allocate the memory directly on the heap. */
+  result = TbxHeapAllocate(size);
+#else
   /* Attempt to allocate a block from a memory pool with the same size. If non-existant,
    * automatically create the memory pool. If no more free blocks available in the
    * memory pool, automatically expand the memory pool by adding one more block.
    */
   result = TbxMemPoolAllocateAuto(size);
+#endif
   /* Verify the allocation result. */
   if (result == nullptr)
   {
@@ -104,10 +110,14 @@ void * operator new(size_t size)
 ****************************************************************************************/
 void operator delete(void * mem)
 {
-  /* Give the block back to the memory pool. */
+  /* Give the block back to the memory pool or heap. */
   if (mem != nullptr)
   {
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+    TbxHeapFree(mem);
+#else
     TbxMemPoolRelease(mem);
+#endif
   }
 } /*** end of operator delete ***/
 
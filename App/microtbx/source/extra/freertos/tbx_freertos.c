@@ -37,6 +37,8 @@
 /*
  * An implementation of pvPortMalloc() and vPortFree() based on the memory pools module
  * of MicroTBX. Note that this implementation allows allocated memory to be freed again.
+ * When the TLSF heap is enabled with TBX_CONF_HEAP_TLSF_ENABLE, the heap module is used
+ * directly instead, as it supports freeing memory too.
  *
  * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative implementations, and the
  * memory management pages of http://www.FreeRTOS.org for more information.
@@ -93,6 +95,10 @@ void * pvPortMalloc(size_t xWantedSize)
   /* Prevent the scheduler from performing a context switch, while allocating memory. */
   vTaskSuspendAll();
 
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+  /* Allocate the memory directly on the heap. */
+  result = TbxHeapAllocate(xWantedSize);
+#else
   /* Attempt to allocate a block from the best fitting memory pool. */
   result = TbxMemPoolAllocate(xWantedSize);
   /* Was the allocation not successful? */
@@ -114,6 +120,7 @@ void * pvPortMalloc(size_t xWantedSize)
      */
     result = TbxMemPoolAllocate(xWantedSize);
   }
+#endif
   /* Allow memory allocation tracing. */
   traceMALLOC( result, xWantedSize );
 
@@ -144,8 +151,16 @@ void * pvPortMalloc(size_t xWantedSize)
 ****************************************************************************************/
 void vPortFree(void * pv)
 {
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+  /* Give the memory back to the heap. */
+  if (pv != NULL)
+  {
+    TbxHeapFree(pv);
+  }
+#else
   /* Give the block back to the memory pool. */
   TbxMemPoolRelease(pv);
+#endif
 } /*** end of vPortFree ***/
 
 
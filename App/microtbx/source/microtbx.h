@@ -59,7 +59,9 @@
 #include "tbx_critsect.h"     // Critical sections
 #include "tbx_heap.h"         // Heap memory allocation
 #include "tbx_list.h"         // Linked lists
+#include "tbx_ilist.h"        // Intrusive linked lists
 #include "tbx_mempool.h"      // Pool based heap memory manager
+#include "tbx_arena.h"        // Arena allocator
 #include "tbx_random.h"       // Random number generator
 #include "tbx_checksum.h"     // Checksum module
 #include "tbx_crypto.h"       // Cryptography module
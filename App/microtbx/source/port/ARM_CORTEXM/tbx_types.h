@@ -49,6 +49,22 @@ extern "C" {
  */
 typedef uint32_t tTbxPortCpuSR;
 
+/** \brief Port specific part of a lock. On a single core, a lock only needs to mask the
+ *         interrupts. The level is the value for the BASEPRI register on ARM Cortex-M3
+ *         and higher. A level of 0 disables all interrupts.
+ */
+typedef struct
+{
+  tTbxPortCpuSR level;
+} tTbxPortLock;
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Initializer of the port specific part of a lock. */
+#define TBX_PORT_LOCK_INIT(level)                { (level) }
+
 
 #ifdef __cplusplus
 }
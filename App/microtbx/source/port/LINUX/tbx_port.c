@@ -115,4 +115,55 @@ void TbxPortInterruptsRestore(tTbxPortCpuSR prevCpuSr)
 } /*** end of TbxPortInterruptsRestore ***/
 
 
+/************************************************************************************//**
+** \brief     Obtains the lock. Each lock has its own mutex, so only threads that use the
+**            same lock are locked out. Nested entries by the thread that already holds
+**            the lock are detected with the help of the owner.
+** \param     portLock Port specific part of the lock.
+** \return    TBX_PORT_CPU_SR_IRQ_EN if the mutex was locked by this call, 0 for a nested
+**            entry.
+**
+****************************************************************************************/
+tTbxPortCpuSR TbxPortLockAcquire(tTbxPortLock * portLock)
+{
+  tTbxPortCpuSR result = 0U;
+  uintptr_t     self = (uintptr_t)pthread_self();
+
+  /* Only lock the mutex if the calling thread does not already hold it. Only the thread
+   * that holds the mutex stores itself as the owner, so the owner can never match the
+   * calling thread, unless it already holds the mutex.
+   */
+  if (__atomic_load_n(&portLock->owner, __ATOMIC_ACQUIRE) != self)
+  {
+    /* Lock out other threads that use the same lock. */
+    (void)pthread_mutex_lock(&portLock->mutex);
+    /* Store the owner to detect nested entries. */
+    __atomic_store_n(&portLock->owner, self, __ATOMIC_RELEASE);
+    /* Update the result accordingly. */
+    result = TBX_PORT_CPU_SR_IRQ_EN;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxPortLockAcquire ***/
+
+
+/************************************************************************************//**
+** \brief     Releases the lock, if it was locked by the matching call to
+**            TbxPortLockAcquire().
+** \param     portLock Port specific part of the lock.
+** \param     prevCpuSr The value returned by TbxPortLockAcquire().
+**
+****************************************************************************************/
+void TbxPortLockRelease(tTbxPortLock * portLock, tTbxPortCpuSR prevCpuSr)
+{
+  /* Was the mutex locked upon entering the lock? */
+  if (prevCpuSr == TBX_PORT_CPU_SR_IRQ_EN)
+  {
+    /* Clear the owner, before no longer locking out other threads. */
+    __atomic_store_n(&portLock->owner, (uintptr_t)0U, __ATOMIC_RELEASE);
+    (void)pthread_mutex_unlock(&portLock->mutex);
+  }
+} /*** end of TbxPortLockRelease ***/
+
+
 /*********************************** end of tbx_port.c *********************************/
@@ -36,6 +36,11 @@
 #ifndef TBX_TYPES_H
 #define TBX_TYPES_H
 
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include <pthread.h>                             /* Posix thread utilities             */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -49,6 +54,25 @@ extern "C" {
  */
 typedef uint32_t tTbxPortCpuSR;
 
+/** \brief Port specific part of a lock. Each lock has its own mutex, so threads only
+ *         serialize on the locks they actually share. The owner is needed to detect
+ *         nested entries by the thread that already holds the mutex.
+ */
+typedef struct
+{
+  pthread_mutex_t    mutex;
+  volatile uintptr_t owner;
+} tTbxPortLock;
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Initializer of the port specific part of a lock. The interrupt mask level is
+ *         not applicable to this port.
+ */
+#define TBX_PORT_LOCK_INIT(level)                { PTHREAD_MUTEX_INITIALIZER, 0U }
+
 
 #ifdef __cplusplus
 }
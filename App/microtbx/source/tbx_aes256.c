@@ -1,448 +1,520 @@
-/*
-*   Byte-oriented AES-256 implementation.
-*   All lookup tables replaced with 'on the fly' calculations.
+/************************************************************************************//**
+* \file         tbx_aes256.c
+* \brief        AES256 block cipher source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
 *
-*   Copyright (c) 2007-2011 Ilya O. Levin, www.literatecode.com
-*   Other contributors: Hal Finney, Frank Voorburg (MISRA compliance)
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
 *
-*   Permission to use, copy, modify, and distribute this software for any
-*   purpose with or without fee is hereby granted, provided that the above
-*   copyright notice and this permission notice appear in all copies.
+* SPDX-License-Identifier: MIT
 *
-*   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
-*   WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
-*   MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
-*   ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
-*   WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
-*   ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
-*   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
-*/
-#include <stdint.h>                         /* for standard integer types              */
-#include "tbx_aes256.h"
-
-static uint8_t rj_sbox(uint8_t x);
-static uint8_t rj_sbox_inv(uint8_t x);
-static uint8_t rj_xtime(uint8_t x);
-static void aes_subBytes(uint8_t *buf);
-static void aes_subBytes_inv(uint8_t *buf);
-static void aes_addRoundKey(uint8_t *buf, uint8_t const *key);
-static void aes_addRoundKey_cpy(uint8_t *buf, uint8_t const *key, uint8_t *cpk);
-static void aes_shiftRows(uint8_t *buf);
-static void aes_shiftRows_inv(uint8_t *buf);
-static void aes_mixColumns(uint8_t *buf);
-static void aes_mixColumns_inv(uint8_t *buf);
-static void aes_expandEncKey(uint8_t *k, uint8_t *rc);
-static void aes_expandDecKey(uint8_t *k, uint8_t *rc);
-
-/* -------------------------------------------------------------------------- */
-static uint8_t rj_sbox(uint8_t x)
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX global header             */
+#include "tbx_aes256.h"                          /* AES256 block cipher                */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Number of rounds for a 256-bit key. */
+#define TBX_AES256_ROUNDS                        (14U)
+
+/** \brief Number of 32-bit words in a 256-bit key. */
+#define TBX_AES256_KEY_WORDS                     (8U)
+
+/** \brief Rotates a 32-bit word to the right by the specified number of bits. Each
+ *         T-table in the textbook implementation is the first one, rotated by a multiple
+ *         of 8 bits. Only storing the first one saves 3 kB of ROM. The rotation is
+ *         free on ARM Cortex-M, thanks to its barrel shifter.
+ */
+#define TBX_AES256_ROR(word, bits)               (((word) >> (bits)) | \
+                                                  ((word) << (32U - (bits))))
+
+/** \brief Extracts byte number idx from a 32-bit word, where byte 0 is the most
+ *         significant one.
+ */
+#define TBX_AES256_BYTE(word, idx)               ((uint8_t)((word) >> \
+                                                            (24U - ((idx) * 8U))))
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static uint32_t TbxAes256Load(uint8_t const * bytes);
+static void     TbxAes256Store(uint8_t * bytes, uint32_t word);
+static uint32_t TbxAes256SubWord(uint32_t word);
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Substitution box. */
+static const uint8_t tbxAes256SBox[256] =
 {
-    static const uint8_t sbox[256] =
-    {
-        0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5,
-        0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
-        0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0,
-        0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
-        0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc,
-        0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-        0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a,
-        0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
-        0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0,
-        0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
-        0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b,
-        0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-        0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85,
-        0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
-        0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5,
-        0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
-        0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17,
-        0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-        0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88,
-        0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
-        0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c,
-        0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
-        0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9,
-        0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-        0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6,
-        0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
-        0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e,
-        0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
-        0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94,
-        0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-        0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68,
-        0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
-    };
-
-    return sbox[(x)];
-} /* rj_sbox */
-
-/* -------------------------------------------------------------------------- */
-static uint8_t rj_sbox_inv(uint8_t x)
+  0x63U, 0x7cU, 0x77U, 0x7bU, 0xf2U, 0x6bU, 0x6fU, 0xc5U, 0x30U, 0x01U, 0x67U, 0x2bU,
+  0xfeU, 0xd7U, 0xabU, 0x76U, 0xcaU, 0x82U, 0xc9U, 0x7dU, 0xfaU, 0x59U, 0x47U, 0xf0U,
+  0xadU, 0xd4U, 0xa2U, 0xafU, 0x9cU, 0xa4U, 0x72U, 0xc0U, 0xb7U, 0xfdU, 0x93U, 0x26U,
+  0x36U, 0x3fU, 0xf7U, 0xccU, 0x34U, 0xa5U, 0xe5U, 0xf1U, 0x71U, 0xd8U, 0x31U, 0x15U,
+  0x04U, 0xc7U, 0x23U, 0xc3U, 0x18U, 0x96U, 0x05U, 0x9aU, 0x07U, 0x12U, 0x80U, 0xe2U,
+  0xebU, 0x27U, 0xb2U, 0x75U, 0x09U, 0x83U, 0x2cU, 0x1aU, 0x1bU, 0x6eU, 0x5aU, 0xa0U,
+  0x52U, 0x3bU, 0xd6U, 0xb3U, 0x29U, 0xe3U, 0x2fU, 0x84U, 0x53U, 0xd1U, 0x00U, 0xedU,
+  0x20U, 0xfcU, 0xb1U, 0x5bU, 0x6aU, 0xcbU, 0xbeU, 0x39U, 0x4aU, 0x4cU, 0x58U, 0xcfU,
+  0xd0U, 0xefU, 0xaaU, 0xfbU, 0x43U, 0x4dU, 0x33U, 0x85U, 0x45U, 0xf9U, 0x02U, 0x7fU,
+  0x50U, 0x3cU, 0x9fU, 0xa8U, 0x51U, 0xa3U, 0x40U, 0x8fU, 0x92U, 0x9dU, 0x38U, 0xf5U,
+  0xbcU, 0xb6U, 0xdaU, 0x21U, 0x10U, 0xffU, 0xf3U, 0xd2U, 0xcdU, 0x0cU, 0x13U, 0xecU,
+  0x5fU, 0x97U, 0x44U, 0x17U, 0xc4U, 0xa7U, 0x7eU, 0x3dU, 0x64U, 0x5dU, 0x19U, 0x73U,
+  0x60U, 0x81U, 0x4fU, 0xdcU, 0x22U, 0x2aU, 0x90U, 0x88U, 0x46U, 0xeeU, 0xb8U, 0x14U,
+  0xdeU, 0x5eU, 0x0bU, 0xdbU, 0xe0U, 0x32U, 0x3aU, 0x0aU, 0x49U, 0x06U, 0x24U, 0x5cU,
+  0xc2U, 0xd3U, 0xacU, 0x62U, 0x91U, 0x95U, 0xe4U, 0x79U, 0xe7U, 0xc8U, 0x37U, 0x6dU,
+  0x8dU, 0xd5U, 0x4eU, 0xa9U, 0x6cU, 0x56U, 0xf4U, 0xeaU, 0x65U, 0x7aU, 0xaeU, 0x08U,
+  0xbaU, 0x78U, 0x25U, 0x2eU, 0x1cU, 0xa6U, 0xb4U, 0xc6U, 0xe8U, 0xddU, 0x74U, 0x1fU,
+  0x4bU, 0xbdU, 0x8bU, 0x8aU, 0x70U, 0x3eU, 0xb5U, 0x66U, 0x48U, 0x03U, 0xf6U, 0x0eU,
+  0x61U, 0x35U, 0x57U, 0xb9U, 0x86U, 0xc1U, 0x1dU, 0x9eU, 0xe1U, 0xf8U, 0x98U, 0x11U,
+  0x69U, 0xd9U, 0x8eU, 0x94U, 0x9bU, 0x1eU, 0x87U, 0xe9U, 0xceU, 0x55U, 0x28U, 0xdfU,
+  0x8cU, 0xa1U, 0x89U, 0x0dU, 0xbfU, 0xe6U, 0x42U, 0x68U, 0x41U, 0x99U, 0x2dU, 0x0fU,
+  0xb0U, 0x54U, 0xbbU, 0x16U
+};
+
+/** \brief Inverse substitution box. */
+static const uint8_t tbxAes256SBoxInv[256] =
 {
-    static const uint8_t sboxinv[256] =
-    {
-        0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38,
-        0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
-        0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87,
-        0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
-        0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d,
-        0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
-        0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2,
-        0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
-        0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16,
-        0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
-        0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda,
-        0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
-        0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a,
-        0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
-        0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02,
-        0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
-        0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea,
-        0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
-        0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85,
-        0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
-        0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89,
-        0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
-        0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20,
-        0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
-        0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31,
-        0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
-        0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d,
-        0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
-        0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0,
-        0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
-        0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26,
-        0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d
-    };
-
-    return sboxinv[(x)];
-} /* rj_sbox_inv */
-
-/* -------------------------------------------------------------------------- */
-static uint8_t rj_xtime(uint8_t x)
+  0x52U, 0x09U, 0x6aU, 0xd5U, 0x30U, 0x36U, 0xa5U, 0x38U, 0xbfU, 0x40U, 0xa3U, 0x9eU,
+  0x81U, 0xf3U, 0xd7U, 0xfbU, 0x7cU, 0xe3U, 0x39U, 0x82U, 0x9bU, 0x2fU, 0xffU, 0x87U,
+  0x34U, 0x8eU, 0x43U, 0x44U, 0xc4U, 0xdeU, 0xe9U, 0xcbU, 0x54U, 0x7bU, 0x94U, 0x32U,
+  0xa6U, 0xc2U, 0x23U, 0x3dU, 0xeeU, 0x4cU, 0x95U, 0x0bU, 0x42U, 0xfaU, 0xc3U, 0x4eU,
+  0x08U, 0x2eU, 0xa1U, 0x66U, 0x28U, 0xd9U, 0x24U, 0xb2U, 0x76U, 0x5bU, 0xa2U, 0x49U,
+  0x6dU, 0x8bU, 0xd1U, 0x25U, 0x72U, 0xf8U, 0xf6U, 0x64U, 0x86U, 0x68U, 0x98U, 0x16U,
+  0xd4U, 0xa4U, 0x5cU, 0xccU, 0x5dU, 0x65U, 0xb6U, 0x92U, 0x6cU, 0x70U, 0x48U, 0x50U,
+  0xfdU, 0xedU, 0xb9U, 0xdaU, 0x5eU, 0x15U, 0x46U, 0x57U, 0xa7U, 0x8dU, 0x9dU, 0x84U,
+  0x90U, 0xd8U, 0xabU, 0x00U, 0x8cU, 0xbcU, 0xd3U, 0x0aU, 0xf7U, 0xe4U, 0x58U, 0x05U,
+  0xb8U, 0xb3U, 0x45U, 0x06U, 0xd0U, 0x2cU, 0x1eU, 0x8fU, 0xcaU, 0x3fU, 0x0fU, 0x02U,
+  0xc1U, 0xafU, 0xbdU, 0x03U, 0x01U, 0x13U, 0x8aU, 0x6bU, 0x3aU, 0x91U, 0x11U, 0x41U,
+  0x4fU, 0x67U, 0xdcU, 0xeaU, 0x97U, 0xf2U, 0xcfU, 0xceU, 0xf0U, 0xb4U, 0xe6U, 0x73U,
+  0x96U, 0xacU, 0x74U, 0x22U, 0xe7U, 0xadU, 0x35U, 0x85U, 0xe2U, 0xf9U, 0x37U, 0xe8U,
+  0x1cU, 0x75U, 0xdfU, 0x6eU, 0x47U, 0xf1U, 0x1aU, 0x71U, 0x1dU, 0x29U, 0xc5U, 0x89U,
+  0x6fU, 0xb7U, 0x62U, 0x0eU, 0xaaU, 0x18U, 0xbeU, 0x1bU, 0xfcU, 0x56U, 0x3eU, 0x4bU,
+  0xc6U, 0xd2U, 0x79U, 0x20U, 0x9aU, 0xdbU, 0xc0U, 0xfeU, 0x78U, 0xcdU, 0x5aU, 0xf4U,
+  0x1fU, 0xddU, 0xa8U, 0x33U, 0x88U, 0x07U, 0xc7U, 0x31U, 0xb1U, 0x12U, 0x10U, 0x59U,
+  0x27U, 0x80U, 0xecU, 0x5fU, 0x60U, 0x51U, 0x7fU, 0xa9U, 0x19U, 0xb5U, 0x4aU, 0x0dU,
+  0x2dU, 0xe5U, 0x7aU, 0x9fU, 0x93U, 0xc9U, 0x9cU, 0xefU, 0xa0U, 0xe0U, 0x3bU, 0x4dU,
+  0xaeU, 0x2aU, 0xf5U, 0xb0U, 0xc8U, 0xebU, 0xbbU, 0x3cU, 0x83U, 0x53U, 0x99U, 0x61U,
+  0x17U, 0x2bU, 0x04U, 0x7eU, 0xbaU, 0x77U, 0xd6U, 0x26U, 0xe1U, 0x69U, 0x14U, 0x63U,
+  0x55U, 0x21U, 0x0cU, 0x7dU
+};
+
+/** \brief Encryption T-table. Combines SubBytes and MixColumns for one byte of a column.
+ *         Each entry holds the substituted byte multiplied by {02, 01, 01, 03}.
+ */
+static const uint32_t tbxAes256Te[256] =
 {
-    uint8_t result;
-    uint8_t y;
-
-    y = (uint8_t)(x << 1U);
-
-    if ( (x & 0x80U) != 0U)
-    {
-        result = y ^ 0x1bU;
-    }
-    else
-    {
-        result = y;
-    }
-
-    return result;
-} /* rj_xtime */
-
-/* -------------------------------------------------------------------------- */
-static void aes_subBytes(uint8_t *buf)
+  0xc66363a5U, 0xf87c7c84U, 0xee777799U, 0xf67b7b8dU, 0xfff2f20dU, 0xd66b6bbdU,
+  0xde6f6fb1U, 0x91c5c554U, 0x60303050U, 0x02010103U, 0xce6767a9U, 0x562b2b7dU,
+  0xe7fefe19U, 0xb5d7d762U, 0x4dababe6U, 0xec76769aU, 0x8fcaca45U, 0x1f82829dU,
+  0x89c9c940U, 0xfa7d7d87U, 0xeffafa15U, 0xb25959ebU, 0x8e4747c9U, 0xfbf0f00bU,
+  0x41adadecU, 0xb3d4d467U, 0x5fa2a2fdU, 0x45afafeaU, 0x239c9cbfU, 0x53a4a4f7U,
+  0xe4727296U, 0x9bc0c05bU, 0x75b7b7c2U, 0xe1fdfd1cU, 0x3d9393aeU, 0x4c26266aU,
+  0x6c36365aU, 0x7e3f3f41U, 0xf5f7f702U, 0x83cccc4fU, 0x6834345cU, 0x51a5a5f4U,
+  0xd1e5e534U, 0xf9f1f108U, 0xe2717193U, 0xabd8d873U, 0x62313153U, 0x2a15153fU,
+  0x0804040cU, 0x95c7c752U, 0x46232365U, 0x9dc3c35eU, 0x30181828U, 0x379696a1U,
+  0x0a05050fU, 0x2f9a9ab5U, 0x0e070709U, 0x24121236U, 0x1b80809bU, 0xdfe2e23dU,
+  0xcdebeb26U, 0x4e272769U, 0x7fb2b2cdU, 0xea75759fU, 0x1209091bU, 0x1d83839eU,
+  0x582c2c74U, 0x341a1a2eU, 0x361b1b2dU, 0xdc6e6eb2U, 0xb45a5aeeU, 0x5ba0a0fbU,
+  0xa45252f6U, 0x763b3b4dU, 0xb7d6d661U, 0x7db3b3ceU, 0x5229297bU, 0xdde3e33eU,
+  0x5e2f2f71U, 0x13848497U, 0xa65353f5U, 0xb9d1d168U, 0x00000000U, 0xc1eded2cU,
+  0x40202060U, 0xe3fcfc1fU, 0x79b1b1c8U, 0xb65b5bedU, 0xd46a6abeU, 0x8dcbcb46U,
+  0x67bebed9U, 0x7239394bU, 0x944a4adeU, 0x984c4cd4U, 0xb05858e8U, 0x85cfcf4aU,
+  0xbbd0d06bU, 0xc5efef2aU, 0x4faaaae5U, 0xedfbfb16U, 0x864343c5U, 0x9a4d4dd7U,
+  0x66333355U, 0x11858594U, 0x8a4545cfU, 0xe9f9f910U, 0x04020206U, 0xfe7f7f81U,
+  0xa05050f0U, 0x783c3c44U, 0x259f9fbaU, 0x4ba8a8e3U, 0xa25151f3U, 0x5da3a3feU,
+  0x804040c0U, 0x058f8f8aU, 0x3f9292adU, 0x219d9dbcU, 0x70383848U, 0xf1f5f504U,
+  0x63bcbcdfU, 0x77b6b6c1U, 0xafdada75U, 0x42212163U, 0x20101030U, 0xe5ffff1aU,
+  0xfdf3f30eU, 0xbfd2d26dU, 0x81cdcd4cU, 0x180c0c14U, 0x26131335U, 0xc3ecec2fU,
+  0xbe5f5fe1U, 0x359797a2U, 0x884444ccU, 0x2e171739U, 0x93c4c457U, 0x55a7a7f2U,
+  0xfc7e7e82U, 0x7a3d3d47U, 0xc86464acU, 0xba5d5de7U, 0x3219192bU, 0xe6737395U,
+  0xc06060a0U, 0x19818198U, 0x9e4f4fd1U, 0xa3dcdc7fU, 0x44222266U, 0x542a2a7eU,
+  0x3b9090abU, 0x0b888883U, 0x8c4646caU, 0xc7eeee29U, 0x6bb8b8d3U, 0x2814143cU,
+  0xa7dede79U, 0xbc5e5ee2U, 0x160b0b1dU, 0xaddbdb76U, 0xdbe0e03bU, 0x64323256U,
+  0x743a3a4eU, 0x140a0a1eU, 0x924949dbU, 0x0c06060aU, 0x4824246cU, 0xb85c5ce4U,
+  0x9fc2c25dU, 0xbdd3d36eU, 0x43acacefU, 0xc46262a6U, 0x399191a8U, 0x319595a4U,
+  0xd3e4e437U, 0xf279798bU, 0xd5e7e732U, 0x8bc8c843U, 0x6e373759U, 0xda6d6db7U,
+  0x018d8d8cU, 0xb1d5d564U, 0x9c4e4ed2U, 0x49a9a9e0U, 0xd86c6cb4U, 0xac5656faU,
+  0xf3f4f407U, 0xcfeaea25U, 0xca6565afU, 0xf47a7a8eU, 0x47aeaee9U, 0x10080818U,
+  0x6fbabad5U, 0xf0787888U, 0x4a25256fU, 0x5c2e2e72U, 0x381c1c24U, 0x57a6a6f1U,
+  0x73b4b4c7U, 0x97c6c651U, 0xcbe8e823U, 0xa1dddd7cU, 0xe874749cU, 0x3e1f1f21U,
+  0x964b4bddU, 0x61bdbddcU, 0x0d8b8b86U, 0x0f8a8a85U, 0xe0707090U, 0x7c3e3e42U,
+  0x71b5b5c4U, 0xcc6666aaU, 0x904848d8U, 0x06030305U, 0xf7f6f601U, 0x1c0e0e12U,
+  0xc26161a3U, 0x6a35355fU, 0xae5757f9U, 0x69b9b9d0U, 0x17868691U, 0x99c1c158U,
+  0x3a1d1d27U, 0x279e9eb9U, 0xd9e1e138U, 0xebf8f813U, 0x2b9898b3U, 0x22111133U,
+  0xd26969bbU, 0xa9d9d970U, 0x078e8e89U, 0x339494a7U, 0x2d9b9bb6U, 0x3c1e1e22U,
+  0x15878792U, 0xc9e9e920U, 0x87cece49U, 0xaa5555ffU, 0x50282878U, 0xa5dfdf7aU,
+  0x038c8c8fU, 0x59a1a1f8U, 0x09898980U, 0x1a0d0d17U, 0x65bfbfdaU, 0xd7e6e631U,
+  0x844242c6U, 0xd06868b8U, 0x824141c3U, 0x299999b0U, 0x5a2d2d77U, 0x1e0f0f11U,
+  0x7bb0b0cbU, 0xa85454fcU, 0x6dbbbbd6U, 0x2c16163aU
+};
+
+/** \brief Decryption T-table. Combines InvSubBytes and InvMixColumns for one byte of a
+ *         column. Each entry holds the inverse substituted byte multiplied by
+ *         {0e, 09, 0d, 0b}.
+ */
+static const uint32_t tbxAes256Td[256] =
 {
-    register uint8_t i = 16;
-
-    while (i-- > 0U)
-    {
-        buf[i] = rj_sbox(buf[i]);
-    }
-} /* aes_subBytes */
-
-/* -------------------------------------------------------------------------- */
-static void aes_subBytes_inv(uint8_t *buf)
+  0x51f4a750U, 0x7e416553U, 0x1a17a4c3U, 0x3a275e96U, 0x3bab6bcbU, 0x1f9d45f1U,
+  0xacfa58abU, 0x4be30393U, 0x2030fa55U, 0xad766df6U, 0x88cc7691U, 0xf5024c25U,
+  0x4fe5d7fcU, 0xc52acbd7U, 0x26354480U, 0xb562a38fU, 0xdeb15a49U, 0x25ba1b67U,
+  0x45ea0e98U, 0x5dfec0e1U, 0xc32f7502U, 0x814cf012U, 0x8d4697a3U, 0x6bd3f9c6U,
+  0x038f5fe7U, 0x15929c95U, 0xbf6d7aebU, 0x955259daU, 0xd4be832dU, 0x587421d3U,
+  0x49e06929U, 0x8ec9c844U, 0x75c2896aU, 0xf48e7978U, 0x99583e6bU, 0x27b971ddU,
+  0xbee14fb6U, 0xf088ad17U, 0xc920ac66U, 0x7dce3ab4U, 0x63df4a18U, 0xe51a3182U,
+  0x97513360U, 0x62537f45U, 0xb16477e0U, 0xbb6bae84U, 0xfe81a01cU, 0xf9082b94U,
+  0x70486858U, 0x8f45fd19U, 0x94de6c87U, 0x527bf8b7U, 0xab73d323U, 0x724b02e2U,
+  0xe31f8f57U, 0x6655ab2aU, 0xb2eb2807U, 0x2fb5c203U, 0x86c57b9aU, 0xd33708a5U,
+  0x302887f2U, 0x23bfa5b2U, 0x02036abaU, 0xed16825cU, 0x8acf1c2bU, 0xa779b492U,
+  0xf307f2f0U, 0x4e69e2a1U, 0x65daf4cdU, 0x0605bed5U, 0xd134621fU, 0xc4a6fe8aU,
+  0x342e539dU, 0xa2f355a0U, 0x058ae132U, 0xa4f6eb75U, 0x0b83ec39U, 0x4060efaaU,
+  0x5e719f06U, 0xbd6e1051U, 0x3e218af9U, 0x96dd063dU, 0xdd3e05aeU, 0x4de6bd46U,
+  0x91548db5U, 0x71c45d05U, 0x0406d46fU, 0x605015ffU, 0x1998fb24U, 0xd6bde997U,
+  0x894043ccU, 0x67d99e77U, 0xb0e842bdU, 0x07898b88U, 0xe7195b38U, 0x79c8eedbU,
+  0xa17c0a47U, 0x7c420fe9U, 0xf8841ec9U, 0x00000000U, 0x09808683U, 0x322bed48U,
+  0x1e1170acU, 0x6c5a724eU, 0xfd0efffbU, 0x0f853856U, 0x3daed51eU, 0x362d3927U,
+  0x0a0fd964U, 0x685ca621U, 0x9b5b54d1U, 0x24362e3aU, 0x0c0a67b1U, 0x9357e70fU,
+  0xb4ee96d2U, 0x1b9b919eU, 0x80c0c54fU, 0x61dc20a2U, 0x5a774b69U, 0x1c121a16U,
+  0xe293ba0aU, 0xc0a02ae5U, 0x3c22e043U, 0x121b171dU, 0x0e090d0bU, 0xf28bc7adU,
+  0x2db6a8b9U, 0x141ea9c8U, 0x57f11985U, 0xaf75074cU, 0xee99ddbbU, 0xa37f60fdU,
+  0xf701269fU, 0x5c72f5bcU, 0x44663bc5U, 0x5bfb7e34U, 0x8b432976U, 0xcb23c6dcU,
+  0xb6edfc68U, 0xb8e4f163U, 0xd731dccaU, 0x42638510U, 0x13972240U, 0x84c61120U,
+  0x854a247dU, 0xd2bb3df8U, 0xaef93211U, 0xc729a16dU, 0x1d9e2f4bU, 0xdcb230f3U,
+  0x0d8652ecU, 0x77c1e3d0U, 0x2bb3166cU, 0xa970b999U, 0x119448faU, 0x47e96422U,
+  0xa8fc8cc4U, 0xa0f03f1aU, 0x567d2cd8U, 0x223390efU, 0x87494ec7U, 0xd938d1c1U,
+  0x8ccaa2feU, 0x98d40b36U, 0xa6f581cfU, 0xa57ade28U, 0xdab78e26U, 0x3fadbfa4U,
+  0x2c3a9de4U, 0x5078920dU, 0x6a5fcc9bU, 0x547e4662U, 0xf68d13c2U, 0x90d8b8e8U,
+  0x2e39f75eU, 0x82c3aff5U, 0x9f5d80beU, 0x69d0937cU, 0x6fd52da9U, 0xcf2512b3U,
+  0xc8ac993bU, 0x10187da7U, 0xe89c636eU, 0xdb3bbb7bU, 0xcd267809U, 0x6e5918f4U,
+  0xec9ab701U, 0x834f9aa8U, 0xe6956e65U, 0xaaffe67eU, 0x21bccf08U, 0xef15e8e6U,
+  0xbae79bd9U, 0x4a6f36ceU, 0xea9f09d4U, 0x29b07cd6U, 0x31a4b2afU, 0x2a3f2331U,
+  0xc6a59430U, 0x35a266c0U, 0x744ebc37U, 0xfc82caa6U, 0xe090d0b0U, 0x33a7d815U,
+  0xf104984aU, 0x41ecdaf7U, 0x7fcd500eU, 0x1791f62fU, 0x764dd68dU, 0x43efb04dU,
+  0xccaa4d54U, 0xe49604dfU, 0x9ed1b5e3U, 0x4c6a881bU, 0xc12c1fb8U, 0x4665517fU,
+  0x9d5eea04U, 0x018c355dU, 0xfa877473U, 0xfb0b412eU, 0xb3671d5aU, 0x92dbd252U,
+  0xe9105633U, 0x6dd64713U, 0x9ad7618cU, 0x37a10c7aU, 0x59f8148eU, 0xeb133c89U,
+  0xcea927eeU, 0xb761c935U, 0xe11ce5edU, 0x7a47b13cU, 0x9cd2df59U, 0x55f2733fU,
+  0x1814ce79U, 0x73c737bfU, 0x53f7cdeaU, 0x5ffdaa5bU, 0xdf3d6f14U, 0x7844db86U,
+  0xcaaff381U, 0xb968c43eU, 0x3824342cU, 0xc2a3405fU, 0x161dc372U, 0xbce2250cU,
+  0x283c498bU, 0xff0d9541U, 0x39a80171U, 0x080cb3deU, 0xd8b4e49cU, 0x6456c190U,
+  0x7bcb8461U, 0xd532b670U, 0x486c5c74U, 0xd0b85742U
+};
+
+/** \brief Round constants for the key expansion. */
+static const uint32_t tbxAes256RCon[7] =
 {
-    register uint8_t i = 16;
-
-    while (i-- > 0U)
-    {
-        buf[i] = rj_sbox_inv(buf[i]);
-    }
-} /* aes_subBytes_inv */
-
-/* -------------------------------------------------------------------------- */
-static void aes_addRoundKey(uint8_t *buf, uint8_t const *key)
+  0x01000000U, 0x02000000U, 0x04000000U, 0x08000000U,
+  0x10000000U, 0x20000000U, 0x40000000U
+};
+
+
+/************************************************************************************//**
+** \brief     Expands the 256-bit key into the key schedule for encryption.
+** \param     roundKeys Array with TBX_AES256_ROUND_KEYS_NUM words for storing the key
+**            schedule.
+** \param     key The 256-bit key as an array of 32 bytes.
+**
+****************************************************************************************/
+void TbxAes256ExpandEncKey(uint32_t       * roundKeys,
+                           uint8_t  const * key)
 {
-    register uint8_t i = 16;
-
-    while (i-- > 0U)
-    {
-        buf[i] ^= key[i];
-    }
-} /* aes_addRoundKey */
-
-/* -------------------------------------------------------------------------- */
-static void aes_addRoundKey_cpy(uint8_t *buf, uint8_t const *key, uint8_t *cpk)
-{
-    register uint8_t i = 16U;
-
-    while (i-- > 0U)
+  uint32_t temp;
+
+  /* The first round keys are the key itself. */
+  for (uint8_t idx = 0U; idx < TBX_AES256_KEY_WORDS; idx++)
+  {
+    roundKeys[idx] = TbxAes256Load(&key[idx * 4U]);
+  }
+  /* Derive the other round keys. */
+  for (uint8_t idx = TBX_AES256_KEY_WORDS; idx < TBX_AES256_ROUND_KEYS_NUM; idx++)
+  {
+    temp = roundKeys[idx - 1U];
+    /* At the start of each key length, rotate, substitute and add the round constant. */
+    if ((idx % TBX_AES256_KEY_WORDS) == 0U)
     {
-        cpk[i] = key[i];
-        buf[i] ^= cpk[i];
-        cpk[16U + i] = key[16U + i];
+      temp = TbxAes256SubWord(TBX_AES256_ROR(temp, 24U)) ^
+             tbxAes256RCon[(idx / TBX_AES256_KEY_WORDS) - 1U];
     }
-} /* aes_addRoundKey_cpy */
-
-
-/* -------------------------------------------------------------------------- */
-static void aes_shiftRows(uint8_t *buf)
-{
-    register uint8_t i; /* to make it potentially parallelable :) */
-    register uint8_t j;
-
-    i       = buf[1];
-    buf[1]  = buf[5];
-    buf[5]  = buf[9];
-    buf[9]  = buf[13];
-    buf[13] = i;
-    i       = buf[10];
-    buf[10] = buf[2];
-    buf[2]  = i;
-    j       = buf[3];
-    buf[3]  = buf[15];
-    buf[15] = buf[11];
-    buf[11] = buf[7];
-    buf[7]  = j;
-    j       = buf[14];
-    buf[14] = buf[6];
-    buf[6]  = j;
-} /* aes_shiftRows */
-
-/* -------------------------------------------------------------------------- */
-static void aes_shiftRows_inv(uint8_t *buf)
-{
-    register uint8_t i; /* same as above :) */
-    register uint8_t j;
-
-    i       = buf[1];
-    buf[1]  = buf[13];
-    buf[13] = buf[9];
-    buf[9]  = buf[5];
-    buf[5]  = i;
-    i       = buf[2];
-    buf[2]  = buf[10];
-    buf[10] = i;
-    j       = buf[3];
-    buf[3]  = buf[7];
-    buf[7]  = buf[11];
-    buf[11] = buf[15];
-    buf[15] = j;
-    j       = buf[6];
-    buf[6]  = buf[14];
-    buf[14] = j;
-} /* aes_shiftRows_inv */
-
-/* -------------------------------------------------------------------------- */
-static void aes_mixColumns(uint8_t *buf)
-{
-    register uint8_t i;
-
-    for (i = 0U; i < 16U; i += 4U)
+    /* Halfway a 256-bit key length, only substitute. */
+    else if ((idx % TBX_AES256_KEY_WORDS) == 4U)
     {
-        register uint8_t a;
-        register uint8_t b;
-        register uint8_t c;
-        register uint8_t d;
-        register uint8_t e;
-
-        a = buf[i];
-        b = buf[i + 1U];
-        c = buf[i + 2U];
-        d = buf[i + 3U];
-        e = a ^ b ^ c ^ d;
-        buf[i] ^= e ^ rj_xtime(a ^ b);
-        buf[i + 1U] ^= e ^ rj_xtime(b ^ c);
-        buf[i + 2U] ^= e ^ rj_xtime(c ^ d);
-        buf[i + 3U] ^= e ^ rj_xtime(d ^ a);
+      temp = TbxAes256SubWord(temp);
     }
-} /* aes_mixColumns */
-
-/* -------------------------------------------------------------------------- */
-static void aes_mixColumns_inv(uint8_t *buf)
-{
-    register uint8_t i;
-
-    for (i = 0U; i < 16U; i += 4U)
+    else
     {
-        register uint8_t a;
-        register uint8_t b;
-        register uint8_t c;
-        register uint8_t d;
-        register uint8_t e;
-        register uint8_t x;
-        register uint8_t y;
-        register uint8_t z;
-
-        a = buf[i];
-        b = buf[i + 1U];
-        c = buf[i + 2U];
-        d = buf[i + 3U];
-        e = a ^ b ^ c ^ d;
-        z = rj_xtime(e);
-        x = e ^ rj_xtime(rj_xtime(z ^ a ^ c));
-        y = e ^ rj_xtime(rj_xtime(z ^ b ^ d));
-        buf[i] ^= x ^ rj_xtime(a ^ b);
-        buf[i + 1U] ^= y ^ rj_xtime(b ^ c);
-        buf[i + 2U] ^= x ^ rj_xtime(c ^ d);
-        buf[i + 3U] ^= y ^ rj_xtime(d ^ a);
+      /* Nothing else to do. */
     }
-} /* aes_mixColumns_inv */
-
-/* -------------------------------------------------------------------------- */
-static void aes_expandEncKey(uint8_t *k, uint8_t *rc)
+    roundKeys[idx] = roundKeys[idx - TBX_AES256_KEY_WORDS] ^ temp;
+  }
+} /*** end of TbxAes256ExpandEncKey ***/
+
+
+/************************************************************************************//**
+** \brief     Expands the 256-bit key into the key schedule for decryption. This is the
+**            encryption key schedule in reverse round order, with InvMixColumns applied
+**            to the round keys of the inner rounds. It enables decryption with the same
+**            table driven round structure as encryption.
+** \param     roundKeys Array with TBX_AES256_ROUND_KEYS_NUM words for storing the key
+**            schedule.
+** \param     key The 256-bit key as an array of 32 bytes.
+**
+****************************************************************************************/
+void TbxAes256ExpandDecKey(uint32_t       * roundKeys,
+                           uint8_t  const * key)
 {
-    register uint8_t i;
-
-    k[0U] ^= rj_sbox(k[29U]) ^ (*rc);
-    k[1U] ^= rj_sbox(k[30U]);
-    k[2U] ^= rj_sbox(k[31U]);
-    k[3U] ^= rj_sbox(k[28U]);
-    *rc = rj_xtime( *rc);
-
-    for(i = 4U; i < 16U; i += 4U)
+  uint32_t temp;
+  uint8_t  first;
+  uint8_t  last;
+
+  /* Start with the encryption key schedule. */
+  TbxAes256ExpandEncKey(roundKeys, key);
+  /* Reverse the order of the round keys. */
+  for (first = 0U, last = (uint8_t)(TBX_AES256_ROUND_KEYS_NUM - 4U); first < last;
+       first += 4U, last -= 4U)
+  {
+    for (uint8_t idx = 0U; idx < 4U; idx++)
     {
-        k[i]      ^= k[i - 4U];
-        k[i + 1U] ^= k[i - 3U];
-        k[i + 2U] ^= k[i - 2U];
-        k[i + 3U] ^= k[i - 1U];
+      temp = roundKeys[first + idx];
+      roundKeys[first + idx] = roundKeys[last + idx];
+      roundKeys[last + idx] = temp;
     }
-    k[16U] ^= rj_sbox(k[12U]);
-    k[17U] ^= rj_sbox(k[13U]);
-    k[18U] ^= rj_sbox(k[14U]);
-    k[19U] ^= rj_sbox(k[15U]);
-
-    for(i = 20U; i < 32U; i += 4U)
-    {
-        k[i]      ^= k[i - 4U];
-        k[i + 1U] ^= k[i - 3U];
-        k[i + 2U] ^= k[i - 2U];
-        k[i + 3U] ^= k[i - 1U];
-    }
-} /* aes_expandEncKey */
-
-/* -------------------------------------------------------------------------- */
-static void aes_expandDecKey(uint8_t *k, uint8_t *rc)
+  }
+  /* Apply InvMixColumns to all round keys, except the first and the last one. The
+   * substitution box cancels out the inverse substitution in the T-table.
+   */
+  for (uint8_t idx = 4U; idx < (TBX_AES256_ROUND_KEYS_NUM - 4U); idx++)
+  {
+    temp = roundKeys[idx];
+    roundKeys[idx] = tbxAes256Td[tbxAes256SBox[TBX_AES256_BYTE(temp, 0U)]] ^
+      TBX_AES256_ROR(tbxAes256Td[tbxAes256SBox[TBX_AES256_BYTE(temp, 1U)]], 8U) ^
+      TBX_AES256_ROR(tbxAes256Td[tbxAes256SBox[TBX_AES256_BYTE(temp, 2U)]], 16U) ^
+      TBX_AES256_ROR(tbxAes256Td[tbxAes256SBox[TBX_AES256_BYTE(temp, 3U)]], 24U);
+  }
+} /*** end of TbxAes256ExpandDecKey ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts one block of 16 bytes.
+** \param     roundKeys The key schedule for encryption.
+** \param     input The 16 bytes to encrypt.
+** \param     output Storage for the 16 encrypted bytes. It is okay if it is the same as
+**            input.
+**
+****************************************************************************************/
+void TbxAes256EncryptBlock(uint32_t const * roundKeys,
+                           uint8_t  const * input,
+                           uint8_t        * output)
 {
-    uint8_t i;
-    uint8_t mask = 0U;
-
-    for(i = 28U; i > 16U; i -= 4U)
-    {
-        k[i]      ^= k[i - 4U];
-        k[i + 1U] ^= k[i - 3U];
-        k[i + 2U] ^= k[i - 2U];
-        k[i + 3U] ^= k[i - 1U];
-    }
-
-    k[16U] ^= rj_sbox(k[12U]);
-    k[17U] ^= rj_sbox(k[13U]);
-    k[18U] ^= rj_sbox(k[14U]);
-    k[19U] ^= rj_sbox(k[15U]);
-
-    for(i = 12U; i > 0U; i -= 4U)
-    {
-        k[i] ^= k[i - 4U];
-        k[i + 1U] ^= k[i - 3U];
-        k[i + 2U] ^= k[i - 2U];
-        k[i + 3U] ^= k[i - 1U];
-    }
-
-    if (( (*rc) & 1U) > 0U)
-    {
-      mask = 0x8dU;
-    }
-    *rc = (*rc >> 1U) ^ mask;
-
-    k[0U] ^= rj_sbox(k[29U]) ^ (*rc);
-    k[1U] ^= rj_sbox(k[30U]);
-    k[2U] ^= rj_sbox(k[31U]);
-    k[3U] ^= rj_sbox(k[28U]);
-} /* aes_expandDecKey */
-
-
-/* -------------------------------------------------------------------------- */
-void tbx_aes256_init(tbx_aes256_context *ctx, uint8_t const *k)
+  uint32_t         s0, s1, s2, s3;
+  uint32_t         t0, t1, t2, t3;
+  uint32_t const * rk = roundKeys;
+
+  /* Load the state and add the initial round key. */
+  s0 = TbxAes256Load(&input[0U])  ^ rk[0U];
+  s1 = TbxAes256Load(&input[4U])  ^ rk[1U];
+  s2 = TbxAes256Load(&input[8U])  ^ rk[2U];
+  s3 = TbxAes256Load(&input[12U]) ^ rk[3U];
+  /* Perform all rounds, except the last one. Each column takes one table lookup per
+   * byte, which combines SubBytes, ShiftRows and MixColumns.
+   */
+  for (uint8_t round = 1U; round < TBX_AES256_ROUNDS; round++)
+  {
+    rk = &rk[4U];
+    t0 = tbxAes256Te[TBX_AES256_BYTE(s0, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s1, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s2, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s3, 3U)], 24U) ^ rk[0U];
+    t1 = tbxAes256Te[TBX_AES256_BYTE(s1, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s2, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s3, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s0, 3U)], 24U) ^ rk[1U];
+    t2 = tbxAes256Te[TBX_AES256_BYTE(s2, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s3, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s0, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s1, 3U)], 24U) ^ rk[2U];
+    t3 = tbxAes256Te[TBX_AES256_BYTE(s3, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s0, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s1, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Te[TBX_AES256_BYTE(s2, 3U)], 24U) ^ rk[3U];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+  /* The last round has no MixColumns, so it uses the substitution box. */
+  rk = &rk[4U];
+  t0 = ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s0, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s1, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s2, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s3, 3U)]) ^ rk[0U];
+  t1 = ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s1, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s2, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s3, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s0, 3U)]) ^ rk[1U];
+  t2 = ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s2, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s3, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s0, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s1, 3U)]) ^ rk[2U];
+  t3 = ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s3, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s0, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s1, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(s2, 3U)]) ^ rk[3U];
+  /* Store the result. */
+  TbxAes256Store(&output[0U], t0);
+  TbxAes256Store(&output[4U], t1);
+  TbxAes256Store(&output[8U], t2);
+  TbxAes256Store(&output[12U], t3);
+} /*** end of TbxAes256EncryptBlock ***/
+
+
+/************************************************************************************//**
+** \brief     Decrypts one block of 16 bytes.
+** \param     roundKeys The key schedule for decryption.
+** \param     input The 16 bytes to decrypt.
+** \param     output Storage for the 16 decrypted bytes. It is okay if it is the same as
+**            input.
+**
+****************************************************************************************/
+void TbxAes256DecryptBlock(uint32_t const * roundKeys,
+                           uint8_t  const * input,
+                           uint8_t        * output)
 {
-    uint8_t rcon = 1;
-    register uint8_t i;
-
-    for (i = 0U; i < sizeof(ctx->key); i++)
-    {
-        ctx->deckey[i] = k[i];
-        ctx->enckey[i] = k[i];
-    }
-    for (i = 7U; i > 0U; --i)
-    {
-        aes_expandEncKey(ctx->deckey, &rcon);
-    }
-} /* tbx_aes256_init */
-
-/* -------------------------------------------------------------------------- */
-void tbx_aes256_done(tbx_aes256_context *ctx)
+  uint32_t         s0, s1, s2, s3;
+  uint32_t         t0, t1, t2, t3;
+  uint32_t const * rk = roundKeys;
+
+  /* Load the state and add the initial round key. */
+  s0 = TbxAes256Load(&input[0U])  ^ rk[0U];
+  s1 = TbxAes256Load(&input[4U])  ^ rk[1U];
+  s2 = TbxAes256Load(&input[8U])  ^ rk[2U];
+  s3 = TbxAes256Load(&input[12U]) ^ rk[3U];
+  /* Perform all rounds, except the last one. Each column takes one table lookup per
+   * byte, which combines InvSubBytes, InvShiftRows and InvMixColumns.
+   */
+  for (uint8_t round = 1U; round < TBX_AES256_ROUNDS; round++)
+  {
+    rk = &rk[4U];
+    t0 = tbxAes256Td[TBX_AES256_BYTE(s0, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s3, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s2, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s1, 3U)], 24U) ^ rk[0U];
+    t1 = tbxAes256Td[TBX_AES256_BYTE(s1, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s0, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s3, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s2, 3U)], 24U) ^ rk[1U];
+    t2 = tbxAes256Td[TBX_AES256_BYTE(s2, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s1, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s0, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s3, 3U)], 24U) ^ rk[2U];
+    t3 = tbxAes256Td[TBX_AES256_BYTE(s3, 0U)] ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s2, 1U)], 8U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s1, 2U)], 16U) ^
+         TBX_AES256_ROR(tbxAes256Td[TBX_AES256_BYTE(s0, 3U)], 24U) ^ rk[3U];
+    s0 = t0;
+    s1 = t1;
+    s2 = t2;
+    s3 = t3;
+  }
+  /* The last round has no InvMixColumns, so it uses the inverse substitution box. */
+  rk = &rk[4U];
+  t0 = ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s0, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s3, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s2, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s1, 3U)]) ^ rk[0U];
+  t1 = ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s1, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s0, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s3, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s2, 3U)]) ^ rk[1U];
+  t2 = ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s2, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s1, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s0, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s3, 3U)]) ^ rk[2U];
+  t3 = ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s3, 0U)] << 24U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s2, 1U)] << 16U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s1, 2U)] << 8U) ^
+       ((uint32_t)tbxAes256SBoxInv[TBX_AES256_BYTE(s0, 3U)]) ^ rk[3U];
+  /* Store the result. */
+  TbxAes256Store(&output[0U], t0);
+  TbxAes256Store(&output[4U], t1);
+  TbxAes256Store(&output[8U], t2);
+  TbxAes256Store(&output[12U], t3);
+} /*** end of TbxAes256DecryptBlock ***/
+
+
+/************************************************************************************//**
+** \brief     Loads 4 bytes into a 32-bit word, with the first byte as the most
+**            significant one. Works byte wise, so the bytes do not have to be aligned.
+** \param     bytes Pointer to the 4 bytes.
+** \return    The 32-bit word.
+**
+****************************************************************************************/
+static uint32_t TbxAes256Load(uint8_t const * bytes)
 {
-    register uint8_t i;
-
-    for (i = 0U; i < sizeof(ctx->key); i++)
-    {
-        ctx->key[i]    = 0U;
-        ctx->enckey[i] = 0U;
-        ctx->deckey[i] = 0U;
-    }
-} /* tbx_aes256_done */
-
-/* -------------------------------------------------------------------------- */
-void tbx_aes256_encrypt_ecb(tbx_aes256_context *ctx, uint8_t *buf)
+  return ((uint32_t)bytes[0U] << 24U) | ((uint32_t)bytes[1U] << 16U) |
+         ((uint32_t)bytes[2U] << 8U)  | ((uint32_t)bytes[3U]);
+} /*** end of TbxAes256Load ***/
+
+
+/************************************************************************************//**
+** \brief     Stores a 32-bit word into 4 bytes, with the most significant byte first.
+** \param     bytes Pointer to the 4 bytes.
+** \param     word The 32-bit word.
+**
+****************************************************************************************/
+static void TbxAes256Store(uint8_t * bytes,
+                           uint32_t  word)
 {
-    uint8_t i;
-    uint8_t rcon = 1U;
-
-    aes_addRoundKey_cpy(buf, ctx->enckey, ctx->key);
-    for (i = 1U; i < 14U; ++i)
-    {
-        aes_subBytes(buf);
-        aes_shiftRows(buf);
-        aes_mixColumns(buf);
-        if ((i & 1U) > 0U)
-        {
-            aes_addRoundKey( buf, &ctx->key[16U]);
-        }
-        else
-        {
-            aes_expandEncKey(ctx->key, &rcon);
-            aes_addRoundKey(buf, ctx->key);
-        }
-    }
-    aes_subBytes(buf);
-    aes_shiftRows(buf);
-    aes_expandEncKey(ctx->key, &rcon);
-    aes_addRoundKey(buf, ctx->key);
-} /* tbx_aes256_encrypt */
-
-/* -------------------------------------------------------------------------- */
-void tbx_aes256_decrypt_ecb(tbx_aes256_context *ctx, uint8_t *buf)
+  bytes[0U] = TBX_AES256_BYTE(word, 0U);
+  bytes[1U] = TBX_AES256_BYTE(word, 1U);
+  bytes[2U] = TBX_AES256_BYTE(word, 2U);
+  bytes[3U] = TBX_AES256_BYTE(word, 3U);
+} /*** end of TbxAes256Store ***/
+
+
+/************************************************************************************//**
+** \brief     Applies the substitution box to each byte of a 32-bit word.
+** \param     word The 32-bit word.
+** \return    The substituted word.
+**
+****************************************************************************************/
+static uint32_t TbxAes256SubWord(uint32_t word)
 {
-    uint8_t i;
-    uint8_t rcon = 0x80U;
+  return ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(word, 0U)] << 24U) |
+         ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(word, 1U)] << 16U) |
+         ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(word, 2U)] << 8U)  |
+         ((uint32_t)tbxAes256SBox[TBX_AES256_BYTE(word, 3U)]);
+} /*** end of TbxAes256SubWord ***/
 
-    aes_addRoundKey_cpy(buf, ctx->deckey, ctx->key);
-    aes_shiftRows_inv(buf);
-    aes_subBytes_inv(buf);
 
-    for (i = 13U; i > 0U; --i)
-    {
-        if ((i & 1U) > 0U)
-        {
-            aes_expandDecKey(ctx->key, &rcon);
-            aes_addRoundKey(buf, &ctx->key[16U]);
-        }
-        else
-        {
-            aes_addRoundKey(buf, ctx->key);
-        }
-        aes_mixColumns_inv(buf);
-        aes_shiftRows_inv(buf);
-        aes_subBytes_inv(buf);
-    }
-    aes_addRoundKey( buf, ctx->key);
-} /* tbx_aes256_decrypt */
+/*********************************** end of tbx_aes256.c *******************************/
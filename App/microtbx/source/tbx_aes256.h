@@ -1,39 +1,74 @@
-/*  
-*   Byte-oriented AES-256 implementation.
-*   All lookup tables replaced with 'on the fly' calculations. 
+/************************************************************************************//**
+* \file         tbx_aes256.h
+* \brief        AES256 block cipher header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
 *
-*   Copyright (c) 2007-2009 Ilya O. Levin, www.literatecode.com
-*   Other contributors: Hal Finney, Frank Voorburg (MISRA compliance)
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
 *
-*   Permission to use, copy, modify, and distribute this software for any
-*   purpose with or without fee is hereby granted, provided that the above
-*   copyright notice and this permission notice appear in all copies.
+* SPDX-License-Identifier: MIT
 *
-*   THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
-*   WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
-*   MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
-*   ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
-*   WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
-*   ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
-*   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
-*/
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBX_AES256_H
+#define TBX_AES256_H
 
 #ifdef __cplusplus
-extern "C" { 
+extern "C" {
 #endif
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Number of 32-bit words in an AES256 key schedule. This is the initial round
+ *         key plus one round key for each of the 14 rounds, with 4 words per round key.
+ */
+#define TBX_AES256_ROUND_KEYS_NUM                (60U)
+
 
-    typedef struct {
-        uint8_t key[32]; 
-        uint8_t enckey[32]; 
-        uint8_t deckey[32];
-    } tbx_aes256_context; 
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+void TbxAes256ExpandEncKey(uint32_t       * roundKeys,
+                           uint8_t  const * key);
 
+void TbxAes256ExpandDecKey(uint32_t       * roundKeys,
+                           uint8_t  const * key);
+
+void TbxAes256EncryptBlock(uint32_t const * roundKeys,
+                           uint8_t  const * input,
+                           uint8_t        * output);
+
+void TbxAes256DecryptBlock(uint32_t const * roundKeys,
+                           uint8_t  const * input,
+                           uint8_t        * output);
 
-    void tbx_aes256_init(tbx_aes256_context *ctx, uint8_t const *k);
-    void tbx_aes256_done(tbx_aes256_context *ctx);
-    void tbx_aes256_encrypt_ecb(tbx_aes256_context *ctx, uint8_t *buf);
-    void tbx_aes256_decrypt_ecb(tbx_aes256_context *ctx, uint8_t *buf);
 
 #ifdef __cplusplus
 }
 #endif
+
+#endif /* TBX_AES256_H */
+/*********************************** end of tbx_aes256.h *******************************/
@@ -0,0 +1,363 @@
+/************************************************************************************//**
+* \file         tbx_arena.c
+* \brief        Arena allocator source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX global header             */
+
+
+/************************************************************************************//**
+** \brief     Initializes an arena that allocates from a buffer provided by the caller,
+**            for example a statically allocated array.
+** \param     arena Pointer to the arena to initialize.
+** \param     buffer Pointer to the buffer that the arena allocates memory from.
+** \param     size Size of the buffer in bytes.
+**
+****************************************************************************************/
+void TbxArenaInit(tTbxArena * arena,
+                  void      * buffer,
+                  size_t      size)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((arena != NULL) && (buffer != NULL) && (size > 0U));
+
+  /* Only continue if the parameters are valid. */
+  if ( (arena != NULL) && (buffer != NULL) && (size > 0U) )
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* Link the buffer and start out with nothing allocated. */
+    arena->bufferPtr = (uint8_t *)buffer;
+    arena->size = size;
+    arena->offset = 0U;
+    arena->peak = 0U;
+    arena->blockPtr = NULL;
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxArenaInit ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes an arena that allocates from a memory pool block. The block is
+**            allocated with TbxMemPoolAllocateAuto(), so the memory pool is created or
+**            extended when needed. Call TbxArenaDelete() to give the block back.
+** \param     arena Pointer to the arena to initialize.
+** \param     size Size of the arena's buffer in bytes.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxArenaCreate(tTbxArena * arena,
+                       size_t      size)
+{
+  uint8_t   result = TBX_ERROR;
+  void    * blockPtr;
+
+  /* Verify parameters. */
+  TBX_ASSERT((arena != NULL) && (size > 0U));
+
+  /* Only continue if the parameters are valid. */
+  if ( (arena != NULL) && (size > 0U) )
+  {
+    /* Attempt to allocate the buffer from a memory pool. */
+    blockPtr = TbxMemPoolAllocateAuto(size);
+    /* Only continue if the allocation was successful. */
+    if (blockPtr != NULL)
+    {
+      /* Initialize the arena with the block as its buffer. */
+      TbxArenaInit(arena, blockPtr, size);
+      /* Store the block, such that it can be released again upon deletion. */
+      arena->blockPtr = blockPtr;
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxArenaCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Deletes an arena. If its buffer is a memory pool block, it is given back to
+**            the memory pool. Afterwards, all memory that was allocated from the arena is
+**            no longer valid.
+** \param     arena Pointer to the arena to operate on.
+**
+****************************************************************************************/
+void TbxArenaDelete(tTbxArena * arena)
+{
+  void * blockPtr;
+
+  /* Verify parameters. */
+  TBX_ASSERT(arena != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (arena != NULL)
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* Store the block pointer and detach the buffer from the arena. */
+    blockPtr = arena->blockPtr;
+    arena->bufferPtr = NULL;
+    arena->size = 0U;
+    arena->offset = 0U;
+    arena->blockPtr = NULL;
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+    /* Give the block back to the memory pool, if the arena owned one. */
+    if (blockPtr != NULL)
+    {
+      TbxMemPoolRelease(blockPtr);
+    }
+  }
+} /*** end of TbxArenaDelete ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates the desired number of bytes from the arena. The address is
+**            aligned to the address size.
+** \param     arena Pointer to the arena to operate on.
+** \param     size The number of bytes to allocate.
+** \return    Pointer to the start of the newly allocated memory if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+void * TbxArenaAllocate(tTbxArena * arena,
+                        size_t      size)
+{
+  /* Allocate with the default alignment, which is the address size. */
+  return TbxArenaAllocateAligned(arena, size, sizeof(void *));
+} /*** end of TbxArenaAllocate ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates the desired number of bytes from the arena, at an address that is
+**            aligned to the specified number of bytes.
+** \param     arena Pointer to the arena to operate on.
+** \param     size The number of bytes to allocate.
+** \param     alignment Alignment of the address in bytes. Must be a power of two.
+** \return    Pointer to the start of the newly allocated memory if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+void * TbxArenaAllocateAligned(tTbxArena * arena,
+                               size_t      size,
+                               size_t      alignment)
+{
+  void      * result = NULL;
+  uintptr_t   freeAddr;
+  size_t      gap;
+
+  /* Verify parameters. */
+  TBX_ASSERT((arena != NULL) && (size > 0U));
+  TBX_ASSERT((alignment > 0U) && ((alignment & (alignment - 1U)) == 0U));
+
+  /* Only continue if the parameters are valid. */
+  if ( (arena != NULL) && (size > 0U) && 
+       (alignment > 0U) && ((alignment & (alignment - 1U)) == 0U) )
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* Only continue if the arena has a buffer. */
+    if (arena->bufferPtr != NULL)
+    {
+      /* Determine the number of bytes to skip to reach the alignment. */
+      freeAddr = (uintptr_t)&arena->bufferPtr[arena->offset];
+      gap = (size_t)(((freeAddr + (alignment - 1U)) & ~(alignment - 1U)) - freeAddr);
+      /* Is there enough space left in the arena for this allocation request? */
+      if ( (gap <= (arena->size - arena->offset)) && 
+           (size <= ((arena->size - arena->offset) - gap)) )
+      {
+        /* Set the address for the newly allocated memory. */
+        result = &arena->bufferPtr[arena->offset + gap];
+        /* Perform the actual allocation by moving the offset forward. */
+        arena->offset += gap + size;
+        /* Keep track of the highest number of allocated bytes. */
+        if (arena->offset > arena->peak)
+        {
+          arena->peak = arena->offset;
+        }
+      }
+    }
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxArenaAllocateAligned ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the current allocation state of the arena. It marks the start of a
+**            scope. Pass it to TbxArenaRelease() at the end of the scope, to release all
+**            memory that was allocated inside the scope. Scopes can be nested.
+** \param     arena Pointer to the arena to operate on.
+** \return    The mark.
+**
+****************************************************************************************/
+tTbxArenaMark TbxArenaGetMark(tTbxArena const * arena)
+{
+  tTbxArenaMark result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(arena != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (arena != NULL)
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* The mark is the current allocation offset. */
+    result = arena->offset;
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxArenaGetMark ***/
+
+
+/************************************************************************************//**
+** \brief     Releases all memory that was allocated from the arena, after the mark was
+**            obtained. Marks of nested scopes must be released in reverse order.
+** \param     arena Pointer to the arena to operate on.
+** \param     mark Mark that was obtained with TbxArenaGetMark().
+**
+****************************************************************************************/
+void TbxArenaRelease(tTbxArena     * arena,
+                     tTbxArenaMark   mark)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(arena != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (arena != NULL)
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* Sanity check. The mark cannot be beyond the allocated memory, which happens when
+     * an outer scope was already released.
+     */
+    TBX_ASSERT(mark <= arena->offset);
+    /* Only continue if the sanity check passed. */
+    if (mark <= arena->offset)
+    {
+      /* Release the memory by moving the offset back to the mark. */
+      arena->offset = mark;
+    }
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxArenaRelease ***/
+
+
+/************************************************************************************//**
+** \brief     Releases all memory that was allocated from the arena.
+** \param     arena Pointer to the arena to operate on.
+**
+****************************************************************************************/
+void TbxArenaReset(tTbxArena * arena)
+{
+  /* Release back to the very start of the arena. */
+  TbxArenaRelease(arena, 0U);
+} /*** end of TbxArenaReset ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the number of bytes that are still available in the arena. Note
+**            that an aligned allocation might need a few more bytes than requested.
+** \param     arena Pointer to the arena to operate on.
+** \return    Number of free bytes in the arena.
+**
+****************************************************************************************/
+size_t TbxArenaGetFree(tTbxArena const * arena)
+{
+  size_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(arena != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (arena != NULL)
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* Determine the number of bytes after the allocation offset. */
+    result = arena->size - arena->offset;
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxArenaGetFree ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the highest number of bytes that were allocated from the arena at
+**            the same time. Useful for tuning the size of the arena.
+** \param     arena Pointer to the arena to operate on.
+** \return    Highest number of allocated bytes.
+**
+****************************************************************************************/
+size_t TbxArenaGetPeak(tTbxArena const * arena)
+{
+  size_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(arena != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (arena != NULL)
+  {
+    /* Obtain mutual exclusive access to the arena. */
+    TbxCriticalSectionEnter();
+    /* Read the highest number of allocated bytes. */
+    result = arena->peak;
+    /* Release mutual exclusive access of the arena. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxArenaGetPeak ***/
+
+
+/*********************************** end of tbx_arena.c ********************************/
@@ -0,0 +1,108 @@
+/************************************************************************************//**
+* \file         tbx_arena.h
+* \brief        Arena allocator header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBX_ARENA_H
+#define TBX_ARENA_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Layout of an arena. Memory is allocated from its buffer by simply moving the
+ *         allocation offset forward. All memory allocated after a mark is released at
+ *         once by moving the offset back to the mark. Note that its elements should be
+ *         considered private and only be accessed internally by this arena module.
+ */
+typedef struct
+{
+  /** \brief Pointer to the start of the arena's buffer. */
+  uint8_t * bufferPtr;
+  /** \brief Size of the arena's buffer in bytes. */
+  size_t    size;
+  /** \brief Number of bytes from the start of the buffer that are allocated. */
+  size_t    offset;
+  /** \brief Highest number of bytes that were allocated since initialization. */
+  size_t    peak;
+  /** \brief Pointer to the memory pool block that backs the buffer, if it was allocated
+   *         by TbxArenaCreate(). NULL if the arena uses a buffer from the caller.
+   */
+  void    * blockPtr;
+} tTbxArena;
+
+/** \brief Allocation state of an arena, obtained with TbxArenaGetMark(). Passing it to
+ *         TbxArenaRelease() releases everything that was allocated after it.
+ */
+typedef size_t tTbxArenaMark;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+void          TbxArenaInit            (tTbxArena       * arena,
+                                       void            * buffer,
+                                       size_t            size);
+
+uint8_t       TbxArenaCreate          (tTbxArena       * arena,
+                                       size_t            size);
+
+void          TbxArenaDelete          (tTbxArena       * arena);
+
+void        * TbxArenaAllocate        (tTbxArena       * arena,
+                                       size_t            size);
+
+void        * TbxArenaAllocateAligned (tTbxArena       * arena,
+                                       size_t            size,
+                                       size_t            alignment);
+
+tTbxArenaMark TbxArenaGetMark         (tTbxArena const * arena);
+
+void          TbxArenaRelease         (tTbxArena       * arena,
+                                       tTbxArenaMark     mark);
+
+void          TbxArenaReset           (tTbxArena       * arena);
+
+size_t        TbxArenaGetFree         (tTbxArena const * arena);
+
+size_t        TbxArenaGetPeak         (tTbxArena const * arena);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBX_ARENA_H */
+/*********************************** end of tbx_arena.h ********************************/
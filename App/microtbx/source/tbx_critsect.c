@@ -43,6 +43,13 @@
 /****************************************************************************************
 * Local data declarations
 ****************************************************************************************/
+#if (TBX_CONF_CRITSECT_MASK_LEVEL > 0U)
+/** \brief Lock of the critical section. Used when the critical section only masks the
+ *         interrupts up to the configured level, instead of disabling all interrupts.
+ */
+static tTbxLock tbxCritSectLock = TBX_LOCK_INIT("critsect",
+                                                TBX_CONF_CRITSECT_MASK_LEVEL);
+#else
 /** \brief Counter that gets incremented each time a critical section is entered and
  *         decremented each time a critical section is left.
  */
@@ -53,6 +60,7 @@ static volatile uint32_t      tbxCritSectNestingCounter = 0U;
  *         exiting the critical section,
  */
 static volatile tTbxPortCpuSR tbxCritSectCpuSR = 0U;
+#endif
 
 
 /************************************************************************************//**
@@ -68,6 +76,10 @@ static volatile tTbxPortCpuSR tbxCritSectCpuSR = 0U;
 ****************************************************************************************/
 void TbxCriticalSectionEnter(void)
 {
+#if (TBX_CONF_CRITSECT_MASK_LEVEL > 0U)
+  /* Only mask the interrupts up to the configured level. */
+  TbxLockEnter(&tbxCritSectLock);
+#else
   tTbxPortCpuSR cpuSR;
 
   /* Disable the interrupts and store the CPU status register value in a local variable.
@@ -90,6 +102,7 @@ void TbxCriticalSectionEnter(void)
   }
   /* Increment the nesting counter. */
   tbxCritSectNestingCounter++;
+#endif
 } /*** end of TbxCriticalSectionEnter ***/
 
 
@@ -106,6 +119,10 @@ void TbxCriticalSectionEnter(void)
 ****************************************************************************************/
 void TbxCriticalSectionExit(void)
 {
+#if (TBX_CONF_CRITSECT_MASK_LEVEL > 0U)
+  /* Unmask the interrupts again, if this is the last nested exit. */
+  TbxLockExit(&tbxCritSectLock);
+#else
   /* A call to this function must always be preceeded by a call to
    * TbxCriticalSectionEnter(). This means the tbxCritSectNestingCounter must be > 0.
    */
@@ -130,7 +147,116 @@ void TbxCriticalSectionExit(void)
       TbxPortInterruptsRestore(tbxCritSectCpuSR);
     }
   }
+#endif
 } /*** end of TbxCriticalSectionExit ***/
 
 
+/************************************************************************************//**
+** \brief     Enter a lock. A lock is a critical section for just the resources that it
+**            protects. It only masks the interrupts up to the level of the lock and it
+**            has its own nesting counter. Note that each call to this function should
+**            always be followed by a call to TbxLockExit(). Nested locks must be exited
+**            in the reverse order. For example:
+**              static tTbxLock myLock = TBX_LOCK_INIT("my", (6U << 4U));
+**              TbxLockEnter(&myLock);
+**              ...access resource shared with interrupt of priority 6 or lower...
+**              TbxLockExit(&myLock);
+** \param     lock Pointer to the lock to enter.
+**
+****************************************************************************************/
+void TbxLockEnter(tTbxLock * lock)
+{
+  tTbxPortCpuSR cpuSR;
+
+  /* Verify parameter. */
+  TBX_ASSERT(lock != NULL);
+
+  /* Only continue with a valid parameter. */
+  if (lock != NULL)
+  {
+    /* Obtain the lock and store the CPU status register value in a local variable. Note
+     * that it should not write directly to the lock's cpuSR yet, because it should only
+     * be accessed while holding the lock.
+     */
+    cpuSR = TbxPortLockAcquire(&lock->portLock);
+
+    /* It this the first time we enter the lock, as opposed to a nested entry? */
+    if (lock->nestingCounter == 0U)
+    {
+      /* Store the CPU status register value. It is needed to restore the interrupt
+       * status upon exiting the lock.
+       */
+      lock->cpuSR = cpuSR;
+    }
+    /* Increment the nesting counter. */
+    lock->nestingCounter++;
+  }
+} /*** end of TbxLockEnter ***/
+
+
+/************************************************************************************//**
+** \brief     Exit a lock. Note that each call to this function should always be preceded
+**            by a call to TbxLockEnter().
+** \param     lock Pointer to the lock to exit.
+**
+****************************************************************************************/
+void TbxLockExit(tTbxLock * lock)
+{
+  /* Verify parameters. A call to this function must always be preceeded by a call to
+   * TbxLockEnter(). This means the nesting counter must be > 0.
+   */
+  TBX_ASSERT((lock != NULL) && (lock->nestingCounter > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((lock != NULL) && (lock->nestingCounter > 0U))
+  {
+    /* Decrement the nesting counter. */
+    lock->nestingCounter--;
+
+    /* Is this the final call meaning that it is time we actually release the lock? */
+    if (lock->nestingCounter == 0U)
+    {
+      /* Release the lock and restore the interrupt status to the state it was right
+       * before the lock was entered for the first time.
+       */
+      TbxPortLockRelease(&lock->portLock, lock->cpuSR);
+    }
+  }
+} /*** end of TbxLockExit ***/
+
+
+#if defined(TBX_PORT_LOCK_GENERIC)
+/************************************************************************************//**
+** \brief     Generic implementation for ports that do not support locks. It obtains the
+**            lock by disabling all interrupts.
+** \param     portLock Port specific part of the lock. Not used.
+** \return    The current value of the CPU status register.
+**
+****************************************************************************************/
+tTbxPortCpuSR TbxPortLockAcquire(tTbxPortLock * portLock)
+{
+  TBX_UNUSED_ARG(portLock);
+
+  /* Disable all interrupts. */
+  return TbxPortInterruptsDisable();
+} /*** end of TbxPortLockAcquire ***/
+
+
+/************************************************************************************//**
+** \brief     Generic implementation for ports that do not support locks. It releases the
+**            lock by restoring the interrupts.
+** \param     portLock Port specific part of the lock. Not used.
+** \param     prevCpuSr The CPU status register value returned by TbxPortLockAcquire().
+**
+****************************************************************************************/
+void TbxPortLockRelease(tTbxPortLock * portLock, tTbxPortCpuSR prevCpuSr)
+{
+  TBX_UNUSED_ARG(portLock);
+
+  /* Restore the interrupts. */
+  TbxPortInterruptsRestore(prevCpuSr);
+} /*** end of TbxPortLockRelease ***/
+#endif
+
+
 /*********************************** end of tbx_critsect.c *****************************/
@@ -39,6 +39,55 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_CONF_CRITSECT_MASK_LEVEL
+/** \brief Interrupt mask level of the critical section. A value of 0 disables all
+ *         interrupts. On ARM Cortex-M3 and higher, any other value is written to the
+ *         BASEPRI register, which only masks the interrupts with the same or a lower
+ *         urgency. It is therefore the priority shifted into the implemented priority
+ *         bits, for example (5U << (8U - __NVIC_PRIO_BITS)). Interrupts that are not
+ *         masked, must not call MicroTBX functions. Note that it is possible to override
+ *         this value by adding this macro definition to the configuration header file.
+ */
+#define TBX_CONF_CRITSECT_MASK_LEVEL             (0U)
+#endif
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Initializer for a lock. The name is only for debugging purposes. The level is
+ *         the interrupt mask level, with the same meaning as
+ *         TBX_CONF_CRITSECT_MASK_LEVEL. Example:
+ *           static tTbxLock adcLock = TBX_LOCK_INIT("adc", (6U << 4U));
+ */
+#define TBX_LOCK_INIT(name, level)               { (name), 0U, 0U, \
+                                                   TBX_PORT_LOCK_INIT(level) }
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Layout of a lock. A lock is a critical section for just the resources that it
+ *         protects. It has its own nesting counter and its own interrupt mask level, so
+ *         unrelated modules do not serialize on the one global critical section. Its
+ *         elements should be considered private.
+ */
+typedef struct
+{
+  /** \brief Name of the lock, for debugging purposes. */
+  char           const * name;
+  /** \brief Number of times the lock was entered and not yet exited. */
+  volatile uint32_t      nestingCounter;
+  /** \brief CPU status register from right before the lock was entered. */
+  volatile tTbxPortCpuSR cpuSR;
+  /** \brief Port specific part of the lock. */
+  tTbxPortLock           portLock;
+} tTbxLock;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -46,6 +95,10 @@ void TbxCriticalSectionEnter(void);
 
 void TbxCriticalSectionExit (void);
 
+void TbxLockEnter           (tTbxLock * lock);
+
+void TbxLockExit            (tTbxLock * lock);
+
 
 #ifdef __cplusplus
 }
@@ -42,10 +42,10 @@
 
 
 /****************************************************************************************
-* Macro definitions
+* Function prototypes
 ****************************************************************************************/
-/** \brief Size of an AES block. Decryption is performed in this block size. */
-#define TBX_CRYPTO_AES_BLOCK_SIZE                (16U)
+static void TbxCryptoWipe(uint32_t * words,
+                          size_t     num);
 
 
 /************************************************************************************//**
@@ -62,7 +62,7 @@ void TbxCryptoAes256Encrypt(uint8_t       * data,
                             size_t          len, 
                             uint8_t const * key)
 {
-  tbx_aes256_context ctx;
+  uint32_t roundKeys[TBX_AES256_ROUND_KEYS_NUM];
 
   /* Verify parameters. */
   TBX_ASSERT(data != NULL);
@@ -74,15 +74,15 @@ void TbxCryptoAes256Encrypt(uint8_t       * data,
   if ( (data != NULL) && (len > 0U) && (key != NULL) && \
        ((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U) )
   {
-    /* Initialize the context. */
-    tbx_aes256_init(&ctx, key);
+    /* Expand the key. Only the encryption key schedule is needed. */
+    TbxAes256ExpandEncKey(roundKeys, key);
     /* Encrypt in blocks of 16 bytes. */
-    for (size_t idx = 0U; idx < (len / TBX_CRYPTO_AES_BLOCK_SIZE); idx++)
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
     {
-      tbx_aes256_encrypt_ecb(&ctx, &data[idx * TBX_CRYPTO_AES_BLOCK_SIZE]);
+      TbxAes256EncryptBlock(roundKeys, &data[idx], &data[idx]);
     }
-    /* Cleanup */
-    tbx_aes256_done(&ctx);
+    /* Cleanup. */
+    TbxCryptoWipe(roundKeys, TBX_AES256_ROUND_KEYS_NUM);
   }
 } /*** end of TbxCryptoAes256Encrypt ***/
 
@@ -101,7 +101,7 @@ void TbxCryptoAes256Decrypt(uint8_t       * data,
                             size_t          len, 
                             uint8_t const * key)
 {
-  tbx_aes256_context ctx;
+  uint32_t roundKeys[TBX_AES256_ROUND_KEYS_NUM];
 
   /* Verify parameters. */
   TBX_ASSERT(data != NULL);
@@ -113,17 +113,317 @@ void TbxCryptoAes256Decrypt(uint8_t       * data,
   if ( (data != NULL) && (len > 0U) && (key != NULL) && \
        ((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U) )
   {
-    /* Initialize the context. */
-    tbx_aes256_init(&ctx, key);
+    /* Expand the key. Only the decryption key schedule is needed. */
+    TbxAes256ExpandDecKey(roundKeys, key);
     /* Decrypt in blocks of 16 bytes. */
-    for (size_t idx = 0U; idx < (len / TBX_CRYPTO_AES_BLOCK_SIZE); idx++)
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
     {
-      tbx_aes256_decrypt_ecb(&ctx, &data[idx * TBX_CRYPTO_AES_BLOCK_SIZE]);
+      TbxAes256DecryptBlock(roundKeys, &data[idx], &data[idx]);
     }
-    /* Cleanup */
-    tbx_aes256_done(&ctx);
+    /* Cleanup. */
+    TbxCryptoWipe(roundKeys, TBX_AES256_ROUND_KEYS_NUM);
   }
 } /*** end of TbxCryptoAes256Decrypt ***/
 
 
+/************************************************************************************//**
+** \brief     Initializes the context for AES256 operations with the specified 256-bit
+**            (32 bytes) key. It expands the key schedules for both encryption and
+**            decryption once, such that all further calls with this context can skip
+**            this step. Call TbxCryptoAes256Done() once the context is no longer needed.
+** \param     ctx Pointer to the context to initialize.
+** \param     key The 256-bit key as a array of 32 bytes.
+**
+****************************************************************************************/
+void TbxCryptoAes256Init(tTbxCryptoAes256Ctx       * ctx,
+                         uint8_t             const * key)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+  TBX_ASSERT(key != NULL);
+
+  /* Only continue if the parameters are valid. */
+  if ((ctx != NULL) && (key != NULL))
+  {
+    /* Expand and cache the key schedules. */
+    TbxAes256ExpandEncKey(ctx->encRoundKeys, key);
+    TbxAes256ExpandDecKey(ctx->decRoundKeys, key);
+  }
+} /*** end of TbxCryptoAes256Init ***/
+
+
+/************************************************************************************//**
+** \brief     Clears the cached key schedules from the context, such that the key can no
+**            longer be derived from its memory.
+** \param     ctx Pointer to the context.
+**
+****************************************************************************************/
+void TbxCryptoAes256Done(tTbxCryptoAes256Ctx * ctx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+
+  /* Only continue if the parameters are valid. */
+  if (ctx != NULL)
+  {
+    /* Wipe the key schedules. */
+    TbxCryptoWipe(ctx->encRoundKeys, TBX_AES256_ROUND_KEYS_NUM);
+    TbxCryptoWipe(ctx->decRoundKeys, TBX_AES256_ROUND_KEYS_NUM);
+  }
+} /*** end of TbxCryptoAes256Done ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts the len-bytes in the specified data-array in ECB mode, using the
+**            key of the context. The results are written back into the same array.
+** \param     ctx Pointer to the initialized context.
+** \param     data Pointer to the byte array with data to encrypt.
+** \param     len The number of bytes in the data-array to encrypt. It must be a multiple
+**            of 16, as this is the AES256 minimal block size.
+**
+****************************************************************************************/
+void TbxCryptoAes256EncryptEcb(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+  TBX_ASSERT(data != NULL);
+  TBX_ASSERT(len > 0U);
+  TBX_ASSERT((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U);
+
+  /* Only continue if the parameters are valid. */
+  if ( (ctx != NULL) && (data != NULL) && (len > 0U) && \
+       ((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U) )
+  {
+    /* Encrypt in blocks of 16 bytes. */
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
+    {
+      TbxAes256EncryptBlock(ctx->encRoundKeys, &data[idx], &data[idx]);
+    }
+  }
+} /*** end of TbxCryptoAes256EncryptEcb ***/
+
+
+/************************************************************************************//**
+** \brief     Decrypts the len-bytes in the specified data-array in ECB mode, using the
+**            key of the context. The results are written back into the same array.
+** \param     ctx Pointer to the initialized context.
+** \param     data Pointer to the byte array with data to decrypt.
+** \param     len The number of bytes in the data-array to decrypt. It must be a multiple
+**            of 16, as this is the AES256 minimal block size.
+**
+****************************************************************************************/
+void TbxCryptoAes256DecryptEcb(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+  TBX_ASSERT(data != NULL);
+  TBX_ASSERT(len > 0U);
+  TBX_ASSERT((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U);
+
+  /* Only continue if the parameters are valid. */
+  if ( (ctx != NULL) && (data != NULL) && (len > 0U) && \
+       ((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U) )
+  {
+    /* Decrypt in blocks of 16 bytes. */
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
+    {
+      TbxAes256DecryptBlock(ctx->decRoundKeys, &data[idx], &data[idx]);
+    }
+  }
+} /*** end of TbxCryptoAes256DecryptEcb ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts the len-bytes in the specified data-array in CBC mode, using the
+**            key of the context. The results are written back into the same array. The
+**            initialization vector is updated to the last encrypted block. A large
+**            buffer can therefore be encrypted in chunks, by calling this function
+**            again with the same iv for the next chunk.
+** \param     ctx Pointer to the initialized context.
+** \param     data Pointer to the byte array with data to encrypt.
+** \param     len The number of bytes in the data-array to encrypt. It must be a multiple
+**            of 16, as this is the AES256 minimal block size.
+** \param     iv The 16 byte initialization vector.
+**
+****************************************************************************************/
+void TbxCryptoAes256EncryptCbc(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len,
+                               uint8_t                   * iv)
+{
+  uint8_t const * chainPtr;
+
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+  TBX_ASSERT(data != NULL);
+  TBX_ASSERT(len > 0U);
+  TBX_ASSERT((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U);
+  TBX_ASSERT(iv != NULL);
+
+  /* Only continue if the parameters are valid. */
+  if ( (ctx != NULL) && (data != NULL) && (len > 0U) && \
+       ((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U) && (iv != NULL) )
+  {
+    /* The first block is chained to the initialization vector. */
+    chainPtr = iv;
+    /* Encrypt in blocks of 16 bytes. */
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
+    {
+      /* Chain the block to the previous encrypted block, before encrypting it. */
+      for (uint8_t byteIdx = 0U; byteIdx < TBX_CRYPTO_AES_BLOCK_SIZE; byteIdx++)
+      {
+        data[idx + byteIdx] ^= chainPtr[byteIdx];
+      }
+      TbxAes256EncryptBlock(ctx->encRoundKeys, &data[idx], &data[idx]);
+      chainPtr = &data[idx];
+    }
+    /* Continue the chain with the last encrypted block upon the next call. */
+    for (uint8_t byteIdx = 0U; byteIdx < TBX_CRYPTO_AES_BLOCK_SIZE; byteIdx++)
+    {
+      iv[byteIdx] = chainPtr[byteIdx];
+    }
+  }
+} /*** end of TbxCryptoAes256EncryptCbc ***/
+
+
+/************************************************************************************//**
+** \brief     Decrypts the len-bytes in the specified data-array in CBC mode, using the
+**            key of the context. The results are written back into the same array. The
+**            initialization vector is updated to the last encrypted block. A large
+**            buffer can therefore be decrypted in chunks, by calling this function
+**            again with the same iv for the next chunk.
+** \param     ctx Pointer to the initialized context.
+** \param     data Pointer to the byte array with data to decrypt.
+** \param     len The number of bytes in the data-array to decrypt. It must be a multiple
+**            of 16, as this is the AES256 minimal block size.
+** \param     iv The 16 byte initialization vector.
+**
+****************************************************************************************/
+void TbxCryptoAes256DecryptCbc(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len,
+                               uint8_t                   * iv)
+{
+  uint8_t cipherBlock[TBX_CRYPTO_AES_BLOCK_SIZE];
+
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+  TBX_ASSERT(data != NULL);
+  TBX_ASSERT(len > 0U);
+  TBX_ASSERT((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U);
+  TBX_ASSERT(iv != NULL);
+
+  /* Only continue if the parameters are valid. */
+  if ( (ctx != NULL) && (data != NULL) && (len > 0U) && \
+       ((len % TBX_CRYPTO_AES_BLOCK_SIZE) == 0U) && (iv != NULL) )
+  {
+    /* Decrypt in blocks of 16 bytes. */
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
+    {
+      /* Keep a copy of the encrypted block, because it is needed to unchain the next
+       * block and the decryption overwrites it.
+       */
+      for (uint8_t byteIdx = 0U; byteIdx < TBX_CRYPTO_AES_BLOCK_SIZE; byteIdx++)
+      {
+        cipherBlock[byteIdx] = data[idx + byteIdx];
+      }
+      TbxAes256DecryptBlock(ctx->decRoundKeys, &data[idx], &data[idx]);
+      /* Unchain the block from the previous encrypted block. */
+      for (uint8_t byteIdx = 0U; byteIdx < TBX_CRYPTO_AES_BLOCK_SIZE; byteIdx++)
+      {
+        data[idx + byteIdx] ^= iv[byteIdx];
+        iv[byteIdx] = cipherBlock[byteIdx];
+      }
+    }
+  }
+} /*** end of TbxCryptoAes256DecryptCbc ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts or decrypts the len-bytes in the specified data-array in CTR mode,
+**            using the key of the context. The results are written back into the same
+**            array. Encryption and decryption are the same operation in CTR mode. Each
+**            block is XOR-ed with the encrypted counter block, after which the counter
+**            block is incremented as a 128-bit big endian number. The length does not
+**            have to be a multiple of 16. Note that the counter is also incremented for
+**            a partial last block. To process a large buffer in chunks, all but the last
+**            chunk should therefore be a multiple of 16 bytes.
+** \param     ctx Pointer to the initialized context.
+** \param     data Pointer to the byte array with data to encrypt or decrypt.
+** \param     len The number of bytes in the data-array.
+** \param     counter The 16 byte counter block. Typically a nonce followed by a block
+**            counter.
+**
+****************************************************************************************/
+void TbxCryptoAes256Ctr(tTbxCryptoAes256Ctx const * ctx,
+                        uint8_t                   * data,
+                        size_t                      len,
+                        uint8_t                   * counter)
+{
+  uint8_t keyStream[TBX_CRYPTO_AES_BLOCK_SIZE];
+  size_t  chunkLen;
+  uint8_t byteIdx;
+
+  /* Verify parameters. */
+  TBX_ASSERT(ctx != NULL);
+  TBX_ASSERT(data != NULL);
+  TBX_ASSERT(len > 0U);
+  TBX_ASSERT(counter != NULL);
+
+  /* Only continue if the parameters are valid. */
+  if ((ctx != NULL) && (data != NULL) && (len > 0U) && (counter != NULL))
+  {
+    /* Process in blocks of 16 bytes, where the last one can be shorter. */
+    for (size_t idx = 0U; idx < len; idx += TBX_CRYPTO_AES_BLOCK_SIZE)
+    {
+      /* Generate the key stream for this block. */
+      TbxAes256EncryptBlock(ctx->encRoundKeys, counter, keyStream);
+      chunkLen = len - idx;
+      if (chunkLen > TBX_CRYPTO_AES_BLOCK_SIZE)
+      {
+        chunkLen = TBX_CRYPTO_AES_BLOCK_SIZE;
+      }
+      for (byteIdx = 0U; byteIdx < chunkLen; byteIdx++)
+      {
+        data[idx + byteIdx] ^= keyStream[byteIdx];
+      }
+      /* Increment the counter block, starting at its least significant byte, until a
+       * byte does not wrap around.
+       */
+      byteIdx = TBX_CRYPTO_AES_BLOCK_SIZE;
+      do
+      {
+        byteIdx--;
+        counter[byteIdx]++;
+      }
+      while ((counter[byteIdx] == 0U) && (byteIdx > 0U));
+    }
+  }
+} /*** end of TbxCryptoAes256Ctr ***/
+
+
+/************************************************************************************//**
+** \brief     Overwrites the words in the array with zeroes. Used for clearing key
+**            material from memory, once it is no longer needed.
+** \param     words Pointer to the array.
+** \param     num Number of words in the array.
+**
+****************************************************************************************/
+static void TbxCryptoWipe(uint32_t * words,
+                          size_t     num)
+{
+  /* The volatile access prevents the compiler from optimizing the stores away. */
+  uint32_t volatile * wordPtr = words;
+
+  for (size_t idx = 0U; idx < num; idx++)
+  {
+    wordPtr[idx] = 0U;
+  }
+} /*** end of TbxCryptoWipe ***/
+
+
 /*********************************** end of tbx_crypto.c *******************************/
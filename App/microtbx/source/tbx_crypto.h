@@ -39,6 +39,31 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Size of an AES block in bytes. This is also the size of the initialization
+ *         vector and the counter block.
+ */
+#define TBX_CRYPTO_AES_BLOCK_SIZE                (16U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Context for AES256 operations with the same key. It caches the expanded key
+ *         schedules, so they do not have to be derived again for each call. Its elements
+ *         should be considered private.
+ */
+typedef struct
+{
+  /** \brief Key schedule for encryption. */
+  uint32_t encRoundKeys[60];
+  /** \brief Key schedule for decryption. */
+  uint32_t decRoundKeys[60];
+} tTbxCryptoAes256Ctx;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -50,6 +75,34 @@ void TbxCryptoAes256Decrypt(uint8_t       * data,
                             size_t          len,
                             uint8_t const * key);
 
+void TbxCryptoAes256Init      (tTbxCryptoAes256Ctx       * ctx,
+                               uint8_t             const * key);
+
+void TbxCryptoAes256Done      (tTbxCryptoAes256Ctx       * ctx);
+
+void TbxCryptoAes256EncryptEcb(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len);
+
+void TbxCryptoAes256DecryptEcb(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len);
+
+void TbxCryptoAes256EncryptCbc(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len,
+                               uint8_t                   * iv);
+
+void TbxCryptoAes256DecryptCbc(tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len,
+                               uint8_t                   * iv);
+
+void TbxCryptoAes256Ctr       (tTbxCryptoAes256Ctx const * ctx,
+                               uint8_t                   * data,
+                               size_t                      len,
+                               uint8_t                   * counter);
+
 
 #ifdef __cplusplus
 }
@@ -51,6 +51,857 @@
 #endif
 
 
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/* cppcheck-suppress [unassignedVariable,unmatchedSuppression] 
+ * The actual heap buffer. Whenever memory needs to be dynamically allocated, it will
+ * be taken from this buffer. As such, it is okay to not be initialized and therefore
+ * the warning about no value being assigned to this variable can be ignored. It is
+ * declared as an array of pointer sized elements to align it to the address size.
+ */
+static uintptr_t tbxHeapBuffer[(TBX_CONF_HEAP_SIZE + (sizeof(uintptr_t) - 1U)) / 
+                               sizeof(uintptr_t)];
+
+
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+/****************************************************************************************
+*   T W O - L E V E L   S E G R E G A T E D   F I T   H E A P
+****************************************************************************************/
+/*
+ * The free blocks are kept in segregated free lists. The first level splits the block
+ * sizes in powers of two. The second level linearly splits each power of two range in
+ * TBX_HEAP_SL_COUNT parts. Bitmaps flag which free lists are not empty, such that a
+ * fitting free block is found with two find-first-set operations. A freed block is
+ * immediately merged with its physical neighbors, when these are free. This makes both
+ * allocating and freeing take constant time, with low fragmentation.
+ *
+ * Each block starts with a header, holding the pointer to the previous physical block
+ * and the block size. The pointer to the previous physical block is only valid while
+ * that block is free and it is located in that block's last data bytes. The size's two
+ * lower bits flag whether the block itself and the previous physical block are free.
+ * The pointers to the previous and next block in the free list are only present in a
+ * free block and are located in its data bytes. An allocated block therefore only has
+ * the overhead of one size_t.
+ */
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Alignment of the blocks and their size. Equals the address size. */
+#define TBX_HEAP_ALIGN_SIZE            (sizeof(void *))
+
+/** \brief Base two logarithm of TBX_HEAP_ALIGN_SIZE. */
+#define TBX_HEAP_ALIGN_SIZE_LOG2       ((sizeof(void *) > 4U) ? 3U : 2U)
+
+/** \brief Base two logarithm of the number of second level free lists. */
+#define TBX_HEAP_SL_COUNT_LOG2         (3U)
+
+/** \brief Number of second level free lists per first level. */
+#define TBX_HEAP_SL_COUNT              (1U << TBX_HEAP_SL_COUNT_LOG2)
+
+/** \brief Blocks smaller than (1 << TBX_HEAP_FL_SHIFT) bytes are all stored in the first
+ *         first level, split linearly in steps of TBX_HEAP_ALIGN_SIZE bytes.
+ */
+#define TBX_HEAP_FL_SHIFT              (TBX_HEAP_SL_COUNT_LOG2 + TBX_HEAP_ALIGN_SIZE_LOG2)
+
+/** \brief Base two logarithm of the block size limit. It's derived from the heap size to
+ *         not waste RAM on free lists that can never be used.
+ */
+#if (TBX_CONF_HEAP_SIZE < 0x400UL)
+#define TBX_HEAP_FL_MAX                (10U)
+#elif (TBX_CONF_HEAP_SIZE < 0x800UL)
+#define TBX_HEAP_FL_MAX                (11U)
+#elif (TBX_CONF_HEAP_SIZE < 0x1000UL)
+#define TBX_HEAP_FL_MAX                (12U)
+#elif (TBX_CONF_HEAP_SIZE < 0x2000UL)
+#define TBX_HEAP_FL_MAX                (13U)
+#elif (TBX_CONF_HEAP_SIZE < 0x4000UL)
+#define TBX_HEAP_FL_MAX                (14U)
+#elif (TBX_CONF_HEAP_SIZE < 0x8000UL)
+#define TBX_HEAP_FL_MAX                (15U)
+#elif (TBX_CONF_HEAP_SIZE < 0x10000UL)
+#define TBX_HEAP_FL_MAX                (16U)
+#elif (TBX_CONF_HEAP_SIZE < 0x20000UL)
+#define TBX_HEAP_FL_MAX                (17U)
+#elif (TBX_CONF_HEAP_SIZE < 0x40000UL)
+#define TBX_HEAP_FL_MAX                (18U)
+#elif (TBX_CONF_HEAP_SIZE < 0x80000UL)
+#define TBX_HEAP_FL_MAX                (19U)
+#elif (TBX_CONF_HEAP_SIZE < 0x100000UL)
+#define TBX_HEAP_FL_MAX                (20U)
+#elif (TBX_CONF_HEAP_SIZE < 0x1000000UL)
+#define TBX_HEAP_FL_MAX                (24U)
+#else
+#define TBX_HEAP_FL_MAX                (31U)
+#endif
+
+/** \brief Number of first level free lists. */
+#define TBX_HEAP_FL_COUNT              (TBX_HEAP_FL_MAX - TBX_HEAP_FL_SHIFT + 1U)
+
+/** \brief Size of the largest block. */
+#define TBX_HEAP_BLOCK_SIZE_MAX        ((size_t)1U << TBX_HEAP_FL_MAX)
+
+/** \brief Size of the smallest block, which must be able to hold the free list pointers
+ *         and the previous physical block pointer of the next block.
+ */
+#define TBX_HEAP_BLOCK_SIZE_MIN        (sizeof(tHeapBlock) - sizeof(tHeapBlock *))
+
+/** \brief Overhead of an allocated block. */
+#define TBX_HEAP_BLOCK_OVERHEAD        (sizeof(size_t))
+
+/** \brief Offset from the start of the block header to the block data. */
+#define TBX_HEAP_BLOCK_DATA_OFFSET     (sizeof(tHeapBlock *) + sizeof(size_t))
+
+/** \brief Flag in the block size, which indicates that the block is free. */
+#define TBX_HEAP_BLOCK_FREE_BIT        ((size_t)1U)
+
+/** \brief Flag in the block size, which indicates that the previous block is free. */
+#define TBX_HEAP_BLOCK_PREV_FREE_BIT   ((size_t)2U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Layout of the block header. */
+typedef struct t_heap_block
+{
+  /** \brief Pointer to the previous physical block. Only valid if it is free. */
+  struct t_heap_block * prevPhysPtr;
+  /** \brief Size of the block's data in bytes, including the flag bits. */
+  size_t                size;
+  /** \brief Pointer to the next block in the free list. Only valid if it is free. */
+  struct t_heap_block * nextFreePtr;
+  /** \brief Pointer to the previous block in the free list. Only valid if it is free. */
+  struct t_heap_block * prevFreePtr;
+} tHeapBlock;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void         TbxHeapInit           (void);
+
+static uint8_t      TbxHeapBitFirst       (uint32_t           value);
+
+static uint8_t      TbxHeapBitLast        (size_t             value);
+
+static void         TbxHeapMapping        (size_t             size,
+                                           uint8_t          * flPtr,
+                                           uint8_t          * slPtr);
+
+static size_t       TbxHeapBlockSize      (tHeapBlock const * blockPtr);
+
+static tHeapBlock * TbxHeapBlockNext      (tHeapBlock const * blockPtr);
+
+static tHeapBlock * TbxHeapBlockLinkNext  (tHeapBlock       * blockPtr);
+
+static void         TbxHeapBlockMarkFree  (tHeapBlock       * blockPtr);
+
+static void         TbxHeapBlockMarkUsed  (tHeapBlock       * blockPtr);
+
+static void         TbxHeapListInsert     (tHeapBlock       * blockPtr);
+
+static void         TbxHeapListRemove     (tHeapBlock       * blockPtr);
+
+static tHeapBlock * TbxHeapListLocate     (size_t             size);
+
+static tHeapBlock * TbxHeapBlockSplit     (tHeapBlock       * blockPtr,
+                                           size_t             size);
+
+static tHeapBlock * TbxHeapBlockAbsorb    (tHeapBlock       * prevPtr,
+                                           tHeapBlock const * blockPtr);
+
+static void       * TbxHeapBlockPrepare   (tHeapBlock       * blockPtr,
+                                           size_t             size);
+
+static size_t       TbxHeapAdjustSize     (size_t             size);
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Flag to determine if the heap was initialized. */
+static uint8_t      tbxHeapInitialized = TBX_FALSE;
+
+/** \brief Bitmap with a bit for each first level that has a non-empty free list. */
+static uint32_t     tbxHeapFlBitmap;
+
+/** \brief Bitmaps with a bit for each non-empty second level free list. */
+static uint32_t     tbxHeapSlBitmap[TBX_HEAP_FL_COUNT];
+
+/** \brief Heads of the segregated free lists. */
+static tHeapBlock * tbxHeapFreeLists[TBX_HEAP_FL_COUNT][TBX_HEAP_SL_COUNT];
+
+/** \brief Total number of bytes managed by the heap. */
+static size_t       tbxHeapSize;
+
+/** \brief Number of free bytes, so the summed size of all free blocks. */
+static size_t       tbxHeapFree;
+
+/** \brief Lowest number of free bytes since initialization. */
+static size_t       tbxHeapMinFree;
+
+
+/************************************************************************************//**
+** \brief     Allocates the desired number of bytes on the heap. It can be used instead
+**            of the compiler specific malloc() function. The allocated memory can be
+**            freed again with TbxHeapFree(). Both take constant time.
+** \param     size The number of bytes to allocate on the heap.
+** \return    Pointer to the start of the newly allocated heap memory if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+void * TbxHeapAllocate(size_t size)
+{
+  /* Allocate with the default alignment, which is the address size. */
+  return TbxHeapAllocateAligned(size, TBX_HEAP_ALIGN_SIZE);
+} /*** end of TbxHeapAllocate ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates the desired number of bytes on the heap, at an address that is
+**            aligned to the specified number of bytes. Useful for DMA buffers and for
+**            C++ over-aligned types.
+** \param     size The number of bytes to allocate on the heap.
+** \param     alignment Alignment of the address in bytes. Must be a power of two.
+** \return    Pointer to the start of the newly allocated heap memory if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+void * TbxHeapAllocateAligned(size_t size,
+                              size_t alignment)
+{
+  void       * result = NULL;
+  tHeapBlock * blockPtr;
+  size_t       sizeWanted;
+  size_t       sizeSearched;
+  size_t       gap;
+
+  /* Verify parameters. */
+  TBX_ASSERT(size > 0U);
+  TBX_ASSERT((alignment > 0U) && ((alignment & (alignment - 1U)) == 0U));
+
+  /* Only continue if the parameters are valid. */
+  if ( (size > 0U) && (alignment > 0U) && ((alignment & (alignment - 1U)) == 0U) )
+  {
+    /* Blocks are always aligned to at least the address size. */
+    if (alignment < TBX_HEAP_ALIGN_SIZE)
+    {
+      alignment = TBX_HEAP_ALIGN_SIZE;
+    }
+    /* Align the desired size to the address size and check its limits. */
+    sizeWanted = TbxHeapAdjustSize(size);
+    /* With a larger alignment, the block should have room for a leading gap that is
+     * large enough to become a free block by itself.
+     */
+    sizeSearched = sizeWanted;
+    if ( (sizeWanted > 0U) && (alignment > TBX_HEAP_ALIGN_SIZE) )
+    {
+      sizeSearched = TbxHeapAdjustSize(sizeWanted + alignment + sizeof(tHeapBlock));
+    }
+    /* Only continue with a valid size. */
+    if (sizeSearched > 0U)
+    {
+      /* Obtain mutual exclusive access to the heap. */
+      TbxCriticalSectionEnter();
+      /* Initialize the heap upon first usage. */
+      TbxHeapInit();
+      /* Attempt to locate a fitting free block and remove it from its free list. */
+      blockPtr = TbxHeapListLocate(sizeSearched);
+      /* Only continue if one was found. */
+      if (blockPtr != NULL)
+      {
+        /* Determine the gap to the first aligned address. */
+        uintptr_t dataAddr = (uintptr_t)blockPtr + TBX_HEAP_BLOCK_DATA_OFFSET;
+        gap = (size_t)(((dataAddr + (alignment - 1U)) & ~(alignment - 1U)) - dataAddr);
+        /* The gap must be large enough to hold a free block, so move it up if not. */
+        if ( (gap > 0U) && (gap < sizeof(tHeapBlock)) )
+        {
+          uintptr_t nextAddr = dataAddr + sizeof(tHeapBlock) + (alignment - 1U);
+          gap = (size_t)((nextAddr & ~(alignment - 1U)) - dataAddr);
+        }
+        /* Split off the gap as a separate free block. */
+        if (gap > 0U)
+        {
+          tHeapBlock * leadingPtr = blockPtr;
+          /* The aligned block starts where the gap ends. */
+          blockPtr = TbxHeapBlockSplit(leadingPtr, gap - TBX_HEAP_BLOCK_OVERHEAD);
+          blockPtr->size |= TBX_HEAP_BLOCK_PREV_FREE_BIT;
+          (void)TbxHeapBlockLinkNext(leadingPtr);
+          TbxHeapListInsert(leadingPtr);
+        }
+        /* Trim the block to the wanted size and mark it as used. */
+        result = TbxHeapBlockPrepare(blockPtr, sizeWanted);
+      }
+      /* Release mutual exclusive access to the heap. */
+      TbxCriticalSectionExit();
+    }
+  }
+
+  /* Return the address of the allocated memory to the caller. */
+  return result;
+} /*** end of TbxHeapAllocateAligned ***/
+
+
+/************************************************************************************//**
+** \brief     Frees memory that was previously allocated on the heap, such that it can
+**            be allocated again. The block is merged with its free neighbors.
+** \param     memPtr Pointer to the memory, as returned by TbxHeapAllocate() or
+**            TbxHeapAllocateAligned().
+**
+****************************************************************************************/
+void TbxHeapFree(void * memPtr)
+{
+  tHeapBlock * blockPtr;
+  uintptr_t    memAddr = (uintptr_t)memPtr;
+
+  /* Verify parameter. The pointer should be within the heap buffer. */
+  TBX_ASSERT((memAddr >= (uintptr_t)&tbxHeapBuffer[1]) && 
+             (memAddr < (uintptr_t)&tbxHeapBuffer[sizeof(tbxHeapBuffer) / 
+                                                  sizeof(tbxHeapBuffer[0])]));
+
+  /* Only continue if the parameter is valid. */
+  if ( (memAddr >= (uintptr_t)&tbxHeapBuffer[1]) && 
+       (memAddr < (uintptr_t)&tbxHeapBuffer[sizeof(tbxHeapBuffer) / 
+                                            sizeof(tbxHeapBuffer[0])]) )
+  {
+    /* Obtain mutual exclusive access to the heap. */
+    TbxCriticalSectionEnter();
+    /* Get the block header that precedes the data. */
+    blockPtr = (tHeapBlock *)(void *)((uint8_t *)memPtr - TBX_HEAP_BLOCK_DATA_OFFSET);
+    /* Sanity check. The block should not already be free. */
+    TBX_ASSERT((blockPtr->size & TBX_HEAP_BLOCK_FREE_BIT) == 0U);
+    /* Only continue if the sanity check passed. */
+    if ((blockPtr->size & TBX_HEAP_BLOCK_FREE_BIT) == 0U)
+    {
+      tHeapBlock * nextPtr;
+      /* Flag the block as free. */
+      TbxHeapBlockMarkFree(blockPtr);
+      /* Merge with the previous physical block, if it is free. */
+      if ((blockPtr->size & TBX_HEAP_BLOCK_PREV_FREE_BIT) != 0U)
+      {
+        tHeapBlock * prevPtr = blockPtr->prevPhysPtr;
+        TbxHeapListRemove(prevPtr);
+        blockPtr = TbxHeapBlockAbsorb(prevPtr, blockPtr);
+      }
+      /* Merge with the next physical block, if it is free. */
+      nextPtr = TbxHeapBlockNext(blockPtr);
+      if ((nextPtr->size & TBX_HEAP_BLOCK_FREE_BIT) != 0U)
+      {
+        TbxHeapListRemove(nextPtr);
+        blockPtr = TbxHeapBlockAbsorb(blockPtr, nextPtr);
+      }
+      /* Make the merged block available again. */
+      TbxHeapListInsert(blockPtr);
+    }
+    /* Release mutual exclusive access to the heap. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxHeapFree ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the current amount of bytes that are still available on the heap.
+**            Note that this is the sum of all free blocks. Because of fragmentation, it
+**            might not be possible to allocate all of it in one go.
+** \return    Number of free bytes on the heap.
+**
+****************************************************************************************/
+size_t TbxHeapGetFree(void)
+{
+  size_t result;
+
+  /* Obtain mutual exclusive access to the heap. */
+  TbxCriticalSectionEnter();
+  /* Initialize the heap upon first usage. */
+  TbxHeapInit();
+  /* Read the number of free bytes. */
+  result = tbxHeapFree;
+  /* Release mutual exclusive access to the heap. */
+  TbxCriticalSectionExit();
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxHeapGetFree ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the run-time statistics of the heap.
+** \param     stats Pointer to where the statistics are written to.
+**
+****************************************************************************************/
+void TbxHeapGetStats(tTbxHeapStats * stats)
+{
+  tHeapBlock const * blockPtr;
+  size_t             largestBlock = 0U;
+
+  /* Verify parameter. */
+  TBX_ASSERT(stats != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (stats != NULL)
+  {
+    /* Obtain mutual exclusive access to the heap. */
+    TbxCriticalSectionEnter();
+    /* Initialize the heap upon first usage. */
+    TbxHeapInit();
+    /* Copy the statistics. */
+    stats->size = tbxHeapSize;
+    stats->free = tbxHeapFree;
+    stats->minFree = tbxHeapMinFree;
+    /* The largest free block is in the highest non-empty free list. */
+    if (tbxHeapFlBitmap != 0U)
+    {
+      uint8_t fl = TbxHeapBitLast(tbxHeapFlBitmap);
+      uint8_t sl = TbxHeapBitLast(tbxHeapSlBitmap[fl]);
+      /* The blocks in this free list are of different sizes, so check them all. */
+      for (blockPtr = tbxHeapFreeLists[fl][sl]; blockPtr != NULL; 
+           blockPtr = blockPtr->nextFreePtr)
+      {
+        if (TbxHeapBlockSize(blockPtr) > largestBlock)
+        {
+          largestBlock = TbxHeapBlockSize(blockPtr);
+        }
+      }
+    }
+    /* Release mutual exclusive access to the heap. */
+    TbxCriticalSectionExit();
+    /* TbxHeapListLocate() rounds the size up to the next free list. Only sizes up to
+     * the lower boundary of the largest block's free list are therefore guaranteed to
+     * be found.
+     */
+    stats->largestFree = largestBlock;
+    if (largestBlock >= ((size_t)1U << TBX_HEAP_FL_SHIFT))
+    {
+      stats->largestFree &= ~(((size_t)1U << (TbxHeapBitLast(largestBlock) - 
+                                              TBX_HEAP_SL_COUNT_LOG2)) - 1U);
+    }
+    /* Determine the fragmentation. */
+    stats->fragmentation = 0U;
+    if (stats->free > 0U)
+    {
+      stats->fragmentation = (uint8_t)(100U - ((largestBlock * 100U) / stats->free));
+    }
+  }
+} /*** end of TbxHeapGetStats ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes the heap as one large free block upon first usage. It is
+**            followed by a zero sized sentinel block that is flagged as used, such that
+**            the last block is never merged with what lies beyond the heap buffer.
+** \attention Should be called with mutual exclusive access to the heap.
+**
+****************************************************************************************/
+static void TbxHeapInit(void)
+{
+  tHeapBlock * blockPtr;
+  tHeapBlock * sentinelPtr;
+
+  /* Only initialize once. */
+  if (tbxHeapInitialized == TBX_FALSE)
+  {
+    tbxHeapInitialized = TBX_TRUE;
+    /* Create the block at the start of the heap buffer. Its data size covers the heap
+     * buffer, minus its own header and the sentinel's size. 
+     */
+    blockPtr = (tHeapBlock *)(void *)&tbxHeapBuffer[0];
+    tbxHeapSize = (sizeof(tbxHeapBuffer) - TBX_HEAP_BLOCK_DATA_OFFSET - 
+                   TBX_HEAP_BLOCK_OVERHEAD) & ~(TBX_HEAP_ALIGN_SIZE - 1U);
+    /* Make sure the size does not exceed the maximum block size. */
+    TBX_ASSERT(tbxHeapSize < TBX_HEAP_BLOCK_SIZE_MAX);
+    blockPtr->size = tbxHeapSize | TBX_HEAP_BLOCK_FREE_BIT;
+    /* Create the sentinel block. */
+    sentinelPtr = TbxHeapBlockLinkNext(blockPtr);
+    sentinelPtr->size = TBX_HEAP_BLOCK_PREV_FREE_BIT;
+    /* Add the block to the free lists. */
+    tbxHeapFree = 0U;
+    TbxHeapListInsert(blockPtr);
+    tbxHeapMinFree = tbxHeapFree;
+  }
+} /*** end of TbxHeapInit ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the index of the least significant set bit.
+** \param     value Value to check. Should not be zero.
+** \return    Bit index.
+**
+****************************************************************************************/
+static uint8_t TbxHeapBitFirst(uint32_t value)
+{
+  uint8_t result = 0U;
+
+#if defined(__GNUC__)
+  /* Use the compiler's built-in function. */
+  result = (uint8_t)__builtin_ctz(value);
+#else
+  /* Shift until the least significant bit is set. */
+  while ( (value != 0U) && ((value & 1U) == 0U) )
+  {
+    value >>= 1U;
+    result++;
+  }
+#endif
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxHeapBitFirst ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the index of the most significant set bit.
+** \param     value Value to check. Should not be zero.
+** \return    Bit index.
+**
+****************************************************************************************/
+static uint8_t TbxHeapBitLast(size_t value)
+{
+  uint8_t result = 0U;
+
+#if defined(__GNUC__)
+  /* Use the compiler's built-in function. */
+  result = (uint8_t)(63U - (uint8_t)__builtin_clzll((unsigned long long)value));
+#else
+  /* Shift until only the most significant bit remains. */
+  while (value > 1U)
+  {
+    value >>= 1U;
+    result++;
+  }
+#endif
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxHeapBitLast ***/
+
+
+/************************************************************************************//**
+** \brief     Maps a block size to the indices of the free list it belongs to.
+** \param     size Block size.
+** \param     flPtr Pointer to where the first level index is written to.
+** \param     slPtr Pointer to where the second level index is written to.
+**
+****************************************************************************************/
+static void TbxHeapMapping(size_t    size,
+                           uint8_t * flPtr,
+                           uint8_t * slPtr)
+{
+  /* Small blocks are all in the first level and split linearly. */
+  if (size < ((size_t)1U << TBX_HEAP_FL_SHIFT))
+  {
+    *flPtr = 0U;
+    *slPtr = (uint8_t)(size / TBX_HEAP_ALIGN_SIZE);
+  }
+  /* Other blocks are split in powers of two and linearly within a power of two. */
+  else
+  {
+    uint8_t fl = TbxHeapBitLast(size);
+    *slPtr = (uint8_t)((size >> (fl - TBX_HEAP_SL_COUNT_LOG2)) ^ TBX_HEAP_SL_COUNT);
+    *flPtr = (uint8_t)(fl - (TBX_HEAP_FL_SHIFT - 1U));
+  }
+} /*** end of TbxHeapMapping ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the data size of a block, without the flag bits.
+** \param     blockPtr Pointer to the block.
+** \return    Block size.
+**
+****************************************************************************************/
+static size_t TbxHeapBlockSize(tHeapBlock const * blockPtr)
+{
+  return blockPtr->size & ~(TBX_HEAP_BLOCK_FREE_BIT | TBX_HEAP_BLOCK_PREV_FREE_BIT);
+} /*** end of TbxHeapBlockSize ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the next physical block.
+** \param     blockPtr Pointer to the block.
+** \return    Pointer to the next physical block.
+**
+****************************************************************************************/
+static tHeapBlock * TbxHeapBlockNext(tHeapBlock const * blockPtr)
+{
+  /* The next block's header starts with its previous physical block pointer, which
+   * overlaps with the last data bytes of this block.
+   */
+  uint8_t const * dataPtr = (uint8_t const *)blockPtr + TBX_HEAP_BLOCK_DATA_OFFSET;
+  return (tHeapBlock *)(void *)(dataPtr + TbxHeapBlockSize(blockPtr) - 
+                                TBX_HEAP_BLOCK_OVERHEAD);
+} /*** end of TbxHeapBlockNext ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the next physical block and stores the block in its previous
+**            physical block pointer.
+** \param     blockPtr Pointer to the block.
+** \return    Pointer to the next physical block.
+**
+****************************************************************************************/
+static tHeapBlock * TbxHeapBlockLinkNext(tHeapBlock * blockPtr)
+{
+  tHeapBlock * nextPtr = TbxHeapBlockNext(blockPtr);
+  nextPtr->prevPhysPtr = blockPtr;
+  return nextPtr;
+} /*** end of TbxHeapBlockLinkNext ***/
+
+
+/************************************************************************************//**
+** \brief     Flags the block as free, also in the next physical block.
+** \param     blockPtr Pointer to the block.
+**
+****************************************************************************************/
+static void TbxHeapBlockMarkFree(tHeapBlock * blockPtr)
+{
+  tHeapBlock * nextPtr = TbxHeapBlockLinkNext(blockPtr);
+  nextPtr->size |= TBX_HEAP_BLOCK_PREV_FREE_BIT;
+  blockPtr->size |= TBX_HEAP_BLOCK_FREE_BIT;
+} /*** end of TbxHeapBlockMarkFree ***/
+
+
+/************************************************************************************//**
+** \brief     Flags the block as used, also in the next physical block.
+** \param     blockPtr Pointer to the block.
+**
+****************************************************************************************/
+static void TbxHeapBlockMarkUsed(tHeapBlock * blockPtr)
+{
+  tHeapBlock * nextPtr = TbxHeapBlockNext(blockPtr);
+  nextPtr->size &= ~TBX_HEAP_BLOCK_PREV_FREE_BIT;
+  blockPtr->size &= ~TBX_HEAP_BLOCK_FREE_BIT;
+} /*** end of TbxHeapBlockMarkUsed ***/
+
+
+/************************************************************************************//**
+** \brief     Inserts a free block at the start of the free list that fits its size.
+** \param     blockPtr Pointer to the block.
+**
+****************************************************************************************/
+static void TbxHeapListInsert(tHeapBlock * blockPtr)
+{
+  uint8_t fl;
+  uint8_t sl;
+
+  /* Determine the free list. */
+  TbxHeapMapping(TbxHeapBlockSize(blockPtr), &fl, &sl);
+  /* Insert the block at the start of the free list. */
+  blockPtr->prevFreePtr = NULL;
+  blockPtr->nextFreePtr = tbxHeapFreeLists[fl][sl];
+  if (blockPtr->nextFreePtr != NULL)
+  {
+    blockPtr->nextFreePtr->prevFreePtr = blockPtr;
+  }
+  tbxHeapFreeLists[fl][sl] = blockPtr;
+  /* Flag the free list as non-empty. */
+  tbxHeapFlBitmap |= (uint32_t)1U << fl;
+  tbxHeapSlBitmap[fl] |= (uint32_t)1U << sl;
+  /* Update the statistics. */
+  tbxHeapFree += TbxHeapBlockSize(blockPtr);
+} /*** end of TbxHeapListInsert ***/
+
+
+/************************************************************************************//**
+** \brief     Removes a free block from its free list.
+** \param     blockPtr Pointer to the block.
+**
+****************************************************************************************/
+static void TbxHeapListRemove(tHeapBlock * blockPtr)
+{
+  uint8_t fl;
+  uint8_t sl;
+
+  /* Determine the free list. */
+  TbxHeapMapping(TbxHeapBlockSize(blockPtr), &fl, &sl);
+  /* Unlink the block from its neighbors in the free list. */
+  if (blockPtr->prevFreePtr != NULL)
+  {
+    blockPtr->prevFreePtr->nextFreePtr = blockPtr->nextFreePtr;
+  }
+  else
+  {
+    tbxHeapFreeLists[fl][sl] = blockPtr->nextFreePtr;
+    /* Flag the free list as empty, if this was the last block. */
+    if (blockPtr->nextFreePtr == NULL)
+    {
+      tbxHeapSlBitmap[fl] &= ~((uint32_t)1U << sl);
+      if (tbxHeapSlBitmap[fl] == 0U)
+      {
+        tbxHeapFlBitmap &= ~((uint32_t)1U << fl);
+      }
+    }
+  }
+  if (blockPtr->nextFreePtr != NULL)
+  {
+    blockPtr->nextFreePtr->prevFreePtr = blockPtr->prevFreePtr;
+  }
+  /* Update the statistics. */
+  tbxHeapFree -= TbxHeapBlockSize(blockPtr);
+} /*** end of TbxHeapListRemove ***/
+
+
+/************************************************************************************//**
+** \brief     Locates a free block that is at least the specified size and removes it
+**            from its free list. The size is rounded up to the next free list, such
+**            that all blocks in that free list are large enough.
+** \param     size Minimum block size.
+** \return    Pointer to the block if successful, NULL otherwise.
+**
+****************************************************************************************/
+static tHeapBlock * TbxHeapListLocate(size_t size)
+{
+  tHeapBlock * result = NULL;
+  uint8_t      fl;
+  uint8_t      sl;
+  uint32_t     slMap;
+  uint32_t     flMap;
+
+  /* Round up to the next free list. */
+  if (size >= ((size_t)1U << TBX_HEAP_FL_SHIFT))
+  {
+    size += ((size_t)1U << (TbxHeapBitLast(size) - TBX_HEAP_SL_COUNT_LOG2)) - 1U;
+  }
+  TbxHeapMapping(size, &fl, &sl);
+  /* Only continue if the free list exists. */
+  if (fl < TBX_HEAP_FL_COUNT)
+  {
+    /* Search for a non-empty free list in this first level, starting at the second 
+     * level.
+     */
+    slMap = tbxHeapSlBitmap[fl] & (~(uint32_t)0U << sl);
+    /* None found, so search for the next non-empty first level. */
+    if (slMap == 0U)
+    {
+      flMap = tbxHeapFlBitmap & (~(uint32_t)0U << (fl + 1U));
+      if (flMap != 0U)
+      {
+        fl = TbxHeapBitFirst(flMap);
+        slMap = tbxHeapSlBitmap[fl];
+      }
+    }
+    /* Remove the first block from the non-empty free list, if one was found. */
+    if (slMap != 0U)
+    {
+      sl = TbxHeapBitFirst(slMap);
+      result = tbxHeapFreeLists[fl][sl];
+      TbxHeapListRemove(result);
+    }
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxHeapListLocate ***/
+
+
+/************************************************************************************//**
+** \brief     Splits a block in two. The block keeps the specified size and the
+**            remaining part becomes a new free block, which is not yet in a free list.
+** \param     blockPtr Pointer to the block to split.
+** \param     size New size of the block.
+** \return    Pointer to the remaining block.
+**
+****************************************************************************************/
+static tHeapBlock * TbxHeapBlockSplit(tHeapBlock * blockPtr,
+                                      size_t       size)
+{
+  tHeapBlock * remainingPtr;
+  size_t       remainingSize;
+  size_t       flags = blockPtr->size & (TBX_HEAP_BLOCK_FREE_BIT | 
+                                         TBX_HEAP_BLOCK_PREV_FREE_BIT);
+
+  /* The remaining block starts right after the block's new size. */
+  remainingPtr = (tHeapBlock *)(void *)((uint8_t *)blockPtr + 
+                 TBX_HEAP_BLOCK_DATA_OFFSET + size - TBX_HEAP_BLOCK_OVERHEAD);
+  remainingSize = TbxHeapBlockSize(blockPtr) - (size + TBX_HEAP_BLOCK_OVERHEAD);
+  remainingPtr->size = remainingSize;
+  /* Update the block's size. */
+  blockPtr->size = size | flags;
+  /* Flag the remaining block as free. */
+  TbxHeapBlockMarkFree(remainingPtr);
+  /* Give the result back to the caller. */
+  return remainingPtr;
+} /*** end of TbxHeapBlockSplit ***/
+
+
+/************************************************************************************//**
+** \brief     Merges a block with its previous physical block.
+** \param     prevPtr Pointer to the previous physical block.
+** \param     blockPtr Pointer to the block.
+** \return    Pointer to the merged block.
+**
+****************************************************************************************/
+static tHeapBlock * TbxHeapBlockAbsorb(tHeapBlock       * prevPtr,
+                                       tHeapBlock const * blockPtr)
+{
+  /* The previous block grows with this block, including its header. */
+  prevPtr->size += TbxHeapBlockSize(blockPtr) + TBX_HEAP_BLOCK_OVERHEAD;
+  (void)TbxHeapBlockLinkNext(prevPtr);
+  /* Give the result back to the caller. */
+  return prevPtr;
+} /*** end of TbxHeapBlockAbsorb ***/
+
+
+/************************************************************************************//**
+** \brief     Trims a located free block to the specified size, returns the rest to the
+**            free lists and marks the block as used.
+** \param     blockPtr Pointer to the block.
+** \param     size Wanted data size.
+** \return    Pointer to the block's data.
+**
+****************************************************************************************/
+static void * TbxHeapBlockPrepare(tHeapBlock * blockPtr,
+                                  size_t       size)
+{
+  /* Only split if the remaining part is large enough to become a free block. */
+  if (TbxHeapBlockSize(blockPtr) >= (sizeof(tHeapBlock) + size))
+  {
+    tHeapBlock * remainingPtr = TbxHeapBlockSplit(blockPtr, size);
+    (void)TbxHeapBlockLinkNext(blockPtr);
+    remainingPtr->size |= TBX_HEAP_BLOCK_PREV_FREE_BIT;
+    TbxHeapListInsert(remainingPtr);
+  }
+  /* Flag the block as used. */
+  TbxHeapBlockMarkUsed(blockPtr);
+  /* Update the statistics. */
+  if (tbxHeapFree < tbxHeapMinFree)
+  {
+    tbxHeapMinFree = tbxHeapFree;
+  }
+  /* Give the block's data back to the caller. */
+  return (uint8_t *)blockPtr + TBX_HEAP_BLOCK_DATA_OFFSET;
+} /*** end of TbxHeapBlockPrepare ***/
+
+
+/************************************************************************************//**
+** \brief     Aligns the requested size to the address size and makes sure it is within
+**            the block size limits.
+** \param     size Requested size.
+** \return    Adjusted size or 0 if the size is too large.
+**
+****************************************************************************************/
+static size_t TbxHeapAdjustSize(size_t size)
+{
+  size_t result = 0U;
+
+  /* Only continue if the size is not too large. */
+  if (size < TBX_HEAP_BLOCK_SIZE_MAX)
+  {
+    /* Align the size. */
+    result = (size + (TBX_HEAP_ALIGN_SIZE - 1U)) & ~(TBX_HEAP_ALIGN_SIZE - 1U);
+    /* Each block must be at least large enough to hold the free list pointers. */
+    if (result < TBX_HEAP_BLOCK_SIZE_MIN)
+    {
+      result = TBX_HEAP_BLOCK_SIZE_MIN;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxHeapAdjustSize ***/
+
+
+#else /* (TBX_CONF_HEAP_TLSF_ENABLE > 0U) */
+/****************************************************************************************
+*   L I N E A R   H E A P
+****************************************************************************************/
 /****************************************************************************************
 * Local data declarations
 ****************************************************************************************/
@@ -69,33 +920,50 @@ static size_t tbxHeapAllocated = 0U;
 ****************************************************************************************/
 void * TbxHeapAllocate(size_t size)
 {
-  /* cppcheck-suppress [unassignedVariable,unmatchedSuppression] 
-   * The actual heap buffer. Whenever memory needs to be dynamically allocated, it will
-   * be taken from this buffer. As such, it is okay to not be initialized and therefore
-   * the warning about no value being assigned to this variable can be ignored.
-   */
-  static uint8_t   tbxHeapBuffer[TBX_CONF_HEAP_SIZE];
-  void           * result = NULL;
+  /* Allocate with the default alignment, which is the address size. */
+  return TbxHeapAllocateAligned(size, sizeof(void *));
+} /*** end of TbxHeapAllocate ***/
 
-  /* Verify parameter. */
+
+/************************************************************************************//**
+** \brief     Allocates the desired number of bytes on the heap, at an address that is
+**            aligned to the specified number of bytes. The bytes skipped to reach the
+**            alignment are lost.
+** \param     size The number of bytes to allocate on the heap.
+** \param     alignment Alignment of the address in bytes. Must be a power of two.
+** \return    Pointer to the start of the newly allocated heap memory if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+void * TbxHeapAllocateAligned(size_t size,
+                              size_t alignment)
+{
+  void   * result = NULL;
+  uint8_t * heapPtr = (uint8_t *)&tbxHeapBuffer[0];
+
+  /* Verify parameters. */
   TBX_ASSERT(size > 0U);
+  TBX_ASSERT((alignment > 0U) && ((alignment & (alignment - 1U)) == 0U));
 
   /* Only continue if the parameters are valid. */
-  if (size > 0U)
+  if ( (size > 0U) && (alignment > 0U) && ((alignment & (alignment - 1U)) == 0U) )
   {
     /* Align the desired size to the address size to make it work on all targets. */
     size_t sizeWanted = (size + (sizeof(void *) - 1U)) & ~(sizeof(void *) - 1U);
     /* Obtain mutual exclusive access to tbxHeapAllocated. */
     TbxCriticalSectionEnter();
-      /* Determine the number of still available bytes in the heap buffer. */
+    /* Determine the number of bytes to skip to reach the alignment. */
+    uintptr_t freeAddr = (uintptr_t)&heapPtr[tbxHeapAllocated];
+    size_t gap = (size_t)(((freeAddr + (alignment - 1U)) & ~(alignment - 1U)) - freeAddr);
+    /* Determine the number of still available bytes in the heap buffer. */
     size_t sizeAvailable = TBX_CONF_HEAP_SIZE - tbxHeapAllocated;
     /* Is there enough space left on the heap for this allocation request? */
-    if (sizeAvailable >= sizeWanted)
+    if ( (sizeAvailable >= sizeWanted) && ((sizeAvailable - sizeWanted) >= gap) )
     {
       /* Set the address for the newly allocated memory. */
-      result = &tbxHeapBuffer[tbxHeapAllocated];
+      result = &heapPtr[tbxHeapAllocated + gap];
       /* Perform the actual allocation by incrementing the counter. */
-      tbxHeapAllocated += sizeWanted;
+      tbxHeapAllocated += gap + sizeWanted;
     }
     /* Release mutual exclusive access to tbxHeapAllocated. */
     TbxCriticalSectionExit();
@@ -103,7 +971,22 @@ void * TbxHeapAllocate(size_t size)
 
   /* Return the address of the allocated memory to the caller. */
   return result;
-} /*** end of TbxHeapAllocate ***/
+} /*** end of TbxHeapAllocateAligned ***/
+
+
+/************************************************************************************//**
+** \brief     Freeing memory is not supported by the linear heap. Enable the TLSF heap
+**            with configuration macro TBX_CONF_HEAP_TLSF_ENABLE if needed.
+** \param     memPtr Pointer to the memory.
+**
+****************************************************************************************/
+void TbxHeapFree(void * memPtr)
+{
+  TBX_UNUSED_ARG(memPtr);
+
+  /* Flag the unsupported operation. */
+  TBX_ASSERT(TBX_FALSE);
+} /*** end of TbxHeapFree ***/
 
 
 /************************************************************************************//**
@@ -127,4 +1010,29 @@ size_t TbxHeapGetFree(void)
 } /*** end of TbxHeapGetFree ***/
 
 
+/************************************************************************************//**
+** \brief     Obtains the run-time statistics of the heap. Since memory cannot be freed,
+**            the free bytes always form one block and also equal the lowest number of
+**            free bytes.
+** \param     stats Pointer to where the statistics are written to.
+**
+****************************************************************************************/
+void TbxHeapGetStats(tTbxHeapStats * stats)
+{
+  /* Verify parameter. */
+  TBX_ASSERT(stats != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (stats != NULL)
+  {
+    stats->size = TBX_CONF_HEAP_SIZE;
+    stats->free = TbxHeapGetFree();
+    stats->minFree = stats->free;
+    stats->largestFree = stats->free;
+    stats->fragmentation = 0U;
+  }
+} /*** end of TbxHeapGetStats ***/
+#endif /* (TBX_CONF_HEAP_TLSF_ENABLE > 0U) */
+
+
 /*********************************** end of tbx_heap.c *********************************/
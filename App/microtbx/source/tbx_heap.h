@@ -39,12 +39,61 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_CONF_HEAP_TLSF_ENABLE
+/** \brief Enable/disable the two-level segregated fit (TLSF) heap manager. When
+ *         disabled, the heap is a simple linear allocator that does not support freeing
+ *         of allocated memory. When enabled, allocated memory can be freed again with
+ *         TbxHeapFree(). Note that it is possible to override this value by adding this
+ *         macro definition to the configuration header file.
+ */
+#define TBX_CONF_HEAP_TLSF_ENABLE                (0U)
+#endif
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Run-time statistics of the heap, obtained with TbxHeapGetStats(). */
+typedef struct
+{
+  /** \brief Total number of bytes managed by the heap. */
+  size_t  size;
+  /** \brief Number of bytes that are currently free. */
+  size_t  free;
+  /** \brief Lowest number of free bytes since the first allocation. The heap's high-water
+   *         mark equals size - minFree.
+   */
+  size_t  minFree;
+  /** \brief Largest number of bytes that TbxHeapAllocate() is guaranteed to allocate at
+   *         this point. With the TLSF heap, this is the size of the largest free block,
+   *         rounded down to the lower boundary of its free list. The allocation rounds a
+   *         request up to the next free list boundary, so a request between the two
+   *         could fail, even though a large enough block is free.
+   */
+  size_t  largestFree;
+  /** \brief External fragmentation in percent: 0 when all free bytes are available as
+   *         one block. Based on the size of the largest free block.
+   */
+  uint8_t fragmentation;
+} tTbxHeapStats;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-void * TbxHeapAllocate(size_t size);
+void * TbxHeapAllocate       (size_t          size);
+
+void * TbxHeapAllocateAligned(size_t          size,
+                              size_t          alignment);
+
+void   TbxHeapFree           (void          * memPtr);
+
+size_t TbxHeapGetFree        (void);
 
-size_t TbxHeapGetFree (void);
+void   TbxHeapGetStats       (tTbxHeapStats * stats);
 
 
 #ifdef __cplusplus
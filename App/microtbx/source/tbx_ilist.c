@@ -0,0 +1,646 @@
+/************************************************************************************//**
+* \file         tbx_ilist.c
+* \brief        Intrusive linked lists source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX global header             */
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void            TbxIListUnlink    (tTbxIList             * list,
+                                          tTbxIListLink   const * link);
+
+static void            TbxIListLinkBefore(tTbxIList             * list,
+                                          tTbxIListLink         * link,
+                                          tTbxIListLink         * linkRef);
+
+static tTbxIListLink * TbxIListMergeRuns (tTbxIList             * list,
+                                          tTbxIListLink   const * prevLinkPtr,
+                                          size_t                  leftCount,
+                                          size_t                  rightCount,
+                                          tTbxIListCompareLinks   compareLinksFcn);
+
+
+/************************************************************************************//**
+** \brief     Initializes an intrusive linked list as an empty list.
+** \param     list Pointer to the list to initialize.
+**
+****************************************************************************************/
+void TbxIListInit(tTbxIList * list)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(list != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (list != NULL)
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Set the list to empty. */
+    list->firstLinkPtr = NULL;
+    list->lastLinkPtr = NULL;
+    list->linkCount = 0U;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxIListInit ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the number of items that are currently stored in the list.
+** \param     list Pointer to the list to operate on.
+** \return    Total number of items currently stored in the list.
+**
+****************************************************************************************/
+size_t TbxIListGetSize(tTbxIList const * list)
+{
+  size_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(list != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (list != NULL)
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Store the current number of items in the list in the result variable. */
+    result = list->linkCount;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxIListGetSize ***/
+
+
+/************************************************************************************//**
+** \brief     Inserts an item into the list. The item will be added at the start of the
+**            list.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item to insert.
+**
+****************************************************************************************/
+void TbxIListInsertFront(tTbxIList     * list,
+                         tTbxIListLink * link)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (link != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (link != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Check if the list is not empty. */
+    if (list->firstLinkPtr != NULL)
+    {
+      /* Link the item in front of the current start of the list. */
+      TbxIListLinkBefore(list, link, list->firstLinkPtr);
+    }
+    /* The list is currently empty. */
+    else
+    {
+      /* The item will be the only one, so it is both the first and the last. */
+      link->prevLinkPtr = NULL;
+      link->nextLinkPtr = NULL;
+      list->firstLinkPtr = link;
+      list->lastLinkPtr = link;
+    }
+    /* Increment the link counter. */
+    list->linkCount++;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxIListInsertFront ***/
+
+
+/************************************************************************************//**
+** \brief     Inserts an item into the list. The item will be added at the end of the
+**            list.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item to insert.
+**
+****************************************************************************************/
+void TbxIListInsertBack(tTbxIList     * list,
+                        tTbxIListLink * link)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (link != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (link != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Add the item after the current end of the list. */
+    link->prevLinkPtr = list->lastLinkPtr;
+    link->nextLinkPtr = NULL;
+    /* Check if the list is not empty. */
+    if (list->lastLinkPtr != NULL)
+    {
+      list->lastLinkPtr->nextLinkPtr = link;
+    }
+    /* The list is currently empty, so the item is also the first one. */
+    else
+    {
+      list->firstLinkPtr = link;
+    }
+    list->lastLinkPtr = link;
+    /* Increment the link counter. */
+    list->linkCount++;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxIListInsertBack ***/
+
+
+/************************************************************************************//**
+** \brief     Inserts an item into the list, in front of the reference item.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item to insert.
+** \param     linkRef Pointer to the link of the reference item, which must already be in
+**            the list.
+**
+****************************************************************************************/
+void TbxIListInsertBefore(tTbxIList     * list,
+                          tTbxIListLink * link,
+                          tTbxIListLink * linkRef)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (link != NULL) && (linkRef != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (link != NULL) && (linkRef != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Link the item in front of the reference item. */
+    TbxIListLinkBefore(list, link, linkRef);
+    /* Increment the link counter. */
+    list->linkCount++;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxIListInsertBefore ***/
+
+
+/************************************************************************************//**
+** \brief     Inserts an item into the list, after the reference item.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item to insert.
+** \param     linkRef Pointer to the link of the reference item, which must already be in
+**            the list.
+**
+****************************************************************************************/
+void TbxIListInsertAfter(tTbxIList     * list,
+                         tTbxIListLink * link,
+                         tTbxIListLink * linkRef)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (link != NULL) && (linkRef != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (link != NULL) && (linkRef != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Link the item after the reference item. */
+    link->prevLinkPtr = linkRef;
+    link->nextLinkPtr = linkRef->nextLinkPtr;
+    /* Is the reference item not the end of the list? */
+    if (linkRef->nextLinkPtr != NULL)
+    {
+      linkRef->nextLinkPtr->prevLinkPtr = link;
+    }
+    /* The item becomes the new end of the list. */
+    else
+    {
+      list->lastLinkPtr = link;
+    }
+    linkRef->nextLinkPtr = link;
+    /* Increment the link counter. */
+    list->linkCount++;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxIListInsertAfter ***/
+
+
+/************************************************************************************//**
+** \brief     Removes an item from the list. This takes constant time, because the item
+**            holds its own link, so there is no need to search for it.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item to remove, which must be in the list.
+**
+****************************************************************************************/
+void TbxIListRemove(tTbxIList     * list,
+                    tTbxIListLink * link)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (link != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (link != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Sanity check. The list should not be empty. */
+    TBX_ASSERT(list->linkCount > 0U);
+    /* Only continue if the sanity check passed. */
+    if (list->linkCount > 0U)
+    {
+      /* Unlink the item from its neighbors. */
+      TbxIListUnlink(list, link);
+      link->prevLinkPtr = NULL;
+      link->nextLinkPtr = NULL;
+      /* Decrement the link counter. */
+      list->linkCount--;
+    }
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxIListRemove ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the item at the start of the list. Note that the item is just read,
+**            not removed.
+** \param     list Pointer to the list to operate on.
+** \return    Pointer to the link of the item at the start of the list or NULL if the
+**            list is empty.
+**
+****************************************************************************************/
+tTbxIListLink * TbxIListGetFirst(tTbxIList const * list)
+{
+  tTbxIListLink * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(list != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (list != NULL)
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Read the start of the list. */
+    result = list->firstLinkPtr;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxIListGetFirst ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the item at the end of the list. Note that the item is just read,
+**            not removed.
+** \param     list Pointer to the list to operate on.
+** \return    Pointer to the link of the item at the end of the list or NULL if the list
+**            is empty.
+**
+****************************************************************************************/
+tTbxIListLink * TbxIListGetLast(tTbxIList const * list)
+{
+  tTbxIListLink * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(list != NULL);
+
+  /* Only continue if the parameter is valid. */
+  if (list != NULL)
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Read the end of the list. */
+    result = list->lastLinkPtr;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxIListGetLast ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the item that is located one position up in the list, relative to
+**            the reference item. Note that the item is just read, not removed.
+** \param     list Pointer to the list to operate on.
+** \param     linkRef Pointer to the link of the reference item.
+** \return    Pointer to the link of the previous item or NULL if the reference item is
+**            at the start of the list.
+**
+****************************************************************************************/
+tTbxIListLink * TbxIListGetPrevious(tTbxIList     const * list,
+                                    tTbxIListLink const * linkRef)
+{
+  tTbxIListLink * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (linkRef != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (linkRef != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Read the previous item. */
+    result = linkRef->prevLinkPtr;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxIListGetPrevious ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the item that is located one position down in the list, relative
+**            to the reference item. Note that the item is just read, not removed.
+** \param     list Pointer to the list to operate on.
+** \param     linkRef Pointer to the link of the reference item.
+** \return    Pointer to the link of the next item or NULL if the reference item is at
+**            the end of the list.
+**
+****************************************************************************************/
+tTbxIListLink * TbxIListGetNext(tTbxIList     const * list,
+                                tTbxIListLink const * linkRef)
+{
+  tTbxIListLink * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (linkRef != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (linkRef != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list. */
+    TbxCriticalSectionEnter();
+    /* Read the next item. */
+    result = linkRef->nextLinkPtr;
+    /* Release mutual exclusive access of the list. */
+    TbxCriticalSectionExit();
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxIListGetNext ***/
+
+
+/************************************************************************************//**
+** \brief     Sorts the items in the list. While sorting, it calls the specified callback
+**            function which should do the actual comparison of the items. It is the same
+**            stable bottom-up merge sort as TbxListSortItems().
+** \attention The items are detached from the list and merged with interrupts enabled.
+**            Meanwhile the list reads as empty to other contexts, such as interrupts.
+**            Items that they insert with TbxIListInsertFront() or TbxIListInsertBack()
+**            end up behind the sorted items. They must not remove or insert relative to
+**            the items that are being sorted.
+** \param     list Pointer to the list to operate on.
+** \param     compareLinksFcn Callback function that does the item comparison.
+**
+****************************************************************************************/
+void TbxIListSort(tTbxIList             * list,
+                  tTbxIListCompareLinks   compareLinksFcn)
+{
+  tTbxIList       chain;
+  size_t          runSize;
+  size_t          runStart;
+  size_t          rightCount;
+  tTbxIListLink * runPrevLinkPtr;
+
+  /* Verify parameters. */
+  TBX_ASSERT((list != NULL) && (compareLinksFcn != NULL));
+
+  /* Only continue if the parameters are valid. */
+  if ( (list != NULL) && (compareLinksFcn != NULL) )
+  {
+    /* Obtain mutual exclusive access to the list, just to detach its items. */
+    TbxCriticalSectionEnter();
+    chain = *list;
+    list->firstLinkPtr = NULL;
+    list->lastLinkPtr = NULL;
+    list->linkCount = 0U;
+    TbxCriticalSectionExit();
+    /* Each pass merges all pairs of neighboring runs. Initially each item is a sorted
+     * run by itself. Continue until one run spans the entire chain.
+     */
+    for (runSize = 1U; runSize < chain.linkCount; runSize *= 2U)
+    {
+      /* Start at the first run in the chain, which has no item in front of it. */
+      runPrevLinkPtr = NULL;
+      /* Loop over all pairs of runs. Note that a left run without a right run, at the
+       * end of the chain, is already sorted.
+       */
+      for (runStart = 0U; (runStart + runSize) < chain.linkCount;
+           runStart += 2U * runSize)
+      {
+        /* The right run is shorter at the end of the chain. */
+        rightCount = chain.linkCount - runStart - runSize;
+        if (rightCount > runSize)
+        {
+          rightCount = runSize;
+        }
+        /* Merge the runs and continue after the merged run. */
+        runPrevLinkPtr = TbxIListMergeRuns(&chain, runPrevLinkPtr, runSize, rightCount,
+                                           compareLinksFcn);
+      }
+    }
+    /* Only relink a chain that holds items. */
+    if (chain.linkCount > 0U)
+    {
+      /* Obtain mutual exclusive access to the list, while the sorted items are put
+       * back in front of the items that were inserted meanwhile.
+       */
+      TbxCriticalSectionEnter();
+      if (list->firstLinkPtr != NULL)
+      {
+        chain.lastLinkPtr->nextLinkPtr = list->firstLinkPtr;
+        list->firstLinkPtr->prevLinkPtr = chain.lastLinkPtr;
+        chain.lastLinkPtr = list->lastLinkPtr;
+      }
+      list->firstLinkPtr = chain.firstLinkPtr;
+      list->lastLinkPtr = chain.lastLinkPtr;
+      list->linkCount += chain.linkCount;
+      /* Release mutual exclusive access of the list. */
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxIListSort ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to unlink an item from its neighbors. The link counter and
+**            the item's own link are not changed.
+** \attention Should be called with mutual exclusive access to the list.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item.
+**
+****************************************************************************************/
+static void TbxIListUnlink(tTbxIList           * list,
+                           tTbxIListLink const * link)
+{
+  /* Connect the previous item to the next item. */
+  if (link->prevLinkPtr != NULL)
+  {
+    link->prevLinkPtr->nextLinkPtr = link->nextLinkPtr;
+  }
+  else
+  {
+    list->firstLinkPtr = link->nextLinkPtr;
+  }
+  /* Connect the next item to the previous item. */
+  if (link->nextLinkPtr != NULL)
+  {
+    link->nextLinkPtr->prevLinkPtr = link->prevLinkPtr;
+  }
+  else
+  {
+    list->lastLinkPtr = link->prevLinkPtr;
+  }
+} /*** end of TbxIListUnlink ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to link an item in front of the reference item. The link
+**            counter is not changed.
+** \attention Should be called with mutual exclusive access to the list.
+** \param     list Pointer to the list to operate on.
+** \param     link Pointer to the link of the item.
+** \param     linkRef Pointer to the link of the reference item.
+**
+****************************************************************************************/
+static void TbxIListLinkBefore(tTbxIList     * list,
+                               tTbxIListLink * link,
+                               tTbxIListLink * linkRef)
+{
+  /* Connect the item to its new neighbors. */
+  link->prevLinkPtr = linkRef->prevLinkPtr;
+  link->nextLinkPtr = linkRef;
+  /* Connect the new neighbors to the item. */
+  if (linkRef->prevLinkPtr != NULL)
+  {
+    linkRef->prevLinkPtr->nextLinkPtr = link;
+  }
+  else
+  {
+    list->firstLinkPtr = link;
+  }
+  linkRef->prevLinkPtr = link;
+} /*** end of TbxIListLinkBefore ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to merge two neighboring runs of sorted items into one
+**            sorted run. Items of the right run are moved in front of the first item in
+**            the left run that is greater. Equal items keep their order, which makes the
+**            merge stable.
+** \attention Should be called with mutual exclusive access to the list.
+** \param     list Pointer to the list to operate on.
+** \param     prevLinkPtr Pointer to the link in front of the left run or NULL if the
+**            left run starts at the start of the list.
+** \param     leftCount Number of items in the left run.
+** \param     rightCount Number of items in the right run.
+** \param     compareLinksFcn Callback function that does the item comparison.
+** \return    Pointer to the last link of the merged run.
+**
+****************************************************************************************/
+static tTbxIListLink * TbxIListMergeRuns(tTbxIList             * list,
+                                         tTbxIListLink   const * prevLinkPtr,
+                                         size_t                  leftCount,
+                                         size_t                  rightCount,
+                                         tTbxIListCompareLinks   compareLinksFcn)
+{
+  tTbxIListLink * result;
+  tTbxIListLink * leftLinkPtr;
+  tTbxIListLink * rightLinkPtr;
+  tTbxIListLink * endLinkPtr;
+  tTbxIListLink * movedLinkPtr;
+  size_t          idx;
+
+  /* Locate the first item of the left run. */
+  leftLinkPtr = (prevLinkPtr == NULL) ? list->firstLinkPtr : prevLinkPtr->nextLinkPtr;
+  /* Locate the first item of the right run, which follows the left run. */
+  rightLinkPtr = leftLinkPtr;
+  for (idx = 0U; idx < leftCount; idx++)
+  {
+    rightLinkPtr = rightLinkPtr->nextLinkPtr;
+  }
+  /* Locate the item that follows the right run. It stays in place during the merge. */
+  endLinkPtr = rightLinkPtr;
+  for (idx = 0U; idx < rightCount; idx++)
+  {
+    endLinkPtr = endLinkPtr->nextLinkPtr;
+  }
+  /* Keep merging until one of the runs is empty. The remaining items are then already
+   * at the correct location.
+   */
+  while ( (leftCount > 0U) && (rightCount > 0U) )
+  {
+    /* Is the left item greater than the right item? */
+    if (compareLinksFcn(leftLinkPtr, rightLinkPtr) == TBX_TRUE)
+    {
+      /* Move the right item in front of the left item. */
+      movedLinkPtr = rightLinkPtr;
+      rightLinkPtr = rightLinkPtr->nextLinkPtr;
+      TbxIListUnlink(list, movedLinkPtr);
+      TbxIListLinkBefore(list, movedLinkPtr, leftLinkPtr);
+      rightCount--;
+    }
+    else
+    {
+      /* The left item is at the correct location. Continue with the next one. */
+      leftLinkPtr = leftLinkPtr->nextLinkPtr;
+      leftCount--;
+    }
+  }
+  /* The merged run ends right in front of the item that followed the right run. */
+  result = (endLinkPtr == NULL) ? list->lastLinkPtr : endLinkPtr->prevLinkPtr;
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxIListMergeRuns ***/
+
+
+/*********************************** end of tbx_ilist.c ********************************/
@@ -0,0 +1,134 @@
+/************************************************************************************//**
+* \file         tbx_ilist.h
+* \brief        Intrusive linked lists header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2024 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBX_ILIST_H
+#define TBX_ILIST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Obtains the pointer to the item that contains the link. For example, when the
+ *         item is of type tMsg and its link member is called link:
+ *         tMsg * msg = TBX_ILIST_ITEM(linkPtr, tMsg, link);
+ */
+#define TBX_ILIST_ITEM(linkPtr, type, member) \
+  ((type *)(void *)((uint8_t *)(linkPtr) - offsetof(type, member)))
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Layout of the link that connects an item to its neighbors in an intrusive
+ *         linked list. It is a member of the item itself, so no memory needs to be
+ *         allocated when inserting the item. Note that its elements should be
+ *         considered private and only be accessed internally by this module.
+ */
+typedef struct t_tbx_ilist_link
+{
+  /** \brief Pointer to the previous link in the list or NULL if it is the list start. */
+  struct t_tbx_ilist_link * prevLinkPtr;
+  /** \brief Pointer to the next link in the list or NULL if it is the list end. */
+  struct t_tbx_ilist_link * nextLinkPtr;
+} tTbxIListLink;
+
+/** \brief Layout of an intrusive linked list. Note that its elements should be
+ *         considered private and only be accessed internally by this module.
+ */
+typedef struct
+{
+  /** \brief Total number of links that are currently present in the list. */
+  size_t          linkCount;
+  /** \brief Pointer to the first link of the list, also known as the head. */
+  tTbxIListLink * firstLinkPtr;
+  /** \brief Pointer to the last link of the list, also known as the tail. */
+  tTbxIListLink * lastLinkPtr;
+} tTbxIList;
+
+/** \brief Callback function to compare items. It is called during list sorting. The
+ *         return value of the callback function has the following meaning: TBX_TRUE if
+ *         the data of link1's item is greater than the data of link2's item, TBX_FALSE
+ *         otherwise.
+ */
+typedef uint8_t (* tTbxIListCompareLinks)(tTbxIListLink const * link1, 
+                                          tTbxIListLink const * link2);
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+void            TbxIListInit         (tTbxIList                   * list);
+
+size_t          TbxIListGetSize      (tTbxIList             const * list);
+
+void            TbxIListInsertFront  (tTbxIList                   * list,
+                                      tTbxIListLink               * link);
+
+void            TbxIListInsertBack   (tTbxIList                   * list,
+                                      tTbxIListLink               * link);
+
+void            TbxIListInsertBefore (tTbxIList                   * list,
+                                      tTbxIListLink               * link,
+                                      tTbxIListLink               * linkRef);
+
+void            TbxIListInsertAfter  (tTbxIList                   * list,
+                                      tTbxIListLink               * link,
+                                      tTbxIListLink               * linkRef);
+
+void            TbxIListRemove       (tTbxIList                   * list,
+                                      tTbxIListLink               * link);
+
+tTbxIListLink * TbxIListGetFirst     (tTbxIList             const * list);
+
+tTbxIListLink * TbxIListGetLast      (tTbxIList             const * list);
+
+tTbxIListLink * TbxIListGetPrevious  (tTbxIList             const * list,
+                                      tTbxIListLink         const * linkRef);
+
+tTbxIListLink * TbxIListGetNext      (tTbxIList             const * list,
+                                      tTbxIListLink         const * linkRef);
+
+void            TbxIListSort         (tTbxIList                   * list,
+                                      tTbxIListCompareLinks         compareLinksFcn);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBX_ILIST_H */
+/*********************************** end of tbx_ilist.h ********************************/
@@ -46,6 +46,23 @@
 static tTbxListNode * TbxListFindListNode(tTbxList const * list, 
                                           void     const * item);
 
+static tTbxListNode * TbxListMergeRuns   (tTbxListNode        ** firstNodePtr,
+                                          tTbxListNode        ** lastNodePtr,
+                                          tTbxListNode   const * prevNodePtr,
+                                          size_t                 leftCount,
+                                          size_t                 rightCount,
+                                          tTbxListCompareItems   compareItemsFcn);
+
+static void           TbxListMoveNode    (tTbxListNode        ** firstNodePtr,
+                                          tTbxListNode        ** lastNodePtr,
+                                          tTbxListNode         * nodePtr,
+                                          tTbxListNode         * nodeRefPtr);
+
+static void           TbxListExchangeNodes(tTbxListNode      ** firstNodePtr,
+                                           tTbxListNode      ** lastNodePtr,
+                                           tTbxListNode       * node1Ptr,
+                                           tTbxListNode       * node2Ptr);
+
 
 /************************************************************************************//**
 ** \brief     Creates a new and empty linked list and returns its pointer. Make sure to
@@ -880,7 +897,16 @@ void TbxListSwapItems(tTbxList const * list,
 
 /************************************************************************************//**
 ** \brief     Sorts the items in the list. While sorting, it calls the specified callback
-**            function which should do the actual comparison of the items.
+**            function which should do the actual comparison of the items. It is a
+**            stable bottom-up merge sort on the node links, so it takes O(n log n)
+**            comparisons and does not need additional memory. Neighboring runs of
+**            sorted nodes are merged, doubling the run size with each pass. Afterwards,
+**            the nodes at the start and the end of the list are exchanged back into
+**            place, such that the list itself is not modified.
+** \attention The critical section is only held to take the list's nodes at the start
+**            and to put its first and last nodes back in place at the end. The nodes
+**            are merged with interrupts enabled, so the list must not be accessed by
+**            another context, such as an interrupt, while it is sorted.
 ** \param     list Pointer to a previously created linked list to operate on.
 ** \param     compareItemsFcn Callback function that does the item comparison.
 **
@@ -888,9 +914,15 @@ void TbxListSwapItems(tTbxList const * list,
 void TbxListSortItems(tTbxList             const * list, 
                       tTbxListCompareItems         compareItemsFcn)
 {
-  tTbxListNode * currentNode;
-  tTbxListNode * idxNode;
-  void         * tempItemPtr;
+  size_t         nodeCount;
+  size_t         runSize;
+  size_t         runStart;
+  size_t         rightCount;
+  tTbxListNode * runPrevNodePtr;
+  tTbxListNode * firstNodePtr;
+  tTbxListNode * lastNodePtr;
+  tTbxListNode * listFirstNodePtr;
+  tTbxListNode * listLastNodePtr;
 
   /* Verify parameters. */
   TBX_ASSERT(list != NULL);
@@ -899,44 +931,50 @@ void TbxListSortItems(tTbxList             const * list,
   /* Only continue if the parameters are valid. */
   if ( (list != NULL) && (compareItemsFcn != NULL) )
   {
-    /* Obtain mutual exclusive access to the list. */
+    /* Obtain mutual exclusive access to the list, just to take its nodes. */
     TbxCriticalSectionEnter();
-    /* To accomplish the sort, we maintain two pointers: current and index. Initially,
-     * current points to head node and index will point to node next to current.
-     * Traverse through the list till current's next node points to NULL, by comparing
-     * current's data with index's data. If the current's data is greater than the
-     * index's data, then swap data between them. Continue this process till the entire
-     * list is sorted in ascending order. It is a basic bubble sort algorithm.
-     */
-    currentNode = list->firstNodePtr;
-    /* Traverse through the entire list. Note that sorting is only done if there are
-     * at least two nodes in the list.
+    nodeCount = list->nodeCount;
+    listFirstNodePtr = list->firstNodePtr;
+    listLastNodePtr = list->lastNodePtr;
+    TbxCriticalSectionExit();
+    /* The merge operates on a copy of the list's first and last node pointers. */
+    firstNodePtr = listFirstNodePtr;
+    lastNodePtr = listLastNodePtr;
+    /* Each pass merges all pairs of neighboring runs. Initially each node is a sorted
+     * run by itself. Continue until one run spans the entire list.
      */
-    while (currentNode->nextNodePtr != NULL)
+    for (runSize = 1U; runSize < nodeCount; runSize *= 2U)
     {
-      /* Point index to the node next to current. */
-      idxNode = currentNode->nextNodePtr;
-      /* Keep looping while the index node is valid. */
-      while (idxNode != NULL)
+      /* Start at the first run in the list, which has no node in front of it. */
+      runPrevNodePtr = NULL;
+      /* Loop over all pairs of runs. Note that a left run without a right run, at the
+       * end of the list, is already sorted.
+       */
+      for (runStart = 0U; (runStart + runSize) < nodeCount; runStart += 2U * runSize)
       {
-        /* If current's data is greater than index's data, swap the data of current and
-         * index.
-         */
-        if (compareItemsFcn(currentNode->itemPtr, idxNode->itemPtr) == TBX_TRUE)
+        /* The right run is shorter at the end of the list. */
+        rightCount = nodeCount - runStart - runSize;
+        if (rightCount > runSize)
         {
-          /* Perform the swap. */
-          tempItemPtr = currentNode->itemPtr;
-          currentNode->itemPtr = idxNode->itemPtr;
-          idxNode->itemPtr = tempItemPtr;
+          rightCount = runSize;
         }
-        /* Move the index node one forward and continue there the next loop. */
-        idxNode = idxNode->nextNodePtr;
+        /* Merge the runs and continue after the merged run. */
+        runPrevNodePtr = TbxListMergeRuns(&firstNodePtr, &lastNodePtr, runPrevNodePtr,
+                                          runSize, rightCount, compareItemsFcn);
       }
-      /* Move the current node one forward and continue there the next loop. */
-      currentNode = currentNode->nextNodePtr;
     }
-    /* Release mutual exclusive access of the list. */
-    TbxCriticalSectionExit();
+    /* Exchange the list's original first and last nodes back to the start and the end.
+     * Their items are exchanged as well, so the sorted order of the items remains.
+     */
+    if (nodeCount > 1U)
+    {
+      /* Obtain mutual exclusive access to the list, while its ends are put back. */
+      TbxCriticalSectionEnter();
+      TbxListExchangeNodes(&firstNodePtr, &lastNodePtr, listFirstNodePtr, firstNodePtr);
+      TbxListExchangeNodes(&firstNodePtr, &lastNodePtr, listLastNodePtr, lastNodePtr);
+      /* Release mutual exclusive access of the list. */
+      TbxCriticalSectionExit();
+    }
   }
 } /*** end of TbxListSortItems ***/
 
@@ -993,4 +1031,189 @@ static tTbxListNode * TbxListFindListNode(tTbxList const * list,
 } /*** end of TbxListFindListNode ***/
 
 
+/************************************************************************************//**
+** \brief     Helper function to merge two neighboring runs of sorted nodes into one
+**            sorted run. Nodes of the right run are moved in front of the first node in
+**            the left run that is greater. Equal nodes keep their order, which makes the
+**            merge stable.
+** \attention Should be called while no other context accesses the nodes.
+** \param     firstNodePtr Pointer to the pointer of the first node in the list.
+** \param     lastNodePtr Pointer to the pointer of the last node in the list.
+** \param     prevNodePtr Pointer to the node in front of the left run or NULL if the
+**            left run starts at the start of the list.
+** \param     leftCount Number of nodes in the left run.
+** \param     rightCount Number of nodes in the right run.
+** \param     compareItemsFcn Callback function that does the item comparison.
+** \return    Pointer to the last node of the merged run.
+**
+****************************************************************************************/
+static tTbxListNode * TbxListMergeRuns(tTbxListNode        ** firstNodePtr,
+                                       tTbxListNode        ** lastNodePtr,
+                                       tTbxListNode   const * prevNodePtr,
+                                       size_t                 leftCount,
+                                       size_t                 rightCount,
+                                       tTbxListCompareItems   compareItemsFcn)
+{
+  tTbxListNode * result;
+  tTbxListNode * leftNodePtr;
+  tTbxListNode * rightNodePtr;
+  tTbxListNode * endNodePtr;
+  tTbxListNode * movedNodePtr;
+  size_t         idx;
+
+  /* Locate the first node of the left run. */
+  leftNodePtr = (prevNodePtr == NULL) ? *firstNodePtr : prevNodePtr->nextNodePtr;
+  /* Locate the first node of the right run, which follows the left run. */
+  rightNodePtr = leftNodePtr;
+  for (idx = 0U; idx < leftCount; idx++)
+  {
+    rightNodePtr = rightNodePtr->nextNodePtr;
+  }
+  /* Locate the node that follows the right run. It stays in place during the merge. */
+  endNodePtr = rightNodePtr;
+  for (idx = 0U; idx < rightCount; idx++)
+  {
+    endNodePtr = endNodePtr->nextNodePtr;
+  }
+  /* Keep merging until one of the runs is empty. The remaining nodes are then already
+   * at the correct location.
+   */
+  while ( (leftCount > 0U) && (rightCount > 0U) )
+  {
+    /* Is the left item greater than the right item? */
+    if (compareItemsFcn(leftNodePtr->itemPtr, rightNodePtr->itemPtr) == TBX_TRUE)
+    {
+      /* Move the right node in front of the left node. */
+      movedNodePtr = rightNodePtr;
+      rightNodePtr = rightNodePtr->nextNodePtr;
+      TbxListMoveNode(firstNodePtr, lastNodePtr, movedNodePtr, leftNodePtr);
+      rightCount--;
+    }
+    else
+    {
+      /* The left node is at the correct location. Continue with the next one. */
+      leftNodePtr = leftNodePtr->nextNodePtr;
+      leftCount--;
+    }
+  }
+  /* The merged run ends right in front of the node that followed the right run. */
+  result = (endNodePtr == NULL) ? *lastNodePtr : endNodePtr->prevNodePtr;
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxListMergeRuns ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to move a node in front of another node in the list.
+** \attention Should be called while no other context accesses the nodes.
+** \param     firstNodePtr Pointer to the pointer of the first node in the list.
+** \param     lastNodePtr Pointer to the pointer of the last node in the list.
+** \param     nodePtr Pointer to the node to move.
+** \param     nodeRefPtr Pointer to the node that the node should be moved in front of or
+**            NULL to move it to the end of the list.
+**
+****************************************************************************************/
+static void TbxListMoveNode(tTbxListNode ** firstNodePtr,
+                            tTbxListNode ** lastNodePtr,
+                            tTbxListNode  * nodePtr,
+                            tTbxListNode  * nodeRefPtr)
+{
+  /* Unlink the node from its current neighbors. */
+  if (nodePtr->prevNodePtr != NULL)
+  {
+    nodePtr->prevNodePtr->nextNodePtr = nodePtr->nextNodePtr;
+  }
+  else
+  {
+    *firstNodePtr = nodePtr->nextNodePtr;
+  }
+  if (nodePtr->nextNodePtr != NULL)
+  {
+    nodePtr->nextNodePtr->prevNodePtr = nodePtr->prevNodePtr;
+  }
+  else
+  {
+    *lastNodePtr = nodePtr->prevNodePtr;
+  }
+  /* Link the node to the end of the list. */
+  if (nodeRefPtr == NULL)
+  {
+    nodePtr->prevNodePtr = *lastNodePtr;
+    nodePtr->nextNodePtr = NULL;
+    if (*lastNodePtr != NULL)
+    {
+      (*lastNodePtr)->nextNodePtr = nodePtr;
+    }
+    else
+    {
+      *firstNodePtr = nodePtr;
+    }
+    *lastNodePtr = nodePtr;
+  }
+  /* Link the node in front of the reference node. */
+  else
+  {
+    nodePtr->prevNodePtr = nodeRefPtr->prevNodePtr;
+    nodePtr->nextNodePtr = nodeRefPtr;
+    if (nodeRefPtr->prevNodePtr != NULL)
+    {
+      nodeRefPtr->prevNodePtr->nextNodePtr = nodePtr;
+    }
+    else
+    {
+      *firstNodePtr = nodePtr;
+    }
+    nodeRefPtr->prevNodePtr = nodePtr;
+  }
+} /*** end of TbxListMoveNode ***/
+
+
+/************************************************************************************//**
+** \brief     Helper function to exchange the location of two nodes in the list,
+**            together with their items. Afterwards, the items are still in the same
+**            order, yet are held by different nodes.
+** \attention Should be called with mutual exclusive access to the list.
+** \param     firstNodePtr Pointer to the pointer of the first node in the list.
+** \param     lastNodePtr Pointer to the pointer of the last node in the list.
+** \param     node1Ptr Pointer to the first node.
+** \param     node2Ptr Pointer to the second node.
+**
+****************************************************************************************/
+static void TbxListExchangeNodes(tTbxListNode ** firstNodePtr,
+                                 tTbxListNode ** lastNodePtr,
+                                 tTbxListNode  * node1Ptr,
+                                 tTbxListNode  * node2Ptr)
+{
+  void         * tempItemPtr;
+  tTbxListNode * node2NextPtr;
+
+  /* Only exchange different nodes. */
+  if (node1Ptr != node2Ptr)
+  {
+    /* Exchange the items. */
+    tempItemPtr = node1Ptr->itemPtr;
+    node1Ptr->itemPtr = node2Ptr->itemPtr;
+    node2Ptr->itemPtr = tempItemPtr;
+    /* Exchange the locations, while taking into account that the nodes could be
+     * neighbors.
+     */
+    if (node1Ptr->nextNodePtr == node2Ptr)
+    {
+      TbxListMoveNode(firstNodePtr, lastNodePtr, node2Ptr, node1Ptr);
+    }
+    else if (node2Ptr->nextNodePtr == node1Ptr)
+    {
+      TbxListMoveNode(firstNodePtr, lastNodePtr, node1Ptr, node2Ptr);
+    }
+    else
+    {
+      node2NextPtr = node2Ptr->nextNodePtr;
+      TbxListMoveNode(firstNodePtr, lastNodePtr, node2Ptr, node1Ptr);
+      TbxListMoveNode(firstNodePtr, lastNodePtr, node1Ptr, node2NextPtr);
+    }
+  }
+} /*** end of TbxListExchangeNodes ***/
+
+
 /*********************************** end of tbx_list.c *********************************/
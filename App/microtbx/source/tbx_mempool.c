@@ -41,83 +41,119 @@
 
 
 /****************************************************************************************
-* Type definitions
+* Configuration macros
 ****************************************************************************************/
-/** \brief Layout of a block node, which forms the building block of a linked list
- *         consisting of data blocks.
+#ifndef TBX_CONF_MEMPOOL_CLASS_GRANULE
+/** \brief Byte granularity of the size class index, which maps an allocation size
+ *         directly to its best fitting memory pool. Note that it is possible to override
+ *         this value by adding this macro definition to the configuration header file.
  */
-typedef struct t_block_node
-{
-  /** \brief Pointer to the block. */
-  void                * blockPtr;
-  /** \brief Pointer to the next node in the list or NULL if it is the list end. */
-  struct t_block_node * nextNodePtr;
-} tBlockNode;
+#define TBX_CONF_MEMPOOL_CLASS_GRANULE           (8U)
+#endif
+
+#ifndef TBX_CONF_MEMPOOL_CLASS_NUM
+/** \brief Number of entries in the size class index. Allocation sizes up to
+ *         TBX_CONF_MEMPOOL_CLASS_NUM * TBX_CONF_MEMPOOL_CLASS_GRANULE bytes are mapped
+ *         to their memory pool in constant time. Larger allocations start searching at
+ *         the memory pool of the last size class. Note that it is possible to override
+ *         this value by adding this macro definition to the configuration header file.
+ */
+#define TBX_CONF_MEMPOOL_CLASS_NUM               (16U)
+#endif
 
-/** \brief Linked list consisting of data block nodes. */
-typedef tBlockNode * tBlockList;
 
-/** \brief Layout of a single memory pool. */
-typedef struct
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/* Forward declaration of the memory pool type. */
+struct t_pool;
+
+/** \brief Layout of the header that precedes the data of each block. While the block is
+ *         allocated, it points to the memory pool that the block belongs to, such that
+ *         it can be released without searching. While the block is free, it links the
+ *         block into the memory pool's free block list. This way no separate node is
+ *         needed per block.
+ */
+typedef union t_block_header
 {
-  /** \brief The number of bytes that fit in one block. */
-  size_t       blockSize;
-  /** \brief Pointer to the linked list with free data block nodes. */
-  tBlockList * freeBlockListPtr;
-  /** \brief Pointer to the linked list with used data block nodes. */
-  tBlockList * usedBlockListPtr;
-} tPool;
-
-/** \brief Layout of a memory pool node, which forms the building block of a linked list
- *         consisting of memory pools.
+  /** \brief Pointer to the memory pool that owns the allocated block. */
+  struct t_pool         * poolPtr;
+  /** \brief Pointer to the next free block or NULL if it is the list end. */
+  union t_block_header  * nextFreePtr;
+} tBlockHeader;
+
+/** \brief Layout of a single memory pool, which also forms the building block of a
+ *         linked list consisting of memory pools, sorted by ascending block size.
  */
-typedef struct t_pool_node
+typedef struct t_pool
 {
-  /** \brief Pointer to the memory pool. */
-  tPool              * poolPtr;
-  /** \brief Pointer to the next node in the list or NULL if it is the list end. */
-  struct t_pool_node * nextNodePtr;
-} tPoolNode;
-
-/** \brief Linked list consisting of memory pool nodes. */
-typedef tPoolNode * tPoolList;
+  /** \brief The number of bytes that fit in one block. */
+  size_t          blockSize;
+  /** \brief Pointer to the first block in the list with free blocks. */
+  tBlockHeader  * freeListPtr;
+  /** \brief Pointer to the next memory pool in the list or NULL if it is the list end. */
+  struct t_pool * nextPoolPtr;
+  /** \brief Points to the memory pool itself. Used for validating the memory pool
+   *         pointer stored in the header of a block that should be released.
+   */
+  struct t_pool * selfPtr;
+  /** \brief Total number of blocks in the memory pool. */
+  size_t          numBlocks;
+  /** \brief Number of blocks that are currently free. */
+  size_t          numFree;
+  /** \brief Lowest number of free blocks since the memory pool was created. */
+  size_t          minFree;
+  /** \brief Number of allocation requests that failed due to no more free blocks. */
+  size_t          numFailed;
+} tPool;
 
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
 /* Pool list management functions */
-static tPoolNode  * TbxMemPoolListFind         (size_t             blockSize);
+static tPool * TbxMemPoolListFind         (size_t         blockSize);
+
+static tPool * TbxMemPoolListFindBestFit  (size_t         blockSize);
 
-static tPoolNode  * TbxMemPoolListFindBestFit  (size_t             blockSize);
+static void    TbxMemPoolListInsert       (tPool        * poolPtr);
 
-static void         TbxMemPoolListInsert       (tPoolNode        * nodePtr);
+static void    TbxMemPoolClassIndexUpdate (void);
 
 /* Block management functions. */
-static void       * TbxMemPoolBlockCreate      (size_t             size);
+static uint8_t TbxMemPoolBlocksCreate     (tPool        * poolPtr,
+                                           size_t         numBlocks);
 
-static void       * TbxMemPoolBlockGetDataPtr  (void             * memPtr);
+static tPool * TbxMemPoolBlockGetPool     (void   const * dataPtr);
 
-static size_t       TbxMemPoolBlockGetBlockSize(void       const * memPtr);
 
-static void       * TbxMemPoolBlockGetMemPtr   (void             * dataPtr);
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Linked list with memory pools, sorted by ascending block size. */
+static tPool * tbxPoolList = NULL;
 
-/* Block list management functions. */
-static tBlockList * TbxMemPoolBlockListCreate  (void);
+/** \brief Size class index. Entry N points to the smallest memory pool with a block size
+ *         larger than N * TBX_CONF_MEMPOOL_CLASS_GRANULE bytes.
+ */
+static tPool * tbxPoolClassIndex[TBX_CONF_MEMPOOL_CLASS_NUM];
 
-static void         TbxMemPoolBlockListInsert  (tBlockList       * listPtr,
-                                                tBlockNode       * nodePtr);
-                                              
-static tBlockNode * TbxMemPoolBlockListExtract (tBlockList       * listPtr);
+/** \brief Lowest address of a memory pool. Used for validating the memory pool pointer
+ *         stored in the header of a block that should be released.
+ */
+static uintptr_t tbxPoolAddrMin = UINTPTR_MAX;
 
-static uint8_t      TbxMemPoolBlockListIsEmpty (tBlockList const * listPtr);
+/** \brief Highest address of a memory pool. */
+static uintptr_t tbxPoolAddrMax = 0U;
 
+/** \brief Lowest address of the memory that holds the blocks of all memory pools. Used
+ *         for validating a pointer that should be released, before its block header is
+ *         read.
+ */
+static uintptr_t tbxBlockAddrMin = UINTPTR_MAX;
 
-/****************************************************************************************
-* Local data declarations
-****************************************************************************************/
-/** \brief Linked list with memory pools. */
-static tPoolList tbxPoolList = NULL;
+/** \brief Address right after the memory that holds the blocks of all memory pools. */
+static uintptr_t tbxBlockAddrEnd = 0U;
 
 
 /************************************************************************************//**
@@ -147,9 +183,8 @@ static tPoolList tbxPoolList = NULL;
 uint8_t TbxMemPoolCreate(size_t numBlocks, 
                          size_t blockSize)
 {
-  uint8_t      result = TBX_ERROR;
-  void       * blockPtr;
-  tPool      * poolPtr;
+  uint8_t   result = TBX_ERROR;
+  tPool   * poolPtr;
 
   /* Verify parameters. */
   TBX_ASSERT(numBlocks > 0U);
@@ -158,119 +193,45 @@ uint8_t TbxMemPoolCreate(size_t numBlocks,
   /* Only continue if the parameters are valid. */
   if ( (numBlocks > 0U) && (blockSize > 0U) )
   {
-    /* Set the result value to okay. */
-    result = TBX_OK;
     /* Obtain mutual exclusive access to the memory pool list. */
     TbxCriticalSectionEnter();
-    /* Attempt to locate a memory pool node in the list that is configured for the same
-     * block size.
+    /* Attempt to locate a memory pool in the list that is configured for the same block
+     * size.
      */
-    tPoolNode * poolNodePtr = TbxMemPoolListFind(blockSize);
-    /* Create a new memory pool node and its associated empty memory pool if a memory
-     * pool node for this block size does not yet exist.
+    poolPtr = TbxMemPoolListFind(blockSize);
+    /* Create a new and empty memory pool if one for this block size does not yet
+     * exist.
      */
-    if (poolNodePtr == NULL)
+    if (poolPtr == NULL)
     {
-      /* Create a new memory pool node. */
-      poolNodePtr = TbxHeapAllocate(sizeof(tPoolNode));
-      /* Verify that the memory pool node could be created. */
-      if (poolNodePtr == NULL)
+      /* Create a new memory pool object. */
+      poolPtr = TbxHeapAllocate(sizeof(tPool));
+      /* Only continue with initializing the memory pool if it could be created. */
+      if (poolPtr != NULL)
       {
-        /* Flag the error. */
-        result = TBX_ERROR;
-      }
-      /* Continue with creating the memory pool object. */
-      else
-      {
-        /* Create a new memory pool object. */
-        poolPtr = TbxHeapAllocate(sizeof(tPool));
-        /* Verify that the memory pool object could be created. */
-        if (poolPtr == NULL)
-        {
-          /* Flag the error. */
-          result = TBX_ERROR;
-        }
-        /* Continue with initializing both the memory pool and its node. */
-        else
-        {
-          /* Initialize the memory pool node. */
-          poolNodePtr->nextNodePtr = NULL;
-          poolNodePtr->poolPtr = poolPtr;
-          /* Store the data size of the blocks managed by the memory pool. */
-          poolPtr->blockSize = blockSize;
-          /* Create the block list object that will hold blocks that are still free. */
-          poolPtr->freeBlockListPtr = TbxMemPoolBlockListCreate();
-          /* Create the block list object that will hold blocks that are in use. */
-          poolPtr->usedBlockListPtr = TbxMemPoolBlockListCreate();
-          /* Verify that the block list objects could be created. */
-          if ( (poolPtr->freeBlockListPtr == NULL) ||
-               (poolPtr->usedBlockListPtr == NULL) )
-          {
-            /* Flag the error. */
-            result = TBX_ERROR;
-          }
-          /* The (empty) memory pool and its node were created. Time to insert it into
-           * the list.
-           */
-          else
-          {
-            TbxMemPoolListInsert(poolNodePtr);
-          }
-        }
+        /* Store the data size of the blocks managed by the memory pool. */
+        poolPtr->blockSize = blockSize;
+        /* Initialize the free block list to be empty. */
+        poolPtr->freeListPtr = NULL;
+        poolPtr->nextPoolPtr = NULL;
+        poolPtr->selfPtr = poolPtr;
+        /* Reset the statistics. */
+        poolPtr->numBlocks = 0U;
+        poolPtr->numFree = 0U;
+        poolPtr->minFree = 0U;
+        poolPtr->numFailed = 0U;
+        /* The (empty) memory pool was created. Time to insert it into the list. */
+        TbxMemPoolListInsert(poolPtr);
       }
     }
-    /* Only continue if all is okay so far. */
-    if (result == TBX_OK)
+    /* The pool pointer is valid at this point, if all is okay so far. It either points
+     * to a newly created and empty memory pool or to an already existing memory pool
+     * that can be extended. 
+     */
+    if (poolPtr != NULL)
     {
-      /* The pool node pointer it now valid. It either points to a node that holds a
-       * newly created and empty memory pool or to a node that holds an already existing
-       * memory pool that can be extended. Create the blocks one by one and add them as
-       * nodes to the free block list.
-       */
-      for (size_t blockNodeIdx = 0U; blockNodeIdx < numBlocks; blockNodeIdx++)
-      {
-        /* Allocate memory for the block node. */
-        tBlockNode * blockNodePtr = TbxHeapAllocate(sizeof(tBlockNode));
-        /* Verify that the node could be allocated. */
-        if (blockNodePtr == NULL)
-        {
-          /* Flag the error. */
-          result = TBX_ERROR;
-        }
-        /* The node was created. */
-        else
-        {
-          /* Allocate memory for the actual data block itself. */
-          blockPtr = TbxMemPoolBlockCreate(blockSize);
-          /* Verify that the the data block could be allocated. */
-          if (blockPtr == NULL)
-          {
-            /* Flag the error. */
-            result = TBX_ERROR;
-          }
-          /* The data block was created. */
-          else
-          {
-            /* Initialize the block node. */
-            blockNodePtr->blockPtr = blockPtr;
-            blockNodePtr->nextNodePtr = NULL;
-            /* Sanity check. The pool node pointer should not be NULL here. */
-            TBX_ASSERT(poolNodePtr != NULL);
-            /* Flag error in case the sanity check failed. */
-            if (poolNodePtr == NULL)
-            {
-              /* Flag the error. */
-              result = TBX_ERROR;
-            }
-            else
-            {
-              /* Insert the block node into the free block list. */
-              TbxMemPoolBlockListInsert(poolNodePtr->poolPtr->freeBlockListPtr,
-                                        blockNodePtr);
-            }
-          }
-        }
-      }
+      /* Create the blocks and add them to the free block list. */
+      result = TbxMemPoolBlocksCreate(poolPtr, numBlocks);
     }
     /* Release mutual exclusive access to the memory pool list. */
     TbxCriticalSectionExit();
@@ -304,9 +265,8 @@ uint8_t TbxMemPoolCreate(size_t numBlocks,
 ****************************************************************************************/
 void * TbxMemPoolAllocate(size_t size)
 {
-  void            * result = NULL;
-  void            * blockDataPtr;
-  tPoolNode const * poolNodePtr;
+  void  * result = NULL;
+  tPool * poolPtr;
 
   /* Verify parameter. */
   TBX_ASSERT(size > 0U);
@@ -316,35 +276,34 @@ void * TbxMemPoolAllocate(size_t size)
   {
     /* Obtain mutual exclusive access to the memory pool list. */
     TbxCriticalSectionEnter();
-    /* Try to find the best fitting memory pool that has a block available. */
-    poolNodePtr = TbxMemPoolListFindBestFit(size);
-    /* Only continue with the allocation of a memory pool candidate was found. */
-    if (poolNodePtr != NULL)
+    /* Try to find the best fitting memory pool. */
+    poolPtr = TbxMemPoolListFindBestFit(size);
+    /* Only continue with the allocation if a memory pool candidate was found. */
+    if (poolPtr != NULL)
     {
-      /* Get the pointer to the actual memory pool. */
-      tPool const * poolPtr = poolNodePtr->poolPtr;
-      /* Sanity check. The memory pool should not be NULL here. */
-      TBX_ASSERT(poolPtr != NULL);
-      /* Only continue if the sanity check passed. */
-      if (poolPtr != NULL)
+      /* Attempt to extract the first block from the list with free blocks. */
+      tBlockHeader * blockPtr = poolPtr->freeListPtr;
+      /* Only continue if a free block could be extracted. */
+      if (blockPtr != NULL)
       {
-        /* Attempt to extract a block node from the linked list with free block nodes. */
-        tBlockNode * blockNodePtr = TbxMemPoolBlockListExtract(poolPtr->freeBlockListPtr);
-        /* Only continue if a free block node could be extracted. */
-        if (blockNodePtr != NULL)
+        /* Remove the block from the list with free blocks. */
+        poolPtr->freeListPtr = blockPtr->nextFreePtr;
+        /* Store the memory pool in the block header for when it is released. */
+        blockPtr->poolPtr = poolPtr;
+        /* Update the statistics. */
+        poolPtr->numFree--;
+        if (poolPtr->numFree < poolPtr->minFree)
         {
-          /* Read and store the pointer that points to the block's data. */
-          blockDataPtr = TbxMemPoolBlockGetDataPtr(blockNodePtr->blockPtr);
-          /* Now the node itself needs to be inserted into the linked list with used
-           * block nodes. This way this node can be reused when freeing this or another
-           * block.
-           */
-          TbxMemPoolBlockListInsert(poolPtr->usedBlockListPtr, blockNodePtr);
-          /* Perform a sanity check. The block's data pointer should not be NULL here. */
-          TBX_ASSERT(blockDataPtr != NULL);
-          /* Set the result value. */
-          result = blockDataPtr;
+          poolPtr->minFree = poolPtr->numFree;
         }
+        /* The block's data starts right after its header. */
+        result = &blockPtr[1];
+      }
+      /* No more free blocks in the memory pool. */
+      else
+      {
+        /* Update the statistics. */
+        poolPtr->numFailed++;
       }
     }
     /* Release mutual exclusive access to the memory pool list. */
@@ -389,9 +348,8 @@ void * TbxMemPoolAllocate(size_t size)
 ****************************************************************************************/
 void * TbxMemPoolAllocateAuto(size_t size)
 {
-  void            * result      = NULL;
-  tPoolNode const * poolNodePtr = NULL;
-  tPoolNode const * currentPoolNodePtr;
+  void        * result      = NULL;
+  tPool const * poolPtr;
 
   /* Verify parameter. */
   TBX_ASSERT(size > 0U);
@@ -401,29 +359,13 @@ void * TbxMemPoolAllocateAuto(size_t size)
   {
     /* Obtain mutual exclusive access to the memory pool list. */
     TbxCriticalSectionEnter();
-    /* Get pointer to the pool node at the head of the linked list. */
-    currentPoolNodePtr = tbxPoolList;
-    /* Loop through all nodes until one of the exact same size is found. */
-    while (currentPoolNodePtr != NULL)
-    {
-      /* Does this memory pool hold blocks of the exact same size? */
-      if (currentPoolNodePtr->poolPtr->blockSize == size)
-      {
-        /* Existing memory pool of the exact same size was found. Set the poolNodePtr to
-         * point to this memory pool.
-         */
-        poolNodePtr = currentPoolNodePtr;
-        /* Memory pool found, so no need to continue searching. */
-        break;
-      }
-      /* Continue with the next pool node in the list. */
-      currentPoolNodePtr = currentPoolNodePtr->nextNodePtr;
-    }
+    /* Attempt to locate a memory pool of the exact same size. */
+    poolPtr = TbxMemPoolListFind(size);
     /* Release mutual exclusive access to the memory pool list. */
     TbxCriticalSectionExit();
 
     /* No memory pool with the exact same size found? */
-    if (poolNodePtr == NULL)
+    if (poolPtr == NULL)
     {
       /* Automatically create a memory pool with the blockSize set to the size to
        * allocate. 
@@ -451,7 +393,7 @@ void * TbxMemPoolAllocateAuto(size_t size)
            * expanded it with one block.
            */
           result = TbxMemPoolAllocate(size);      
-       }
+        }
       }
     }
   }
@@ -473,8 +415,7 @@ void * TbxMemPoolAllocateAuto(size_t size)
 ****************************************************************************************/
 void TbxMemPoolRelease(void * memPtr)
 {
-  void            * blockPtr;
-  tPoolNode const * poolNodePtr;
+  tPool * poolPtr;
 
   /* Verify parameter. */
   TBX_ASSERT(memPtr != NULL);
@@ -484,51 +425,25 @@ void TbxMemPoolRelease(void * memPtr)
   {
     /* Obtain mutual exclusive access to the memory pool list. */
     TbxCriticalSectionEnter();
-    /* First convert the block's data pointer to the block's base memory pointer. */
-    blockPtr = TbxMemPoolBlockGetMemPtr(memPtr);
-    /* Only continue if the block pointer is valid. */
-    if (blockPtr != NULL)
+    /* Read the memory pool that the block belongs to from the block's header. */
+    poolPtr = TbxMemPoolBlockGetPool(memPtr);
+    /* Sanity check. The memory pool that the to be released memory originally belonged
+     * to should have been found. Also more blocks should not be released than actually
+     * allocated.
+     */
+    TBX_ASSERT((poolPtr != NULL) && (poolPtr->numFree < poolPtr->numBlocks));
+    /* Only continue if the sanity check passed. */
+    if ( (poolPtr != NULL) && (poolPtr->numFree < poolPtr->numBlocks) )
     {
-      /* Get the block's data size. */
-      size_t blockSize = TbxMemPoolBlockGetBlockSize(blockPtr);
-      /* Attempt to locate the memory pool node that holds the memory pool with this
-       * block size.
-       */
-      poolNodePtr = TbxMemPoolListFind(blockSize);
-      /* Sanity check. The memory pool node that the to be released memory originally
-       * belonged to should have been found.
+      /* The block header is located right before the block's data. */
+      tBlockHeader * blockPtr = &((tBlockHeader *)memPtr)[-1];
+      /* Insert the block at the start of the list with free blocks. This way the block
+       * can be allocated again in the future.
        */
-      TBX_ASSERT(poolNodePtr != NULL);
-      /* Only continue if the sanity check passed. */
-      if (poolNodePtr != NULL)
-      {
-        /* Get the pointer to the actual memory pool. */
-        tPool const * poolPtr = poolNodePtr->poolPtr;
-        /* Sanity check. The memory pool should not be NULL here. */
-        TBX_ASSERT(poolPtr != NULL);
-        /* Only continue if the sanity check passed. */
-        if (poolPtr != NULL)
-        {
-          /* Attempt to extract a block node from the linked list with used block
-           * nodes.
-           */
-          tBlockNode * blockNodePtr = TbxMemPoolBlockListExtract(poolPtr->usedBlockListPtr);
-          /* Sanity check. A node should be available, otherwise more blocks were
-           * released than actually allocated, which shouldn't happen.
-           */
-          TBX_ASSERT(blockNodePtr != NULL);
-          /* Only continue if a block node could be extracted. */
-          if (blockNodePtr != NULL)
-          {
-            /* Initialize the block. */
-            blockNodePtr->blockPtr = blockPtr;
-            /* Now the node itself needs to be inserted into the linked list with free
-             * block nodes. This way this node can be allocated again in the future.
-             */
-            TbxMemPoolBlockListInsert(poolPtr->freeBlockListPtr, blockNodePtr);
-          }
-        }
-      }
+      blockPtr->nextFreePtr = poolPtr->freeListPtr;
+      poolPtr->freeListPtr = blockPtr;
+      /* Update the statistics. */
+      poolPtr->numFree++;
     }
     /* Release mutual exclusive access to the memory pool list. */
     TbxCriticalSectionExit();
@@ -536,501 +451,345 @@ void TbxMemPoolRelease(void * memPtr)
 } /*** end of TbxMemPoolRelease ***/
 
 
-/****************************************************************************************
-*   P O O L   L I S T   M A N A G E M E N T   F U N C T I O N S
-****************************************************************************************/
-
 /************************************************************************************//**
-** \brief     Searches through the linked list with memory pools to find a pool that was
-**            created to hold blocks that are of the exact size as specified by the
-**            parameter.
-** \param     blockSize Size of the blocks managed by the memory pool.
-** \return    Pointer to the found memory pool node if successful, NULL otherwise.
+** \brief     Obtains the run-time statistics of a memory pool. Useful for tuning the
+**            number of blocks in each memory pool. The memory pools are indexed by
+**            ascending block size. Keep incrementing the index, starting at zero, until
+**            this function returns TBX_ERROR, to obtain the statistics of all memory
+**            pools.
+** \param     poolIdx Zero based index of the memory pool.
+** \param     stats Pointer to where the statistics are written to.
+** \return    TBX_OK if successful, TBX_ERROR if no memory pool exists at this index.
 **
 ****************************************************************************************/
-static tPoolNode * TbxMemPoolListFind(size_t blockSize)
+uint8_t TbxMemPoolGetStats(size_t             poolIdx,
+                           tTbxMemPoolStats * stats)
 {
-  tPoolNode * result = NULL;
-  tPoolNode * poolNodePtr;
+  uint8_t       result = TBX_ERROR;
+  tPool const * poolPtr;
 
   /* Verify parameter. */
-  TBX_ASSERT(blockSize > 0U);
+  TBX_ASSERT(stats != NULL);
 
   /* Only continue if the parameter is valid. */
-  if (blockSize > 0U)
+  if (stats != NULL)
   {
-    /* Get pointer to the pool node at the head of the linked list. */
-    poolNodePtr = tbxPoolList;
-    /* Loop through all nodes until a match is found. */
-    while (poolNodePtr != NULL)
+    /* Obtain mutual exclusive access to the memory pool list. */
+    TbxCriticalSectionEnter();
+    /* Get pointer to the memory pool at the head of the linked list. */
+    poolPtr = tbxPoolList;
+    /* Move to the memory pool with the specified index. */
+    for (size_t idx = 0U; (idx < poolIdx) && (poolPtr != NULL); idx++)
     {
-      /* Does this node hold a memory pool created for the same block size as we are
-       * trying to find?
-       */
-      if (poolNodePtr->poolPtr->blockSize == blockSize)
-      {
-        /* Update the result because a match was found. */
-        result = poolNodePtr;
-        /* No need to continue looping since a match was found. */
-        break;
-      }
-      /* Continue with the next pool node in the list. */
-      poolNodePtr = poolNodePtr->nextNodePtr;
+      poolPtr = poolPtr->nextPoolPtr;
     }
-  }
-
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMemPoolListFind ***/
-
-
-/************************************************************************************//**
-** \brief     Searches through the linked list with memory pools to find a pool that was
-**            created to hold blocks that are of equal size or slightly greater. If the
-**            found memory pool has no more free blocks available the search
-**            is NOT continued for a memory pool of the next size up. Although this
-**            sounds like a nice feature to have, this was not implemented on purpose.
-**            The reason for this is that it is now possible to expand an existing memory
-**            pool when it is full. Assume a situation where all blocks in the memory
-**            pool are already allocated. The next call to TbxMemPoolAllocate() therefore
-**            fails. You can now call TbxMemPoolCreate() again for the same block size
-**            and the original memory pool is expanded automatically. Note that this
-**            function relies on the fact that the memory pools in the list are sorted
-**            by ascending block size.
-** \param     blockSize Size of the block to fit.
-** \return    Pointer to the found memory pool node if successful, NULL otherwise.
-**
-****************************************************************************************/
-static tPoolNode * TbxMemPoolListFindBestFit(size_t blockSize)
-{
-  tPoolNode * result = NULL;
-  tPoolNode * poolNodePtr;
-
-  /* Verify parameter. */
-  TBX_ASSERT(blockSize > 0U);
-
-  /* Only continue if the parameter is valid. */
-  if (blockSize > 0U)
-  {
-    /* Get pointer to the pool node at the head of the linked list. */
-    poolNodePtr = tbxPoolList;
-    /* Loop through all nodes until a fit is found. */
-    while (poolNodePtr != NULL)
+    /* Only continue if a memory pool exists at this index. */
+    if (poolPtr != NULL)
     {
-      /* Does this memory pool hold blocks that would fit the specified block size? */
-      if (poolNodePtr->poolPtr->blockSize >= blockSize)
-      {
-        /* A fit is found. Now check if this memory pool has free blocks available. */
-        if (TbxMemPoolBlockListIsEmpty(poolNodePtr->poolPtr->freeBlockListPtr) \
-            == TBX_FALSE)
-        {
-          /* Found a match so update the result value. */
-          result = poolNodePtr;
-        }
-        /* Best fit is found, so no need to continue searching even if the memory pool
-         * does not have any free blocks available.
-         */
-        break;
-      }
-      /* Continue with the next pool node in the list. */
-      poolNodePtr = poolNodePtr->nextNodePtr;
+      /* Copy the statistics. */
+      stats->blockSize = poolPtr->blockSize;
+      stats->numBlocks = poolPtr->numBlocks;
+      stats->numFree = poolPtr->numFree;
+      stats->minFree = poolPtr->minFree;
+      stats->numFailed = poolPtr->numFailed;
+      /* Update the result. */
+      result = TBX_OK;
     }
+    /* Release mutual exclusive access to the memory pool list. */
+    TbxCriticalSectionExit();
   }
 
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMemPoolListFindBestFit ***/
-
-
-/************************************************************************************//**
-** \brief     Inserts the specified memory pool node into the linked list with memory
-**            pool nodes. It automatically sorts the nodes by ascending block size. Note
-**            that this function only works properly is there is not already a memory
-**            pool in the list configured for the same block size as the new one that
-**            this function should insert.
-** \param     nodePtr Pointer to the memory pool node to insert.
-**
-****************************************************************************************/
-static void TbxMemPoolListInsert(tPoolNode * nodePtr)
-{
-  tPoolNode * currentNodePtr;
-  tPoolNode * prevNodePtr = NULL;
-  uint8_t     nodeInserted = TBX_FALSE;
-
-  /* Verify parameter. */
-  TBX_ASSERT(nodePtr != NULL);
-
-  /* Only continue if the parameter is valid. */
-  if (nodePtr != NULL)
-  {
-    /* Sanity check. The pointer to the memory pool should not be NULL here. */
-    TBX_ASSERT(nodePtr->poolPtr != NULL);
-    /* Is the list with memory pools empty? */
-    if (tbxPoolList == NULL)
-    {
-      /* Add the node at the start of the list. */
-      nodePtr->nextNodePtr = NULL;
-      tbxPoolList = nodePtr;
-    }
-    /* The list with memory pools is not empty. */
-    else
-    {
-      /* Get pointer to the pool node at the head of the linked list. */
-      currentNodePtr = tbxPoolList;
-      /* Loop through the nodes to find the location where the new node should be
-       * inserted, such that the nodes always remain sorted by ascending block size.
-       */
-      while (currentNodePtr != NULL)
-      {
-        /* Sanity check. The pointer to the memory pool should not be NULL here. */
-        TBX_ASSERT(currentNodePtr->poolPtr != NULL);
-        /* Only continue if the sanity check passed. */
-        if (currentNodePtr->poolPtr != NULL)
-        {
-          /* This function should not be used to insert a memory pool node that has a
-           * block size that equals an already existing node. Verify this.
-          */
-          TBX_ASSERT(currentNodePtr->poolPtr->blockSize != nodePtr->poolPtr->blockSize);
-          /* Is the block size of this node's memory pool larger than the new one? */
-          if (currentNodePtr->poolPtr->blockSize > nodePtr->poolPtr->blockSize)
-          {
-            /* The new node should be inserted before this one. If the current node is
-             * the head of the list, the new node should become the new head.
-            */
-            if (currentNodePtr == tbxPoolList)
-            {
-              /* Sanity check. In this case the previous node should still be NULL. */
-              TBX_ASSERT(prevNodePtr == NULL);
-              /* Add the node at the start of the list, right before the current node. */
-              nodePtr->nextNodePtr = currentNodePtr;
-              tbxPoolList = nodePtr;
-            }
-            /* The current node is not the head of the list, so the new node should be
-             * inserted between previous node and the current node.
-            */
-            else
-            {
-              /* Sanity check. In this case the previous node should not be NULL. */
-              TBX_ASSERT(prevNodePtr != NULL);
-              /* Only continue if the sanity check passed. */
-              if (prevNodePtr != NULL)
-              {
-                /* Insert the node between the previous and current nodes. */
-                nodePtr->nextNodePtr = currentNodePtr;
-                prevNodePtr->nextNodePtr = nodePtr;
-              }
-            }
-            /* Set flag to indicate that the new node was successfully inserted. */
-            nodeInserted = TBX_TRUE;
-          }
-        }
-        /* Did we reach the end of the list and the new node was not yet inserted? */
-        if ( (currentNodePtr->nextNodePtr == NULL) && (nodeInserted == TBX_FALSE) )
-        {
-          /* There are no memory pools present in the list that have a block size larger
-           * than the new node. This means that the new node should be inserted at the
-           * tail of the list.
-           */
-          nodePtr->nextNodePtr = NULL;
-          currentNodePtr->nextNodePtr = nodePtr;
-          /* Set flag to indicate that the new node was successfully inserted. */
-          nodeInserted = TBX_TRUE;
-        }
-        /* Check if the new node was already inserted. */
-        if (nodeInserted == TBX_TRUE)
-        {
-          /* All done so no need to continue looping. */
-          break;
-        }
-        /* Update loop variables. */
-        prevNodePtr = currentNodePtr;
-        currentNodePtr = currentNodePtr->nextNodePtr;
-      }
-    }
-  }
-} /*** end of TbxMemPoolListInsert ***/
+} /*** end of TbxMemPoolGetStats ***/
 
 
 /****************************************************************************************
-*   B L O C K   M A N A G E M E N T   F U N C T I O N S
+*   P O O L   L I S T   M A N A G E M E N T   F U N C T I O N S
 ****************************************************************************************/
 
 /************************************************************************************//**
-** \brief     Creates and initializes a new block including its memory allocation on the
-**            heap. A block consists of the actual memory to hold the block data and is
-**            preceded by an element of size_t, where the size of the block is written
-**            to:
-**            memPtr  -> -----------
-**                      | blockSize |
-**            dataPtr ->|------------------------------------------------
-**                      | data byte 0 | data byte 1 | data byte 2 | etc. |
-**                       ------------------------------------------------
-** \param     size The data size of the block in bytes.
-** \return    Pointer to the memory of the created block if successful, NULL otherwise.
+** \brief     Searches for a memory pool that was created to hold blocks that are of the
+**            exact size as specified by the parameter.
+** \param     blockSize Size of the blocks managed by the memory pool.
+** \return    Pointer to the found memory pool if successful, NULL otherwise.
 **
 ****************************************************************************************/
-static void * TbxMemPoolBlockCreate(size_t size)
+static tPool * TbxMemPoolListFind(size_t blockSize)
 {
-  void   * result = NULL;
-  void   * blockMemPtr;
+  tPool * result;
 
-  /* Verify parameter. */
-  TBX_ASSERT(size > 0U);
-
-  /* Only continue if the parameter is valid. */
-  if (size > 0U)
+  /* The best fitting memory pool is the one with the exact size, if it exists. */
+  result = TbxMemPoolListFindBestFit(blockSize);
+  /* Reset the result if the best fitting memory pool holds larger blocks. */
+  if ( (result != NULL) && (result->blockSize != blockSize) )
   {
-    /* Allocate memory for the block data and an extra size_t value at the start. */
-    blockMemPtr = TbxHeapAllocate(sizeof(size_t) + size);
-    /* Only continue if the memory allocation was successful. */
-    if (blockMemPtr != NULL)
-    {
-      /* Set the result value. */
-      result = blockMemPtr;
-      /* Create a pointer to an array of size_t elements. */
-      size_t * blockSizeArray = blockMemPtr;
-      /* Write to the first element, which should hold the block size. */
-      blockSizeArray[0U] = size;
-    }
+    result = NULL;
   }
 
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMemPoolBlockCreate ***/
+} /*** end of TbxMemPoolListFind ***/
 
 
 /************************************************************************************//**
-** \brief     Converts the block memory pointer, which points to the start of the block's
-**            allocated memory, to the pointer where the actual block data starts.
-** \param     memPtr Pointer to the start of the block's allocated memory.
-** \return    Pointer to where the block's data starts if successful, NULL otherwise.
+** \brief     Searches for a memory pool that was created to hold blocks that are of
+**            equal size or slightly greater. The size class index directly provides the
+**            memory pool to start searching at. It at most skips the memory pools with a
+**            block size that falls within the same size class, but is still too small.
+**            If the found memory pool has no more free blocks available the search is
+**            NOT continued for a memory pool of the next size up. Although this sounds
+**            like a nice feature to have, this was not implemented on purpose. The
+**            reason for this is that it is now possible to expand an existing memory
+**            pool when it is full. Assume a situation where all blocks in the memory
+**            pool are already allocated. The next call to TbxMemPoolAllocate() therefore
+**            fails. You can now call TbxMemPoolCreate() again for the same block size and
+**            the original memory pool is expanded automatically.
+** \param     blockSize Size of the block to fit.
+** \return    Pointer to the found memory pool if successful, NULL otherwise.
 **
 ****************************************************************************************/
-static void * TbxMemPoolBlockGetDataPtr(void * memPtr)
+static tPool * TbxMemPoolListFindBestFit(size_t blockSize)
 {
-  void   * result = NULL;
-  size_t * blockSizeArray;
-  void   * dataPtr;
+  tPool * result = NULL;
+  size_t  classIdx;
 
   /* Verify parameter. */
-  TBX_ASSERT(memPtr != NULL);
+  TBX_ASSERT(blockSize > 0U);
 
   /* Only continue if the parameter is valid. */
-  if (memPtr != NULL)
+  if (blockSize > 0U)
   {
-    /* Create a pointer to an array of size_t elements. */
-    blockSizeArray = memPtr;
-    /* The block data starts after the block size value. */
-    dataPtr = &blockSizeArray[1U];
-    /* Set the result value. */
-    result = dataPtr;
+    /* Determine the size class. Larger sizes all start at the last size class. */
+    classIdx = (blockSize - 1U) / TBX_CONF_MEMPOOL_CLASS_GRANULE;
+    if (classIdx >= TBX_CONF_MEMPOOL_CLASS_NUM)
+    {
+      classIdx = TBX_CONF_MEMPOOL_CLASS_NUM - 1U;
+    }
+    /* Get the smallest memory pool of this size class. */
+    result = tbxPoolClassIndex[classIdx];
+    /* Skip the memory pools with blocks that are too small. */
+    while ( (result != NULL) && (result->blockSize < blockSize) )
+    {
+      result = result->nextPoolPtr;
+    }
   }
 
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMemPoolBlockGetDataPtr ***/
+} /*** end of TbxMemPoolListFindBestFit ***/
 
 
 /************************************************************************************//**
-** \brief     Extract the size of the block data, given the pointer to the block's
-**            allocated memory.
-** \param     memPtr Pointer to the start of the block's allocated memory.
-** \return    Size in bytes of the block's data if successful, 0 otherwise.
+** \brief     Inserts the specified memory pool into the linked list with memory pools.
+**            It automatically sorts the memory pools by ascending block size and
+**            updates the size class index. Note that this function only works properly
+**            if there is not already a memory pool in the list configured for the same
+**            block size as the new one that this function should insert.
+** \param     poolPtr Pointer to the memory pool to insert.
 **
 ****************************************************************************************/
-static size_t TbxMemPoolBlockGetBlockSize(void const * memPtr)
+static void TbxMemPoolListInsert(tPool * poolPtr)
 {
-  size_t         result = 0U;
-  size_t const * blockSizeArray;
+  tPool ** linkPtr;
 
   /* Verify parameter. */
-  TBX_ASSERT(memPtr != NULL);
+  TBX_ASSERT(poolPtr != NULL);
 
   /* Only continue if the parameter is valid. */
-  if (memPtr != NULL)
+  if (poolPtr != NULL)
   {
-    /* Create a pointer to an array of size_t elements. */
-    blockSizeArray = memPtr;
-    /* The block size value is located at the start of the block, */
-    size_t blockSize = blockSizeArray[0U];
-    /* Set the result value. */
-    result = blockSize;
+    /* Start at the head of the list. */
+    linkPtr = &tbxPoolList;
+    /* Skip all memory pools with a smaller block size, such that the memory pools
+     * always remain sorted by ascending block size.
+     */
+    while ( (*linkPtr != NULL) && ((*linkPtr)->blockSize < poolPtr->blockSize) )
+    {
+      linkPtr = &(*linkPtr)->nextPoolPtr;
+    }
+    /* This function should not be used to insert a memory pool that has a block size
+     * that equals an already existing one. Verify this.
+     */
+    TBX_ASSERT((*linkPtr == NULL) || ((*linkPtr)->blockSize != poolPtr->blockSize));
+    /* Insert the memory pool at this location. */
+    poolPtr->nextPoolPtr = *linkPtr;
+    *linkPtr = poolPtr;
+    /* Update the address range of the memory pools. */
+    if ((uintptr_t)poolPtr < tbxPoolAddrMin)
+    {
+      tbxPoolAddrMin = (uintptr_t)poolPtr;
+    }
+    if ((uintptr_t)poolPtr > tbxPoolAddrMax)
+    {
+      tbxPoolAddrMax = (uintptr_t)poolPtr;
+    }
+    /* Rebuild the size class index to include the new memory pool. */
+    TbxMemPoolClassIndexUpdate();
   }
-
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMemPoolBlockGetBlockSize ***/
+} /*** end of TbxMemPoolListInsert ***/
 
 
 /************************************************************************************//**
-** \brief     Convert the pointer that points to where the block's data starts, to a
-**            pointer that points to where the block's allocated memory starts.
-** \param     dataPtr Pointer to the start of the block's data.
-** \return    Pointer to the memory of the block if successful, NULL otherwise.
+** \brief     Rebuilds the size class index, based on the linked list with memory pools.
+**            Only needed when a new memory pool was inserted into the list.
 **
 ****************************************************************************************/
-static void * TbxMemPoolBlockGetMemPtr(void * dataPtr)
+static void TbxMemPoolClassIndexUpdate(void)
 {
-  void   * result = NULL;
-  void   * blockMemPtr;
-  size_t * blockSizeArray;
+  tPool * poolPtr;
 
-  /* Verify parameter. */
-  TBX_ASSERT(dataPtr != NULL);
-
-  /* Only continue if the parameter is valid. */
-  if (dataPtr != NULL)
+  /* Get pointer to the memory pool at the head of the linked list. */
+  poolPtr = tbxPoolList;
+  /* Loop through all size classes. */
+  for (size_t classIdx = 0U; classIdx < TBX_CONF_MEMPOOL_CLASS_NUM; classIdx++)
   {
-    /* Create a pointer to an array of size_t elements. */
-    blockSizeArray = dataPtr;
-    /* Get pointer to the start of the block, which is one size_t element before the
-     * pointer to the block's data.
+    /* Skip the memory pools with blocks that are too small for all sizes in this size
+     * class.
      */
-    blockMemPtr = &blockSizeArray[-1];
-    /* Set the result value. */
-    result = blockMemPtr;
+    while ( (poolPtr != NULL) && 
+            (poolPtr->blockSize <= (classIdx * TBX_CONF_MEMPOOL_CLASS_GRANULE)) )
+    {
+      poolPtr = poolPtr->nextPoolPtr;
+    }
+    /* Store the smallest memory pool of this size class. */
+    tbxPoolClassIndex[classIdx] = poolPtr;
   }
-
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMemPoolBlockGetMemPtr ***/
+} /*** end of TbxMemPoolClassIndexUpdate ***/
 
 
 /****************************************************************************************
-*   B L O C K   L I S T   M A N A G E M E N T   F U N C T I O N S
+*   B L O C K   M A N A G E M E N T   F U N C T I O N S
 ****************************************************************************************/
 
 /************************************************************************************//**
-** \brief     Creates a new and empty linked list that can be used for building a list
-**            with block nodes. Memory needed for the linked list object itself is
-**            allocated on the heap.
-** \return    Pointer to the newly created blocks list if successful, NULL otherwise.
+** \brief     Creates new blocks for the memory pool and adds them to its list with free
+**            blocks. The memory for all blocks is allocated on the heap at once. Each
+**            block consists of a header, followed by the memory to hold the block data:
+**            blockPtr -> -------------------------------
+**                       | header (pool or next free)   |
+**            dataPtr  ->|------------------------------------------------
+**                       | data byte 0 | data byte 1 | data byte 2 | etc. |
+**                        ------------------------------------------------
+**            The block data is padded to the header size, such that the next block's
+**            header and data are properly aligned.
+** \param     poolPtr Pointer to the memory pool.
+** \param     numBlocks The number of blocks to create.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-static tBlockList * TbxMemPoolBlockListCreate(void)
+static uint8_t TbxMemPoolBlocksCreate(tPool  * poolPtr,
+                                      size_t   numBlocks)
 {
-  tBlockList * result;
-
-  /* Attempt to create the linked list object on the heap. */
-  result = TbxHeapAllocate(sizeof(tBlockList));
-  /* Only continue with the linked list initialization when the allocation was
-   * successful.
-   */
-  if (result != NULL)
-  {
-    /* Initialize the linked list to be empty. */
-    *result = NULL;
-  }
-
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMemPoolBlockListCreate ***/
+  uint8_t   result = TBX_ERROR;
+  uint8_t * blocksMemPtr;
+  size_t    blockStride;
 
-
-/************************************************************************************//**
-** \brief     Inserts the specified block node into the linked list with block nodes.
-** \param     listPtr Pointer to the linked list with blocks.
-** \param     nodePtr Pointer to the block node to insert.
-**
-****************************************************************************************/
-static void TbxMemPoolBlockListInsert(tBlockList * listPtr, 
-                                      tBlockNode * nodePtr)
-{
   /* Verify parameters. */
-  TBX_ASSERT(listPtr != NULL);
-  TBX_ASSERT(nodePtr != NULL);
-
-  /* Only continue if the parameters are valid. */
-  if ( (listPtr != NULL) && (nodePtr != NULL) )
-  {
-    /* Is the list currently empty? */
-    if (*listPtr == NULL)
-    {
-      /* There is no next node. */
-      nodePtr->nextNodePtr = NULL;
-    }
-    /* Linked list is not empty. */
-    else
-    {
-      /* The new node will be the current head of the list. */
-      nodePtr->nextNodePtr = *listPtr;
-    }
-    /* Insert the new node at the start of the list. */
-    *listPtr = nodePtr;
-  }
-} /*** end of TbxMemPoolBlockListInsert ***/
-
-
-/************************************************************************************//**
-** \brief     Extracts a block node from the linked list with block nodes.
-** \param     listPtr Pointer to the linked list with blocks.
-** \return    Pointer to the block node that was extracted or NULL if the linked list
-**            contained no more nodes.
-**
-****************************************************************************************/
-static tBlockNode * TbxMemPoolBlockListExtract(tBlockList * listPtr)
-{
-  tBlockNode * result = NULL;
-
-  /* Verify parameter. */
-  TBX_ASSERT(listPtr != NULL);
+  TBX_ASSERT(poolPtr != NULL);
+  TBX_ASSERT(numBlocks > 0U);
 
-  /* Only continue if the parameter is valid. */
-  if (listPtr != NULL)
+  /* Only continue if the parameters are valid and the total size does not overflow. */
+  if ( (poolPtr != NULL) && (numBlocks > 0U) && 
+       (poolPtr->blockSize < (SIZE_MAX / 2U)) )
   {
-    /* Only extract a node if the list currently not empty. */
-    if (*listPtr != NULL)
+    /* Determine the size of one block, including its header and padding. */
+    blockStride = sizeof(tBlockHeader) + 
+                  ((poolPtr->blockSize + (sizeof(tBlockHeader) - 1U)) & 
+                   ~(sizeof(tBlockHeader) - 1U));
+    /* Allocate memory for all blocks at once, if it does not overflow. */
+    if (numBlocks <= (SIZE_MAX / blockStride))
     {
-      /* Get the first node. */
-      result = *listPtr;
-      /* Is there currently only one node in the list? */
-      if ((*listPtr)->nextNodePtr == NULL)
+      blocksMemPtr = TbxHeapAllocate(numBlocks * blockStride);
+      /* Only continue if the memory allocation was successful. */
+      if (blocksMemPtr != NULL)
       {
-        /* Set the list to be empty. */
-        *listPtr = NULL;
-      }
-      /* There are currently at least two nodes in the list. */
-      else
-      {
-        /* Make the second node the first one. */
-        *listPtr = result->nextNodePtr;
+        /* Add the blocks one by one to the list with free blocks. */
+        for (size_t blockIdx = 0U; blockIdx < numBlocks; blockIdx++)
+        {
+          /* The heap allocates at an address aligned to the header size. */
+          tBlockHeader * blockPtr = 
+            (tBlockHeader *)(void *)&blocksMemPtr[blockIdx * blockStride];
+          /* Insert the block at the start of the list with free blocks. */
+          blockPtr->nextFreePtr = poolPtr->freeListPtr;
+          poolPtr->freeListPtr = blockPtr;
+        }
+        /* Update the address range of the memory that holds the blocks. */
+        if ((uintptr_t)blocksMemPtr < tbxBlockAddrMin)
+        {
+          tbxBlockAddrMin = (uintptr_t)blocksMemPtr;
+        }
+        if (((uintptr_t)blocksMemPtr + (numBlocks * blockStride)) > tbxBlockAddrEnd)
+        {
+          tbxBlockAddrEnd = (uintptr_t)blocksMemPtr + (numBlocks * blockStride);
+        }
+        /* Update the statistics. */
+        poolPtr->numBlocks += numBlocks;
+        poolPtr->numFree += numBlocks;
+        poolPtr->minFree += numBlocks;
+        /* Update the result. */
+        result = TBX_OK;
       }
     }
   }
 
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMemPoolBlockListExtract ***/
+} /*** end of TbxMemPoolBlocksCreate ***/
 
 
 /************************************************************************************//**
-** \brief     Checks if the linked list with block nodes is empty. So when it does not
-**            contain any nodes.
-** \param     listPtr Pointer to the linked list with blocks.
-** \return    TBX_TRUE if the block list is empty, TBX_FALSE otherwise.
+** \brief     Obtains the memory pool that an allocated block belongs to, by reading it
+**            from the block's header. The block header is only read if the pointer lies
+**            within the memory that holds the blocks. The memory pool pointer is
+**            validated as well, such that a pointer that was not allocated with this
+**            module is detected.
+** \param     dataPtr Pointer to the start of the block's data.
+** \return    Pointer to the memory pool if successful, NULL otherwise.
 **
 ****************************************************************************************/
-static uint8_t TbxMemPoolBlockListIsEmpty(tBlockList const * listPtr)
+static tPool * TbxMemPoolBlockGetPool(void const * dataPtr)
 {
-  uint8_t result = TBX_FALSE;
+  tPool              * result = NULL;
+  tBlockHeader const * blockPtr;
+  uintptr_t            dataAddr;
+  uintptr_t            poolAddr;
 
   /* Verify parameter. */
-  TBX_ASSERT(listPtr != NULL);
+  TBX_ASSERT(dataPtr != NULL);
 
   /* Only continue if the parameter is valid. */
-  if (listPtr != NULL)
+  if (dataPtr != NULL)
   {
-    /* Is the list empty? */
-    if (*listPtr == NULL)
+    /* The pointer must be aligned and its block header must be located within the
+     * memory that holds the blocks, before the block header can be safely read.
+     */
+    dataAddr = (uintptr_t)dataPtr;
+    if ( (dataAddr >= (tbxBlockAddrMin + sizeof(tBlockHeader))) &&
+         (dataAddr < tbxBlockAddrEnd) && ((dataAddr % sizeof(tBlockHeader)) == 0U) )
     {
-      /* Update the result value. */
-      result = TBX_TRUE;
+      /* The block header is located right before the block's data. */
+      blockPtr = &((tBlockHeader const *)dataPtr)[-1];
+      poolAddr = (uintptr_t)blockPtr->poolPtr;
+      /* The memory pool pointer must be aligned and within the range of created memory
+       * pools, before it can be safely dereferenced.
+       */
+      if ( (poolAddr >= tbxPoolAddrMin) && (poolAddr <= tbxPoolAddrMax) &&
+           ((poolAddr % sizeof(tBlockHeader)) == 0U) )
+      {
+        /* Only a real memory pool points to itself. */
+        if (blockPtr->poolPtr->selfPtr == blockPtr->poolPtr)
+        {
+          /* Update the result. */
+          result = blockPtr->poolPtr;
+        }
+      }
     }
   }
 
   /* Give the result back to the caller. */
   return result;
-} /*** end of TbxMemPoolBlockListIsEmpty ***/
+} /*** end of TbxMemPoolBlockGetPool ***/
 
 
 /*********************************** end of tbx_mempool.c ******************************/
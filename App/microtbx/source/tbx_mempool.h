@@ -39,6 +39,27 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Run-time statistics of a memory pool, obtained with TbxMemPoolGetStats(). */
+typedef struct
+{
+  /** \brief The number of bytes that fit in one block. */
+  size_t blockSize;
+  /** \brief Total number of blocks in the memory pool. */
+  size_t numBlocks;
+  /** \brief Number of blocks that are currently free. */
+  size_t numFree;
+  /** \brief Lowest number of free blocks since the memory pool was created. */
+  size_t minFree;
+  /** \brief Number of allocation requests that failed, because the memory pool had no
+   *         more free blocks.
+   */
+  size_t numFailed;
+} tTbxMemPoolStats;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
@@ -51,6 +72,9 @@ void    * TbxMemPoolAllocateAuto(size_t   size);
 
 void      TbxMemPoolRelease     (void   * memPtr);
 
+uint8_t   TbxMemPoolGetStats    (size_t             poolIdx,
+                                 tTbxMemPoolStats * stats);
+
 
 #ifdef __cplusplus
 }
@@ -47,11 +47,23 @@ extern "C"
  ****************************************************************************************/
 #include "tbx_types.h"     // MicroTBX port specific types
 
+  /****************************************************************************************
+   * Type definitions
+   ****************************************************************************************/
+#ifndef TBX_PORT_LOCK_INIT
+  // Ports that do not support locks fall back to disabling all interrupts.
+  typedef uint8_t tTbxPortLock;
+#define TBX_PORT_LOCK_INIT( level )    ( 0U )
+#define TBX_PORT_LOCK_GENERIC
+#endif
+
   /****************************************************************************************
    * Function prototypes
    ****************************************************************************************/
   tTbxPortCpuSR TbxPortInterruptsDisable( void );
   void          TbxPortInterruptsRestore( tTbxPortCpuSR prevCpuSr );
+  tTbxPortCpuSR TbxPortLockAcquire( tTbxPortLock *portLock );
+  void          TbxPortLockRelease( tTbxPortLock *portLock, tTbxPortCpuSR prevCpuSr );
 
 #ifdef __cplusplus
 }
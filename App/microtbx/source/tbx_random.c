@@ -4,6 +4,9 @@
 * \details      The RNG algorithm is based on a linear feedback shift register (LFSR) as
 *               presented in application note 4400 from Maxim Integrated. It can be found
 *               at: www.maximintegrated.com/en/app-notes/index.mvp/id/4400.
+*               Alternatively, the xoshiro128** generator by D. Blackman and S. Vigna
+*               or the PCG32 generator by M.E. O'Neill can be selected with
+*               TBX_CONF_RANDOM_GENERATOR.
 * \internal
 *----------------------------------------------------------------------------------------
 *                          C O P Y R I G H T
@@ -46,6 +49,13 @@
 /****************************************************************************************
 * Macro definitions
 ****************************************************************************************/
+/** \brief Number of 32-bit random numbers that TbxRandomFill() generates per critical
+ *         section. It bounds the time that the interrupts are masked, without the
+ *         overhead of a critical section for each number.
+ */
+#define TBX_RANDOM_FILL_BATCH_SIZE     (8U)
+
+#if (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_LFSR)
 /** \brief Polynomial mask for the 32-bit LFSR. The polynomial mask is created by taking
  *         the binary representation of the polynomial and truncating the right-most bit.
  */
@@ -55,17 +65,27 @@
  *         the binary representation of the polynomial and truncating the right-most bit.
  */
 #define TBX_RANDOM_LFSR31_POLYMASK     (0x7A5BC2E3UL)
+#elif (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_PCG32)
+/** \brief Multiplier of the PCG32 linear congruential generator. */
+#define TBX_RANDOM_PCG32_MULTIPLIER    (6364136223846793005ULL)
+#endif
 
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-static void     TbxRandomInitLFSRs     (void);
+static void     TbxRandomSeed          (void);
 
+static uint32_t TbxRandomNext          (void);
+
+#if (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_LFSR)
 static uint32_t TbxRandomShiftLFSR     (uint32_t * lfsr,
                                         uint32_t   polymask);
 
 static uint16_t TbxRandomNumber16BitGet(void);
+#elif (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_XOSHIRO128SS)
+static uint32_t TbxRandomSplitMix      (uint32_t * state);
+#endif
 
 
 /****************************************************************************************
@@ -74,11 +94,25 @@ static uint16_t TbxRandomNumber16BitGet(void);
 /** \brief Pointer to the application provided seed initialization handler function. */
 static tTbxRandomSeedInitHandler tbxRandomSeedInitHandler = NULL;
 
+/** \brief Flag to keep track of whether the generator was seeded. */
+static volatile uint8_t          tbxRandomSeeded = TBX_FALSE;
+
+#if (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_LFSR)
 /** \brief Storage for the 32-bit LFSR value. */
 static uint32_t                  tbxRandomNumberLFSR32;
 
 /** \brief Storage for the 31-bit LFSR value. */
 static uint32_t                  tbxRandomNumberLFSR31;
+#elif (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_XOSHIRO128SS)
+/** \brief State of the xoshiro128** generator. It must never be all zeroes. */
+static uint32_t                  tbxRandomXoshiroState[4];
+#else
+/** \brief State of the PCG32 generator. */
+static uint64_t                  tbxRandomPcgState;
+
+/** \brief Increment of the PCG32 generator. Selects the stream and must be odd. */
+static uint64_t                  tbxRandomPcgInc;
+#endif
 
 
 /************************************************************************************//**
@@ -88,25 +122,85 @@ static uint32_t                  tbxRandomNumberLFSR31;
 ****************************************************************************************/
 uint32_t TbxRandomNumberGet(void)
 {
-  uint32_t       result;
-  static uint8_t seeded = TBX_FALSE;
+  uint32_t result;
 
-  /* Make sure both the 32-bit and 31-bit LFSRs are seeded. */
-  if (seeded == TBX_FALSE)
+  /* Make sure the generator is seeded. */
+  if (tbxRandomSeeded == TBX_FALSE)
   {
-    TbxRandomInitLFSRs();
-    seeded = TBX_TRUE;
+    TbxRandomSeed();
+    tbxRandomSeeded = TBX_TRUE;
   }
 
-  /* Construct a 32-bit random number by combining two 16-bit random numbers. */
-  result  = ((uint32_t)TbxRandomNumber16BitGet() << 16UL);
-  result |= TbxRandomNumber16BitGet();
+  /* Obtain mutual exclusive access to the generator state, while generating the next
+   * random number.
+   */
+  TbxCriticalSectionEnter();
+  result = TbxRandomNext();
+  TbxCriticalSectionExit();
 
   /* Give the result back to the caller. */
   return result;
 } /*** end of TbxRandomNumberGet ***/
 
 
+/************************************************************************************//**
+** \brief     Fills a buffer with random bytes. This is faster than calling
+**            TbxRandomNumberGet() for each 4 bytes, because it enters the critical
+**            section once per batch of random numbers.
+** \param     data Pointer to the byte array to fill.
+** \param     len The number of bytes to fill.
+**
+****************************************************************************************/
+void TbxRandomFill(uint8_t * data,
+                   size_t    len)
+{
+  uint32_t batch[TBX_RANDOM_FILL_BATCH_SIZE];
+  size_t   batchLen;
+  size_t   wordsNum;
+  size_t   idx = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(data != NULL);
+  TBX_ASSERT(len > 0U);
+
+  /* Only continue if the parameters are valid. */
+  if ((data != NULL) && (len > 0U))
+  {
+    /* Make sure the generator is seeded. */
+    if (tbxRandomSeeded == TBX_FALSE)
+    {
+      TbxRandomSeed();
+      tbxRandomSeeded = TBX_TRUE;
+    }
+    /* Keep going until the buffer is filled. */
+    while (idx < len)
+    {
+      /* Determine the number of bytes and random numbers for this batch. */
+      batchLen = len - idx;
+      if (batchLen > (TBX_RANDOM_FILL_BATCH_SIZE * sizeof(uint32_t)))
+      {
+        batchLen = TBX_RANDOM_FILL_BATCH_SIZE * sizeof(uint32_t);
+      }
+      wordsNum = (batchLen + (sizeof(uint32_t) - 1U)) / sizeof(uint32_t);
+      /* Generate the random numbers of this batch. */
+      TbxCriticalSectionEnter();
+      for (size_t wordIdx = 0U; wordIdx < wordsNum; wordIdx++)
+      {
+        batch[wordIdx] = TbxRandomNext();
+      }
+      TbxCriticalSectionExit();
+      /* Copy them to the buffer, least significant byte first. */
+      for (size_t byteIdx = 0U; byteIdx < batchLen; byteIdx++)
+      {
+        data[idx] = (uint8_t)(batch[byteIdx / sizeof(uint32_t)] >>
+                              ((byteIdx % sizeof(uint32_t)) * 8U));
+        idx++;
+      }
+    }
+  }
+} /*** end of TbxRandomFill ***/
+
+
 /************************************************************************************//**
 ** \brief     Sets the application specific function that should be called when the
 **            seed for the random number generation should be initialized. The actual
@@ -151,12 +245,12 @@ void TbxRandomSetSeedInitHandler(tTbxRandomSeedInitHandler seedInitHandler)
 } /*** end of TbxRandomSetSeedInitHandler ***/
 
 
+#if (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_LFSR)
 /************************************************************************************//**
 ** \brief     Initialize both the 32-bit and 31-bit LFSRs with a non-zero seed value.
-** \return    none.
 **
 ****************************************************************************************/
-static void TbxRandomInitLFSRs(void)
+static void TbxRandomSeed(void)
 {
   uint32_t seedLFSR32 = 0xABCDEUL;
   uint32_t seedLFSR31 = 0x23456789UL;
@@ -187,7 +281,7 @@ static void TbxRandomInitLFSRs(void)
    */
   tbxRandomNumberLFSR32 = seedLFSR32;
   tbxRandomNumberLFSR31 = seedLFSR31;
-} /*** end of TbxRandomInitLFSRs ***/
+} /*** end of TbxRandomSeed ***/
 
 
 /************************************************************************************//**
@@ -226,7 +320,8 @@ static uint32_t TbxRandomShiftLFSR(uint32_t * lfsr,
 
 
 /************************************************************************************//**
-** \brief     Obtains a 16-bit random number.
+** \brief     Obtains a 16-bit random number. The caller should have mutual exclusive
+**            access to the LFSRs.
 ** \return    Value of the newly generated 16-bit random number.
 **
 ****************************************************************************************/
@@ -236,8 +331,6 @@ static uint16_t TbxRandomNumber16BitGet(void)
   uint32_t lfsr32_second_shift;
   uint32_t lfsr31_first_shift;
 
-  /* Obtain mutual exclusive access to the 32-bit and 31-bit global LFSRs. */
-  TbxCriticalSectionEnter();
   /* Shifting the 32-bit LFSR more than once before getting a random number improves its
    * statistical properties. For this reason the 32-bit LFSR is shifted twice.
    */
@@ -251,8 +344,6 @@ static uint16_t TbxRandomNumber16BitGet(void)
    */
   lfsr31_first_shift = TbxRandomShiftLFSR(&tbxRandomNumberLFSR31,
                                           TBX_RANDOM_LFSR31_POLYMASK);
-  /* Release mutual exclusive access to the 32-bit and 31-bit global LFSRs. */
-  TbxCriticalSectionExit();
 
   /* Construct the actual 16-bit random value by XORing the twice shifted 32-bit LFSR and
    * the once shifted 31-bit LFSR.
@@ -264,4 +355,172 @@ static uint16_t TbxRandomNumber16BitGet(void)
 } /*** end of TbxRandomNumber16BitGet ***/
 
 
+/************************************************************************************//**
+** \brief     Generates the next 32-bit random number, by combining two 16-bit random
+**            numbers. The caller should have mutual exclusive access to the generator
+**            state.
+** \return    Value of the newly generated random number.
+**
+****************************************************************************************/
+static uint32_t TbxRandomNext(void)
+{
+  uint32_t result;
+
+  /* Construct a 32-bit random number by combining two 16-bit random numbers. */
+  result  = ((uint32_t)TbxRandomNumber16BitGet() << 16UL);
+  result |= TbxRandomNumber16BitGet();
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxRandomNext ***/
+#elif (TBX_CONF_RANDOM_GENERATOR == TBX_RANDOM_GENERATOR_XOSHIRO128SS)
+/************************************************************************************//**
+** \brief     Initialize the xoshiro128** state. The 128-bit state is derived from two
+**            seed values with SplitMix32, which makes sure that similar seed values
+**            still result in very different states.
+**
+****************************************************************************************/
+static void TbxRandomSeed(void)
+{
+  uint32_t seed[2] = { 0xABCDEUL, 0x23456789UL };
+
+  /* Request the application to fill in the seed values, if it registered a handler for
+   * this.
+   */
+  if (tbxRandomSeedInitHandler != NULL)
+  {
+    /* Call the application specific seed initialization handler. */
+    seed[0] = tbxRandomSeedInitHandler();
+    seed[1] = tbxRandomSeedInitHandler();
+  }
+
+  /* Expand the seed values to the state. The second seed value is mixed into the
+   * SplitMix32 state halfway, instead of starting a new sequence with it. Otherwise two
+   * equal seed values result in a state with two equal halves, which xoshiro128**
+   * cancels out. Note that this function is only called once the first time a random
+   * number is generated, so there is no need to use a critical section for writing to
+   * the state.
+   */
+  tbxRandomXoshiroState[0] = TbxRandomSplitMix(&seed[0]);
+  tbxRandomXoshiroState[1] = TbxRandomSplitMix(&seed[0]);
+  seed[0] ^= seed[1];
+  tbxRandomXoshiroState[2] = TbxRandomSplitMix(&seed[0]);
+  tbxRandomXoshiroState[3] = TbxRandomSplitMix(&seed[0]);
+
+  /* Make sure the state is not all zeroes. */
+  if ((tbxRandomXoshiroState[0] | tbxRandomXoshiroState[1] |
+       tbxRandomXoshiroState[2] | tbxRandomXoshiroState[3]) == 0U)
+  {
+    tbxRandomXoshiroState[0] = 0xABCDEUL;
+  }
+} /*** end of TbxRandomSeed ***/
+
+
+/************************************************************************************//**
+** \brief     Generates the next 32-bit random number with xoshiro128**. The caller
+**            should have mutual exclusive access to the generator state.
+** \return    Value of the newly generated random number.
+**
+****************************************************************************************/
+static uint32_t TbxRandomNext(void)
+{
+  uint32_t result;
+  uint32_t temp;
+  uint32_t * state = tbxRandomXoshiroState;
+
+  /* Scramble the second state word into the result. */
+  temp = state[1] * 5U;
+  result = ((temp << 7U) | (temp >> 25U)) * 9U;
+  /* Advance the state. */
+  temp = state[1] << 9U;
+  state[2] ^= state[0];
+  state[3] ^= state[1];
+  state[1] ^= state[2];
+  state[0] ^= state[3];
+  state[2] ^= temp;
+  state[3] = (state[3] << 11U) | (state[3] >> 21U);
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxRandomNext ***/
+
+
+/************************************************************************************//**
+** \brief     SplitMix32 generator. Only used for expanding the seed values.
+** \param     state Pointer to the SplitMix32 state. It is updated.
+** \return    Value of the newly generated number.
+**
+****************************************************************************************/
+static uint32_t TbxRandomSplitMix(uint32_t * state)
+{
+  uint32_t result;
+
+  /* Advance the state by the golden ratio constant. */
+  *state += 0x9E3779B9UL;
+  /* Mix the bits of the state into the result. */
+  result = *state;
+  result = (result ^ (result >> 16U)) * 0x85EBCA6BUL;
+  result = (result ^ (result >> 13U)) * 0xC2B2AE35UL;
+  result ^= result >> 16U;
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxRandomSplitMix ***/
+#else
+/************************************************************************************//**
+** \brief     Initialize the PCG32 state. The first seed value is the initial state and
+**            the second one selects the stream.
+**
+****************************************************************************************/
+static void TbxRandomSeed(void)
+{
+  uint32_t seedState = 0xABCDEUL;
+  uint32_t seedStream = 0x23456789UL;
+
+  /* Request the application to fill in the seed values, if it registered a handler for
+   * this.
+   */
+  if (tbxRandomSeedInitHandler != NULL)
+  {
+    /* Call the application specific seed initialization handler. */
+    seedState = tbxRandomSeedInitHandler();
+    seedStream = tbxRandomSeedInitHandler();
+  }
+
+  /* Initialize the state as recommended for PCG32. Note that this function is only
+   * called once the first time a random number is generated, so there is no need to
+   * use a critical section for writing to the state.
+   */
+  tbxRandomPcgState = 0U;
+  tbxRandomPcgInc = ((uint64_t)seedStream << 1U) | 1U;
+  (void)TbxRandomNext();
+  tbxRandomPcgState += seedState;
+  (void)TbxRandomNext();
+} /*** end of TbxRandomSeed ***/
+
+
+/************************************************************************************//**
+** \brief     Generates the next 32-bit random number with PCG32. The caller should have
+**            mutual exclusive access to the generator state.
+** \return    Value of the newly generated random number.
+**
+****************************************************************************************/
+static uint32_t TbxRandomNext(void)
+{
+  uint64_t oldState = tbxRandomPcgState;
+  uint32_t xorShifted;
+  uint32_t rotation;
+
+  /* Advance the state of the linear congruential generator. */
+  tbxRandomPcgState = (oldState * TBX_RANDOM_PCG32_MULTIPLIER) + tbxRandomPcgInc;
+  /* Permute the old state into the result with a xorshift and a random rotation. */
+  xorShifted = (uint32_t)(((oldState >> 18U) ^ oldState) >> 27U);
+  rotation = (uint32_t)(oldState >> 59U);
+
+  /* Give the result back to the caller. */
+  return (xorShifted >> rotation) | (xorShifted << ((32U - rotation) & 31U));
+} /*** end of TbxRandomNext ***/
+#endif
+
+
 /*********************************** end of tbx_random.c *******************************/
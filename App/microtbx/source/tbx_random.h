@@ -39,6 +39,34 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Generator based on a 32-bit and a 31-bit linear feedback shift register. */
+#define TBX_RANDOM_GENERATOR_LFSR                (0U)
+
+/** \brief Generator based on xoshiro128**, with a period of 2^128 - 1. */
+#define TBX_RANDOM_GENERATOR_XOSHIRO128SS        (1U)
+
+/** \brief Generator based on PCG32 (XSH RR variant), with a period of 2^64. */
+#define TBX_RANDOM_GENERATOR_PCG32               (2U)
+
+
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_CONF_RANDOM_GENERATOR
+/** \brief Selects the random number generator algorithm. The LFSR generator shifts
+ *         its registers bit by bit and is therefore the slowest. Both xoshiro128** and
+ *         PCG32 generate a 32-bit number in a handful of instructions and have better
+ *         statistical properties. xoshiro128** only needs 32-bit operations. PCG32
+ *         needs a 64-bit multiplication. Note that it is possible to override this value
+ *         by adding this macro definition to the configuration header file.
+ */
+#define TBX_CONF_RANDOM_GENERATOR                (TBX_RANDOM_GENERATOR_LFSR)
+#endif
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -51,6 +79,9 @@ typedef uint32_t (* tTbxRandomSeedInitHandler)(void);
 ****************************************************************************************/
 uint32_t TbxRandomNumberGet         (void);
 
+void     TbxRandomFill              (uint8_t * data,
+                                     size_t    len);
+
 void     TbxRandomSetSeedInitHandler(tTbxRandomSeedInitHandler seedInitHandler);
 
 
@@ -46,12 +46,29 @@ extern "C" {
 #define TBX_CONF_ASSERTIONS_ENABLE               (1U)
 
 
+/****************************************************************************************
+*   C R I T I C A L   S E C T I O N S   M O D U L E   C O N F I G U R A T I O N
+****************************************************************************************/
+/** \brief Interrupt mask level of the critical section. 0 disables all interrupts. */
+#define TBX_CONF_CRITSECT_MASK_LEVEL             (0U)
+
+
 /****************************************************************************************
 *   H E A P   M O D U L E   C O N F I G U R A T I O N
 ****************************************************************************************/
 /** \brief Configure the size of the heap in bytes. */
 #define TBX_CONF_HEAP_SIZE                       (2048U)
 
+/** \brief Enable/disable the two-level segregated fit heap, which supports freeing. */
+#define TBX_CONF_HEAP_TLSF_ENABLE                (0U)
+
+
+/****************************************************************************************
+*   R A N D O M   N U M B E R   M O D U L E   C O N F I G U R A T I O N
+****************************************************************************************/
+/** \brief Select the random number generator algorithm. */
+#define TBX_CONF_RANDOM_GENERATOR                (TBX_RANDOM_GENERATOR_LFSR)
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,599 @@
+/************************************************************************************//**
+* \file         benchmarks.c
+* \brief        Benchmarks source file.
+* \details      Measures the throughput of the MicroTBX functions that were optimized for
+*               speed. Meant to be linked with the Linux port, next to the unit tests, and
+*               built with the same optimization level as the firmware. The results are
+*               printed to the standard output.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2022 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX global header             */
+#include "benchmarks.h"                          /* Benchmarks header                  */
+#include <stdio.h>                               /* Standard I/O functions             */
+#include <string.h>                              /* String utilities                   */
+#include <time.h>                                /* Time definitions                   */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Size of the buffer that each AES256 benchmark processes. */
+#define BENCHMARK_AES_BUF_SIZE                   (4096U)
+
+/** \brief Size of the buffer that each random number benchmark fills. */
+#define BENCHMARK_RANDOM_BUF_SIZE                (4096U)
+
+/** \brief Number of blocks in each memory pool of the memory pool benchmarks. */
+#define BENCHMARK_MEMPOOL_BLOCKS                 (8U)
+
+/** \brief Number of extra memory pools, with larger blocks, that the memory pool
+ *         benchmarks add to show how the lookup scales with the number of pools.
+ */
+#define BENCHMARK_MEMPOOL_EXTRA_POOLS            (48U)
+
+/** \brief Number of items that each sort benchmark sorts. */
+#define BENCHMARK_SORT_ITEMS                     (1000U)
+
+/** \brief Number of runs per benchmark. The fastest one is reported, as it is the least
+ *         disturbed by the scheduler.
+ */
+#define BENCHMARK_RUNS                           (20U)
+
+/** \brief Minimum duration of a single run in nanoseconds, to stay well above the
+ *         resolution of the clock.
+ */
+#define BENCHMARK_MIN_RUN_NS                     (50000000U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Function that processes the benchmark buffer once. */
+typedef void (* tBenchmarkFcn)(void);
+
+/** \brief Item that the sort benchmarks sort. */
+typedef struct
+{
+  uint32_t      key;
+  tTbxIListLink link;
+} tBenchmarkSortItem;
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Buffer that the AES256 benchmarks process. */
+static uint8_t benchmarkAesBuf[BENCHMARK_AES_BUF_SIZE];
+
+/** \brief Context with the cached key schedules. */
+static tTbxCryptoAes256Ctx benchmarkAesCtx;
+
+/** \brief IV or counter for the CBC and CTR benchmarks. */
+static uint8_t benchmarkAesIv[16];
+
+/** \brief 256-bit key from NIST SP 800-38A. */
+static const uint8_t benchmarkAesKey[32] =
+{
+  0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+  0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+};
+
+/** \brief Buffer that the random number benchmarks fill. */
+static uint8_t benchmarkRandomBuf[BENCHMARK_RANDOM_BUF_SIZE];
+
+/** \brief Combination of the obtained random numbers, so that they are used. */
+static uint32_t benchmarkRandomSink;
+
+/** \brief Block sizes of the memory pools that the memory pool benchmarks use. */
+static const size_t benchmarkMemPoolSizes[] =
+{
+  8U, 12U, 16U, 24U, 32U, 48U, 64U, 96U, 128U, 192U, 256U, 512U
+};
+
+/** \brief Block size of the largest extra memory pool. */
+static size_t benchmarkMemPoolLargestSize;
+
+/** \brief Items that the sort benchmarks sort. */
+static tBenchmarkSortItem benchmarkSortItems[BENCHMARK_SORT_ITEMS];
+
+/** \brief Linked list with the items, for the TbxListSortItems() benchmark. */
+static tTbxList * benchmarkSortList;
+
+/** \brief Intrusive linked list with the items, for the TbxIListSort() benchmark. */
+static tTbxIList benchmarkSortIList;
+
+/** \brief State of the xorshift generator that shuffles the keys of the items. */
+static uint32_t benchmarkSortState = 0x12345678U;
+
+
+/************************************************************************************//**
+** \brief     Obtains the time of the monotonic clock.
+** \return    Time in nanoseconds.
+**
+****************************************************************************************/
+static uint64_t benchmarkGetTimeNs(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+} /*** end of benchmarkGetTimeNs ***/
+
+
+/************************************************************************************//**
+** \brief     Measures how long one call of a benchmark function takes.
+** \param     benchmarkFcn Function to measure.
+** \return    Time of one call in nanoseconds, from the fastest run.
+**
+****************************************************************************************/
+static double benchmarkMeasure(tBenchmarkFcn benchmarkFcn)
+{
+  uint64_t bestNs = UINT64_MAX;
+  uint64_t startNs;
+  uint64_t runNs;
+  uint32_t calls;
+  uint32_t run;
+
+  /* Warm up the caches and find out how many calls make one run long enough. */
+  calls = 1U;
+  do
+  {
+    calls *= 2U;
+    startNs = benchmarkGetTimeNs();
+    for (uint32_t idx = 0U; idx < calls; idx++)
+    {
+      benchmarkFcn();
+    }
+    runNs = benchmarkGetTimeNs() - startNs;
+  }
+  while (runNs < BENCHMARK_MIN_RUN_NS);
+
+  /* Time the runs and keep the fastest one. */
+  for (run = 0U; run < BENCHMARK_RUNS; run++)
+  {
+    startNs = benchmarkGetTimeNs();
+    for (uint32_t idx = 0U; idx < calls; idx++)
+    {
+      benchmarkFcn();
+    }
+    runNs = benchmarkGetTimeNs() - startNs;
+    if (runNs < bestNs)
+    {
+      bestNs = runNs;
+    }
+  }
+  return (double)bestNs / (double)calls;
+} /*** end of benchmarkMeasure ***/
+
+
+/************************************************************************************//**
+** \brief     Runs a benchmark and prints its throughput.
+** \param     name Name to print.
+** \param     benchmarkFcn Function that processes the buffer once.
+** \param     bytes Number of bytes that one call of the function processes.
+**
+****************************************************************************************/
+static void benchmarkRun(char const * name, tBenchmarkFcn benchmarkFcn, size_t bytes)
+{
+  double mbPerSec;
+
+  mbPerSec = ((double)bytes * 1000.0) / benchmarkMeasure(benchmarkFcn);
+  printf("  %-32s %8.1f MB/s\n", name, mbPerSec);
+} /*** end of benchmarkRun ***/
+
+
+/************************************************************************************//**
+** \brief     Runs a benchmark and prints the time that one of its operations takes.
+** \param     name Name to print.
+** \param     benchmarkFcn Function that performs the operations.
+** \param     ops Number of operations that one call of the function performs.
+**
+****************************************************************************************/
+static void benchmarkRunOps(char const * name, tBenchmarkFcn benchmarkFcn, size_t ops)
+{
+  double nsPerOp;
+
+  nsPerOp = benchmarkMeasure(benchmarkFcn) / (double)ops;
+  printf("  %-32s %8.1f ns\n", name, nsPerOp);
+} /*** end of benchmarkRunOps ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts the buffer with the one-shot function, which derives the key
+**            schedule on each call.
+**
+****************************************************************************************/
+static void benchmarkAes256Encrypt(void)
+{
+  TbxCryptoAes256Encrypt(benchmarkAesBuf, sizeof(benchmarkAesBuf), benchmarkAesKey);
+} /*** end of benchmarkAes256Encrypt ***/
+
+
+/************************************************************************************//**
+** \brief     Decrypts the buffer with the one-shot function, which derives the key
+**            schedules on each call.
+**
+****************************************************************************************/
+static void benchmarkAes256Decrypt(void)
+{
+  TbxCryptoAes256Decrypt(benchmarkAesBuf, sizeof(benchmarkAesBuf), benchmarkAesKey);
+} /*** end of benchmarkAes256Decrypt ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts the buffer in ECB mode with the cached key schedule.
+**
+****************************************************************************************/
+static void benchmarkAes256EncryptEcb(void)
+{
+  TbxCryptoAes256EncryptEcb(&benchmarkAesCtx, benchmarkAesBuf, sizeof(benchmarkAesBuf));
+} /*** end of benchmarkAes256EncryptEcb ***/
+
+
+/************************************************************************************//**
+** \brief     Decrypts the buffer in ECB mode with the cached key schedule.
+**
+****************************************************************************************/
+static void benchmarkAes256DecryptEcb(void)
+{
+  TbxCryptoAes256DecryptEcb(&benchmarkAesCtx, benchmarkAesBuf, sizeof(benchmarkAesBuf));
+} /*** end of benchmarkAes256DecryptEcb ***/
+
+
+/************************************************************************************//**
+** \brief     Encrypts the buffer in CBC mode with the cached key schedule.
+**
+****************************************************************************************/
+static void benchmarkAes256EncryptCbc(void)
+{
+  TbxCryptoAes256EncryptCbc(&benchmarkAesCtx, benchmarkAesBuf, sizeof(benchmarkAesBuf),
+                            benchmarkAesIv);
+} /*** end of benchmarkAes256EncryptCbc ***/
+
+
+/************************************************************************************//**
+** \brief     Decrypts the buffer in CBC mode with the cached key schedule.
+**
+****************************************************************************************/
+static void benchmarkAes256DecryptCbc(void)
+{
+  TbxCryptoAes256DecryptCbc(&benchmarkAesCtx, benchmarkAesBuf, sizeof(benchmarkAesBuf),
+                            benchmarkAesIv);
+} /*** end of benchmarkAes256DecryptCbc ***/
+
+
+/************************************************************************************//**
+** \brief     Processes the buffer in CTR mode with the cached key schedule.
+**
+****************************************************************************************/
+static void benchmarkAes256Ctr(void)
+{
+  TbxCryptoAes256Ctr(&benchmarkAesCtx, benchmarkAesBuf, sizeof(benchmarkAesBuf),
+                     benchmarkAesIv);
+} /*** end of benchmarkAes256Ctr ***/
+
+
+/************************************************************************************//**
+** \brief     Fills the buffer with 32-bit random numbers, one call per number.
+**
+****************************************************************************************/
+static void benchmarkRandomNumberGet(void)
+{
+  uint32_t number;
+
+  for (size_t idx = 0U; idx < sizeof(benchmarkRandomBuf); idx += sizeof(number))
+  {
+    number = TbxRandomNumberGet();
+    (void)memcpy(&benchmarkRandomBuf[idx], &number, sizeof(number));
+    benchmarkRandomSink ^= number;
+  }
+} /*** end of benchmarkRandomNumberGet ***/
+
+
+/************************************************************************************//**
+** \brief     Fills the buffer with random bytes in one call.
+**
+****************************************************************************************/
+static void benchmarkRandomFill(void)
+{
+  TbxRandomFill(benchmarkRandomBuf, sizeof(benchmarkRandomBuf));
+} /*** end of benchmarkRandomFill ***/
+
+
+/************************************************************************************//**
+** \brief     Runs the random number benchmarks and prints their results.
+**
+****************************************************************************************/
+static void benchmarkRandomRunAll(void)
+{
+  static char const * const generatorNames[] =
+  {
+    "LFSR", "xoshiro128**", "PCG32"
+  };
+
+  printf("Random numbers, %s, %u byte buffer, best of %u runs:\n",
+         generatorNames[TBX_CONF_RANDOM_GENERATOR], BENCHMARK_RANDOM_BUF_SIZE,
+         BENCHMARK_RUNS);
+  benchmarkRun("TbxRandomNumberGet", benchmarkRandomNumberGet,
+               sizeof(benchmarkRandomBuf));
+  benchmarkRun("TbxRandomFill", benchmarkRandomFill, sizeof(benchmarkRandomBuf));
+  /* Also report the time per 32-bit number. */
+  benchmarkRunOps("TbxRandomNumberGet, per number", benchmarkRandomNumberGet,
+                  sizeof(benchmarkRandomBuf) / sizeof(uint32_t));
+} /*** end of benchmarkRandomRunAll ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates and releases a block of each memory pool size.
+**
+****************************************************************************************/
+static void benchmarkMemPoolPairs(void)
+{
+  void * blockPtr;
+
+  for (size_t idx = 0U; idx < (sizeof(benchmarkMemPoolSizes)/sizeof(size_t)); idx++)
+  {
+    /* Request one byte less than the block size, like a typical best fit request. */
+    blockPtr = TbxMemPoolAllocate(benchmarkMemPoolSizes[idx] - 1U);
+    TbxMemPoolRelease(blockPtr);
+  }
+} /*** end of benchmarkMemPoolPairs ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates and releases a block of the largest memory pool, which is found
+**            at the end of the pool list.
+**
+****************************************************************************************/
+static void benchmarkMemPoolPairLargest(void)
+{
+  void * blockPtr;
+
+  blockPtr = TbxMemPoolAllocate(benchmarkMemPoolLargestSize);
+  TbxMemPoolRelease(blockPtr);
+} /*** end of benchmarkMemPoolPairLargest ***/
+
+
+/************************************************************************************//**
+** \brief     Runs the memory pool benchmarks and prints their results. Note that memory
+**            pools cannot be deleted, so the pools that this function creates stay on
+**            the heap.
+**
+****************************************************************************************/
+static void benchmarkMemPoolRunAll(void)
+{
+  uint8_t poolsOk = TBX_TRUE;
+  size_t  numSizes = sizeof(benchmarkMemPoolSizes)/sizeof(size_t);
+
+  printf("Memory pools, best of %u runs, per allocate and release pair:\n",
+         BENCHMARK_RUNS);
+  for (size_t idx = 0U; idx < numSizes; idx++)
+  {
+    if (TbxMemPoolCreate(BENCHMARK_MEMPOOL_BLOCKS, benchmarkMemPoolSizes[idx]) == TBX_ERROR)
+    {
+      poolsOk = TBX_FALSE;
+    }
+  }
+  if (poolsOk == TBX_FALSE)
+  {
+    printf("  %-32s skipped, heap too small\n", "TbxMemPoolAllocate");
+  }
+  else
+  {
+    benchmarkRunOps("12 pools, all sizes", benchmarkMemPoolPairs, numSizes);
+    /* Add pools with larger blocks, which are beyond the size class index. */
+    for (size_t idx = 0U; idx < BENCHMARK_MEMPOOL_EXTRA_POOLS; idx++)
+    {
+      benchmarkMemPoolLargestSize = benchmarkMemPoolSizes[numSizes - 1U] + 8U + (idx * 8U);
+      if (TbxMemPoolCreate(1U, benchmarkMemPoolLargestSize) == TBX_ERROR)
+      {
+        poolsOk = TBX_FALSE;
+      }
+    }
+    if (poolsOk == TBX_FALSE)
+    {
+      printf("  %-32s skipped, heap too small\n", "60 pools");
+    }
+    else
+    {
+      benchmarkRunOps("60 pools, all sizes", benchmarkMemPoolPairs, numSizes);
+      benchmarkRunOps("60 pools, largest size", benchmarkMemPoolPairLargest, 1U);
+    }
+  }
+} /*** end of benchmarkMemPoolRunAll ***/
+
+
+/************************************************************************************//**
+** \brief     Gives the items new pseudo random keys, so that each sort starts from an
+**            unsorted list. Uses a xorshift generator instead of the random number
+**            module, to keep the keys the same from build to build.
+**
+****************************************************************************************/
+static void benchmarkSortShuffle(void)
+{
+  for (size_t idx = 0U; idx < BENCHMARK_SORT_ITEMS; idx++)
+  {
+    benchmarkSortState ^= benchmarkSortState << 13U;
+    benchmarkSortState ^= benchmarkSortState >> 17U;
+    benchmarkSortState ^= benchmarkSortState << 5U;
+    benchmarkSortItems[idx].key = benchmarkSortState;
+  }
+} /*** end of benchmarkSortShuffle ***/
+
+
+/************************************************************************************//**
+** \brief     Item comparison function for the TbxListSortItems() benchmark.
+** \param     item1 Pointer to the first item.
+** \param     item2 Pointer to the second item.
+** \return    TBX_TRUE if item1's key is greater than item2's key, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t benchmarkSortCompareItems(void const * item1, void const * item2)
+{
+  uint8_t result = TBX_FALSE;
+
+  if (((tBenchmarkSortItem const *)item1)->key > ((tBenchmarkSortItem const *)item2)->key)
+  {
+    result = TBX_TRUE;
+  }
+  return result;
+} /*** end of benchmarkSortCompareItems ***/
+
+
+/************************************************************************************//**
+** \brief     Link comparison function for the TbxIListSort() benchmark.
+** \param     link1 Link of the first item.
+** \param     link2 Link of the second item.
+** \return    TBX_TRUE if item1's key is greater than item2's key, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t benchmarkSortCompareLinks(tTbxIListLink const * link1,
+                                         tTbxIListLink const * link2)
+{
+  return benchmarkSortCompareItems(TBX_ILIST_ITEM(link1, tBenchmarkSortItem const, link),
+                                   TBX_ILIST_ITEM(link2, tBenchmarkSortItem const, link));
+} /*** end of benchmarkSortCompareLinks ***/
+
+
+/************************************************************************************//**
+** \brief     Shuffles the keys and sorts the linked list.
+**
+****************************************************************************************/
+static void benchmarkListSortItems(void)
+{
+  benchmarkSortShuffle();
+  TbxListSortItems(benchmarkSortList, benchmarkSortCompareItems);
+} /*** end of benchmarkListSortItems ***/
+
+
+/************************************************************************************//**
+** \brief     Shuffles the keys and sorts the intrusive linked list.
+**
+****************************************************************************************/
+static void benchmarkIListSort(void)
+{
+  benchmarkSortShuffle();
+  TbxIListSort(&benchmarkSortIList, benchmarkSortCompareLinks);
+} /*** end of benchmarkIListSort ***/
+
+
+/************************************************************************************//**
+** \brief     Runs the sort benchmarks and prints their results.
+**
+****************************************************************************************/
+static void benchmarkSortRunAll(void)
+{
+  uint8_t listOk = TBX_FALSE;
+
+  printf("Sort, %u items, best of %u runs, per sort:\n", BENCHMARK_SORT_ITEMS,
+         BENCHMARK_RUNS);
+  /* The nodes of the linked list come from a memory pool on the heap. */
+  benchmarkSortList = TbxListCreate();
+  if (benchmarkSortList != NULL)
+  {
+    listOk = TBX_TRUE;
+    for (size_t idx = 0U; idx < BENCHMARK_SORT_ITEMS; idx++)
+    {
+      if (TbxListInsertItemBack(benchmarkSortList, &benchmarkSortItems[idx]) == TBX_ERROR)
+      {
+        listOk = TBX_FALSE;
+        break;
+      }
+    }
+  }
+  TbxIListInit(&benchmarkSortIList);
+  for (size_t idx = 0U; idx < BENCHMARK_SORT_ITEMS; idx++)
+  {
+    TbxIListInsertBack(&benchmarkSortIList, &benchmarkSortItems[idx].link);
+  }
+  /* Each call shuffles the keys first. Report that part too, to subtract it. */
+  benchmarkRunOps("(shuffle only)", benchmarkSortShuffle, 1U);
+  if (listOk == TBX_TRUE)
+  {
+    benchmarkRunOps("TbxListSortItems", benchmarkListSortItems, 1U);
+  }
+  else
+  {
+    printf("  %-32s skipped, heap too small\n", "TbxListSortItems");
+  }
+  benchmarkRunOps("TbxIListSort", benchmarkIListSort, 1U);
+  /* Give the nodes back. */
+  if (benchmarkSortList != NULL)
+  {
+    TbxListDelete(benchmarkSortList);
+    benchmarkSortList = NULL;
+  }
+} /*** end of benchmarkSortRunAll ***/
+
+
+/************************************************************************************//**
+** \brief     Runs all benchmarks and prints their results.
+**
+****************************************************************************************/
+void runBenchmarks(void)
+{
+  /* Prepare the AES256 buffer and context. */
+  for (size_t idx = 0U; idx < sizeof(benchmarkAesBuf); idx++)
+  {
+    benchmarkAesBuf[idx] = (uint8_t)idx;
+  }
+  (void)memset(benchmarkAesIv, 0, sizeof(benchmarkAesIv));
+  TbxCryptoAes256Init(&benchmarkAesCtx, benchmarkAesKey);
+
+  printf("AES256, %u byte buffer, best of %u runs:\n", BENCHMARK_AES_BUF_SIZE,
+         BENCHMARK_RUNS);
+  benchmarkRun("TbxCryptoAes256Encrypt", benchmarkAes256Encrypt, sizeof(benchmarkAesBuf));
+  benchmarkRun("TbxCryptoAes256Decrypt", benchmarkAes256Decrypt, sizeof(benchmarkAesBuf));
+  benchmarkRun("TbxCryptoAes256EncryptEcb", benchmarkAes256EncryptEcb,
+               sizeof(benchmarkAesBuf));
+  benchmarkRun("TbxCryptoAes256DecryptEcb", benchmarkAes256DecryptEcb,
+               sizeof(benchmarkAesBuf));
+  benchmarkRun("TbxCryptoAes256EncryptCbc", benchmarkAes256EncryptCbc,
+               sizeof(benchmarkAesBuf));
+  benchmarkRun("TbxCryptoAes256DecryptCbc", benchmarkAes256DecryptCbc,
+               sizeof(benchmarkAesBuf));
+  benchmarkRun("TbxCryptoAes256Ctr", benchmarkAes256Ctr, sizeof(benchmarkAesBuf));
+
+  TbxCryptoAes256Done(&benchmarkAesCtx);
+
+  benchmarkRandomRunAll();
+  benchmarkMemPoolRunAll();
+  benchmarkSortRunAll();
+} /*** end of runBenchmarks ***/
+
+
+/*********************************** end of benchmarks.c *******************************/
@@ -41,6 +41,8 @@
 #include "unity.h"                               /* Unity unit test framework          */
 #include "unittests.h"                           /* Unit tests header                  */
 #include <sys/time.h>                            /* Time definitions                   */
+#include <string.h>                              /* String utilities                   */
+#include <pthread.h>                             /* Posix thread utilities             */
 
 
 /****************************************************************************************
@@ -54,6 +56,14 @@ typedef struct
   uint8_t  data[8];
 } tListTestMsg;
 
+/** \brief Layout of a message used for testing the intrusive linked list module. */
+typedef struct
+{
+  uint32_t      id;
+  uint32_t      seq;
+  tTbxIListLink link;
+} tIListTestMsg;
+
 
 /****************************************************************************************
 * Local data declarations
@@ -70,6 +80,28 @@ const size_t memPoolBlockSize = 16;
 /** \brief Array with block pointers allocated from the test memory pool. */
 void * memPoolAllocatedBlocks[3];
 
+/** \brief Key of the AES256 test vectors from NIST SP 800-38A. */
+const uint8_t aesVectorKey[32] =
+{
+  0x60, 0x3D, 0xEB, 0x10, 0x15, 0xCA, 0x71, 0xBE,
+  0x2B, 0x73, 0xAE, 0xF0, 0x85, 0x7D, 0x77, 0x81,
+  0x1F, 0x35, 0x2C, 0x07, 0x3B, 0x61, 0x08, 0xD7,
+  0x2D, 0x98, 0x10, 0xA3, 0x09, 0x14, 0xDF, 0xF4
+};
+
+/** \brief Plaintext of the AES256 test vectors from NIST SP 800-38A. */
+const uint8_t aesVectorPlain[64] =
+{
+  0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96,
+  0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+  0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C,
+  0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+  0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11,
+  0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+  0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17,
+  0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+};
+
 /** \brief Test message A for the linked list module. */
 static tListTestMsg listTestMsgA = 
 {
@@ -94,6 +126,15 @@ static tListTestMsg listTestMsgC =
   .data = { 12, 13 }
 };
 
+/** \brief List to insert an item into while it is sorted. NULL once inserted. */
+static tTbxIList * insertMeanwhileList = NULL;
+
+/** \brief Item that gets inserted into the list while it is sorted. */
+static tIListTestMsg insertMeanwhileMsg;
+
+/** \brief Size that the list had while it was sorted. */
+static size_t insertMeanwhileListSize;
+
 
 /************************************************************************************//**
 ** \brief     Handles the run-time assertions. 
@@ -151,6 +192,48 @@ uint8_t compareListMsg(void const * item1, void const * item2)
 } /*** end of compareListMsg ***/
 
 
+/************************************************************************************//**
+** \brief     Message comparison function used for sorting the intrusive linked lists.
+** \param     link1 Link of the first item for the comparison.
+** \param     link2 Link of the second item for the comparison.
+** \return    TBX_TRUE if item1's data is greater than item2's data, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t compareIListMsg(tTbxIListLink const * link1, tTbxIListLink const * link2)
+{
+  uint8_t result = TBX_FALSE;
+  tIListTestMsg const * msg1 = TBX_ILIST_ITEM(link1, tIListTestMsg const, link);
+  tIListTestMsg const * msg2 = TBX_ILIST_ITEM(link2, tIListTestMsg const, link);
+
+  if (msg1->id > msg2->id)
+  {
+    result = TBX_TRUE;
+  }
+  return result;
+} /*** end of compareIListMsg ***/
+
+
+/************************************************************************************//**
+** \brief     Message comparison function that once inserts an extra item at the back of
+**            the list that is being sorted, as if another context inserted it meanwhile.
+** \param     link1 Link of the first item for the comparison.
+** \param     link2 Link of the second item for the comparison.
+** \return    TBX_TRUE if item1's data is greater than item2's data, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t compareIListMsgAndInsert(tTbxIListLink const * link1, tTbxIListLink const * link2)
+{
+  if (insertMeanwhileList != NULL)
+  {
+    /* Store the size the list has while it is sorted. */
+    insertMeanwhileListSize = TbxIListGetSize(insertMeanwhileList);
+    TbxIListInsertBack(insertMeanwhileList, &insertMeanwhileMsg.link);
+    insertMeanwhileList = NULL;
+  }
+  return compareIListMsg(link1, link2);
+} /*** end of compareIListMsgAndInsert ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that verifies that the version macros are present.
 **
@@ -293,6 +376,101 @@ void test_TbxCriticalSectionEnter_ShouldNotAssertUponCritSectExit(void)
 } /*** end of test_TbxCriticalSectionEnter_ShouldNotAssertUponCritSectExit ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that the lock functions trigger an assertion upon invalid parameters
+**            and when exiting a lock that wasn't entered.
+**
+****************************************************************************************/
+void test_TbxLock_ShouldAssertOnInvalidParams(void)
+{
+  tTbxLock testLock = TBX_LOCK_INIT("test", 0U);
+
+  /* Enter a lock that is not valid. */
+  TbxLockEnter(NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* Exit a lock that is not valid. */
+  TbxLockExit(NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* Exit a lock, which hasn't actually been entered yet. */
+  TbxLockExit(&testLock);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxLock_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a lock can be entered multiple times, as long as it is exited
+**            the same number of times.
+**
+****************************************************************************************/
+void test_TbxLock_CanBeNested(void)
+{
+  tTbxLock testLock = TBX_LOCK_INIT("test", 0U);
+
+  /* Enter the lock twice, also from within the critical section. */
+  TbxLockEnter(&testLock);
+  TbxCriticalSectionEnter();
+  TbxLockEnter(&testLock);
+  TEST_ASSERT_EQUAL_UINT32(2U, testLock.nestingCounter);
+  /* Exit it again in the reverse order. */
+  TbxLockExit(&testLock);
+  TbxCriticalSectionExit();
+  TbxLockExit(&testLock);
+  TEST_ASSERT_EQUAL_UINT32(0U, testLock.nestingCounter);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxLock_CanBeNested ***/
+
+
+/************************************************************************************//**
+** \brief     Thread function for test_TbxLock_ShouldNotBlockOtherLocks(). It enters and
+**            exits the lock that it receives.
+** \param     arg Pointer to the lock.
+** \return    Always NULL.
+**
+****************************************************************************************/
+static void * lockTestThread(void * arg)
+{
+  tTbxLock * lock = (tTbxLock *)arg;
+
+  /* Enter and exit the lock. */
+  TbxLockEnter(lock);
+  TbxLockExit(lock);
+  return NULL;
+} /*** end of lockTestThread ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that holding one lock does not block another thread from entering a
+**            different lock.
+**
+****************************************************************************************/
+void test_TbxLock_ShouldNotBlockOtherLocks(void)
+{
+  tTbxLock  lockA = TBX_LOCK_INIT("a", 0U);
+  tTbxLock  lockB = TBX_LOCK_INIT("b", 0U);
+  pthread_t thread;
+
+  /* Hold the first lock, while another thread enters and exits the second lock. Joining
+   * the thread would never return, if both locks serialized on the same mutex.
+   */
+  TbxLockEnter(&lockA);
+  TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, lockTestThread, &lockB));
+  TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+  TbxLockExit(&lockA);
+  /* The second lock should be free again. */
+  TEST_ASSERT_EQUAL_UINT32(0U, lockB.nestingCounter);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxLock_ShouldNotBlockOtherLocks ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that free heap size reporting works.
 ** \attention Should run before any other tests that might allocated from the heap.
@@ -309,8 +487,17 @@ void test_TbxHeapGetFree_ShouldReturnActualFreeSize(void)
   initialFreeHeap = TbxHeapGetFree();
   /* Heap should not be zero. */
   TEST_ASSERT_GREATER_THAN(0, initialFreeHeap);
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+  /* First time that anything gets allocated means that the full heap should be free,
+   * except for the overhead of the first block header and the sentinel block.
+   */
+  TEST_ASSERT_LESS_OR_EQUAL(TBX_CONF_HEAP_SIZE, initialFreeHeap);
+  TEST_ASSERT_GREATER_OR_EQUAL(TBX_CONF_HEAP_SIZE - (4U * sizeof(void *)), 
+                               initialFreeHeap);
+#else
   /* First time that anything gets allocated means that the full heap should be free. */
   TEST_ASSERT_EQUAL(TBX_CONF_HEAP_SIZE, initialFreeHeap);
+#endif
   /* Allocate some memory from the heap. */
   mem = TbxHeapAllocate(allocSize);
   /* Get the current free heap size. */
@@ -421,13 +608,194 @@ void test_TbxHeapAllocate_ShouldAlignToAddressSize(void)
   /* Determine architectures address size by looking at the width of a pointer. */
   addressSize = sizeof(void *);
   /* Make sure the allocated size was aligned to the address size automatically. */
-  /* Should still be the same as before, because nothing should have been allocated. */
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+  /* With the TLSF heap, each block has a header and a minimum size of the free list
+   * pointers plus the pointer to the previous physical block.
+   */
+  TEST_ASSERT_EQUAL(0U, delta % addressSize);
+  TEST_ASSERT_EQUAL(4U * addressSize, delta);
+#else
   TEST_ASSERT_EQUAL(addressSize, delta);
+#endif
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 } /*** end of test_TbxHeapAllocate_ShouldAlignToAddressSize ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that an aligned memory allocation returns an aligned address.
+**
+****************************************************************************************/
+void test_TbxHeapAllocateAligned_ShouldAlignAddress(void)
+{
+  void * mem;
+
+  /* Allocate some memory with a large alignment. */
+  mem = TbxHeapAllocateAligned(3U, 64U);
+  /* Make sure the allocation worked. */
+  TEST_ASSERT_NOT_NULL(mem);
+  /* Make sure the address is aligned. */
+  TEST_ASSERT_EQUAL(0U, ((uintptr_t)mem) % 64U);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  /* An alignment that is not a power of two is not possible. */
+  mem = TbxHeapAllocateAligned(3U, 12U);
+  /* Make sure the allocation failed. */
+  TEST_ASSERT_NULL(mem);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxHeapAllocateAligned_ShouldAlignAddress ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion.
+**
+****************************************************************************************/
+void test_TbxHeapGetStats_ShouldAssertOnInvalidParams(void)
+{
+  /* It should not be possible to get the statistics without a pointer to store them. */
+  TbxHeapGetStats(NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxHeapGetStats_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that the heap statistics are consistent.
+**
+****************************************************************************************/
+void test_TbxHeapGetStats_ShouldReportUsage(void)
+{
+  tTbxHeapStats stats;
+  void        * mem;
+
+  /* Get the statistics. */
+  TbxHeapGetStats(&stats);
+  /* Make sure they are consistent with the free heap size. */
+  TEST_ASSERT_EQUAL(TbxHeapGetFree(), stats.free);
+  TEST_ASSERT_LESS_OR_EQUAL(TBX_CONF_HEAP_SIZE, stats.size);
+  TEST_ASSERT_LESS_OR_EQUAL(stats.free, stats.minFree);
+  TEST_ASSERT_LESS_OR_EQUAL(stats.free, stats.largestFree);
+  TEST_ASSERT_LESS_OR_EQUAL(100U, stats.fragmentation);
+  /* Allocate some memory from the heap. */
+  mem = TbxHeapAllocate(16U);
+  /* Make sure the allocation worked. */
+  TEST_ASSERT_NOT_NULL(mem);
+  /* Nothing was freed, so the lowest number of free bytes should equal the current. */
+  TbxHeapGetStats(&stats);
+  TEST_ASSERT_EQUAL(stats.free, stats.minFree);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxHeapGetStats_ShouldReportUsage ***/
+
+
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Tests that freed memory can be allocated again.
+**
+****************************************************************************************/
+void test_TbxHeapFree_CanReuseMemory(void)
+{
+  size_t initialFreeHeap;
+  void * mem1;
+  void * mem2;
+
+  /* Get the initial free heap size. */
+  initialFreeHeap = TbxHeapGetFree();
+  /* Allocate some memory from the heap. */
+  mem1 = TbxHeapAllocate(40U);
+  TEST_ASSERT_NOT_NULL(mem1);
+  /* Free it again. */
+  TbxHeapFree(mem1);
+  /* Make sure the free heap size is back to what it was. */
+  TEST_ASSERT_EQUAL(initialFreeHeap, TbxHeapGetFree());
+  /* Allocate the same size again, which should give the same memory. */
+  mem2 = TbxHeapAllocate(40U);
+  TEST_ASSERT_EQUAL_PTR(mem1, mem2);
+  TbxHeapFree(mem2);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  /* Freeing memory that is not on the heap is not possible. */
+  TbxHeapFree(&initialFreeHeap);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxHeapFree_CanReuseMemory ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that freed neighboring blocks are merged, such that the heap does
+**            not fragment.
+**
+****************************************************************************************/
+void test_TbxHeapFree_ShouldMergeNeighbors(void)
+{
+  tTbxHeapStats statsBefore;
+  tTbxHeapStats statsAfter;
+  void        * mem[4];
+  size_t        idx;
+
+  /* Get the initial statistics. */
+  TbxHeapGetStats(&statsBefore);
+  /* Allocate a few blocks of different sizes, one of them aligned. */
+  mem[0] = TbxHeapAllocate(24U);
+  mem[1] = TbxHeapAllocate(100U);
+  mem[2] = TbxHeapAllocateAligned(8U, 32U);
+  mem[3] = TbxHeapAllocate(60U);
+  for (idx = 0U; idx < 4U; idx++)
+  {
+    TEST_ASSERT_NOT_NULL(mem[idx]);
+  }
+  /* Free every other block, which fragments the heap. */
+  TbxHeapFree(mem[1]);
+  TbxHeapFree(mem[3]);
+  TbxHeapGetStats(&statsAfter);
+  TEST_ASSERT_GREATER_THAN(0U, statsAfter.fragmentation);
+  /* Free the remaining blocks, which should merge everything back together. */
+  TbxHeapFree(mem[0]);
+  TbxHeapFree(mem[2]);
+  TbxHeapGetStats(&statsAfter);
+  TEST_ASSERT_EQUAL(statsBefore.free, statsAfter.free);
+  TEST_ASSERT_EQUAL(statsBefore.largestFree, statsAfter.largestFree);
+  TEST_ASSERT_EQUAL(statsBefore.fragmentation, statsAfter.fragmentation);
+  /* The lowest number of free bytes should remember the peak usage. */
+  TEST_ASSERT_LESS_THAN(statsAfter.free, statsAfter.minFree);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxHeapFree_ShouldMergeNeighbors ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that the largest free size, reported by the statistics, can actually
+**            be allocated, also when the largest free block is not aligned to the
+**            boundary of its free list.
+**
+****************************************************************************************/
+void test_TbxHeapGetStats_LargestFreeCanBeAllocated(void)
+{
+  tTbxHeapStats stats;
+  void        * mem[2];
+
+  /* Allocate an odd sized block, such that the remaining free block is not aligned to
+   * the boundary of its free list.
+   */
+  mem[0] = TbxHeapAllocate(72U);
+  TEST_ASSERT_NOT_NULL(mem[0]);
+  /* Get the statistics. */
+  TbxHeapGetStats(&stats);
+  TEST_ASSERT_GREATER_THAN(0U, stats.largestFree);
+  TEST_ASSERT_LESS_OR_EQUAL(stats.free, stats.largestFree);
+  /* Allocating the reported largest free size should work. */
+  mem[1] = TbxHeapAllocate(stats.largestFree);
+  TEST_ASSERT_NOT_NULL(mem[1]);
+  /* Free the blocks again. */
+  TbxHeapFree(mem[1]);
+  TbxHeapFree(mem[0]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxHeapGetStats_LargestFreeCanBeAllocated ***/
+#endif
+
+
 /************************************************************************************//**
 ** \brief     Tests that an assertion is triggered if you try to set an invalid seed
 **            initialization handler.
@@ -474,6 +842,102 @@ void test_TbxRandomNumberGet_ShouldReturnRandomNumbers(void)
 } /*** end of test_TbxRandomNumberGet_ShouldReturnRandomNumbers ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion.
+**
+****************************************************************************************/
+void test_TbxRandomFill_ShouldAssertOnInvalidParams(void)
+{
+  uint8_t buffer[8] = { 0 };
+
+  /* Attempt to fill an invalid buffer. */
+  TbxRandomFill(NULL, sizeof(buffer));
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* Attempt to fill zero bytes. */
+  TbxRandomFill(buffer, 0U);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxRandomFill_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that only the requested number of bytes are filled, also when it is
+**            not a multiple of the random number size.
+**
+****************************************************************************************/
+void test_TbxRandomFill_ShouldNotWriteBeyondLength(void)
+{
+  uint8_t buffer[48];
+  size_t  len;
+  size_t  idx;
+
+  /* Fill buffers of all lengths that fit in the buffer, excluding the guard bytes. */
+  for (len = 1U; len <= (sizeof(buffer) - 4U); len++)
+  {
+    /* Initialize the buffer with a known pattern. */
+    memset(buffer, 0xA5, sizeof(buffer));
+    /* Attempt to fill the buffer. */
+    TbxRandomFill(buffer, len);
+    /* Make sure the bytes behind the requested length are untouched. */
+    for (idx = len; idx < sizeof(buffer); idx++)
+    {
+      TEST_ASSERT_EQUAL_UINT8(0xA5, buffer[idx]);
+    }
+  }
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxRandomFill_ShouldNotWriteBeyondLength ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that the filled bytes are uniformly distributed. It performs a
+**            chi-square test on the byte frequencies and a monobit test on all bits.
+**
+****************************************************************************************/
+void test_TbxRandomFill_ShouldBeUniformlyDistributed(void)
+{
+  static uint8_t buffer[65536];
+  uint32_t       counts[256] = { 0 };
+  uint32_t       onesCnt = 0U;
+  double         expected = (double)sizeof(buffer) / 256.0;
+  double         chiSquare = 0.0;
+  double         diff;
+  int32_t        bitsDiff;
+  size_t         idx;
+  uint8_t        bitIdx;
+
+  /* Fill the buffer with random bytes. */
+  TbxRandomFill(buffer, sizeof(buffer));
+  /* Count the byte values and the number of one bits. */
+  for (idx = 0U; idx < sizeof(buffer); idx++)
+  {
+    counts[buffer[idx]]++;
+    for (bitIdx = 0U; bitIdx < 8U; bitIdx++)
+    {
+      onesCnt += (buffer[idx] >> bitIdx) & 1U;
+    }
+  }
+  /* Calculate the chi-square statistic with 255 degrees of freedom. */
+  for (idx = 0U; idx < 256U; idx++)
+  {
+    diff = (double)counts[idx] - expected;
+    chiSquare += (diff * diff) / expected;
+  }
+  /* Make sure it is below the critical value for a significance level of 0.0001. */
+  TEST_ASSERT_TRUE(chiSquare < 347.0);
+  /* Make sure the number of one bits is within 4 standard deviations from half the
+   * number of bits. With 524288 bits, one standard deviation equals 362 bits.
+   */
+  bitsDiff = (int32_t)onesCnt - (int32_t)((sizeof(buffer) * 8U) / 2U);
+  TEST_ASSERT_TRUE((bitsDiff > -1448) && (bitsDiff < 1448));
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxRandomFill_ShouldBeUniformlyDistributed ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns zero.
 **
@@ -911,6 +1375,192 @@ void test_TbxCryptoAes256Decrypt_ShouldDecrypt(void)
 } /*** end of test_TbxCryptoAes256Decrypt_ShouldDecrypt ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that the context based AES256 functions trigger an assertion upon
+**            invalid parameters.
+**
+****************************************************************************************/
+void test_TbxCryptoAes256Ctx_ShouldAssertOnInvalidParams(void)
+{
+  tTbxCryptoAes256Ctx ctx;
+  uint8_t             buffer[32] = { 0 };
+  uint8_t             iv[16] = { 0 };
+
+  /* Initialize the context without a key. */
+  TbxCryptoAes256Init(&ctx, NULL);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Initialize the context properly. */
+  TbxCryptoAes256Init(&ctx, aesVectorKey);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  /* Encrypt in ECB mode with a length that is not a multiple of 16. */
+  TbxCryptoAes256EncryptEcb(&ctx, buffer, 15U);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Decrypt in ECB mode without a context. */
+  TbxCryptoAes256DecryptEcb(NULL, buffer, sizeof(buffer));
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Encrypt in CBC mode without an initialization vector. */
+  TbxCryptoAes256EncryptCbc(&ctx, buffer, sizeof(buffer), NULL);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Decrypt in CBC mode with a length that is not a multiple of 16. */
+  TbxCryptoAes256DecryptCbc(&ctx, buffer, 17U, iv);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Process in CTR mode without data. */
+  TbxCryptoAes256Ctr(&ctx, NULL, sizeof(buffer), iv);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Clear the context without a context. */
+  TbxCryptoAes256Done(NULL);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  assertionCnt = 0;
+  /* Make sure none of the invalid calls changed the buffers. */
+  for (uint8_t idx = 0U; idx < sizeof(buffer); idx++)
+  {
+    TEST_ASSERT_EQUAL_UINT8(0U, buffer[idx]);
+  }
+  /* Clear the context. */
+  TbxCryptoAes256Done(&ctx);
+  TEST_ASSERT_EQUAL_UINT32(0, ctx.encRoundKeys[0]);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxCryptoAes256Ctx_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that ECB mode with a context matches the NIST SP 800-38A test
+**            vectors F.1.5 and F.1.6.
+**
+****************************************************************************************/
+void test_TbxCryptoAes256Ecb_ShouldMatchTestVectors(void)
+{
+  const uint8_t expectedData[64] =
+  {
+    0xF3, 0xEE, 0xD1, 0xBD, 0xB5, 0xD2, 0xA0, 0x3C,
+    0x06, 0x4B, 0x5A, 0x7E, 0x3D, 0xB1, 0x81, 0xF8,
+    0x59, 0x1C, 0xCB, 0x10, 0xD4, 0x10, 0xED, 0x26,
+    0xDC, 0x5B, 0xA7, 0x4A, 0x31, 0x36, 0x28, 0x70,
+    0xB6, 0xED, 0x21, 0xB9, 0x9C, 0xA6, 0xF4, 0xF9,
+    0xF1, 0x53, 0xE7, 0xB1, 0xBE, 0xAF, 0xED, 0x1D,
+    0x23, 0x30, 0x4B, 0x7A, 0x39, 0xF9, 0xF3, 0xFF,
+    0x06, 0x7D, 0x8D, 0x8F, 0x9E, 0x24, 0xEC, 0xC7
+  };
+  tTbxCryptoAes256Ctx ctx;
+  uint8_t             buffer[64];
+
+  /* Encrypt the plaintext. */
+  memcpy(buffer, aesVectorPlain, sizeof(buffer));
+  TbxCryptoAes256Init(&ctx, aesVectorKey);
+  TbxCryptoAes256EncryptEcb(&ctx, buffer, sizeof(buffer));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedData, buffer, sizeof(buffer));
+  /* Decrypt it again, with the same context. */
+  TbxCryptoAes256DecryptEcb(&ctx, buffer, sizeof(buffer));
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(aesVectorPlain, buffer, sizeof(buffer));
+  /* The one-shot functions should give the same result. */
+  TbxCryptoAes256Encrypt(buffer, sizeof(buffer), aesVectorKey);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedData, buffer, sizeof(buffer));
+  TbxCryptoAes256Decrypt(buffer, sizeof(buffer), aesVectorKey);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(aesVectorPlain, buffer, sizeof(buffer));
+  TbxCryptoAes256Done(&ctx);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxCryptoAes256Ecb_ShouldMatchTestVectors ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that CBC mode matches the NIST SP 800-38A test vectors F.2.5 and
+**            F.2.6, also when processing the data in chunks.
+**
+****************************************************************************************/
+void test_TbxCryptoAes256Cbc_ShouldMatchTestVectors(void)
+{
+  const uint8_t initVector[16] =
+  {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+  };
+  const uint8_t expectedData[64] =
+  {
+    0xF5, 0x8C, 0x4C, 0x04, 0xD6, 0xE5, 0xF1, 0xBA,
+    0x77, 0x9E, 0xAB, 0xFB, 0x5F, 0x7B, 0xFB, 0xD6,
+    0x9C, 0xFC, 0x4E, 0x96, 0x7E, 0xDB, 0x80, 0x8D,
+    0x67, 0x9F, 0x77, 0x7B, 0xC6, 0x70, 0x2C, 0x7D,
+    0x39, 0xF2, 0x33, 0x69, 0xA9, 0xD9, 0xBA, 0xCF,
+    0xA5, 0x30, 0xE2, 0x63, 0x04, 0x23, 0x14, 0x61,
+    0xB2, 0xEB, 0x05, 0xE2, 0xC3, 0x9B, 0xE9, 0xFC,
+    0xDA, 0x6C, 0x19, 0x07, 0x8C, 0x6A, 0x9D, 0x1B
+  };
+  tTbxCryptoAes256Ctx ctx;
+  uint8_t             buffer[64];
+  uint8_t             iv[16];
+
+  /* Encrypt the plaintext in two chunks. */
+  memcpy(buffer, aesVectorPlain, sizeof(buffer));
+  memcpy(iv, initVector, sizeof(iv));
+  TbxCryptoAes256Init(&ctx, aesVectorKey);
+  TbxCryptoAes256EncryptCbc(&ctx, &buffer[0], 16U, iv);
+  TbxCryptoAes256EncryptCbc(&ctx, &buffer[16], 48U, iv);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedData, buffer, sizeof(buffer));
+  /* The initialization vector should now hold the last encrypted block. */
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(&expectedData[48], iv, sizeof(iv));
+  /* Decrypt it again, all at once. */
+  memcpy(iv, initVector, sizeof(iv));
+  TbxCryptoAes256DecryptCbc(&ctx, buffer, sizeof(buffer), iv);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(aesVectorPlain, buffer, sizeof(buffer));
+  TbxCryptoAes256Done(&ctx);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxCryptoAes256Cbc_ShouldMatchTestVectors ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that CTR mode matches the NIST SP 800-38A test vectors F.5.5 and
+**            F.5.6, also when processing the data in chunks and for a length that is not
+**            a multiple of 16.
+**
+****************************************************************************************/
+void test_TbxCryptoAes256Ctr_ShouldMatchTestVectors(void)
+{
+  const uint8_t initCounter[16] =
+  {
+    0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7,
+    0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
+  };
+  const uint8_t expectedData[64] =
+  {
+    0x60, 0x1E, 0xC3, 0x13, 0x77, 0x57, 0x89, 0xA5,
+    0xB7, 0xA7, 0xF5, 0x04, 0xBB, 0xF3, 0xD2, 0x28,
+    0xF4, 0x43, 0xE3, 0xCA, 0x4D, 0x62, 0xB5, 0x9A,
+    0xCA, 0x84, 0xE9, 0x90, 0xCA, 0xCA, 0xF5, 0xC5,
+    0x2B, 0x09, 0x30, 0xDA, 0xA2, 0x3D, 0xE9, 0x4C,
+    0xE8, 0x70, 0x17, 0xBA, 0x2D, 0x84, 0x98, 0x8D,
+    0xDF, 0xC9, 0xC5, 0x8D, 0xB6, 0x7A, 0xAD, 0xA6,
+    0x13, 0xC2, 0xDD, 0x08, 0x45, 0x79, 0x41, 0xA6
+  };
+  tTbxCryptoAes256Ctx ctx;
+  uint8_t             buffer[64];
+  uint8_t             counter[16];
+
+  /* Encrypt the plaintext in two chunks. */
+  memcpy(buffer, aesVectorPlain, sizeof(buffer));
+  memcpy(counter, initCounter, sizeof(counter));
+  TbxCryptoAes256Init(&ctx, aesVectorKey);
+  TbxCryptoAes256Ctr(&ctx, &buffer[0], 32U, counter);
+  TbxCryptoAes256Ctr(&ctx, &buffer[32], 32U, counter);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedData, buffer, sizeof(buffer));
+  /* Decrypt only the first 61 bytes. The last 3 should stay encrypted. */
+  memcpy(counter, initCounter, sizeof(counter));
+  TbxCryptoAes256Ctr(&ctx, buffer, 61U, counter);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(aesVectorPlain, buffer, 61U);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(&expectedData[61], &buffer[61], 3U);
+  TbxCryptoAes256Done(&ctx);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxCryptoAes256Ctr_ShouldMatchTestVectors ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
@@ -1153,6 +1803,36 @@ void test_TbxMemPoolRelease_ShouldAssertOnInvalidParams(void)
 } /*** end of test_TbxMemPoolRelease_ShouldAssertOnInvalidParams ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that releasing memory that was never allocated from a memory pool,
+**            such as a variable on the stack or a global variable, triggers an
+**            assertion, without accessing memory outside of the passed variable.
+**
+****************************************************************************************/
+void test_TbxMemPoolRelease_ShouldAssertOnForeignPointer(void)
+{
+  uint32_t stackVar[4] = { 0 };
+
+  /* Pass a pointer to a variable on the stack. */
+  assertionCnt = 0;
+  TbxMemPoolRelease(&stackVar[0]);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Pass a pointer to a global variable. */
+  assertionCnt = 0;
+  TbxMemPoolRelease(&assertionCnt);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Pass a misaligned pointer into an allocated block. */
+  assertionCnt = 0;
+  TbxMemPoolRelease((uint8_t *)memPoolAllocatedBlocks[0] + 1U);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxMemPoolRelease_ShouldAssertOnForeignPointer ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that all previously allocated blocks can be released back to the
 **            memory pool.
@@ -1458,6 +2138,220 @@ void test_TbxMemPoolAllocateAuto_CannotAllocateSmallerSize(void)
 } /*** end of test_TbxMemPoolAllocateAuto_CannotAllocateSmallerSize ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
+**
+****************************************************************************************/
+void test_TbxMemPoolGetStats_ShouldAssertOnInvalidParams(void)
+{
+  uint8_t result;
+
+  /* Pass on a NULL pointer for the statistics, which should not work. */
+  result = TbxMemPoolGetStats(0U, NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+} /*** end of test_TbxMemPoolGetStats_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that the statistics reflect the usage of the memory pool that was
+**            created and fully allocated by the previous tests.
+**
+****************************************************************************************/
+void test_TbxMemPoolGetStats_CanTrackUsage(void)
+{
+  tTbxMemPoolStats stats;
+  size_t           poolIdx = 0U;
+  uint8_t          found = TBX_FALSE;
+
+  /* Loop through all memory pools, until the one of the previous tests is found. Note
+   * that the memory pools are sorted by ascending block size.
+   */
+  while (TbxMemPoolGetStats(poolIdx, &stats) == TBX_OK)
+  {
+    if (stats.blockSize == memPoolBlockSize)
+    {
+      found = TBX_TRUE;
+      break;
+    }
+    poolIdx++;
+  }
+  /* Make sure the memory pool was found. */
+  TEST_ASSERT_EQUAL(TBX_TRUE, found);
+  /* It was expanded by one block and all its blocks are allocated at this point. A few
+   * allocation attempts on the full memory pool were made.
+   */
+  TEST_ASSERT_EQUAL_size_t(memPoolNumBlocks + 1U, stats.numBlocks);
+  TEST_ASSERT_EQUAL_size_t(0U, stats.numFree);
+  TEST_ASSERT_EQUAL_size_t(0U, stats.minFree);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, stats.numFailed);
+
+  /* Release one block and verify that only the number of free blocks changed. */
+  TbxMemPoolRelease(memPoolAllocatedBlocks[0]);
+  TEST_ASSERT_EQUAL(TBX_OK, TbxMemPoolGetStats(poolIdx, &stats));
+  TEST_ASSERT_EQUAL_size_t(1U, stats.numFree);
+  TEST_ASSERT_EQUAL_size_t(0U, stats.minFree);
+  /* Allocate it again. */
+  memPoolAllocatedBlocks[0] = TbxMemPoolAllocate(memPoolBlockSize);
+  TEST_ASSERT_NOT_NULL(memPoolAllocatedBlocks[0]);
+
+  /* An index past the last memory pool should return an error. */
+  while (TbxMemPoolGetStats(poolIdx, &stats) == TBX_OK)
+  {
+    poolIdx++;
+  }
+  TEST_ASSERT_EQUAL(TBX_ERROR, TbxMemPoolGetStats(poolIdx, &stats));
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxMemPoolGetStats_CanTrackUsage ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion.
+**
+****************************************************************************************/
+void test_TbxArenaInit_ShouldAssertOnInvalidParams(void)
+{
+  tTbxArena arena;
+  uint8_t   buffer[16];
+
+  /* It should not be possible to initialize an arena without a buffer. */
+  TbxArenaInit(&arena, NULL, sizeof(buffer));
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* It should not be possible to initialize an arena with a zero sized buffer. */
+  TbxArenaInit(&arena, buffer, 0U);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* It should not be possible to allocate zero bytes. */
+  TbxArenaInit(&arena, buffer, sizeof(buffer));
+  TEST_ASSERT_NULL(TbxArenaAllocate(&arena, 0U));
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxArenaInit_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that memory can be allocated from an arena with a static buffer, until
+**            it is exhausted.
+**
+****************************************************************************************/
+void test_TbxArenaAllocate_CanAllocateFromBuffer(void)
+{
+  tTbxArena arena;
+  uintptr_t buffer[8];
+  uint8_t * mem1;
+  uint8_t * mem2;
+
+  /* Initialize the arena with the static buffer. */
+  TbxArenaInit(&arena, buffer, sizeof(buffer));
+  TEST_ASSERT_EQUAL(sizeof(buffer), TbxArenaGetFree(&arena));
+  /* Allocate two blocks, which should be placed right after each other, taking into
+   * account the alignment to the address size.
+   */
+  mem1 = TbxArenaAllocate(&arena, 1U);
+  mem2 = TbxArenaAllocate(&arena, 1U);
+  TEST_ASSERT_EQUAL_PTR(&buffer[0], mem1);
+  TEST_ASSERT_EQUAL_PTR(&buffer[1], mem2);
+  TEST_ASSERT_EQUAL(sizeof(buffer) - sizeof(void *) - 1U, TbxArenaGetFree(&arena));
+  /* Allocating more than what is left should fail and not change anything. */
+  TEST_ASSERT_NULL(TbxArenaAllocate(&arena, sizeof(buffer)));
+  TEST_ASSERT_EQUAL(sizeof(buffer) - sizeof(void *) - 1U, TbxArenaGetFree(&arena));
+  /* Allocating with a large alignment should give an aligned address. */
+  mem1 = TbxArenaAllocateAligned(&arena, 1U, 16U);
+  TEST_ASSERT_NOT_NULL(mem1);
+  TEST_ASSERT_EQUAL(0U, ((uintptr_t)mem1) % 16U);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxArenaAllocate_CanAllocateFromBuffer ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that nested scopes release their memory at once and that the peak
+**            usage is remembered.
+**
+****************************************************************************************/
+void test_TbxArenaRelease_CanReleaseNestedScopes(void)
+{
+  tTbxArena     arena;
+  uintptr_t     buffer[16];
+  tTbxArenaMark outerMark;
+  tTbxArenaMark innerMark;
+  void        * mem;
+
+  /* Initialize the arena with the static buffer. */
+  TbxArenaInit(&arena, buffer, sizeof(buffer));
+  /* Start the outer scope and allocate some memory. */
+  outerMark = TbxArenaGetMark(&arena);
+  TEST_ASSERT_NOT_NULL(TbxArenaAllocate(&arena, 10U));
+  /* Start the inner scope and allocate some memory. */
+  innerMark = TbxArenaGetMark(&arena);
+  mem = TbxArenaAllocate(&arena, 20U);
+  TEST_ASSERT_NOT_NULL(mem);
+  /* End the inner scope. The next allocation should reuse the same memory. */
+  TbxArenaRelease(&arena, innerMark);
+  TEST_ASSERT_EQUAL_PTR(mem, TbxArenaAllocate(&arena, 4U));
+  /* End the outer scope. The arena should be empty again. */
+  TbxArenaRelease(&arena, outerMark);
+  TEST_ASSERT_EQUAL(sizeof(buffer), TbxArenaGetFree(&arena));
+  /* The peak usage should include both scopes. */
+  TEST_ASSERT_GREATER_OR_EQUAL(30U, TbxArenaGetPeak(&arena));
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  /* Releasing the inner scope after the outer scope is not possible. */
+  TbxArenaRelease(&arena, innerMark);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxArenaRelease_CanReleaseNestedScopes ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that an arena can be backed by a memory pool block, which is released
+**            again when the arena is deleted.
+**
+****************************************************************************************/
+void test_TbxArenaCreate_CanUsePoolBlock(void)
+{
+  tTbxArena        arena;
+  tTbxMemPoolStats stats;
+  size_t           poolIdx = 0U;
+  const size_t     arenaSize = 72U;
+
+  /* Create the arena with its buffer from a memory pool block. */
+  TEST_ASSERT_EQUAL(TBX_OK, TbxArenaCreate(&arena, arenaSize));
+  TEST_ASSERT_EQUAL(arenaSize, TbxArenaGetFree(&arena));
+  TEST_ASSERT_NOT_NULL(TbxArenaAllocate(&arena, arenaSize));
+  TEST_ASSERT_NULL(TbxArenaAllocate(&arena, 1U));
+  /* Locate the memory pool of the block. */
+  while (TbxMemPoolGetStats(poolIdx, &stats) == TBX_OK)
+  {
+    if (stats.blockSize == arenaSize)
+    {
+      break;
+    }
+    poolIdx++;
+  }
+  TEST_ASSERT_EQUAL(arenaSize, stats.blockSize);
+  TEST_ASSERT_EQUAL(stats.numBlocks - 1U, stats.numFree);
+  /* Delete the arena, which should give the block back. */
+  TbxArenaDelete(&arena);
+  TEST_ASSERT_EQUAL(TBX_OK, TbxMemPoolGetStats(poolIdx, &stats));
+  TEST_ASSERT_EQUAL(stats.numBlocks, stats.numFree);
+  /* Allocating from a deleted arena should fail. */
+  TEST_ASSERT_NULL(TbxArenaAllocate(&arena, 1U));
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxArenaCreate_CanUsePoolBlock ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that a new list can be created.
 **
@@ -2425,6 +3319,322 @@ void test_TbxListSortItems_ShouldSortItems(void)
 } /*** end of test_TbxListSortItems_ShouldSortItems ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that sorting keeps the order of equal items and works for lists of
+**            any length.
+**
+****************************************************************************************/
+void test_TbxListSortItems_ShouldBeStable(void)
+{
+  tTbxList           * myList;
+  static tListTestMsg  msgs[21];
+  tListTestMsg       * myMsg;
+  tListTestMsg       * prevMsg;
+  size_t               idx;
+
+  /* Create a new linked list. */
+  myList = TbxListCreate();
+  /* Sorting an empty list should work. */
+  TbxListSortItems(myList, compareListMsg);
+  TEST_ASSERT_NULL(TbxListGetFirstItem(myList));
+  /* Add items with only a few different identifiers. The length holds the original
+   * order.
+   */
+  for (idx = 0U; idx < (sizeof(msgs)/sizeof(msgs[0])); idx++)
+  {
+    msgs[idx].id = (uint32_t)((idx * 5U) % 7U);
+    msgs[idx].len = (uint8_t)idx;
+    (void)TbxListInsertItemBack(myList, &msgs[idx]);
+  }
+  /* Sort based on id. */
+  TbxListSortItems(myList, compareListMsg);
+  /* All items should still be present. */
+  TEST_ASSERT_EQUAL(sizeof(msgs)/sizeof(msgs[0]), TbxListGetSize(myList));
+  /* Check the order of the items. */
+  prevMsg = TbxListGetFirstItem(myList);
+  myMsg = TbxListGetNextItem(myList, prevMsg);
+  while (myMsg != NULL)
+  {
+    /* The identifiers should be ascending. */
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(myMsg->id, prevMsg->id);
+    /* Items with the same identifier should be in the original order. */
+    if (myMsg->id == prevMsg->id)
+    {
+      TEST_ASSERT_LESS_THAN_UINT32(myMsg->len, prevMsg->len);
+    }
+    prevMsg = myMsg;
+    myMsg = TbxListGetNextItem(myList, myMsg);
+  }
+  /* The last item should be the last one found while iterating. */
+  TEST_ASSERT_EQUAL_PTR(prevMsg, TbxListGetLastItem(myList));
+  /* Delete the list as cleanup. */
+  TbxListDelete(myList);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxListSortItems_ShouldBeStable ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that the list can be iterated in both directions after sorting, for
+**            lists of different lengths and item orders.
+**
+****************************************************************************************/
+void test_TbxListSortItems_ShouldKeepLinksConsistent(void)
+{
+  tTbxList           * myList;
+  static tListTestMsg  msgs[12];
+  tListTestMsg       * myMsg;
+  size_t               numItems;
+  size_t               idx;
+  size_t               count;
+
+  /* Try all list lengths and a few different orders. */
+  for (numItems = 1U; numItems <= (sizeof(msgs)/sizeof(msgs[0])); numItems++)
+  {
+    for (size_t order = 0U; order < 3U; order++)
+    {
+      /* Create a new linked list with descending, ascending or scrambled items. */
+      myList = TbxListCreate();
+      for (idx = 0U; idx < numItems; idx++)
+      {
+        if (order == 0U)
+        {
+          msgs[idx].id = (uint32_t)(numItems - idx);
+        }
+        else if (order == 1U)
+        {
+          msgs[idx].id = (uint32_t)idx;
+        }
+        else
+        {
+          msgs[idx].id = (uint32_t)((idx * 5U) % 13U);
+        }
+        (void)TbxListInsertItemBack(myList, &msgs[idx]);
+      }
+      /* Sort based on id. */
+      TbxListSortItems(myList, compareListMsg);
+      /* Iterate forward. The identifiers should be ascending. */
+      count = 0U;
+      myMsg = TbxListGetFirstItem(myList);
+      while (myMsg != NULL)
+      {
+        count++;
+        if (TbxListGetNextItem(myList, myMsg) != NULL)
+        {
+          tListTestMsg * nextMsg = TbxListGetNextItem(myList, myMsg);
+          TEST_ASSERT_LESS_OR_EQUAL_UINT32(nextMsg->id, myMsg->id);
+        }
+        myMsg = TbxListGetNextItem(myList, myMsg);
+      }
+      TEST_ASSERT_EQUAL(numItems, count);
+      /* Iterate backward. The identifiers should be descending. */
+      count = 0U;
+      myMsg = TbxListGetLastItem(myList);
+      while (myMsg != NULL)
+      {
+        count++;
+        if (TbxListGetPreviousItem(myList, myMsg) != NULL)
+        {
+          tListTestMsg * prevMsg = TbxListGetPreviousItem(myList, myMsg);
+          TEST_ASSERT_LESS_OR_EQUAL_UINT32(myMsg->id, prevMsg->id);
+        }
+        myMsg = TbxListGetPreviousItem(myList, myMsg);
+      }
+      TEST_ASSERT_EQUAL(numItems, count);
+      /* Delete the list as cleanup. */
+      TbxListDelete(myList);
+    }
+  }
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxListSortItems_ShouldKeepLinksConsistent ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion.
+**
+****************************************************************************************/
+void test_TbxIList_ShouldAssertOnInvalidParams(void)
+{
+  tTbxIList     myList;
+  tIListTestMsg msg = { 0 };
+
+  /* Pass on a NULL pointer for the list, which should not work. */
+  TbxIListInit(NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* Pass on a NULL pointer for the link, which should not work. */
+  TbxIListInit(&myList);
+  TbxIListInsertBack(&myList, NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* Removing from an empty list should not work. */
+  TbxIListRemove(&myList, &msg.link);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Reset the assertion counter. */
+  assertionCnt = 0;
+  /* Pass on a NULL pointer for the compare function, which should not work. */
+  TbxIListSort(&myList, NULL);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxIList_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that items can be inserted at the correct location and removed
+**            again, without allocating memory.
+**
+****************************************************************************************/
+void test_TbxIList_CanInsertAndRemove(void)
+{
+  tTbxIList     myList;
+  tIListTestMsg msgA = { .id = 1U };
+  tIListTestMsg msgB = { .id = 2U };
+  tIListTestMsg msgC = { .id = 3U };
+  tIListTestMsg msgD = { .id = 4U };
+  size_t        heapFreeBefore;
+
+  /* Initialize the list. */
+  heapFreeBefore = TbxHeapGetFree();
+  TbxIListInit(&myList);
+  TEST_ASSERT_EQUAL(0U, TbxIListGetSize(&myList));
+  TEST_ASSERT_NULL(TbxIListGetFirst(&myList));
+  /* Build the list B -> C, then insert A in front and D at the end: A B C D. */
+  TbxIListInsertBack(&myList, &msgC.link);
+  TbxIListInsertFront(&myList, &msgB.link);
+  TbxIListInsertBefore(&myList, &msgA.link, &msgB.link);
+  TbxIListInsertAfter(&myList, &msgD.link, &msgC.link);
+  TEST_ASSERT_EQUAL(4U, TbxIListGetSize(&myList));
+  /* Check the order in both directions. */
+  TEST_ASSERT_EQUAL_PTR(&msgA.link, TbxIListGetFirst(&myList));
+  TEST_ASSERT_EQUAL_PTR(&msgB.link, TbxIListGetNext(&myList, &msgA.link));
+  TEST_ASSERT_EQUAL_PTR(&msgC.link, TbxIListGetNext(&myList, &msgB.link));
+  TEST_ASSERT_EQUAL_PTR(&msgD.link, TbxIListGetLast(&myList));
+  TEST_ASSERT_EQUAL_PTR(&msgC.link, TbxIListGetPrevious(&myList, &msgD.link));
+  TEST_ASSERT_NULL(TbxIListGetNext(&myList, &msgD.link));
+  TEST_ASSERT_NULL(TbxIListGetPrevious(&myList, &msgA.link));
+  /* The item should be reachable from its link. */
+  TEST_ASSERT_EQUAL_PTR(&msgC, TBX_ILIST_ITEM(TbxIListGetNext(&myList, &msgB.link),
+                                              tIListTestMsg, link));
+  /* Remove the first, a middle and the last item. */
+  TbxIListRemove(&myList, &msgA.link);
+  TbxIListRemove(&myList, &msgC.link);
+  TbxIListRemove(&myList, &msgD.link);
+  TEST_ASSERT_EQUAL(1U, TbxIListGetSize(&myList));
+  TEST_ASSERT_EQUAL_PTR(&msgB.link, TbxIListGetFirst(&myList));
+  TEST_ASSERT_EQUAL_PTR(&msgB.link, TbxIListGetLast(&myList));
+  TbxIListRemove(&myList, &msgB.link);
+  TEST_ASSERT_NULL(TbxIListGetFirst(&myList));
+  TEST_ASSERT_NULL(TbxIListGetLast(&myList));
+  /* No memory should have been allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, TbxHeapGetFree());
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxIList_CanInsertAndRemove ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that sorting the intrusive list keeps the order of equal items.
+**
+****************************************************************************************/
+void test_TbxIListSort_ShouldBeStable(void)
+{
+  tTbxIList             myList;
+  static tIListTestMsg  msgs[100];
+  tTbxIListLink       * linkPtr;
+  tIListTestMsg const * myMsg;
+  tIListTestMsg const * prevMsg = NULL;
+  size_t                idx;
+
+  /* Initialize the list and add items with only a few different identifiers. */
+  TbxIListInit(&myList);
+  for (idx = 0U; idx < (sizeof(msgs)/sizeof(msgs[0])); idx++)
+  {
+    msgs[idx].id = (uint32_t)((idx * 7U) % 10U);
+    msgs[idx].seq = (uint32_t)idx;
+    TbxIListInsertBack(&myList, &msgs[idx].link);
+  }
+  /* Sort based on id. */
+  TbxIListSort(&myList, compareIListMsg);
+  TEST_ASSERT_EQUAL(sizeof(msgs)/sizeof(msgs[0]), TbxIListGetSize(&myList));
+  /* Check the order of the items. */
+  for (linkPtr = TbxIListGetFirst(&myList); linkPtr != NULL; 
+       linkPtr = TbxIListGetNext(&myList, linkPtr))
+  {
+    myMsg = TBX_ILIST_ITEM(linkPtr, tIListTestMsg const, link);
+    if (prevMsg != NULL)
+    {
+      /* The identifiers should be ascending. */
+      TEST_ASSERT_LESS_OR_EQUAL_UINT32(myMsg->id, prevMsg->id);
+      /* Items with the same identifier should be in the original order. */
+      if (myMsg->id == prevMsg->id)
+      {
+        TEST_ASSERT_LESS_THAN_UINT32(myMsg->seq, prevMsg->seq);
+      }
+    }
+    prevMsg = myMsg;
+  }
+  /* The last item should be the last one found while iterating. */
+  TEST_ASSERT_EQUAL_PTR(&prevMsg->link, TbxIListGetLast(&myList));
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxIListSort_ShouldBeStable ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that an item inserted while the intrusive list is sorted is kept and
+**            ends up behind the sorted items.
+**
+****************************************************************************************/
+void test_TbxIListSort_ShouldKeepItemsInsertedMeanwhile(void)
+{
+  tTbxIList             myList;
+  static tIListTestMsg  msgs[10];
+  tTbxIListLink       * linkPtr;
+  tIListTestMsg const * myMsg;
+  size_t                idx;
+
+  /* Initialize the list and add items in descending order. */
+  TbxIListInit(&myList);
+  for (idx = 0U; idx < (sizeof(msgs)/sizeof(msgs[0])); idx++)
+  {
+    msgs[idx].id = (uint32_t)((sizeof(msgs)/sizeof(msgs[0])) - idx);
+    msgs[idx].seq = (uint32_t)idx;
+    TbxIListInsertBack(&myList, &msgs[idx].link);
+  }
+  /* Sort based on id, while the comparison function inserts an extra item once. */
+  insertMeanwhileList = &myList;
+  insertMeanwhileMsg.id = 0U;
+  insertMeanwhileMsg.seq = 0U;
+  insertMeanwhileListSize = 1U;
+  TbxIListSort(&myList, compareIListMsgAndInsert);
+  insertMeanwhileList = NULL;
+  /* The list should read as empty while its items were being sorted. */
+  TEST_ASSERT_EQUAL(0U, insertMeanwhileListSize);
+  TEST_ASSERT_EQUAL((sizeof(msgs)/sizeof(msgs[0])) + 1U, TbxIListGetSize(&myList));
+  /* The sorted items should come first, in ascending order. */
+  linkPtr = TbxIListGetFirst(&myList);
+  for (idx = 0U; idx < (sizeof(msgs)/sizeof(msgs[0])); idx++)
+  {
+    TEST_ASSERT_NOT_NULL(linkPtr);
+    myMsg = TBX_ILIST_ITEM(linkPtr, tIListTestMsg const, link);
+    TEST_ASSERT_EQUAL_UINT32(idx + 1U, myMsg->id);
+    linkPtr = TbxIListGetNext(&myList, linkPtr);
+  }
+  /* The item inserted meanwhile should be the last one. */
+  TEST_ASSERT_EQUAL_PTR(&insertMeanwhileMsg.link, linkPtr);
+  TEST_ASSERT_EQUAL_PTR(&insertMeanwhileMsg.link, TbxIListGetLast(&myList));
+  TEST_ASSERT_NULL(TbxIListGetNext(&myList, linkPtr));
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxIListSort_ShouldKeepItemsInsertedMeanwhile ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that the platform reports that its architecture is little endian,
 **            because the tests run on either a x86-64 or ARMv7l platform.
@@ -2460,16 +3670,30 @@ int runTests(void)
   /* Tests for the critical section module. */
   RUN_TEST(test_TbxCriticalSectionExit_ShouldTriggerAssertionIfNotInCritSect);
   RUN_TEST(test_TbxCriticalSectionEnter_ShouldNotAssertUponCritSectExit);
+  RUN_TEST(test_TbxLock_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxLock_CanBeNested);
+  RUN_TEST(test_TbxLock_ShouldNotBlockOtherLocks);
   /* Tests for the heap module. */
   RUN_TEST(test_TbxHeapGetFree_ShouldReturnActualFreeSize);
   RUN_TEST(test_TbxHeapAllocate_ShouldReturnNotNull);
   RUN_TEST(test_TbxHeapAllocate_ShouldReturnNullIfZeroSizeAllocated);
   RUN_TEST(test_TbxHeapAllocate_ShouldReturnNullIfTooMuchAllocated);
   RUN_TEST(test_TbxHeapAllocate_ShouldAlignToAddressSize);
+  RUN_TEST(test_TbxHeapAllocateAligned_ShouldAlignAddress);
+  RUN_TEST(test_TbxHeapGetStats_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxHeapGetStats_ShouldReportUsage);
+#if (TBX_CONF_HEAP_TLSF_ENABLE > 0U)
+  RUN_TEST(test_TbxHeapFree_CanReuseMemory);
+  RUN_TEST(test_TbxHeapFree_ShouldMergeNeighbors);
+  RUN_TEST(test_TbxHeapGetStats_LargestFreeCanBeAllocated);
+#endif
   /* Tests for the random number module. */
   RUN_TEST(test_TbxRandomSetSeedInitHandler_ShouldTriggerAssertionIfParamNull);
   RUN_TEST(test_TbxRandomSetSeedInitHandler_ShouldWork);
   RUN_TEST(test_TbxRandomNumberGet_ShouldReturnRandomNumbers);
+  RUN_TEST(test_TbxRandomFill_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxRandomFill_ShouldNotWriteBeyondLength);
+  RUN_TEST(test_TbxRandomFill_ShouldBeUniformlyDistributed);
   /* Tests for the checksum module. */
   RUN_TEST(test_TbxChecksumCrc16Calculate_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxChecksumCrc16Calculate_ShouldReturnValidCrc16);
@@ -2480,6 +3704,10 @@ int runTests(void)
   RUN_TEST(test_TbxCryptoAes256Encrypt_ShouldEncrypt);
   RUN_TEST(test_TbxCryptoAes256Decrypt_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxCryptoAes256Decrypt_ShouldDecrypt);
+  RUN_TEST(test_TbxCryptoAes256Ctx_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxCryptoAes256Ecb_ShouldMatchTestVectors);
+  RUN_TEST(test_TbxCryptoAes256Cbc_ShouldMatchTestVectors);
+  RUN_TEST(test_TbxCryptoAes256Ctr_ShouldMatchTestVectors);
   /* Tests for the memory pool module. */
   RUN_TEST(test_TbxMemPoolCreate_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMemPoolCreate_CannotAllocateMoreThanFreeHeap);
@@ -2491,6 +3719,7 @@ int runTests(void)
   RUN_TEST(test_TbxMemPoolAllocate_CannotAllocateWhenFull);
   RUN_TEST(test_TbxMemPoolCreate_CanIncreasePoolSize);
   RUN_TEST(test_TbxMemPoolRelease_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMemPoolRelease_ShouldAssertOnForeignPointer);
   RUN_TEST(test_TbxMemPoolRelease_CanReleaseBlocks);
   RUN_TEST(test_TbxMemPoolAllocate_CanReallocate);
   RUN_TEST(test_TbxMemPoolAllocateAuto_ShouldAssertOnInvalidParams);
@@ -2498,6 +3727,13 @@ int runTests(void)
   RUN_TEST(test_TbxMemPoolAllocateAuto_CanResizeWhenFull);
   RUN_TEST(test_TbxMemPoolAllocateAllocateAuto_CanReallocate);
   RUN_TEST(test_TbxMemPoolAllocateAuto_CannotAllocateSmallerSize);
+  RUN_TEST(test_TbxMemPoolGetStats_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMemPoolGetStats_CanTrackUsage);
+  /* Tests for the arena allocator module. */
+  RUN_TEST(test_TbxArenaInit_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxArenaAllocate_CanAllocateFromBuffer);
+  RUN_TEST(test_TbxArenaRelease_CanReleaseNestedScopes);
+  RUN_TEST(test_TbxArenaCreate_CanUsePoolBlock);
   /* Tests for the linked list module. */
   RUN_TEST(test_TbxListCreate_ReturnsValidListPointer);
   RUN_TEST(test_TbxListCreate_CanReuseMemory);
@@ -2529,6 +3765,13 @@ int runTests(void)
   RUN_TEST(test_TbxListSwapItems_ShouldSwapItems);
   RUN_TEST(test_TbxListSortItems_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxListSortItems_ShouldSortItems);
+  RUN_TEST(test_TbxListSortItems_ShouldBeStable);
+  RUN_TEST(test_TbxListSortItems_ShouldKeepLinksConsistent);
+  /* Tests for the intrusive linked list module. */
+  RUN_TEST(test_TbxIList_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxIList_CanInsertAndRemove);
+  RUN_TEST(test_TbxIListSort_ShouldBeStable);
+  RUN_TEST(test_TbxIListSort_ShouldKeepItemsInsertedMeanwhile);
   /* Tests for the platform module. */
   RUN_TEST(test_TbxPlatformLittleEndian_ShouldReportLittleEndian);
 
@@ -46,6 +46,18 @@ extern "C" {
 #define TBX_CONF_ASSERTIONS_ENABLE               (1U)
 
 
+/****************************************************************************************
+*   C R I T I C A L   S E C T I O N S   M O D U L E   C O N F I G U R A T I O N
+****************************************************************************************/
+/** \brief Interrupt mask level of the critical section. Only mask the interrupts with
+ *         priority 5 (PendSV, which feeds the Modbus stack) and lower (ADC1 at 6, TIM4 at
+ *         15), through BASEPRI. The STM32F1 implements 4 priority bits. Interrupts with
+ *         priority 0..4 (EXTI at 1, USART2 at 4) are never masked by MicroTBX and must
+ *         therefore not call MicroTBX functions. tbxmb_port.c checks this at compile time.
+ */
+#define TBX_CONF_CRITSECT_MASK_LEVEL             (5U << (8U - 4U))
+
+
 /****************************************************************************************
 *   H E A P   M O D U L E   C O N F I G U R A T I O N
 ****************************************************************************************/
@@ -71,4 +71,48 @@ void TbxPortInterruptsRestore( tTbxPortCpuSR prevCpuSr ) {
   return;
 }
 
+// BASEPRI is only implemented on the ARMv7-M and ARMv8-M mainline architectures.
+#if defined( __ARM_ARCH_7M__ ) || defined( __ARM_ARCH_7EM__ ) || defined( __ARM_ARCH_8M_MAIN__ )
+#define TBX_PORT_BASEPRI_SUPPORTED
+#endif
+
+/**
+ * @brief   Obtain a lock by masking the interrupts up to the level of the lock.
+ *          Interrupts with a more urgent priority keep running. A level of 0
+ *          disables all interrupts.
+ */
+tTbxPortCpuSR TbxPortLockAcquire( tTbxPortLock *portLock ) {
+  //
+  tTbxPortCpuSR prev;
+#ifdef TBX_PORT_BASEPRI_SUPPORTED
+  if ( portLock->level != 0u ) {
+    prev = __get_BASEPRI( );                  // Read current priority mask
+    __set_BASEPRI_MAX( portLock->level );     // Only raise the mask, never lower it
+  } else
+#endif
+  {
+    prev = TbxPortInterruptsDisable( );
+  }
+
+  return prev;
+}
+
+/**
+ * @brief   Release a lock by restoring the interrupt mask from before
+ *          TbxPortLockAcquire() was called.
+ */
+void TbxPortLockRelease( tTbxPortLock *portLock, tTbxPortCpuSR prevCpuSr ) {
+  //
+#ifdef TBX_PORT_BASEPRI_SUPPORTED
+  if ( portLock->level != 0u ) {
+    __set_BASEPRI( prevCpuSr );     // Restore previous priority mask
+  } else
+#endif
+  {
+    TbxPortInterruptsRestore( prevCpuSr );
+  }
+
+  return;
+}
+
 /*********************************** end of tbx_port.c *********************************/
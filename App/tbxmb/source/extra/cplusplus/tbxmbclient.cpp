@@ -239,6 +239,70 @@ uint8_t TbxMbClient::writeHoldingRegs(uint8_t         node,
 } /*** end of writeHoldingRegs ***/
 
 
+/************************************************************************************//**
+** \brief     Reads the record(s) of a file from the server with the specified node
+**            address.
+** \details   A record is one 16-bit register inside the file.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535).
+** \param     record Number of the first record (0..9999) inside the file.
+** \param     num Number of records to read. Range can be 1..124.
+** \param     values Array where the record values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readFileRecord(uint8_t  node,
+                                    uint16_t file,
+                                    uint16_t record,
+                                    uint8_t  num,
+                                    uint16_t values[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadFileRecord(m_Channel, node, file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the record(s) of a file to the server with the specified node
+**            address.
+** \details   A record is one 16-bit register inside the file.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file File number (1..65535).
+** \param     record Number of the first record (0..9999) inside the file.
+** \param     num Number of records to write. Range can be 1..122.
+** \param     values Array with the desired record values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::writeFileRecord(uint8_t        node,
+                                     uint16_t       file,
+                                     uint16_t       record,
+                                     uint8_t        num,
+                                     uint16_t const values[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientWriteFileRecord(m_Channel, node, file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Perform diagnostic operation on the server for checking the communication
 **            system.
@@ -52,6 +52,10 @@ public:
   uint8_t writeCoils(uint8_t node, uint16_t addr, uint16_t num, uint8_t const coils[]);
   uint8_t writeHoldingRegs(uint8_t node, uint16_t addr, uint8_t num, 
                            uint16_t const holdingRegs[]);
+  uint8_t readFileRecord(uint8_t node, uint16_t file, uint16_t record, uint8_t num,
+                         uint16_t values[]);
+  uint8_t writeFileRecord(uint8_t node, uint16_t file, uint16_t record, uint8_t num,
+                          uint16_t const values[]);
   uint8_t diagnostics(uint8_t node, uint16_t subcode, uint16_t& count);
   uint8_t customFunction(uint8_t node, uint8_t const txPdu[], uint8_t rxPdu[],
                          uint8_t& len);
@@ -60,6 +64,10 @@ protected:
   /* Members. */
   tTbxMbClient m_Channel;
 
+private:
+  /* The coroutine front-end needs access to the client channel. */
+  friend class TbxMbCoClient;
+
 };
 
 
@@ -0,0 +1,474 @@
+/************************************************************************************//**
+* \file         tbxmbcoro.cpp
+* \brief        MicroTBX-Modbus client C++20 coroutine source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX library                   */
+#include "microtbxmodbus.hpp"                    /* MicroTBX-Modbus C++ library        */
+#include "tbxmbcoro.hpp"                         /* MicroTBX-Modbus C++ coroutines     */
+
+/* The coroutine front-end requires a C++20 compiler. */
+#if (__cplusplus >= 202002L)
+
+/****************************************************************************************
+*                            T B X M B C O T R A N S F E R
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Modbus coroutine transfer constructor for reading or writing registers.
+** \param     client Coroutine client that handles the transfer.
+** \param     node The address of the server.
+** \param     code Modbus function code (FC03, FC04 or FC16).
+** \param     addr Starting element address (0..65535) in the Modbus data table.
+** \param     num Number of registers to read or write.
+** \param     regs Destination array for read requests, nullptr otherwise.
+** \param     writeRegs Source array for write requests, nullptr otherwise.
+**
+****************************************************************************************/
+TbxMbCoTransfer::TbxMbCoTransfer(TbxMbCoClient  & client, 
+                                 uint8_t          node,
+                                 uint8_t          code,
+                                 uint16_t         addr,
+                                 uint8_t          num,
+                                 uint16_t         regs[],
+                                 uint16_t const   writeRegs[])
+  : m_Client(client), m_Next(nullptr), m_Handle(nullptr), m_Node(node), m_Code(code),
+    m_Addr(addr), m_Num(num), m_Regs(regs), m_WriteRegs(writeRegs), m_TxPdu(nullptr),
+    m_RxPdu(nullptr), m_Len(nullptr), m_Result(TBX_ERROR), m_PduLen(0U)
+{
+} /*** end of TbxMbCoTransfer ***/
+
+
+/************************************************************************************//**
+** \brief     Modbus coroutine transfer constructor for a custom function code.
+** \param     client Coroutine client that handles the transfer.
+** \param     node The address of the server.
+** \param     txPdu Byte array with the PDU to transmit.
+** \param     rxPdu Byte array for storing the response PDU.
+** \param     len Length of the PDU to transmit. Holds the length of the response PDU
+**            after the transfer completed.
+**
+****************************************************************************************/
+TbxMbCoTransfer::TbxMbCoTransfer(TbxMbCoClient & client,
+                                 uint8_t         node,
+                                 uint8_t const   txPdu[],
+                                 uint8_t         rxPdu[],
+                                 uint8_t       & len)
+  : m_Client(client), m_Next(nullptr), m_Handle(nullptr), m_Node(node), m_Code(0U),
+    m_Addr(0U), m_Num(0U), m_Regs(nullptr), m_WriteRegs(nullptr), m_TxPdu(txPdu),
+    m_RxPdu(rxPdu), m_Len(&len), m_Result(TBX_ERROR), m_PduLen(0U)
+{
+} /*** end of TbxMbCoTransfer ***/
+
+
+/************************************************************************************//**
+** \brief     Called by co_await to suspend the coroutine. The transfer is added to the
+**            client's queue and submitted right away, when no other transfer of this
+**            client is queued or in progress.
+** \param     handle Handle of the awaiting coroutine.
+** \return    True to stay suspended, false to resume the coroutine right away. The
+**            latter happens when the transfer could not be submitted.
+**
+****************************************************************************************/
+bool TbxMbCoTransfer::await_suspend(std::coroutine_handle<> handle)
+{
+  bool result = true;
+
+  /* Store the handle for resuming the coroutine once the transfer completes. */
+  m_Handle = handle;
+  /* Add the transfer to the client's queue. */
+  m_Client.enqueue(*this);
+  /* Is this the only transfer? Then submit it, even if the client channel is busy. A
+   * blocking transfer in progress makes the channel defer it. An asynchronous transfer
+   * of another user makes it fail. Queuing it would be wrong in that case, because only
+   * the completion of this client's own transfers starts the queued ones.
+   */
+  if (m_Client.m_Head == this)
+  {
+    if (submit() != TBX_OK)
+    {
+      /* Remove it from the queue again and resume the coroutine right away. */
+      m_Client.m_Head = nullptr;
+      m_Client.m_Tail = nullptr;
+      m_Result = TBX_ERROR;
+      result = false;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of await_suspend ***/
+
+
+/************************************************************************************//**
+** \brief     Called by co_await when the coroutine resumes. It evaluates the response
+**            and extracts the register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbCoTransfer::await_resume()
+{
+  uint8_t result = m_Result;
+
+  /* Only process the response of a successful register read or write. */
+  if ( (result == TBX_OK) && (m_TxPdu == nullptr) )
+  {
+    /* Set the result to error by default. */
+    result = TBX_ERROR;
+    /* Read registers response? */
+    if (m_Code != TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS)
+    {
+      uint8_t const byteCount = m_Num * 2U;
+      /* Check the function code, byte count and PDU length. */
+      if ( (m_PduLen == (byteCount + 2U)) && (m_RxBuf[0] == m_Code) &&
+           (m_RxBuf[1] == byteCount) )
+      {
+        /* Copy the register values, which are stored in the big endian format. */
+        for (uint8_t idx = 0U; idx < m_Num; idx++)
+        {
+          m_Regs[idx] = (uint16_t)((uint16_t)m_RxBuf[2U + (idx * 2U)] << 8U) |
+                        m_RxBuf[3U + (idx * 2U)];
+        }
+        result = TBX_OK;
+      }
+    }
+    /* Write registers response. */
+    else
+    {
+      /* A broadcast request does not get a response. */
+      if (m_Node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        result = TBX_OK;
+      }
+      /* The response should echo the starting address and number of registers. */
+      else if ( (m_PduLen == 5U) && (m_RxBuf[0] == m_Code) &&
+                (m_RxBuf[1] == (uint8_t)(m_Addr >> 8U)) &&
+                (m_RxBuf[2] == (uint8_t)m_Addr) && (m_RxBuf[3] == 0U) &&
+                (m_RxBuf[4] == m_Num) )
+      {
+        result = TBX_OK;
+      }
+      else
+      {
+        /* Invalid response. Keep the error result. */
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of await_resume ***/
+
+
+/************************************************************************************//**
+** \brief     Builds the request PDU, if needed, and starts the asynchronous transfer.
+** \return    TBX_OK if the transfer was successfully started, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbCoTransfer::submit()
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Custom function code transfer? */
+  if (m_TxPdu != nullptr)
+  {
+    result = TbxMbClientCustomFunctionAsync(m_Client.m_Channel, m_Node, m_TxPdu, 
+                                            m_RxPdu, m_Len, &TbxMbCoTransfer::onDone,
+                                            this);
+  }
+  /* Register read or write transfer. */
+  else
+  {
+    uint8_t const maxNum = (m_Code == TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS) ? 123U : 125U;
+    /* Only continue with a valid number of registers. A read request cannot be
+     * broadcast, because the response is needed.
+     */
+    if ( (m_Num >= 1U) && (m_Num <= maxNum) && 
+         ((m_Code == TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS) || 
+          (m_Node != TBX_MB_TP_NODE_ADDR_BROADCAST)) )
+    {
+      /* Prepare the request PDU. */
+      m_TxBuf[0] = m_Code;
+      m_TxBuf[1] = (uint8_t)(m_Addr >> 8U);
+      m_TxBuf[2] = (uint8_t)m_Addr;
+      m_TxBuf[3] = 0U;
+      m_TxBuf[4] = m_Num;
+      m_PduLen = 5U;
+      /* Add the byte count and register values for a write request. */
+      if (m_Code == TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS)
+      {
+        m_TxBuf[m_PduLen++] = m_Num * 2U;
+        for (uint8_t idx = 0U; idx < m_Num; idx++)
+        {
+          m_TxBuf[m_PduLen++] = (uint8_t)(m_WriteRegs[idx] >> 8U);
+          m_TxBuf[m_PduLen++] = (uint8_t)m_WriteRegs[idx];
+        }
+      }
+      result = TbxMbClientCustomFunctionAsync(m_Client.m_Channel, m_Node, m_TxBuf,
+                                              m_RxBuf, &m_PduLen, 
+                                              &TbxMbCoTransfer::onDone, this);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of submit ***/
+
+
+/************************************************************************************//**
+** \brief     Completion callback of the asynchronous transfer. Called from the event
+**            task. It starts the next queued transfer of the client and resumes the
+**            coroutine that awaited this transfer.
+** \param     doneArg Pointer to the transfer object.
+** \param     result TBX_OK if the transfer completed successfully, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+void TbxMbCoTransfer::onDone(void    * doneArg,
+                             uint8_t   result)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(doneArg != nullptr);
+
+  /* Only continue with valid parameters. */
+  if (doneArg != nullptr)
+  {
+    TbxMbCoTransfer * transfer = static_cast<TbxMbCoTransfer *>(doneArg);
+    TbxMbCoClient & client = transfer->m_Client;
+    std::coroutine_handle<> handle = transfer->m_Handle;
+    /* Store the result and remove the transfer from the client's queue. */
+    transfer->m_Result = result;
+    client.m_Head = transfer->m_Next;
+    if (client.m_Head == nullptr)
+    {
+      client.m_Tail = nullptr;
+    }
+    /* Start the next transfer, before resuming the coroutine. Once resumed, the
+     * transfer object no longer exists.
+     */
+    client.startNext();
+    handle.resume();
+  }
+} /*** end of onDone ***/
+
+
+/****************************************************************************************
+*                            T B X M B C O C L I E N T
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Modbus coroutine client constructor.
+** \param     client The Modbus client that performs the actual communication. Only
+**            one coroutine client should be created per Modbus client and its channel
+**            should not be used for other asynchronous transfers.
+**
+****************************************************************************************/
+TbxMbCoClient::TbxMbCoClient(TbxMbClient & client)
+  : m_Channel(client.m_Channel), m_Head(nullptr), m_Tail(nullptr)
+{
+} /*** end of TbxMbCoClient ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the input register(s) from the server with the specified node
+**            address. Use with co_await.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            input register read operation.
+** \param     num Number of elements to read from the input registers data table. Range
+**            can be 1..125
+** \param     inputRegs Array where the input register values will be written to.
+** \return    Awaitable transfer. Awaiting it returns TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbCoTransfer TbxMbCoClient::readInputRegs(uint8_t  node,
+                                             uint16_t addr,
+                                             uint8_t  num,
+                                             uint16_t inputRegs[])
+{
+  return TbxMbCoTransfer(*this, node, TBX_MB_FC04_READ_INPUT_REGISTERS, addr, num,
+                         inputRegs, nullptr);
+} /*** end of readInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the holding register(s) from the server with the specified node
+**            address. Use with co_await.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register read operation.
+** \param     num Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     holdingRegs Array where the holding register values will be written to.
+** \return    Awaitable transfer. Awaiting it returns TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbCoTransfer TbxMbCoClient::readHoldingRegs(uint8_t  node,
+                                               uint16_t addr,
+                                               uint8_t  num,
+                                               uint16_t holdingRegs[])
+{
+  return TbxMbCoTransfer(*this, node, TBX_MB_FC03_READ_HOLDING_REGISTERS, addr, num,
+                         holdingRegs, nullptr);
+} /*** end of readHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the holding register(s) to the server with the specified node
+**            address. Use with co_await.
+** \param     node The address of the server.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            holding register write operation.
+** \param     num Number of elements to write to the holding registers data table.
+**            Range can be 1..123
+** \param     holdingRegs Array with the desired holding register values. It must stay
+**            valid until the transfer completes.
+** \return    Awaitable transfer. Awaiting it returns TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbCoTransfer TbxMbCoClient::writeHoldingRegs(uint8_t        node,
+                                                uint16_t       addr,
+                                                uint8_t        num,
+                                                uint16_t const holdingRegs[])
+{
+  return TbxMbCoTransfer(*this, node, TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS, addr, num,
+                         nullptr, holdingRegs);
+} /*** end of writeHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Send a custom function code PDU to the server and receive its response
+**            PDU. Use with co_await.
+** \param     node The address of the server.
+** \param     txPdu Byte array with the PDU to transmit.
+** \param     rxPdu Byte array for storing the response PDU. Should be large enough to
+**            store the response data (TBX_MB_TP_PDU_MAX_LEN).
+** \param     len The length of the PDU to transmit. The length of the received PDU is
+**            written to it, once the transfer completes.
+** \return    Awaitable transfer. Awaiting it returns TBX_OK if successful, TBX_ERROR
+**            otherwise.
+**
+****************************************************************************************/
+TbxMbCoTransfer TbxMbCoClient::customFunction(uint8_t         node,
+                                              uint8_t const   txPdu[],
+                                              uint8_t         rxPdu[],
+                                              uint8_t       & len)
+{
+  return TbxMbCoTransfer(*this, node, txPdu, rxPdu, len);
+} /*** end of customFunction ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the number of transfers that are queued or in progress.
+** \return    Number of pending transfers.
+**
+****************************************************************************************/
+size_t TbxMbCoClient::pending() const
+{
+  size_t result = 0U;
+
+  /* Count the transfers in the queue. */
+  for (TbxMbCoTransfer const * transfer = m_Head; transfer != nullptr;
+       transfer = transfer->m_Next)
+  {
+    result++;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of pending ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a transfer to the end of the queue.
+** \param     transfer The transfer to add.
+**
+****************************************************************************************/
+void TbxMbCoClient::enqueue(TbxMbCoTransfer & transfer)
+{
+  transfer.m_Next = nullptr;
+  /* Add the transfer to the end of the queue. */
+  if (m_Tail == nullptr)
+  {
+    m_Head = &transfer;
+  }
+  else
+  {
+    m_Tail->m_Next = &transfer;
+  }
+  m_Tail = &transfer;
+} /*** end of enqueue ***/
+
+
+/************************************************************************************//**
+** \brief     Submits the transfer at the head of the queue. Transfers that cannot be
+**            submitted are removed from the queue and their coroutines are resumed with
+**            an error result.
+**
+****************************************************************************************/
+void TbxMbCoClient::startNext()
+{
+  TbxMbCoTransfer * failedHead = nullptr;
+  TbxMbCoTransfer * failedTail = nullptr;
+
+  /* Submit the head of the queue. Collect the ones that fail, for example because
+   * another user of the client channel started an asynchronous transfer meanwhile.
+   */
+  while ( (m_Head != nullptr) && (m_Head->submit() != TBX_OK) )
+  {
+    TbxMbCoTransfer * failed = m_Head;
+    m_Head = failed->m_Next;
+    failed->m_Next = nullptr;
+    failed->m_Result = TBX_ERROR;
+    if (failedTail == nullptr)
+    {
+      failedHead = failed;
+    }
+    else
+    {
+      failedTail->m_Next = failed;
+    }
+    failedTail = failed;
+  }
+  if (m_Head == nullptr)
+  {
+    m_Tail = nullptr;
+  }
+  /* Resume the coroutines of the failed transfers. Read the next one before resuming,
+   * because the transfer object no longer exists afterwards.
+   */
+  while (failedHead != nullptr)
+  {
+    TbxMbCoTransfer * failed = failedHead;
+    failedHead = failed->m_Next;
+    failed->m_Handle.resume();
+  }
+} /*** end of startNext ***/
+
+#endif /* __cplusplus >= 202002L */
+
+/*********************************** end of tbxmbcoro.cpp ******************************/
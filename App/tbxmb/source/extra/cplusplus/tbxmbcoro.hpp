@@ -0,0 +1,170 @@
+/************************************************************************************//**
+* \file         tbxmbcoro.hpp
+* \brief        MicroTBX-Modbus client C++20 coroutine header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMBCORO_HPP
+#define TBXMBCORO_HPP
+
+/* The coroutine front-end requires a C++20 compiler. */
+#if (__cplusplus >= 202002L)
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include <coroutine>                             /* C++20 coroutine support            */
+#include <cstdlib>                               /* Standard library                   */
+#include "microtbx.h"                            /* MicroTBX library                   */
+#include "microtbxmodbus.hpp"                    /* MicroTBX-Modbus C++ library        */
+
+
+/****************************************************************************************
+*                            T B X M B C O T A S K
+****************************************************************************************/
+/** \brief Return type of a coroutine that communicates with Modbus servers. The
+ *         coroutine starts right away and runs until its first co_await. From then on
+ *         it is resumed from TbxMbEvent::task(), so the thread that calls the event task
+ *         drives all coroutines. The coroutine frame releases itself when it ends.
+ */
+class TbxMbCoTask
+{
+public:
+  /** \brief Coroutine promise. */
+  struct promise_type
+  {
+    TbxMbCoTask get_return_object() noexcept { return TbxMbCoTask(); }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() noexcept { }
+    void unhandled_exception() noexcept { std::abort(); }
+  };
+};
+
+
+/****************************************************************************************
+*                            T B X M B C O T R A N S F E R
+****************************************************************************************/
+class TbxMbCoClient;
+
+/** \brief Awaitable for one request/response transfer with a Modbus server. It is
+ *         obtained from one of the TbxMbCoClient methods and must be awaited right
+ *         away. The result of co_await is TBX_OK if successful, TBX_ERROR otherwise.
+ */
+class TbxMbCoTransfer
+{
+public:
+  /* Constructors and destructor. */
+  TbxMbCoTransfer(TbxMbCoTransfer const &) = delete;
+  TbxMbCoTransfer & operator=(TbxMbCoTransfer const &) = delete;
+  /* Awaitable interface. */
+  bool await_ready() const noexcept { return false; }
+  bool await_suspend(std::coroutine_handle<> handle);
+  uint8_t await_resume();
+
+private:
+  friend class TbxMbCoClient;
+  /* Constructors. */
+  TbxMbCoTransfer(TbxMbCoClient & client, uint8_t node, uint8_t code, uint16_t addr,
+                  uint8_t num, uint16_t regs[], uint16_t const writeRegs[]);
+  TbxMbCoTransfer(TbxMbCoClient & client, uint8_t node, uint8_t const txPdu[],
+                  uint8_t rxPdu[], uint8_t & len);
+  /* Methods. */
+  uint8_t submit();
+  static void onDone(void * doneArg, uint8_t result);
+  /* Members. */
+  TbxMbCoClient         & m_Client;
+  TbxMbCoTransfer       * m_Next;
+  std::coroutine_handle<> m_Handle;
+  uint8_t                 m_Node;
+  uint8_t                 m_Code;
+  uint16_t                m_Addr;
+  uint8_t                 m_Num;
+  uint16_t              * m_Regs;
+  uint16_t const        * m_WriteRegs;
+  uint8_t const         * m_TxPdu;
+  uint8_t               * m_RxPdu;
+  uint8_t               * m_Len;
+  uint8_t                 m_Result;
+  uint8_t                 m_PduLen;
+  uint8_t                 m_TxBuf[TBX_MB_TP_PDU_MAX_LEN];
+  uint8_t                 m_RxBuf[TBX_MB_TP_PDU_MAX_LEN];
+};
+
+
+/****************************************************************************************
+*                            T B X M B C O C L I E N T
+****************************************************************************************/
+/** \brief Coroutine front-end for a Modbus client. Transfers that are awaited while
+ *         another one is in progress on the same client, are queued and handled in
+ *         order. Transfers on different clients run at the same time. The coroutine
+ *         client must be the only asynchronous user of its client channel. While
+ *         another asynchronous transfer is in progress on the channel, co_await gives
+ *         TBX_ERROR right away. Example:
+ *
+ *           TbxMbCoTask poll(TbxMbCoClient & client)
+ *           {
+ *             uint16_t regs[4];
+ *             for (;;)
+ *             {
+ *               if (co_await client.readHoldingRegs(10U, 40000U, 4U, regs) == TBX_OK)
+ *               {
+ *                 ...process regs...
+ *               }
+ *             }
+ *           }
+ */
+class TbxMbCoClient
+{
+public:
+  /* Constructors and destructor. */
+  explicit TbxMbCoClient(TbxMbClient & client);
+  /* Methods. */
+  TbxMbCoTransfer readInputRegs(uint8_t node, uint16_t addr, uint8_t num,
+                                uint16_t inputRegs[]);
+  TbxMbCoTransfer readHoldingRegs(uint8_t node, uint16_t addr, uint8_t num,
+                                  uint16_t holdingRegs[]);
+  TbxMbCoTransfer writeHoldingRegs(uint8_t node, uint16_t addr, uint8_t num,
+                                   uint16_t const holdingRegs[]);
+  TbxMbCoTransfer customFunction(uint8_t node, uint8_t const txPdu[], uint8_t rxPdu[],
+                                 uint8_t & len);
+  size_t pending() const;
+
+private:
+  friend class TbxMbCoTransfer;
+  /* Methods. */
+  void enqueue(TbxMbCoTransfer & transfer);
+  void startNext();
+  /* Members. */
+  tTbxMbClient      m_Channel;
+  TbxMbCoTransfer * m_Head;
+  TbxMbCoTransfer * m_Tail;
+};
+
+#endif /* __cplusplus >= 202002L */
+
+#endif /* TBXMBCORO_HPP */
+/*********************************** end of tbxmbcoro.hpp ******************************/
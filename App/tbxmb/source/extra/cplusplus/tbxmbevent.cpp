@@ -64,4 +64,16 @@ void TbxMbEvent::task()
   TbxMbEventTask();
 } /*** end of task ***/
 
+
+/************************************************************************************//**
+** \brief     Determines if the Modbus stack has nothing to do, until the next interrupt
+**            posts a new event.
+** \return    True if idle, false if task() has work to do.
+**
+****************************************************************************************/
+bool TbxMbEvent::isIdle()
+{
+  return (TbxMbEventIsIdle() == TBX_TRUE);
+} /*** end of isIdle ***/
+
 /*********************************** end of tbxmbevent.cpp ******************************/
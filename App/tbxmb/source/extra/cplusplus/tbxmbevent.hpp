@@ -42,6 +42,7 @@ class TbxMbEvent
 public:
   /* Methods. */
   static void task();
+  static bool isIdle();
 };
 
 #endif /* TBXMBEVENT_HPP */
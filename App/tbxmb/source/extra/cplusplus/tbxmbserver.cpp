@@ -168,6 +168,48 @@ tTbxMbServerResult TbxMbServer::writeHoldingReg(uint16_t addr,
 } /*** end of writeHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Reads a record of a file.
+** \details   A record is one 16-bit register inside the file.
+** \attention Store the value of the record in your CPUs native endianess. The
+**            MicroTBX-Modbus stack will automatically convert this to the big endianess
+**            that the Modbus protocol requires.
+** \param     file File number (1..65535).
+** \param     record Record number inside the file (0..9999).
+** \param     value Reference where to store the value of the record.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific file or record is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readFileRecord(uint16_t  file,
+                                               uint16_t  record,
+                                               uint16_t& value)
+{
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a record of a file.
+** \details   A record is one 16-bit register inside the file.
+** \attention The value of the record is already in your CPUs native endianess.
+** \param     file File number (1..65535).
+** \param     record Record number inside the file (0..9999).
+** \param     value Value of the record.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific file or record is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::writeFileRecord(uint16_t file,
+                                                uint16_t record,
+                                                uint16_t value)
+{
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of writeFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Implements custom function code handling for supporting Modbus function
 **            codes that are either currently not supported or user defined extensions.
@@ -453,6 +495,88 @@ tTbxMbServerResult TbxMbServer::callbackWriteHoldingReg(tTbxMbServer channel,
 } /*** end of callbackWriteHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readFileRecord() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Record number inside the file (0..9999).
+** \param     value Pointer to write the value of the record to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific file or record is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadFileRecord(tTbxMbServer channel,
+                                                       uint16_t     file,
+                                                       uint16_t     record,
+                                                       uint16_t   * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer. */
+  if (channel != nullptr)
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readFileRecord(file, record, *value);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeFileRecord() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Record number inside the file (0..9999).
+** \param     value New value of the record.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific file or record is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackWriteFileRecord(tTbxMbServer channel,
+                                                        uint16_t     file,
+                                                        uint16_t     record,
+                                                        uint16_t     value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer. */
+  if (channel != nullptr)
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->writeFileRecord(file, record, value);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Wrapper to connect this callback to the customFunction() method of a class
 **            instance.
@@ -549,6 +673,8 @@ TbxMbServerRtu::TbxMbServerRtu(uint8_t            nodeAddr,
       TbxMbServerSetCallbackReadInputReg(m_Channel, callbackReadInputReg);
       TbxMbServerSetCallbackReadHoldingReg(m_Channel, callbackReadHoldingReg);
       TbxMbServerSetCallbackWriteHoldingReg(m_Channel, callbackWriteHoldingReg);
+      TbxMbServerSetCallbackReadFileRecord(m_Channel, callbackReadFileRecord);
+      TbxMbServerSetCallbackWriteFileRecord(m_Channel, callbackWriteFileRecord);
       TbxMbServerSetCallbackCustomFunction(m_Channel, calbackCustomFunction);
     }
   }
@@ -52,6 +52,10 @@ private:
   virtual tTbxMbServerResult readInputReg(uint16_t addr, uint16_t& value);
   virtual tTbxMbServerResult readHoldingReg(uint16_t addr, uint16_t& value);
   virtual tTbxMbServerResult writeHoldingReg(uint16_t addr, uint16_t value);
+  virtual tTbxMbServerResult readFileRecord(uint16_t file, uint16_t record,
+                                            uint16_t& value);
+  virtual tTbxMbServerResult writeFileRecord(uint16_t file, uint16_t record,
+                                             uint16_t value);
   virtual bool               customFunction(uint8_t const rxPdu[], uint8_t txPdu[], 
                                             uint8_t& len);
 
@@ -76,6 +80,10 @@ protected:
                                                    uint16_t * value);
   static tTbxMbServerResult callbackWriteHoldingReg(tTbxMbServer channel, uint16_t addr, 
                                                     uint16_t value);
+  static tTbxMbServerResult callbackReadFileRecord(tTbxMbServer channel, uint16_t file,
+                                                   uint16_t record, uint16_t * value);
+  static tTbxMbServerResult callbackWriteFileRecord(tTbxMbServer channel, uint16_t file,
+                                                    uint16_t record, uint16_t value);
   static  uint8_t           calbackCustomFunction(tTbxMbServer channel,
                                                   uint8_t const * rxPdu, uint8_t * txPdu,
                                                   uint8_t * len);
@@ -204,6 +204,29 @@ void TbxMbOsalEventPurge(void const * context)
 } /*** end of TbxMbOsalEventPurge ***/
 
 
+/************************************************************************************//**
+** \brief     Determines if events are waiting in the event queue.
+** \return    TBX_TRUE if at least one event is waiting, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbOsalEventPending(void)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Only check the queue if it was actually created. */
+  if (eventQueue != NULL)
+  {
+    /* Are there events waiting in the queue? */
+    if (uxQueueMessagesWaiting(eventQueue) > 0U)
+    {
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventPending ***/
+
+
 /************************************************************************************//**
 ** \brief     Creates a new binary semaphore object with an initial count of 0, meaning
 **            that it's taken.
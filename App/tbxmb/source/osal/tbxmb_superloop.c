@@ -163,6 +163,19 @@ void TbxMbOsalEventPurge( void const *context ) {
   return;
 }
 
+/**
+ * \brief     Determines if events are waiting in the event queue.
+ * \return    TBX_TRUE if at least one event is waiting, TBX_FALSE otherwise.
+ */
+uint8_t TbxMbOsalEventPending( void ) {
+  //
+  uint8_t result = TBX_FALSE;
+  TbxCriticalSectionEnter( );
+  if ( eventQueue.count > 0U ) { result = TBX_TRUE; }
+  TbxCriticalSectionExit( );
+  return result;
+}
+
 /**
  * \brief     Creates a new binary semaphore object with an initial count of 0,
  *            meaning that it's taken.
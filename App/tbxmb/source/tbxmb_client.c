@@ -45,12 +45,40 @@
 /** \brief Unique context type to identify a context as being a client channel. */
 #define TBX_MB_CLIENT_CONTEXT_TYPE     (23U)
 
+/** \brief No asynchronous transfer in progress. */
+#define TBX_MB_CLIENT_ASYNC_IDLE       (0U)
+
+/** \brief Asynchronous transfer waiting for the request transmission to complete. */
+#define TBX_MB_CLIENT_ASYNC_WAIT_TX    (1U)
+
+/** \brief Asynchronous transfer waiting for the response or the turnaround delay. */
+#define TBX_MB_CLIENT_ASYNC_WAIT_RX    (2U)
+
+/** \brief Asynchronous transfer waiting for a blocking transfer to complete. */
+#define TBX_MB_CLIENT_ASYNC_WAIT_IDLE  (3U)
+
+/** \brief Client channel is being released and no longer accepts transfers. */
+#define TBX_MB_CLIENT_ASYNC_CLOSED     (4U)
+
+/** \brief Number of ticks of the 20 kHz port timer that make up one millisecond. */
+#define TBX_MB_CLIENT_TICKS_PER_MS     (20U)
+
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
 static void TbxMbClientProcessEvent(tTbxMbEvent * event);
 
+static void TbxMbClientPollAsync   (void        * context);
+
+static void TbxMbClientProcessAsync(tTbxMbClientCtx * clientCtx,
+                                    tTbxMbEventId     eventId);
+
+static uint8_t TbxMbClientStartAsync(tTbxMbClientCtx * clientCtx);
+
+static void TbxMbClientCompleteAsync(tTbxMbClientCtx * clientCtx,
+                                     uint8_t           result);
+
 
 /************************************************************************************//**
 ** \brief     Creates a Modbus client channel object and assigns the specified Modbus
@@ -106,11 +134,21 @@ tTbxMbClient TbxMbClientCreate(tTbxMbTp transport,
         /* Initialize the channel context. */
         newClientCtx->type = TBX_MB_CLIENT_CONTEXT_TYPE;
         newClientCtx->instancePtr = NULL;
-        newClientCtx->pollFcn = NULL;
+        newClientCtx->pollFcn = TbxMbClientPollAsync;
         newClientCtx->processFcn = TbxMbClientProcessEvent;
         newClientCtx->responseTimeout = responseTimeout;
         newClientCtx->turnaroundDelay = turnaroundDelay;
         newClientCtx->transceiveSem = TbxMbOsalSemCreate();
+        newClientCtx->syncBusy = TBX_FALSE;
+        newClientCtx->asyncState = TBX_MB_CLIENT_ASYNC_IDLE;
+        newClientCtx->asyncNode = 0U;
+        newClientCtx->asyncTxPdu = NULL;
+        newClientCtx->asyncRxPdu = NULL;
+        newClientCtx->asyncLen = NULL;
+        newClientCtx->asyncDoneFcn = NULL;
+        newClientCtx->asyncDoneArg = NULL;
+        newClientCtx->asyncWaitMs = 0U;
+        newClientCtx->asyncLastTicks = 0U;
         /* Crosslink the transport layer. */
         newClientCtx->tpCtx = tpCtx;
         newClientCtx->tpCtx->channelCtx = newClientCtx;
@@ -146,6 +184,28 @@ void TbxMbClientFree(tTbxMbClient channel)
     /* Only continue with a valid context type. */
     if (clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE)
     {
+      /* Close the channel for new asynchronous transfers and take over the one that is
+       * possibly still pending.
+       */
+      uint8_t               pending;
+      tTbxMbClientAsyncDone doneFcn;
+      void                * doneArg;
+      TbxCriticalSectionEnter();
+      pending = clientCtx->asyncState;
+      doneFcn = clientCtx->asyncDoneFcn;
+      doneArg = clientCtx->asyncDoneArg;
+      clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_CLOSED;
+      clientCtx->asyncDoneFcn = NULL;
+      clientCtx->asyncDoneArg = NULL;
+      TbxCriticalSectionExit();
+      /* Complete the pending transfer with an error, otherwise its owner waits forever.
+       * Transfers that the callback tries to start, fail right away.
+       */
+      if ((pending != TBX_MB_CLIENT_ASYNC_IDLE) && (doneFcn != NULL))
+      {
+        *clientCtx->asyncLen = 0U;
+        doneFcn(doneArg, TBX_ERROR);
+      }
       /* Release the semaphore used for syncing to PDU transmit and reception events. */
       TbxMbOsalSemFree(clientCtx->transceiveSem);
       /* Remove crosslink between the channel and the transport layer. */
@@ -157,6 +217,7 @@ void TbxMbClientFree(tTbxMbClient channel)
       clientCtx->pollFcn = NULL;
       clientCtx->processFcn = NULL;
       clientCtx->transceiveSem = NULL;
+      clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_IDLE;
       TbxCriticalSectionExit();
       /* Purge possibly pending events from this channel's context. */
       TbxMbEventPurge(channel);
@@ -196,33 +257,45 @@ static void TbxMbClientProcessEvent(tTbxMbEvent * event)
       /* Only continue with a valid context type. */
       if (clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE)
       {
+        /* Is an asynchronous transfer on the bus? In this case the event drives its
+         * state machine instead of synchronizing a blocked task. A deferred one waits
+         * for the blocked task, so the event is still for the blocked task.
+         */
+        if ((clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_TX) ||
+            (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_RX))
+        {
+          TbxMbClientProcessAsync(clientCtx, event->id);
+        }
         /* Filter on the event identifier. */
-        switch (event->id)
+        else
         {
-          case TBX_MB_EVENT_ID_PDU_RECEIVED:
+          switch (event->id)
           {
-            /* Give the PDU received semaphore to synchronize whatever task is waiting
-             * for this event.
-             */
-            TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
-          }
-          break;
+            case TBX_MB_EVENT_ID_PDU_RECEIVED:
+            {
+              /* Give the PDU received semaphore to synchronize whatever task is
+               * waiting for this event.
+               */
+              TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+            }
+            break;
 
-          case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
-          {
-            /* Give the PDU transmitted semaphore to synchronize whatever task is waiting
-             * for this event.
-             */
-            TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
-          }
-          break;
+            case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+            {
+              /* Give the PDU transmitted semaphore to synchronize whatever task is
+               * waiting for this event.
+               */
+              TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+            }
+            break;
 
-          default:
-          {
-            /* An unsupported event was dispatched to us. Should not happen. */
-            TBX_ASSERT(TBX_FALSE);
+            default:
+            {
+              /* An unsupported event was dispatched to us. Should not happen. */
+              TBX_ASSERT(TBX_FALSE);
+            }
+            break;
           }
-          break;
         }
       }
     }
@@ -253,10 +326,25 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
     waitTimeout = clientCtx->turnaroundDelay;
   }
 
-  /* Request the transport layer to transmit the request packet and update the
-   * result accordingly.
+  /* A blocking transfer cannot be started while an asynchronous one is in progress.
+   * Otherwise mark the channel busy, so that an asynchronous transfer started in the
+   * meantime waits for this one to complete.
    */
-  result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
+  uint8_t isClaimed = TBX_FALSE;
+  TbxCriticalSectionEnter();
+  if (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_IDLE)
+  {
+    clientCtx->syncBusy = TBX_TRUE;
+    isClaimed = TBX_TRUE;
+  }
+  TbxCriticalSectionExit();
+  if (isClaimed == TBX_TRUE)
+  {
+    /* Request the transport layer to transmit the request packet and update the
+     * result accordingly.
+     */
+    result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
+  }
   /* Only continue if the request was successfully submitted for transmission. */
   if (result == TBX_OK)
   {
@@ -291,6 +379,11 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
       }
     }
   }
+  /* The channel is free again for a deferred asynchronous transfer. */
+  if (isClaimed == TBX_TRUE)
+  {
+    clientCtx->syncBusy = TBX_FALSE;
+  }
   /* Give the result back to the caller. */
   return result;
 } /*** end of TbxMbClientTransceive ***/
@@ -1185,6 +1278,274 @@ uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
 } /*** end of TbxMbClientWriteHoldingRegs ***/
 
 
+/************************************************************************************//**
+** \brief     Reads the record(s) of a file from the server with the specified node
+**            address.
+** \details   A record is one 16-bit register inside the file. The request holds a single
+**            sub-request for consecutive records.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 255.
+** \param     file File number (1..65535).
+** \param     record Number of the first record (0..9999) inside the file.
+** \param     num Number of records to read. Range can be 1..121, so that the response fits.
+** \param     values Pointer to array where the record values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFileRecord(tTbxMbClient   channel,
+                                  uint8_t        node,
+                                  uint16_t       file,
+                                  uint16_t       record,
+                                  uint8_t        num,
+                                  uint16_t     * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && ((node <= TBX_MB_TP_NODE_ADDR_MAX)||(node == 255U)) &&
+             (file >= 1U) && (record <= (TBX_MB_FILE_RECORD_NUM_MAX + 1U - num)) &&
+             (num >= 1U) && (num <= 121U) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && ((node <= TBX_MB_TP_NODE_ADDR_MAX)||(node == 255U)) &&
+      (file >= 1U) && (record <= (TBX_MB_FILE_RECORD_NUM_MAX + 1U - num)) &&
+      (num >= 1U) && (num <= 121U) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Only continue with a valid context type. */
+    if (clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE)
+    {
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+      /* Should always work, unless this function is being called recursively. Only
+       * continue with access for preparing the request packet.
+       */
+      if (txPacket != NULL)
+      {
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC20_READ_FILE_RECORD;
+        txPacket->dataLen = 8U;
+        /* Byte count of the single sub-request. */
+        txPacket->pdu.data[0] = 7U;
+        /* Reference type. */
+        txPacket->pdu.data[1] = TBX_MB_FILE_REF_TYPE;
+        /* File number. */
+        TbxMbCommonStoreUInt16BE(file, &txPacket->pdu.data[2]);
+        /* Record number. */
+        TbxMbCommonStoreUInt16BE(record, &txPacket->pdu.data[4]);
+        /* Record length. */
+        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[6]);
+
+        /* Determine the request type (broadcast / unicast). */
+        uint8_t isBroadcast = TBX_FALSE;
+        if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+        {
+          isBroadcast = TBX_TRUE;
+        }
+        /* Transmit the request and wait for the response to a unicast request to come in
+         * or the turnaround time to pass for a broadcast request.
+         */
+        result = TbxMbClientTransceive(clientCtx, isBroadcast);
+
+        /* Only continue with processing the response if all is okay so far and the
+         * request was unicast.
+         */
+        if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+        {
+          /* Obtain read access to the response packet. */
+          tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+          /* Since we just received a response packet, the packet access should always 
+           * succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT(rxPacket != NULL);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
+          {
+            /* Check that the response came from the expected node, that it's a response
+             * with the same function code (not an exception response) and that the data
+             * length, the sub-response length and its reference type are as expected.
+             */
+            uint8_t respLen = rxPacket->pdu.data[0];
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC20_READ_FILE_RECORD) ||
+                (respLen != ((num * 2U) + 2U)) ||
+                (rxPacket->dataLen != (respLen + 1U)) ||
+                (rxPacket->pdu.data[1] != ((num * 2U) + 1U)) ||
+                (rxPacket->pdu.data[2] != TBX_MB_FILE_REF_TYPE))
+            {
+              result = TBX_ERROR;
+            }
+            /* Response content valid. Process its data. */
+            else
+            {
+              /* Set pointer to where the record values start in the response. */
+              uint8_t const * recordValPtr = &rxPacket->pdu.data[3];
+              /* Read out and store the record values. */
+              for (uint8_t idx = 0U; idx < num; idx++)
+              {
+                values[idx] = TbxMbCommonExtractUInt16BE(&recordValPtr[idx * 2U]);
+              }
+            }
+          }
+          /* Could not access the response packet. */
+          else
+          {
+            result = TBX_ERROR;
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the record(s) of a file to the server with the specified node
+**            address.
+** \details   A record is one 16-bit register inside the file. The request holds a single
+**            sub-request for consecutive records. Compared to writing holding registers,
+**            this transfers almost the same number of values per request, yet lets the
+**            server recognize a complete file and validate it before applying it.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 255.
+** \param     file File number (1..65535).
+** \param     record Number of the first record (0..9999) inside the file.
+** \param     num Number of records to write. Range can be 1..122.
+** \param     values Pointer to array with the desired record values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteFileRecord(tTbxMbClient         channel,
+                                   uint8_t              node,
+                                   uint16_t             file,
+                                   uint16_t             record,
+                                   uint8_t              num,
+                                   uint16_t     const * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && ((node <= TBX_MB_TP_NODE_ADDR_MAX)||(node == 255U)) &&
+             (file >= 1U) && (record <= (TBX_MB_FILE_RECORD_NUM_MAX + 1U - num)) &&
+             (num >= 1U) && (num <= 122U) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && ((node <= TBX_MB_TP_NODE_ADDR_MAX)||(node == 255U)) &&
+      (file >= 1U) && (record <= (TBX_MB_FILE_RECORD_NUM_MAX + 1U - num)) &&
+      (num >= 1U) && (num <= 122U) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Only continue with a valid context type. */
+    if (clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE)
+    {
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+      /* Should always work, unless this function is being called recursively. Only
+       * continue with access for preparing the request packet.
+       */
+      if (txPacket != NULL)
+      {
+        /* Determine byte count needed for the single sub-request. */
+        uint8_t byteCount = (num * 2U) + 7U;
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC21_WRITE_FILE_RECORD;
+        txPacket->dataLen = byteCount + 1U;
+        /* Byte count. */
+        txPacket->pdu.data[0] = byteCount;
+        /* Reference type. */
+        txPacket->pdu.data[1] = TBX_MB_FILE_REF_TYPE;
+        /* File number. */
+        TbxMbCommonStoreUInt16BE(file, &txPacket->pdu.data[2]);
+        /* Record number. */
+        TbxMbCommonStoreUInt16BE(record, &txPacket->pdu.data[4]);
+        /* Record length. */
+        TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[6]);
+        /* Set pointer to where the record values start in the request. */
+        uint8_t * recordValPtr = &txPacket->pdu.data[8];
+        /* Store the record values. */
+        for (uint8_t idx = 0U; idx < num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(values[idx], &recordValPtr[idx * 2U]);
+        }
+
+        /* Determine the request type (broadcast / unicast). */
+        uint8_t isBroadcast = TBX_FALSE;
+        if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+        {
+          isBroadcast = TBX_TRUE;
+        }
+        /* Transmit the request and wait for the response to a unicast request to come in
+         * or the turnaround time to pass for a broadcast request.
+         */
+        result = TbxMbClientTransceive(clientCtx, isBroadcast);
+
+        /* Only continue with processing the response if all is okay so far and the
+         * request was unicast.
+         */
+        if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+        {
+          /* Obtain read access to the response packet. */
+          tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+          /* Since we just received a response packet, the packet access should always 
+           * succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT(rxPacket != NULL);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
+          {
+            /* Check that the response came from the expected node, that it's a response
+             * with the same function code (not an exception response), that the data
+             * length is as expected and that the sub-request header got echoed. The
+             * record values are not compared, because the server might adjust them.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC21_WRITE_FILE_RECORD) ||
+                (rxPacket->dataLen != (byteCount + 1U)) ||
+                (rxPacket->pdu.data[0] != byteCount) ||
+                (rxPacket->pdu.data[1] != TBX_MB_FILE_REF_TYPE) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != file) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]) != record) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[6]) != num))
+            {
+              result = TBX_ERROR;
+            }
+          }
+          /* Could not access the response packet. */
+          else
+          {
+            result = TBX_ERROR;
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Perform diagnostic operation on the server for checking the communication
 **            system.
@@ -1552,4 +1913,382 @@ uint8_t TbxMbClientCustomFunction (tTbxMbClient         channel,
 } /*** end of TbxMbClientCustomFunction ***/
 
 
+/************************************************************************************//**
+** \brief     Asynchronous version of TbxMbClientCustomFunction(). It submits the request
+**            PDU for transmission and returns right away, without waiting for the
+**            response. Once the transfer completes, the doneFcn callback is called from
+**            TbxMbEventTask(). At that point rxPdu and len hold the response PDU, if
+**            the transfer was successful. Both must therefore stay valid until the
+**            callback was called.
+** \details   This allows one task to drive many client channels at the same time, as
+**            opposed to one task per client channel with the blocking functions. A
+**            client channel handles one asynchronous transfer at a time. Use
+**            TbxMbClientIsBusy() to find out if a new one can be started. If a blocking
+**            transfer is in progress, the asynchronous one starts once it completed. In
+**            this case txPdu must stay valid until the callback was called as well.
+**            TbxMbClientFree() completes a pending transfer with an error.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 255.
+** \param     txPdu Pointer to a byte array with the PDU to transmit.
+** \param     rxPdu Pointer to a byte array for storing the received response PDU.
+** \param     len Pointer to the PDU length, including the function code.
+** \param     doneFcn Function to call when the transfer completed.
+** \param     doneArg Argument that is passed on to the doneFcn callback.
+** \return    TBX_OK if the transfer was started, TBX_ERROR otherwise. Note that the
+**            doneFcn callback is only called if the transfer was started.
+**
+****************************************************************************************/
+uint8_t TbxMbClientCustomFunctionAsync(tTbxMbClient          channel,
+                                       uint8_t               node,
+                                       uint8_t       const * txPdu,
+                                       uint8_t             * rxPdu,
+                                       uint8_t             * len,
+                                       tTbxMbClientAsyncDone doneFcn,
+                                       void                * doneArg)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && ((node <= TBX_MB_TP_NODE_ADDR_MAX)||(node == 255U)) &&
+             (txPdu != NULL) && (rxPdu != NULL) && (len != NULL) && (doneFcn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && ((node <= TBX_MB_TP_NODE_ADDR_MAX)||(node == 255U)) && 
+      (txPdu != NULL) && (rxPdu != NULL) && (len != NULL) && (doneFcn != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Only continue with a valid context type and a valid packet length. It should at
+     * least have a PDU function code.
+     */
+    if ((clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE) && (*len > 0U))
+    {
+      /* Claim the channel, when no other asynchronous transfer is in progress. Store
+       * the transfer information before starting the transmission, because the
+       * transmit complete event can be processed right away.
+       */
+      uint8_t isClaimed = TBX_FALSE;
+      TbxCriticalSectionEnter();
+      if (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_IDLE)
+      {
+        isClaimed = TBX_TRUE;
+        clientCtx->asyncNode = node;
+        clientCtx->asyncTxPdu = txPdu;
+        clientCtx->asyncRxPdu = rxPdu;
+        clientCtx->asyncLen = len;
+        clientCtx->asyncDoneFcn = doneFcn;
+        clientCtx->asyncDoneArg = doneArg;
+        /* The packet response reception timeout is re-used for the transmission, just
+         * like in TbxMbClientTransceive().
+         */
+        clientCtx->asyncWaitMs = clientCtx->responseTimeout;
+        clientCtx->asyncLastTicks = TbxMbPortTimerCount();
+        clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_WAIT_IDLE;
+      }
+      TbxCriticalSectionExit();
+      if (isClaimed == TBX_TRUE)
+      {
+        /* Start right away, unless a blocking transfer is in progress. The poll
+         * function starts it once the blocking transfer completed.
+         */
+        result = TBX_OK;
+        if (clientCtx->syncBusy == TBX_FALSE)
+        {
+          result = TbxMbClientStartAsync(clientCtx);
+        }
+        /* Transmission successfully submitted or deferred? */
+        if (result == TBX_OK)
+        {
+          /* Start polling for the timeout detection. */
+          tTbxMbEvent newEvent;
+          newEvent.context = clientCtx;
+          newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+        }
+        else
+        {
+          /* Back to idle. The callback is not called in this case. */
+          clientCtx->asyncDoneFcn = NULL;
+          clientCtx->asyncDoneArg = NULL;
+          clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_IDLE;
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientCustomFunctionAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if an asynchronous transfer is in progress on the client
+**            channel, including one that waits for a blocking transfer to complete.
+** \param     channel Handle to the Modbus client channel.
+** \return    TBX_TRUE if an asynchronous transfer is in progress, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientIsBusy(tTbxMbClient channel)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx const * clientCtx = (tTbxMbClientCtx const *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Only continue with a valid context type. */
+    if (clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE)
+    {
+      /* Check for a pending asynchronous transfer. A channel that is being released is
+       * not busy, so that whoever waits for it, learns from the failing start.
+       */
+      if ((clientCtx->asyncState != TBX_MB_CLIENT_ASYNC_IDLE) &&
+          (clientCtx->asyncState != TBX_MB_CLIENT_ASYNC_CLOSED))
+      {
+        result = TBX_TRUE;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientIsBusy ***/
+
+
+/************************************************************************************//**
+** \brief     Prepares the request packet of the claimed asynchronous transfer and
+**            submits it for transmission.
+** \param     clientCtx Pointer to the client channel context.
+** \return    TBX_OK if the transmission was submitted, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientStartAsync(tTbxMbClientCtx * clientCtx)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Obtain write access to the request packet. */
+  tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+  /* Only continue with access for preparing the request packet. */
+  if (txPacket != NULL)
+  {
+    /* Prepare the request packet. */
+    txPacket->node = clientCtx->asyncNode;
+    txPacket->pdu.code = clientCtx->asyncTxPdu[0];
+    txPacket->dataLen = *clientCtx->asyncLen - 1U;
+    for (uint8_t idx = 0U; idx < txPacket->dataLen; idx++)
+    {
+      txPacket->pdu.data[idx] = clientCtx->asyncTxPdu[idx + 1U];
+    }
+    /* The transmit complete event can be processed right away, so switch the state
+     * before the transmission.
+     */
+    clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_WAIT_TX;
+    /* Request the transport layer to transmit the request packet. */
+    result = clientCtx->tpCtx->transmitFcn(clientCtx->tpCtx);
+    /* Still waiting for the start, if the transmission could not be submitted. */
+    if (result != TBX_OK)
+    {
+      clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_WAIT_IDLE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientStartAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Event poll function that is automatically called from TbxMbEventTask(),
+**            while an asynchronous transfer is in progress. It starts a deferred
+**            transfer, once the blocking transfer completed, and detects the response
+**            timeout and the end of the turnaround delay after a broadcast request.
+** \param     context Pointer to the client channel context.
+**
+****************************************************************************************/
+static void TbxMbClientPollAsync(void * context)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Convert the context to the client channel context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)context;
+    /* Deferred transfer? */
+    if (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_IDLE)
+    {
+      /* The wait time only starts to count once the blocking transfer completed. */
+      if (clientCtx->syncBusy == TBX_TRUE)
+      {
+        clientCtx->asyncLastTicks = TbxMbPortTimerCount();
+      }
+      /* Attempt to start it. This fails while the transport layer still holds the
+       * response of the blocking transfer, so retry until the wait time passed.
+       */
+      else if (TbxMbClientStartAsync(clientCtx) == TBX_OK)
+      {
+        clientCtx->asyncWaitMs = clientCtx->responseTimeout;
+        clientCtx->asyncLastTicks = TbxMbPortTimerCount();
+      }
+      else
+      {
+        /* Keep the wait time running. */
+      }
+    }
+    /* Only continue with a transfer in progress. */
+    if ((clientCtx->asyncState != TBX_MB_CLIENT_ASYNC_IDLE) &&
+        (clientCtx->asyncState != TBX_MB_CLIENT_ASYNC_CLOSED))
+    {
+      /* Get the number of milliseconds that elapsed since the last detection. Note that
+       * this calculation works, even if the 20 kHz timer counter overflowed.
+       */
+      uint16_t deltaTicks = TbxMbPortTimerCount() - clientCtx->asyncLastTicks;
+      uint16_t deltaMs = deltaTicks / TBX_MB_CLIENT_TICKS_PER_MS;
+      /* Did one or more milliseconds pass? */
+      if (deltaMs > 0U)
+      {
+        /* Update the last millisecond detection tick time. */
+        clientCtx->asyncLastTicks += (uint16_t)(deltaMs * TBX_MB_CLIENT_TICKS_PER_MS);
+        /* Subtract the elapsed milliseconds from the remaining wait time. */
+        if (clientCtx->asyncWaitMs > deltaMs)
+        {
+          clientCtx->asyncWaitMs -= deltaMs;
+        }
+        /* Wait time passed. */
+        else
+        {
+          uint8_t result = TBX_ERROR;
+          clientCtx->asyncWaitMs = 0U;
+          /* The turnaround delay passing after a broadcast request is okay. Everything
+           * else is a timeout error.
+           */
+          if ((clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_RX) &&
+              (clientCtx->asyncNode == TBX_MB_TP_NODE_ADDR_BROADCAST))
+          {
+            result = TBX_OK;
+          }
+          /* No response PDU available in both cases. */
+          *clientCtx->asyncLen = 0U;
+          TbxMbClientCompleteAsync(clientCtx, result);
+        }
+      }
+    }
+  }
+} /*** end of TbxMbClientPollAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Processes a transport layer event for the asynchronous transfer that is in
+**            progress.
+** \param     clientCtx Pointer to the client channel context.
+** \param     eventId The identifier of the event to process.
+**
+****************************************************************************************/
+static void TbxMbClientProcessAsync(tTbxMbClientCtx * clientCtx,
+                                    tTbxMbEventId     eventId)
+{
+  /* Filter on the event identifier. */
+  switch (eventId)
+  {
+    case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+    {
+      /* Request transmitted. Start waiting for the response or the turnaround delay in
+       * case of a broadcast request.
+       */
+      if (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_TX)
+      {
+        clientCtx->asyncWaitMs = clientCtx->responseTimeout;
+        if (clientCtx->asyncNode == TBX_MB_TP_NODE_ADDR_BROADCAST)
+        {
+          clientCtx->asyncWaitMs = clientCtx->turnaroundDelay;
+        }
+        clientCtx->asyncLastTicks = TbxMbPortTimerCount();
+        clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_WAIT_RX;
+      }
+    }
+    break;
+
+    case TBX_MB_EVENT_ID_PDU_RECEIVED:
+    {
+      uint8_t result = TBX_ERROR;
+      /* Obtain read access to the response packet. */
+      tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+      /* Only process it as the response, when actually waiting for one. */
+      if ((rxPacket != NULL) && (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_RX) &&
+          (clientCtx->asyncNode != TBX_MB_TP_NODE_ADDR_BROADCAST))
+      {
+        *clientCtx->asyncLen = 0U;
+        /* Check that the response came from the expected node. */
+        if (rxPacket->node == clientCtx->asyncNode)
+        {
+          /* Set the length, including the function code, and copy the PDU. */
+          *clientCtx->asyncLen = rxPacket->dataLen + 1U;
+          clientCtx->asyncRxPdu[0] = rxPacket->pdu.code;
+          for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+          {
+            clientCtx->asyncRxPdu[idx + 1U] = rxPacket->pdu.data[idx];
+          }
+          result = TBX_OK;
+        }
+      }
+      /* Inform the transport layer that were done with the rx packet. */
+      clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      /* Complete the transfer, if this was the response. */
+      if ((rxPacket != NULL) && (clientCtx->asyncState == TBX_MB_CLIENT_ASYNC_WAIT_RX) &&
+          (clientCtx->asyncNode != TBX_MB_TP_NODE_ADDR_BROADCAST))
+      {
+        TbxMbClientCompleteAsync(clientCtx, result);
+      }
+    }
+    break;
+
+    default:
+    {
+      /* An unsupported event was dispatched to us. Should not happen. */
+      TBX_ASSERT(TBX_FALSE);
+    }
+    break;
+  }
+} /*** end of TbxMbClientProcessAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Completes the asynchronous transfer that is in progress. The client channel
+**            is idle again when the callback runs, so the callback can directly start
+**            the next transfer.
+** \param     clientCtx Pointer to the client channel context.
+** \param     result TBX_OK if the transfer was successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static void TbxMbClientCompleteAsync(tTbxMbClientCtx * clientCtx,
+                                     uint8_t           result)
+{
+  tTbxMbClientAsyncDone doneFcn = clientCtx->asyncDoneFcn;
+  void                * doneArg = clientCtx->asyncDoneArg;
+  tTbxMbEvent           newEvent;
+
+  /* Stop polling for the timeout detection. */
+  newEvent.context = clientCtx;
+  newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+  TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+  /* Back to idle. */
+  clientCtx->asyncState = TBX_MB_CLIENT_ASYNC_IDLE;
+  clientCtx->asyncDoneFcn = NULL;
+  clientCtx->asyncDoneArg = NULL;
+  /* Inform the owner of the transfer. */
+  if (doneFcn != NULL)
+  {
+    doneFcn(doneArg, result);
+  }
+} /*** end of TbxMbClientCompleteAsync ***/
+
+
 /*********************************** end of tbxmb_client.c *****************************/
@@ -42,6 +42,14 @@ extern "C" {
  */
 typedef void * tTbxMbClient;
 
+/** \brief Callback function that signals the completion of an asynchronous transfer,
+ *         started with TbxMbClientCustomFunctionAsync(). The result parameter is
+ *         TBX_OK if the transfer completed successfully, TBX_ERROR otherwise. It's
+ *         called from TbxMbEventTask(), so from the context of the event task.
+ */
+typedef void (* tTbxMbClientAsyncDone)(void    * doneArg,
+                                       uint8_t   result);
+
 
 /****************************************************************************************
 * Function prototypes
@@ -88,6 +96,20 @@ uint8_t      TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
                                          uint8_t              num,
                                          uint16_t     const * holdingRegs);
 
+uint8_t      TbxMbClientReadFileRecord  (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             file,
+                                         uint16_t             record,
+                                         uint8_t              num,
+                                         uint16_t           * values);
+
+uint8_t      TbxMbClientWriteFileRecord (tTbxMbClient         channel,
+                                         uint8_t              node,
+                                         uint16_t             file,
+                                         uint16_t             record,
+                                         uint8_t              num,
+                                         uint16_t     const * values);
+
 uint8_t      TbxMbClientDiagnostics     (tTbxMbClient         channel,
                                          uint8_t              node,
                                          uint16_t             subcode,
@@ -99,6 +121,16 @@ uint8_t      TbxMbClientCustomFunction  (tTbxMbClient         channel,
                                          uint8_t            * rxPdu,
                                          uint8_t            * len);
 
+uint8_t      TbxMbClientCustomFunctionAsync(tTbxMbClient          channel,
+                                            uint8_t               node,
+                                            uint8_t       const * txPdu,
+                                            uint8_t             * rxPdu,
+                                            uint8_t             * len,
+                                            tTbxMbClientAsyncDone doneFcn,
+                                            void                * doneArg);
+
+uint8_t      TbxMbClientIsBusy          (tTbxMbClient         channel);
+
 
 #ifdef __cplusplus
 }
@@ -58,6 +58,17 @@ typedef struct
   uint16_t             responseTimeout;          /**< Maximum response wait time (ms). */
   uint16_t             turnaroundDelay;          /**< Delay (ms) after broadcast PDU.  */
   tTbxMbOsalSem        transceiveSem;            /**< PDU transmit/receive semaphore.  */
+  uint8_t              syncBusy;                 /**< Blocking transfer in progress.   */
+  /* Asynchronous transfer specific members. */
+  uint8_t              asyncState;               /**< Asynchronous transfer state.     */
+  uint8_t              asyncNode;                /**< Node of the pending request.     */
+  uint8_t      const * asyncTxPdu;               /**< Request PDU of a deferred start. */
+  uint8_t            * asyncRxPdu;               /**< Response PDU storage.            */
+  uint8_t            * asyncLen;                 /**< Response PDU length storage.     */
+  tTbxMbClientAsyncDone asyncDoneFcn;            /**< Transfer completion callback.    */
+  void               * asyncDoneArg;             /**< Completion callback argument.    */
+  uint16_t             asyncWaitMs;              /**< Remaining transfer wait time.    */
+  uint16_t             asyncLastTicks;           /**< Last millisecond detection time. */
 } tTbxMbClientCtx;
 
 
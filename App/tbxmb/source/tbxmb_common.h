@@ -65,6 +65,12 @@ extern "C" {
 /** \brief Modbus function code 16 - Write Multiple Registers. */
 #define TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS          (16U)
 
+/** \brief Modbus function code 20 - Read File Record. */
+#define TBX_MB_FC20_READ_FILE_RECORD                  (20U)
+
+/** \brief Modbus function code 21 - Write File Record. */
+#define TBX_MB_FC21_WRITE_FILE_RECORD                 (21U)
+
 
 /* ------------------------- Exception codes ----------------------------------------- */
 /** \brief Modbus exception code 01 - Illegal function. */
@@ -103,6 +109,14 @@ extern "C" {
 #define TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT       (15U)
 
 
+/* ------------------------- File records -------------------------------------------- */
+/** \brief Reference type of the sub-requests for reading and writing file records. */
+#define TBX_MB_FILE_REF_TYPE                          (6U)
+
+/** \brief Highest record number inside a file. */
+#define TBX_MB_FILE_RECORD_NUM_MAX                    (9999U)
+
+
 /* ------------------------- Bit masks ----------------------------------------------- */
 /** \brief Bit mask to OR to the function code to flag it as an exception response. */
 #define TBX_MB_FC_EXCEPTION_MASK                      (0x80U)
@@ -221,6 +221,56 @@ void TbxMbEventTask(void)
 } /*** end of TbxMbEventTask ***/
 
 
+/************************************************************************************//**
+** \brief     Determines if the Modbus stack has nothing to do, until the next interrupt
+**            posts a new event. This is the case when the event queue is empty and no
+**            poll function is active. A poll function is active while waiting for a
+**            character timeout, so during the reception or transmission of a packet.
+** \details   Intended for a superloop application that sleeps the CPU while the stack
+**            is idle. Call it with interrupts disabled, right before going to sleep, to
+**            not miss an event posted by an interrupt. Also note that an event that the
+**            event task posts for itself, such as TBX_MB_EVENT_ID_START_POLLING, is in
+**            the event queue, so it is reported as pending work.
+** \return    TBX_TRUE if idle, TBX_FALSE if TbxMbEventTask() has work to do.
+**
+****************************************************************************************/
+uint8_t TbxMbEventIsIdle(void)
+{
+  uint8_t result = TBX_TRUE;
+
+  /* Is there an event waiting in the queue? */
+  if (TbxMbOsalEventPending() == TBX_TRUE)
+  {
+    result = TBX_FALSE;
+  }
+  /* Check for active poll functions, if the poller list was actually initialized. */
+  else if (pollerListInitialized == TBX_TRUE)
+  {
+    /* Obtain mutual exclusive access to the poller list. */
+    TbxCriticalSectionEnter();
+    /* Loop through the array to locate an active entry. */
+    for (size_t listIdx = 0U; listIdx < TBX_MB_EVENT_QUEUE_SIZE; listIdx++)
+    {
+      /* Is this entry in use? */
+      if (pollerList[listIdx] != NULL)
+      {
+        /* Update the result and stop the loop. */
+        result = TBX_FALSE;
+        break;
+      }
+    }
+    /* Release mutual exclusive access to the poller list. */
+    TbxCriticalSectionExit();
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbEventIsIdle ***/
+
+
 /************************************************************************************//**
 ** \brief     Function that removes all entries from the event queue and the pollerlist,
 **            which are related to the specified context. This function should be called
@@ -37,7 +37,9 @@ extern "C" {
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-void TbxMbEventTask(void);
+void    TbxMbEventTask  (void);
+
+uint8_t TbxMbEventIsIdle(void);
 
 
 #ifdef __cplusplus
@@ -71,6 +71,8 @@ uint8_t       TbxMbOsalEventWait (tTbxMbEvent       * event,
 
 void          TbxMbOsalEventPurge(void        const * context);
 
+uint8_t       TbxMbOsalEventPending(void);
+
 /* Modbus OSAL semaphore API. */
 tTbxMbOsalSem TbxMbOsalSemCreate (void);
 
@@ -420,7 +420,12 @@ static void TbxMbRtuPoll( void *context ) {
             newEvent.context = tpCtx->channelCtx;
             TbxCriticalSectionExit( );
             newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
-            TbxMbOsalEventPost( &newEvent, TBX_FALSE );
+            /* Only post the event if a channel is still linked. It could have been
+             * released while the transmission was in progress.
+             */
+            if ( newEvent.context != NULL ) {
+              TbxMbOsalEventPost( &newEvent, TBX_FALSE );
+            }
           }
         } break;
 
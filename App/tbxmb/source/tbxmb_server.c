@@ -45,6 +45,9 @@
 /** \brief Unique context type to identify a context as being a server channel. */
 #define TBX_MB_SERVER_CONTEXT_TYPE     (37U)
 
+/** \brief Maximum response data length of function code 20 - Read File Record. */
+#define TBX_MB_SERVER_FC20_RESP_LEN_MAX (0xF5U)
+
 
 /****************************************************************************************
 * Function prototypes
@@ -87,6 +90,14 @@ static void TbxMbServerFC16WriteMultipleRegs (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
 
+static void TbxMbServerFC20ReadFileRecord    (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+
+static void TbxMbServerFC21WriteFileRecord   (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+
 
 /************************************************************************************//**
 ** \brief     Creates a Modbus server channel object and assigns the specified Modbus
@@ -144,6 +155,8 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
         newServerCtx->readInputRegFcn = NULL;
         newServerCtx->readHoldingRegFcn = NULL;
         newServerCtx->writeHoldingRegFcn = NULL;
+        newServerCtx->readFileRecordFcn = NULL;
+        newServerCtx->writeFileRecordFcn = NULL;
         newServerCtx->customFunctionFcn = NULL;
         /* Crosslink the transport layer. */
         newServerCtx->tpCtx = tpCtx;
@@ -390,6 +403,70 @@ void TbxMbServerSetCallbackWriteHoldingReg(tTbxMbServer                channel,
 } /*** end of TbxMbServerSetCallbackWriteHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a specific record of a file.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadFileRecord(tTbxMbServer               channel,
+                                          tTbxMbServerReadFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue with a valid context type. */
+    if (serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE)
+    {
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->readFileRecordFcn = callback;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetCallbackReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of a specific record of a file.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackWriteFileRecord(tTbxMbServer                channel,
+                                           tTbxMbServerWriteFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue with a valid context type. */
+    if (serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE)
+    {
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->writeFileRecordFcn = callback;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetCallbackWriteFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Registers the callback function that this server calls, whenever it
 **            received a PDU containing a function code not currently supported. With the
@@ -543,6 +620,20 @@ static void TbxMbServerProcessEvent(tTbxMbEvent * event)
                 }
                 break;
 
+                /* ---------------- FC20 - Read File Record -------------------------- */
+                case TBX_MB_FC20_READ_FILE_RECORD:
+                {
+                  TbxMbServerFC20ReadFileRecord(serverCtx, rxPacket, txPacket);
+                }
+                break;
+
+                /* ---------------- FC21 - Write File Record ------------------------- */
+                case TBX_MB_FC21_WRITE_FILE_RECORD:
+                {
+                  TbxMbServerFC21WriteFileRecord(serverCtx, rxPacket, txPacket);
+                }
+                break;
+
                 /* ---------------- Unsupported function code ------------------------ */
                 default:
                 {
@@ -1514,4 +1605,292 @@ static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
 } /*** end of TbxMbServerFC16WriteMultipleRegs ***/
 
 
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 20 - Read File Record.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+**            The request holds one or more sub-requests of 7 bytes each: reference type,
+**            file number, record number and record length. The response holds a
+**            sub-response for each of them, with the values of the records. Its data
+**            length is limited to TBX_MB_SERVER_FC20_RESP_LEN_MAX bytes.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC20ReadFileRecord(tTbxMbServerCtx       * context,
+                                          tTbxMbTpPacket  const * rxPacket,
+                                          tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint8_t byteCnt = rxPacket->pdu.data[0];
+
+    /* Check if a callback function was registered. */
+    if (context->readFileRecordFcn == NULL)
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the byte count is invalid. It must hold whole sub-requests. */
+    else if ((byteCnt < 7U) || (byteCnt > 0xF5U) || ((byteCnt % 7U) != 0U) ||
+             (rxPacket->dataLen != (byteCnt + 1U)))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      uint16_t respLen = 0U;
+      uint8_t  excCode = 0U;
+
+      /* Check all sub-requests before reading any record, so that an invalid request
+       * does not trigger any of the record callbacks.
+       */
+      for (uint8_t reqIdx = 1U; (reqIdx <= byteCnt) && (excCode == 0U); reqIdx += 7U)
+      {
+        /* Read out the sub-request parameters. */
+        uint8_t const * subReqPtr = &rxPacket->pdu.data[reqIdx];
+        uint8_t         refType   = subReqPtr[0U];
+        uint16_t        fileNum   = TbxMbCommonExtractUInt16BE(&subReqPtr[1U]);
+        uint16_t        recordNum = TbxMbCommonExtractUInt16BE(&subReqPtr[3U]);
+        uint16_t        recordLen = TbxMbCommonExtractUInt16BE(&subReqPtr[5U]);
+
+        /* Check if the record length is invalid or if the sub-response does not fit. */
+        if ((recordLen < 1U) || (recordLen > 124U) ||
+            ((respLen + 2U + (recordLen * 2U)) > TBX_MB_SERVER_FC20_RESP_LEN_MAX))
+        {
+          excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+        }
+        /* Check if the reference type, file number or records are invalid. */
+        else if ((refType != TBX_MB_FILE_REF_TYPE) || (fileNum == 0U) ||
+                 (((uint32_t)recordNum + recordLen - 1U) > TBX_MB_FILE_RECORD_NUM_MAX))
+        {
+          excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        /* Sub-request is valid. */
+        else
+        {
+          /* Update the total length of the sub-responses. */
+          respLen += 2U + (recordLen * 2U);
+        }
+      }
+
+      /* Only read the records if all sub-requests are valid. */
+      respLen = 0U;
+      for (uint8_t reqIdx = 1U; (reqIdx <= byteCnt) && (excCode == 0U); reqIdx += 7U)
+      {
+        /* Read out the sub-request parameters. */
+        uint8_t const * subReqPtr = &rxPacket->pdu.data[reqIdx];
+        uint16_t        fileNum   = TbxMbCommonExtractUInt16BE(&subReqPtr[1U]);
+        uint16_t        recordNum = TbxMbCommonExtractUInt16BE(&subReqPtr[3U]);
+        uint16_t        recordLen = TbxMbCommonExtractUInt16BE(&subReqPtr[5U]);
+        /* Set pointer to where the sub-response starts. */
+        uint8_t * subRespPtr = &txPacket->pdu.data[1U + respLen];
+        /* Prepare the sub-response header. */
+        subRespPtr[0U] = (uint8_t)(1U + (recordLen * 2U));
+        subRespPtr[1U] = TBX_MB_FILE_REF_TYPE;
+        /* Loop through all the records. */
+        for (uint8_t idx = 0U; idx < recordLen; idx++)
+        {
+          uint16_t           recordValue = 0U;
+          tTbxMbServerResult srvResult;
+          /* Obtain the record value. */
+          srvResult = context->readFileRecordFcn(context, fileNum, recordNum + idx,
+                                                 &recordValue);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
+          {
+            if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+            {
+              excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            }
+            else
+            {
+              excCode = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            }
+            /* Stop looping. */
+            break;
+          }
+          /* Store the record value in the response. */
+          TbxMbCommonStoreUInt16BE(recordValue, &subRespPtr[2U + (idx * 2U)]);
+        }
+        /* Update the total length of the sub-responses. */
+        respLen += 2U + (recordLen * 2U);
+      }
+
+      /* Exception detected? */
+      if (excCode != 0U)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        txPacket->pdu.data[0] = excCode;
+        txPacket->dataLen = 1U;
+      }
+      else
+      {
+        /* Prepare the response data length. */
+        txPacket->pdu.data[0] = (uint8_t)respLen;
+        txPacket->dataLen = (uint8_t)(respLen + 1U);
+      }
+    }
+  }
+} /*** end of TbxMbServerFC20ReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 21 - Write File Record.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+**            The request holds one or more sub-requests: reference type, file number,
+**            record number, record length and the values of the records. The response
+**            is an echo of the request.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC21WriteFileRecord(tTbxMbServerCtx       * context,
+                                           tTbxMbTpPacket  const * rxPacket,
+                                           tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint8_t byteCnt = rxPacket->pdu.data[0];
+    uint8_t excCode = 0U;
+
+    /* Check if a callback function was registered. */
+    if (context->writeFileRecordFcn == NULL)
+    {
+      excCode = TBX_MB_EC01_ILLEGAL_FUNCTION;
+    }
+    /* Check if the byte count is invalid. */
+    else if ((byteCnt < 9U) || (byteCnt > 0xFBU) ||
+             (rxPacket->dataLen != (byteCnt + 1U)))
+    {
+      excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+    }
+    /* Check all sub-requests before writing any record, so that a malformed request
+     * does not leave the file partially written.
+     */
+    else
+    {
+      uint8_t reqIdx = 1U;
+      while ((reqIdx <= byteCnt) && (excCode == 0U))
+      {
+        /* The sub-request header must fit. */
+        if ((byteCnt + 1U - reqIdx) < 7U)
+        {
+          excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+        }
+        else
+        {
+          /* Read out the sub-request parameters. */
+          uint8_t const * subReqPtr = &rxPacket->pdu.data[reqIdx];
+          uint8_t         refType   = subReqPtr[0U];
+          uint16_t        fileNum   = TbxMbCommonExtractUInt16BE(&subReqPtr[1U]);
+          uint16_t        recordNum = TbxMbCommonExtractUInt16BE(&subReqPtr[3U]);
+          uint16_t        recordLen = TbxMbCommonExtractUInt16BE(&subReqPtr[5U]);
+
+          /* Check if the record length is invalid or the values do not fit. */
+          if ((recordLen < 1U) || (recordLen > 122U) ||
+              ((byteCnt + 1U - reqIdx - 7U) < (recordLen * 2U)))
+          {
+            excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          }
+          /* Check if the reference type, file number or records are invalid. */
+          else if ((refType != TBX_MB_FILE_REF_TYPE) || (fileNum == 0U) ||
+                   (((uint32_t)recordNum + recordLen - 1U) > TBX_MB_FILE_RECORD_NUM_MAX))
+          {
+            excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          }
+          /* Continue with the next sub-request. */
+          else
+          {
+            reqIdx += (uint8_t)(7U + (recordLen * 2U));
+          }
+        }
+      }
+    }
+
+    /* Only write the records if all sub-requests are valid. */
+    if (excCode == 0U)
+    {
+      uint8_t reqIdx = 1U;
+      /* Loop through all the sub-requests, as long as no exception is detected. */
+      while ((reqIdx <= byteCnt) && (excCode == 0U))
+      {
+        /* Read out the sub-request parameters. */
+        uint8_t const * subReqPtr = &rxPacket->pdu.data[reqIdx];
+        uint16_t        fileNum   = TbxMbCommonExtractUInt16BE(&subReqPtr[1U]);
+        uint16_t        recordNum = TbxMbCommonExtractUInt16BE(&subReqPtr[3U]);
+        uint16_t        recordLen = TbxMbCommonExtractUInt16BE(&subReqPtr[5U]);
+        /* Set pointer to where the record values start in the sub-request. */
+        uint8_t const * recordValPtr = &subReqPtr[7U];
+        /* Loop through all the records. */
+        for (uint8_t idx = 0U; idx < recordLen; idx++)
+        {
+          uint16_t           recordValue;
+          tTbxMbServerResult srvResult;
+          /* Extract the requested record value. */
+          recordValue = TbxMbCommonExtractUInt16BE(&recordValPtr[idx * 2U]);
+          /* Write the record value. */
+          srvResult = context->writeFileRecordFcn(context, fileNum, recordNum + idx,
+                                                  recordValue);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
+          {
+            if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+            {
+              excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            }
+            else
+            {
+              excCode = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            }
+            /* Stop looping. */
+            break;
+          }
+        }
+        /* Continue with the next sub-request. */
+        reqIdx += (uint8_t)(7U + (recordLen * 2U));
+      }
+    }
+
+    /* Exception detected? */
+    if (excCode != 0U)
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = excCode;
+      txPacket->dataLen = 1U;
+    }
+    else
+    {
+      /* The response is an echo of the request. */
+      for (uint8_t idx = 0U; idx <= byteCnt; idx++)
+      {
+        txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+      }
+      txPacket->dataLen = rxPacket->dataLen;
+    }
+  }
+} /*** end of TbxMbServerFC21WriteFileRecord ***/
+
+
 /*********************************** end of tbxmb_server.c *****************************/
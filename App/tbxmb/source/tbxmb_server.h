@@ -148,6 +148,39 @@ extern "C"
   typedef tTbxMbServerResult ( *tTbxMbServerWriteHoldingReg )( tTbxMbServer channel, uint16_t addr,
                                                                uint16_t value );
 
+  /** \brief   Modbus server callback function for reading a record of a file.
+   *  \details A record is one 16-bit register inside the file. Write its value in your
+   *           CPUs native endianess. The MicroTBX-Modbus stack will automatically convert
+   *           this to the big endianess that the Modbus protocol requires.
+   *  \param   channel Handle to the Modbus server channel object that triggered the
+   *           callback.
+   *  \param   file File number (1..65535).
+   *  \param   record Record number inside the file (0..9999).
+   *  \param   value Pointer to write the value of the record to.
+   *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+   *           specific file or record is not supported by this server,
+   *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+   */
+  typedef tTbxMbServerResult ( *tTbxMbServerReadFileRecord )( tTbxMbServer channel, uint16_t file,
+                                                              uint16_t record, uint16_t *value );
+
+  /** \brief   Modbus server callback function for writing a record of a file.
+   *  \details A record is one 16-bit register inside the file. The records of a request
+   *           are written in ascending order, so a write to the last record of a file can
+   *           be used to validate and apply the complete file.
+   *           The value of the record is already in your CPUs native endianess.
+   *  \param   channel Handle to the Modbus server channel object that triggered the
+   *           callback.
+   *  \param   file File number (1..65535).
+   *  \param   record Record number inside the file (0..9999).
+   *  \param   value Value of the record.
+   *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+   *           specific file or record is not supported by this server,
+   *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+   */
+  typedef tTbxMbServerResult ( *tTbxMbServerWriteFileRecord )( tTbxMbServer channel, uint16_t file,
+                                                               uint16_t record, uint16_t value );
+
   /** \brief   Modbus server callback function for implementing custom function code
    *           handling. Thanks to this functionality, the user can support Modbus function
    *           codes that are either currently not supported or user defined extensions.
@@ -189,6 +222,12 @@ extern "C"
   void TbxMbServerSetCallbackWriteHoldingReg( tTbxMbServer                channel,
                                               tTbxMbServerWriteHoldingReg callback );
 
+  void TbxMbServerSetCallbackReadFileRecord( tTbxMbServer               channel,
+                                             tTbxMbServerReadFileRecord callback );
+
+  void TbxMbServerSetCallbackWriteFileRecord( tTbxMbServer                channel,
+                                              tTbxMbServerWriteFileRecord callback );
+
   void TbxMbServerSetCallbackCustomFunction( tTbxMbServer               channel,
                                              tTbxMbServerCustomFunction callback );
 
@@ -61,6 +61,8 @@ typedef struct
   tTbxMbServerReadInputReg      readInputRegFcn;    /**< Read input register callback. */
   tTbxMbServerReadHoldingReg    readHoldingRegFcn;  /**< Read holding register cb.     */
   tTbxMbServerWriteHoldingReg   writeHoldingRegFcn; /**< Write holding register cb.    */
+  tTbxMbServerReadFileRecord    readFileRecordFcn;  /**< Read file record callback.    */
+  tTbxMbServerWriteFileRecord   writeFileRecordFcn; /**< Write file record callback.   */
   tTbxMbServerCustomFunction    customFunctionFcn;  /**< Custom function code callback.*/  
 } tTbxMbServerCtx;
 
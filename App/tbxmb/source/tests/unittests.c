@@ -56,6 +56,32 @@ uint8_t mbServerCoils[2] = { TBX_OFF, TBX_OFF };
 /** \brief Modbus server holding registers. */
 uint16_t mbServerHoldingRegs[2] = { 0x789AU, 0xA51FU };
 
+/** \brief Modbus server records of file 1. */
+uint16_t mbServerFileRecords[2] = { 0x0123U, 0xC3D2U };
+
+/** \brief Number of times that the server read a record of a file. */
+uint32_t mbServerFileReadCnt = 0;
+
+/** \brief Number of times that an asynchronous client transfer signaled completion. */
+uint32_t mbClientAsyncDoneCnt = 0;
+
+/** \brief Result of the last completed asynchronous client transfer. */
+uint8_t mbClientAsyncDoneResult = TBX_ERROR;
+
+/** \brief Client channel that the server callback should start an asynchronous transfer
+ *         on, while it processes a request of a blocking client transfer.
+ */
+tTbxMbClient mbClientAsyncChannel = NULL;
+
+/** \brief Request PDU of the asynchronous transfer started by the server callback. */
+uint8_t mbClientAsyncRequest[1] = { 17U };
+
+/** \brief Response PDU of the asynchronous transfer started by the server callback. */
+uint8_t mbClientAsyncResponse[TBX_MB_TP_PDU_MAX_LEN];
+
+/** \brief PDU length of the asynchronous transfer started by the server callback. */
+uint8_t mbClientAsyncLen = 1U;
+
 /** \brief An invalid MicroTBX-Modbus context. The type is set to one that is not used
  *         by any of its internal contexts. 
  */
@@ -335,6 +361,91 @@ tTbxMbServerResult mbServer_WriteHoldingReg(tTbxMbServer channel, uint16_t addr,
 } /*** end of mbServer_WriteHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Reads a record of a file.
+** \details   Write the value of the record in your CPUs native endianess. The
+**            MicroTBX-Modbus stack will automatically convert this to the big endianess
+**            that the Modbus protocol requires.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Record number inside the file (0..9999).
+** \param     value Pointer to write the value of the record to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific file or record is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult mbServer_ReadFileRecord(tTbxMbServer channel, uint16_t file,
+                                           uint16_t record, uint16_t * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  TBX_UNUSED_ARG(channel);
+
+  /* Count the read accesses. */
+  mbServerFileReadCnt++;
+
+  /* Only file 1 with two records is supported. */
+  if ((file == 1U) && (record < 2U))
+  {
+    *value = mbServerFileRecords[record];
+  }
+  else
+  {
+    /* Unsupported file or record. */
+    result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of mbServer_ReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a record of a file.
+** \details   The value of the record is already in your CPUs native endianess.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     file File number (1..65535).
+** \param     record Record number inside the file (0..9999).
+** \param     value Value of the record.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            specific file or record is not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult mbServer_WriteFileRecord(tTbxMbServer channel, uint16_t file,
+                                            uint16_t record, uint16_t value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  TBX_UNUSED_ARG(channel);
+
+  /* Only file 1 with two records is supported. */
+  if ((file == 1U) && (record < 2U))
+  {
+    /* The first record supports < 1024 values. */
+    if ((record == 0U) && (value >= 1024U))
+    {
+      result = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+    }
+    else
+    {
+      mbServerFileRecords[record] = value;
+    }
+  }
+  else
+  {
+    /* Unsupported file or record. */
+    result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+  }
+
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of mbServer_WriteFileRecord ***/
+
+
 
 /************************************************************************************//**
 ** \brief     Custom function code implementation for function code 17 (Report ServerID).
@@ -382,6 +493,80 @@ uint8_t mbServer_ReportServerIdCallback(tTbxMbServer channel, uint8_t const * rx
 }  /*** end of mbServer_ReportServerIdCallback ***/ 
 
 
+/************************************************************************************//**
+** \brief     Completion callback of an asynchronous client transfer.
+** \param     doneArg Argument that was specified when starting the transfer.
+** \param     result TBX_OK if the transfer completed successfully, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+void mbClient_AsyncDone(void * doneArg, uint8_t result)
+{
+  TBX_UNUSED_ARG(doneArg);
+
+  /* Store the result and keep track of how often this function was called. */
+  mbClientAsyncDoneResult = result;
+  mbClientAsyncDoneCnt++;
+} /*** end of mbClient_AsyncDone ***/
+
+
+/************************************************************************************//**
+** \brief     Custom function code implementation for function code 17 (Report ServerID)
+**            that additionally starts an asynchronous client transfer on the channel
+**            stored in mbClientAsyncChannel. The server processes the request of a
+**            blocking client transfer at this point, so the asynchronous transfer must
+**            be deferred until the blocking one completed.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     rxPdu Pointer to a byte array for reading the received PDU.
+** \param     txPdu Pointer to a byte array for writing the response PDU.
+** \param     len Pointer to the received PDU length, including the function code. When
+**            preparing the response, you can write the length of the transmit PDU to
+**            len as well.
+** \return    TBX_TRUE if the callback function handled the received function code and
+**            prepared a response PDU. TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t mbServer_ReportServerIdAsyncCallback(tTbxMbServer channel, uint8_t const * rxPdu,
+                                             uint8_t * txPdu, uint8_t * len)
+{
+  /* Start the asynchronous transfer only once. */
+  if (mbClientAsyncChannel != NULL)
+  {
+    mbClientAsyncLen = 1U;
+    (void)TbxMbClientCustomFunctionAsync(mbClientAsyncChannel, 10U,
+                                         mbClientAsyncRequest, mbClientAsyncResponse,
+                                         &mbClientAsyncLen, mbClient_AsyncDone, NULL);
+    mbClientAsyncChannel = NULL;
+  }
+  /* Prepare the actual response. */
+  return mbServer_ReportServerIdCallback(channel, rxPdu, txPdu, len);
+}  /*** end of mbServer_ReportServerIdAsyncCallback ***/ 
+
+
+/************************************************************************************//**
+** \brief     Runs the Modbus stack, until the asynchronous client transfer signaled its
+**            completion, with an upper limit of about 2 seconds.
+**
+****************************************************************************************/
+void waitModbusAsyncDone(void)
+{
+  uint32_t doneCntStart = mbClientAsyncDoneCnt;
+  uint16_t lastTicks = TbxMbPortTimerCount();
+  uint16_t currentTicks;
+  uint32_t elapsedTicks = 0U;
+
+  while ((mbClientAsyncDoneCnt == doneCntStart) && (elapsedTicks < 40000U))
+  {
+    /* Run the Modbus stack. */
+    TbxMbEventTask();
+    /* Update the number of 50us ticks that elapsed since the start of the loop. */
+    currentTicks = TbxMbPortTimerCount();
+    elapsedTicks += (uint16_t)(currentTicks - lastTicks);
+    lastTicks = currentTicks;
+  }
+} /*** end of waitModbusAsyncDone ***/
+
+
 /************************************************************************************//**
 ** \brief     In the simulated environment with both a Modbus server and client, the 
 **            event task is not called continuously, but only when the client is waiting
@@ -476,6 +661,12 @@ void test_TbxMbGeneric_FunctionCodeMacrosShouldBePresent(void)
   #ifndef TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS
   TEST_FAIL();
   #endif
+  #ifndef TBX_MB_FC20_READ_FILE_RECORD
+  TEST_FAIL();
+  #endif
+  #ifndef TBX_MB_FC21_WRITE_FILE_RECORD
+  TEST_FAIL();
+  #endif
 } /*** end of test_TbxMbGeneric_FunctionCodeMacrosShouldBePresent ***/
 
 
@@ -539,6 +730,12 @@ void test_TbxMbGeneric_MiscellaneousMacrosShouldBePresent(void)
   #ifndef TBX_MB_FC_EXCEPTION_MASK
   TEST_FAIL();
   #endif
+  #ifndef TBX_MB_FILE_REF_TYPE
+  TEST_FAIL();
+  #endif
+  #ifndef TBX_MB_FILE_RECORD_NUM_MAX
+  TEST_FAIL();
+  #endif
 } /*** end of test_TbxMbGeneric_MiscellaneousMacrosShouldBePresent ***/
 
 
@@ -743,6 +940,37 @@ void test_TbxMbEventTask_CanCall(void)
 } /*** end of test_TbxMbEventTask_CanCall ***/
 
 
+/************************************************************************************//**
+** \brief     Tests that the event module reports pending work.
+**
+****************************************************************************************/
+void test_TbxMbEventIsIdle_ShouldReportPendingWork(void)
+{
+  tTbxMbTp tpRtu;
+
+  /* Process the events that other tests might have left behind. */
+  TbxMbEventTask();
+  /* Without any transport layers or channels created, there should be nothing to do. */
+  assertionCnt = 0;
+  TEST_ASSERT_EQUAL_UINT8(TBX_TRUE, TbxMbEventIsIdle());
+
+  /* Create a transport layer context. It posts an event to start its polling. */
+  tpRtu = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  TEST_ASSERT_EQUAL_UINT8(TBX_FALSE, TbxMbEventIsIdle());
+  /* Processing the event activates the poll function, so there is still work to do. */
+  TbxMbEventTask();
+  TEST_ASSERT_EQUAL_UINT8(TBX_FALSE, TbxMbEventIsIdle());
+
+  /* Free the transport layer. This purges its events and poll function. */
+  TbxMbRtuFree(tpRtu);
+  TEST_ASSERT_EQUAL_UINT8(TBX_TRUE, TbxMbEventIsIdle());
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+} /*** end of test_TbxMbEventIsIdle_ShouldReportPendingWork ***/
+
+
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion.
 **
@@ -1673,7 +1901,7 @@ void test_TbxMbServerSetCallbackWriteHoldingReg_CanSet(void)
 ** \brief     Tests that invalid parameters trigger an assertion.
 **
 ****************************************************************************************/
-void test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams(void)
+void test_TbxMbServerSetCallbackReadFileRecord_ShouldAssertOnInvalidParams(void)
 {
   tTbxMbTp     tpRtu;
   tTbxMbServer mbServer;
@@ -1690,7 +1918,7 @@ void test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams(void)
   /* Try NULL as a server context. */
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
-  TbxMbServerSetCallbackCustomFunction(NULL, mbServer_ReportServerIdCallback);
+  TbxMbServerSetCallbackReadFileRecord(NULL, mbServer_ReadFileRecord);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
@@ -1700,7 +1928,7 @@ void test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams(void)
   /* Try passing a dummy context with an invalid type as a server context. */
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
-  TbxMbServerSetCallbackCustomFunction(&invalidCtx, mbServer_ReportServerIdCallback);
+  TbxMbServerSetCallbackReadFileRecord(&invalidCtx, mbServer_ReadFileRecord);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
@@ -1710,7 +1938,7 @@ void test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams(void)
   /* Try NULL as the callback function pointer. */
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
-  TbxMbServerSetCallbackCustomFunction(mbServer, NULL);
+  TbxMbServerSetCallbackReadFileRecord(mbServer, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
@@ -1720,14 +1948,14 @@ void test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams(void)
   /* Free the server and transport protocol. */
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbServerSetCallbackReadFileRecord_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that the callback function can be set.
 **
 ****************************************************************************************/
-void test_TbxMbServerSetCallbackCustomFunction_CanSet(void)
+void test_TbxMbServerSetCallbackReadFileRecord_CanSet(void)
 {
   tTbxMbTp     tpRtu;
   tTbxMbServer mbServer;
@@ -1741,196 +1969,518 @@ void test_TbxMbServerSetCallbackCustomFunction_CanSet(void)
 
   /* Try setting the callback functioin. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackCustomFunction(mbServer, mbServer_ReportServerIdCallback);
+  TbxMbServerSetCallbackReadFileRecord(mbServer, mbServer_ReadFileRecord);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
   /* Free the server and transport protocol. */
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbServerSetCallbackCustomFunction_CanSet ***/
+} /*** end of test_TbxMbServerSetCallbackReadFileRecord_CanSet ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that invalid parameters trigger an assertion and returns NULL.
+** \brief     Tests that invalid parameters trigger an assertion.
 **
 ****************************************************************************************/
-void test_TbxMbClientCreate_ShouldAssertOnInvalidParams(void)
+void test_TbxMbServerSetCallbackWriteFileRecord_ShouldAssertOnInvalidParams(void)
 {
-  tTbxMbClient result;
+  tTbxMbTp     tpRtu;
+  tTbxMbServer mbServer;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
 
+  /* First create a transport protocol context and a server context. */
+  tpRtu = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  mbServer = TbxMbServerCreate(tpRtu);
+  TEST_ASSERT_NOT_NULL(tpRtu);
+
+  /* Try NULL as a server context. */
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
-  result = TbxMbClientCreate(NULL, 1000U, 1000U);
+  TbxMbServerSetCallbackWriteFileRecord(NULL, mbServer_WriteFileRecord);
   heapFreeAfter = TbxHeapGetFree();
-  /* Make sure an error was returned. */
-  TEST_ASSERT_EQUAL(NULL, result);
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
-} /*** end of test_TbxMbClientCreate_ShouldAssertOnInvalidParams ***/
-
-
-/************************************************************************************//**
-** \brief     Tests that trying to link an already used transport layer trigger an
-**            assertion and returns NULL.
-**
-****************************************************************************************/
-void test_TbxMbClientCreate_ShouldAssertOnUsedTp(void)
-{
-  tTbxMbTp     tpRtu;
-  tTbxMbClient mbClient1;
-  tTbxMbClient mbClient2;
-
-  /* Create the transport layer. */
-  assertionCnt = 0;
-  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
-                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
-  /* Make sure a valid context was returned. */
-  TEST_ASSERT_NOT_NULL(tpRtu);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Create first client that links the transport layer. */
+  /* Try passing a dummy context with an invalid type as a server context. */
   assertionCnt = 0;
-  mbClient1 = TbxMbClientCreate(tpRtu, 1000U, 1000U);
-  /* Make sure a valid context was returned. */
-  TEST_ASSERT_NOT_NULL(mbClient1);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  heapFreeBefore = TbxHeapGetFree();
+  TbxMbServerSetCallbackWriteFileRecord(&invalidCtx, mbServer_WriteFileRecord);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Create second client that tries the link the same transport layer. */
+  /* Try NULL as the callback function pointer. */
   assertionCnt = 0;
-  mbClient2 = TbxMbClientCreate(tpRtu, 1000U, 1000U);
-  /* Make sure an error was returned. */
-  TEST_ASSERT_EQUAL(NULL, mbClient2);
+  heapFreeBefore = TbxHeapGetFree();
+  TbxMbServerSetCallbackWriteFileRecord(mbServer, NULL);
+  heapFreeAfter = TbxHeapGetFree();
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Free the first server and transport layer. */
-  assertionCnt = 0;
-  TbxMbClientFree(mbClient1);
+  /* Free the server and transport protocol. */
+  TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientCreate_ShouldAssertOnUsedTp ***/
+} /*** end of test_TbxMbServerSetCallbackWriteFileRecord_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can be created.
+** \brief     Tests that the callback function can be set.
 **
 ****************************************************************************************/
-void test_TbxMbClientCreate_CanCreate(void)
+void test_TbxMbServerSetCallbackWriteFileRecord_CanSet(void)
 {
   tTbxMbTp     tpRtu;
-  tTbxMbClient mbClient;
+  tTbxMbServer mbServer;
 
-  assertionCnt = 0;
-  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+  /* First create a transport protocol context and a server context. */
+  tpRtu = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
                          TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
-  /* Make sure a valid context was returned. */
   TEST_ASSERT_NOT_NULL(tpRtu);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  mbServer = TbxMbServerCreate(tpRtu);
+  TEST_ASSERT_NOT_NULL(tpRtu);
 
+  /* Try setting the callback functioin. */
   assertionCnt = 0;
-  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
-  /* Make sure a valid context was returned. */
-  TEST_ASSERT_NOT_NULL(mbClient);
+  TbxMbServerSetCallbackWriteFileRecord(mbServer, mbServer_WriteFileRecord);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Free the client and transport layer. */
-  TbxMbClientFree(mbClient);
+  /* Free the server and transport protocol. */
+  TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientCreate_CanCreate ***/
+} /*** end of test_TbxMbServerSetCallbackWriteFileRecord_CanSet ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can be recreated, meaning that no new memory is
-**            allocated from the heap via a memory pool.
+** \brief     Tests that invalid parameters trigger an assertion.
 **
 ****************************************************************************************/
-void test_TbxMbClientCreate_CanRecreate(void)
+void test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams(void)
 {
   tTbxMbTp     tpRtu;
-  tTbxMbClient mbClient;
+  tTbxMbServer mbServer;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
 
-  assertionCnt = 0;
-  heapFreeBefore = TbxHeapGetFree();
-  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+  /* First create a transport protocol context and a server context. */
+  tpRtu = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
                          TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
-  /* Make sure a valid context was returned. */
   TEST_ASSERT_NOT_NULL(tpRtu);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
-
-  assertionCnt = 0;
-  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
-  /* Make sure a valid context was returned. */
-  TEST_ASSERT_NOT_NULL(mbClient);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  mbServer = TbxMbServerCreate(tpRtu);
+  TEST_ASSERT_NOT_NULL(tpRtu);
 
-  /* Free the client and transport layer. */
+  /* Try NULL as a server context. */
   assertionCnt = 0;
-  TbxMbClientFree(mbClient);
-  TbxMbRtuFree(tpRtu);
+  heapFreeBefore = TbxHeapGetFree();
+  TbxMbServerSetCallbackCustomFunction(NULL, mbServer_ReportServerIdCallback);
   heapFreeAfter = TbxHeapGetFree();
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
-} /*** end of test_TbxMbClientCreate_CanRecreate ***/
 
-
-/************************************************************************************//**
-** \brief     Tests that invalid parameters trigger an assertion.
-**
-****************************************************************************************/
-void test_TbxMbClientFree_ShouldAssertOnInvalidParams(void)
-{
-  size_t heapFreeBefore;
-  size_t heapFreeAfter;
-
-  /* Try NULL as a client context. */
+  /* Try passing a dummy context with an invalid type as a server context. */
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
-  TbxMbClientFree(NULL);
+  TbxMbServerSetCallbackCustomFunction(&invalidCtx, mbServer_ReportServerIdCallback);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try passing a dummy context with an invalid type as a server context. */
+  /* Try NULL as the callback function pointer. */
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
-  TbxMbClientFree(&invalidCtx);
+  TbxMbServerSetCallbackCustomFunction(mbServer, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
-} /*** end of test_TbxMbClientFree_ShouldAssertOnInvalidParams ***/
+
+  /* Free the server and transport protocol. */
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can be freed.
+** \brief     Tests that the callback function can be set.
 **
 ****************************************************************************************/
-void test_TbxMbClientFree_CanFree(void)
+void test_TbxMbServerSetCallbackCustomFunction_CanSet(void)
 {
   tTbxMbTp     tpRtu;
+  tTbxMbServer mbServer;
+
+  /* First create a transport protocol context and a server context. */
+  tpRtu = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  mbServer = TbxMbServerCreate(tpRtu);
+  TEST_ASSERT_NOT_NULL(tpRtu);
+
+  /* Try setting the callback functioin. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackCustomFunction(mbServer, mbServer_ReportServerIdCallback);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the server and transport protocol. */
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbServerSetCallbackCustomFunction_CanSet ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus server handles a read file record request with several
+**            sub-requests and responds with a sub-response for each of them.
+**
+****************************************************************************************/
+void test_TbxMbServerFC20ReadFileRecord_CanReadSubRequests(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      len;
+  /* Record 1, record 0 and then both records of file 1. */
+  uint8_t      request[23] = 
+  { 
+    TBX_MB_FC20_READ_FILE_RECORD, 21U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x01U, 0x00U, 0x01U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x01U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x02U
+  };
+  uint8_t      expected[16] =
+  {
+    TBX_MB_FC20_READ_FILE_RECORD, 14U,
+    3U, TBX_MB_FILE_REF_TYPE, 0xC3U, 0xD2U,
+    3U, TBX_MB_FILE_REF_TYPE, 0x01U, 0x23U,
+    5U, TBX_MB_FILE_REF_TYPE, 0x01U, 0x23U, 0xC3U, 0xD2U
+  };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadFileRecord(mbServer, mbServer_ReadFileRecord);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Transceive the request with the three sub-requests. */
+  assertionCnt = 0;
+  mbServerFileReadCnt = 0;
+  len = sizeof(request);
+  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, &len);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the response holds the three sub-responses. */
+  TEST_ASSERT_EQUAL_UINT8(sizeof(expected), len);
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, response, sizeof(expected));
+  /* Make sure each record was read once. */
+  TEST_ASSERT_EQUAL_UINT32(4, mbServerFileReadCnt);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbServerFC20ReadFileRecord_CanReadSubRequests ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus server responds with an exception to a read file record
+**            request with an invalid sub-request, without reading any of the records.
+**
+****************************************************************************************/
+void test_TbxMbServerFC20ReadFileRecord_ShouldRejectInvalidSubRequests(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      len;
+  /* A valid first sub-request and a second one with an invalid reference type. */
+  uint8_t      requestRefType[16] = 
+  { 
+    TBX_MB_FC20_READ_FILE_RECORD, 14U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x01U,
+    0x05U,                0x00U, 0x01U, 0x00U, 0x01U, 0x00U, 0x01U
+  };
+  /* A valid first sub-request and a truncated second one. */
+  uint8_t      requestTruncated[12] = 
+  { 
+    TBX_MB_FC20_READ_FILE_RECORD, 10U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x01U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U
+  };
+  /* Sub-requests of 61 and 60 records, a response of 246 bytes. */
+  uint8_t      requestTooLong[16] = 
+  { 
+    TBX_MB_FC20_READ_FILE_RECORD, 14U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 61U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 60U
+  };
+  /* One sub-request with 122 and one with 121 records, responses of 246 and 244 bytes. */
+  uint8_t      requestOne[9] = 
+  { 
+    TBX_MB_FC20_READ_FILE_RECORD, 7U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 122U
+  };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadFileRecord(mbServer, mbServer_ReadFileRecord);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Transceive the request with the invalid reference type in the second sub-request. */
+  assertionCnt = 0;
+  mbServerFileReadCnt = 0;
+  len = sizeof(requestRefType);
+  result = TbxMbClientCustomFunction(mbClient, 10U, requestRefType, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure an illegal data address exception was received. */
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_FC20_READ_FILE_RECORD | TBX_MB_FC_EXCEPTION_MASK, 
+                         response[0]);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC02_ILLEGAL_DATA_ADDRESS, response[1]);
+  /* Make sure not even the records of the first sub-request were read. */
+  TEST_ASSERT_EQUAL_UINT32(0, mbServerFileReadCnt);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Transceive the request with the truncated second sub-request. */
+  assertionCnt = 0;
+  mbServerFileReadCnt = 0;
+  len = sizeof(requestTruncated);
+  result = TbxMbClientCustomFunction(mbClient, 10U, requestTruncated, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure an illegal data value exception was received. */
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC03_ILLEGAL_DATA_VALUE, response[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, mbServerFileReadCnt);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Transceive it again, with a byte count that claims the full second sub-request. */
+  assertionCnt = 0;
+  requestTruncated[1] = 14U;
+  len = sizeof(requestTruncated);
+  result = TbxMbClientCustomFunction(mbClient, 10U, requestTruncated, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC03_ILLEGAL_DATA_VALUE, response[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, mbServerFileReadCnt);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Transceive the request whose sub-responses exceed the response length limit. */
+  assertionCnt = 0;
+  len = sizeof(requestTooLong);
+  result = TbxMbClientCustomFunction(mbClient, 10U, requestTooLong, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC03_ILLEGAL_DATA_VALUE, response[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, mbServerFileReadCnt);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Same with a single sub-request of 122 records. */
+  assertionCnt = 0;
+  len = sizeof(requestOne);
+  result = TbxMbClientCustomFunction(mbClient, 10U, requestOne, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC03_ILLEGAL_DATA_VALUE, response[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, mbServerFileReadCnt);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* 121 records fit. The server reads up to the third one, which it does not have. */
+  assertionCnt = 0;
+  requestOne[8] = 121U;
+  len = sizeof(requestOne);
+  result = TbxMbClientCustomFunction(mbClient, 10U, requestOne, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC02_ILLEGAL_DATA_ADDRESS, response[1]);
+  TEST_ASSERT_EQUAL_UINT32(3, mbServerFileReadCnt);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbServerFC20ReadFileRecord_ShouldRejectInvalidSubRequests ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus server responds with an exception to a write file
+**            record request with a truncated record block, without writing any record.
+**
+****************************************************************************************/
+void test_TbxMbServerFC21WriteFileRecord_ShouldRejectTruncatedRecordBlock(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
   tTbxMbClient mbClient;
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      len;
+  uint16_t     records[2];
+  /* A valid first sub-request and a second one with only 3 of its 4 value bytes. */
+  uint8_t      request[21] = 
+  { 
+    TBX_MB_FC21_WRITE_FILE_RECORD, 19U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x01U, 0x00U, 0x11U,
+    TBX_MB_FILE_REF_TYPE, 0x00U, 0x01U, 0x00U, 0x00U, 0x00U, 0x02U, 0x00U, 0x22U,
+    0x00U
+  };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackWriteFileRecord(mbServer, mbServer_WriteFileRecord);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Transceive the request with the truncated record block. */
+  assertionCnt = 0;
+  records[0] = mbServerFileRecords[0];
+  records[1] = mbServerFileRecords[1];
+  len = sizeof(request);
+  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, &len);
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure an illegal data value exception was received. */
+  TEST_ASSERT_EQUAL_UINT8(2U, len);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_FC21_WRITE_FILE_RECORD | TBX_MB_FC_EXCEPTION_MASK, 
+                         response[0]);
+  TEST_ASSERT_EQUAL_HEX8(TBX_MB_EC03_ILLEGAL_DATA_VALUE, response[1]);
+  /* Make sure not even the record of the first sub-request was written. */
+  TEST_ASSERT_EQUAL_UINT16(records[0], mbServerFileRecords[0]);
+  TEST_ASSERT_EQUAL_UINT16(records[1], mbServerFileRecords[1]);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbServerFC21WriteFileRecord_ShouldRejectTruncatedRecordBlock ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion and returns NULL.
+**
+****************************************************************************************/
+void test_TbxMbClientCreate_ShouldAssertOnInvalidParams(void)
+{
+  tTbxMbClient result;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
 
   assertionCnt = 0;
   heapFreeBefore = TbxHeapGetFree();
+  result = TbxMbClientCreate(NULL, 1000U, 1000U);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(NULL, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+} /*** end of test_TbxMbClientCreate_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that trying to link an already used transport layer trigger an
+**            assertion and returns NULL.
+**
+****************************************************************************************/
+void test_TbxMbClientCreate_ShouldAssertOnUsedTp(void)
+{
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient1;
+  tTbxMbClient mbClient2;
+
+  /* Create the transport layer. */
+  assertionCnt = 0;
   tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
                          TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
   /* Make sure a valid context was returned. */
@@ -1938,43 +2488,824 @@ void test_TbxMbClientFree_CanFree(void)
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
+  /* Create first client that links the transport layer. */
+  assertionCnt = 0;
+  mbClient1 = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient1);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create second client that tries the link the same transport layer. */
+  assertionCnt = 0;
+  mbClient2 = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(NULL, mbClient2);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Free the first server and transport layer. */
+  assertionCnt = 0;
+  TbxMbClientFree(mbClient1);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbClientCreate_ShouldAssertOnUsedTp ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client can be created.
+**
+****************************************************************************************/
+void test_TbxMbClientCreate_CanCreate(void)
+{
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient;
+
+  assertionCnt = 0;
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  assertionCnt = 0;
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the client and transport layer. */
+  TbxMbClientFree(mbClient);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbClientCreate_CanCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client can be recreated, meaning that no new memory is
+**            allocated from the heap via a memory pool.
+**
+****************************************************************************************/
+void test_TbxMbClientCreate_CanRecreate(void)
+{
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient;
+  size_t       heapFreeBefore;
+  size_t       heapFreeAfter;
+
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  assertionCnt = 0;
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the client and transport layer. */
+  assertionCnt = 0;
+  TbxMbClientFree(mbClient);
+  TbxMbRtuFree(tpRtu);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+} /*** end of test_TbxMbClientCreate_CanRecreate ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion.
+**
+****************************************************************************************/
+void test_TbxMbClientFree_ShouldAssertOnInvalidParams(void)
+{
+  size_t heapFreeBefore;
+  size_t heapFreeAfter;
+
+  /* Try NULL as a client context. */
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  TbxMbClientFree(NULL);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try passing a dummy context with an invalid type as a server context. */
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  TbxMbClientFree(&invalidCtx);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+} /*** end of test_TbxMbClientFree_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client can be freed.
+**
+****************************************************************************************/
+void test_TbxMbClientFree_CanFree(void)
+{
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient;
+  size_t       heapFreeBefore;
+  size_t       heapFreeAfter;
+
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  assertionCnt = 0;
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the client. */
+  assertionCnt = 0;
+  TbxMbClientFree(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the transport layer. */
+  assertionCnt = 0;
+  TbxMbRtuFree(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+} /*** end of test_TbxMbClientFree_CanFree ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
+**
+****************************************************************************************/
+void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient;
+  size_t       heapFreeBefore;
+  size_t       heapFreeAfter;
+  uint8_t      coils[2] = { TBX_OFF, TBX_OFF };
+
+  /* Create a transport layer. */
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a client channel. */
+  assertionCnt = 0;
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Try NULL as a client context. */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(NULL, 10U, 0U, 2U, coils);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 0 as number of coils to read. */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 0U, coils);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 2001 as number of coils to read. */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2001U, coils);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try NULL as the coils data pointer. */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, NULL);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Free the client and transport layer. */
+  TbxMbClientFree(mbClient);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client can read coils from a Modbus server.
+**
+****************************************************************************************/
+void test_TbxMbClientReadCoils_CanRead(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint8_t coils[2] = { TBX_ON, TBX_ON };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadCoil(mbServer, mbServer_ReadCoil);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Read the two coils supported by the server. */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, coils);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read coils were as expected. */
+  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[0]);
+  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[1]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbClientReadCoils_CanRead ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client cannot read coils that are not supported by the
+**            Modbus server.
+**
+****************************************************************************************/
+void test_TbxMbClientReadCoils_CannotReadUnsupported(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint8_t coils[3] = { TBX_OFF, TBX_OFF, TBX_OFF };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadCoil(mbServer, mbServer_ReadCoil);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Read the three coils, while knowing that the third one is not supported by the 
+   * server. 
+   */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 3U, coils);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Read coils that are not supported by Modbus server.  */
+  assertionCnt = 0;
+  result = TbxMbClientReadCoils(mbClient, 10U, 2U, 2U, coils);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbClientReadCoils_CannotReadUnsupported ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
+**
+****************************************************************************************/
+void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient;
+  size_t       heapFreeBefore;
+  size_t       heapFreeAfter;
+  uint8_t      inputs[2] = { TBX_OFF, TBX_OFF };
+
+  /* Create a transport layer. */
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a client channel. */
+  assertionCnt = 0;
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Try NULL as a client context. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(NULL, 10U, 10000U, 2U, inputs);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 0 as number of inputs to read. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 0U, inputs);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 2001 as number of inputs to read. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 2001U, inputs);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try NULL as the inputs data pointer. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 2U, NULL);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Free the client and transport layer. */
+  TbxMbClientFree(mbClient);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client can read inputs from a Modbus server.
+**
+****************************************************************************************/
+void test_TbxMbClientReadInputs_CanRead(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint8_t      inputs[2] = { TBX_OFF, TBX_ON };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadInput(mbServer, mbServer_ReadInput);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Read the two inputs supported by the server. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 2U, inputs);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read inputs were as expected. */
+  TEST_ASSERT_EQUAL_UINT8(TBX_ON, inputs[0]);
+  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, inputs[1]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbClientReadInputs_CanRead ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client cannot read inputs that are not supported by the
+**            Modbus server.
+**
+****************************************************************************************/
+void test_TbxMbClientReadInputs_CannotReadUnsupported(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint8_t inputs[3] = { TBX_OFF, TBX_OFF, TBX_OFF };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadInput(mbServer, mbServer_ReadInput);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Read the three inputs, while knowing that the third one is not supported by the 
+   * server. 
+   */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 3U, inputs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Read inputs that are not supported by Modbus server.  */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 10002U, 2U, inputs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Read inputs that are not supported by Modbus server.  */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputs(mbClient, 10U, 9998U, 2U, inputs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbClientReadInputs_CannotReadUnsupported ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
+**
+****************************************************************************************/
+void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtu;
+  tTbxMbClient mbClient;
+  size_t       heapFreeBefore;
+  size_t       heapFreeAfter;
+  uint16_t     inputRegs[2] = { 0U, 0U };
+
+  /* Create a transport layer. */
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a client channel. */
+  assertionCnt = 0;
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  /* Make sure a valid context was returned. */
+  TEST_ASSERT_NOT_NULL(mbClient);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Try NULL as a client context. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputRegs(NULL, 10U, 30000U, 2U, inputRegs);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 0 as number of input registers to read. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 0U, inputRegs);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 126 as number of input registers to read. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 126U, inputRegs);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try NULL as the input registers' data pointer. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 2U, NULL);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Free the client and transport layer. */
+  TbxMbClientFree(mbClient);
+  TbxMbRtuFree(tpRtu);
+} /*** end of test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client can read input registers from a Modbus server.
+**
+****************************************************************************************/
+void test_TbxMbClientReadInputRegs_CanRead(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint16_t     inputRegs[2] = { 0U, 0U };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadInputReg(mbServer, mbServer_ReadInputReg);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Read the two input registers supported by the server. */
+  assertionCnt = 0;
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 2U, inputRegs);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read inputs were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0x1234U, inputRegs[0]);
+  TEST_ASSERT_EQUAL_UINT16(0x5678U, inputRegs[1]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbClientReadInputRegs_CanRead ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that a Modbus client cannot read input registers that are not
+**            supported by the Modbus server.
+**
+****************************************************************************************/
+void test_TbxMbClientReadInputRegs_CannotReadUnsupported(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtuClient;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  uint16_t     inputRegs[3] = { 0U, 0U, 0U };
+
+  /* Create a Modbus RTU server on serial port 1. */
+  assertionCnt = 0;
+  tpRtuServer = TbxMbRtuCreate(10, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtuClient = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtuClient, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtuClient);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Set the callback for the server. */
+  assertionCnt = 0;
+  TbxMbServerSetCallbackReadInputReg(mbServer, mbServer_ReadInputReg);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Read the three input registers, while knowing that the third one is not supported
+   * by the server. 
+   */
   assertionCnt = 0;
-  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
-  /* Make sure a valid context was returned. */
-  TEST_ASSERT_NOT_NULL(mbClient);
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 3U, inputRegs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Free the client. */
+  /* Read input registers that are not supported by Modbus server.  */
   assertionCnt = 0;
-  TbxMbClientFree(mbClient);
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 30002U, 2U, inputRegs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Free the transport layer. */
+  /* Read input registers that are not supported by Modbus server.  */
   assertionCnt = 0;
-  TbxMbRtuFree(tpRtu);
+  result = TbxMbClientReadInputRegs(mbClient, 10U, 29998U, 2U, inputRegs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  heapFreeAfter = TbxHeapGetFree();
-  /* Make sure no heap memory was allocated. */
-  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
-} /*** end of test_TbxMbClientFree_CanFree ***/
+  /* Free the channels and transport layers. */
+  TbxMbClientFree(mbClient);
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtuClient);
+  TbxMbRtuFree(tpRtuServer);
+} /*** end of test_TbxMbClientReadInputRegs_CannotReadUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
   tTbxMbClient mbClient;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
-  uint8_t      coils[2] = { TBX_OFF, TBX_OFF };
+  uint16_t     holdingRegs[2] = { 0U, 0U };
 
   /* Create a transport layer. */
   assertionCnt = 0;
@@ -1996,7 +3327,7 @@ void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(NULL, 10U, 0U, 2U, coils);
+  result = TbxMbClientReadHoldingRegs(NULL, 10U, 40000U, 2U, holdingRegs);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2005,9 +3336,9 @@ void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 0 as number of coils to read. */
+  /* Try 0 as number of holding registers to read. */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 0U, coils);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 0U, holdingRegs);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2016,9 +3347,9 @@ void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 2001 as number of coils to read. */
+  /* Try 126 as number of holding registers to read. */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2001U, coils);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 126U, holdingRegs);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2027,9 +3358,9 @@ void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try NULL as the coils data pointer. */
+  /* Try NULL as the holding registers' data pointer. */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, NULL);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2041,21 +3372,21 @@ void test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams(void)
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientReadCoils_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can read coils from a Modbus server.
+** \brief     Tests that a Modbus client can read holding registers from a Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadCoils_CanRead(void)
+void test_TbxMbClientReadHoldingRegs_CanRead(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint8_t coils[2] = { TBX_ON, TBX_ON };
+  uint16_t     holdingRegs[2] = { 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2077,21 +3408,21 @@ void test_TbxMbClientReadCoils_CanRead(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadCoil(mbServer, mbServer_ReadCoil);
+  TbxMbServerSetCallbackReadHoldingReg(mbServer, mbServer_ReadHoldingReg);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the two coils supported by the server. */
+  /* Read the two holding registers supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, coils);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read coils were as expected. */
-  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[0]);
-  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[1]);
+  /* Make sure the read inputs were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0x789AU, holdingRegs[0]);
+  TEST_ASSERT_EQUAL_UINT16(0xA51FU, holdingRegs[1]);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -2100,22 +3431,22 @@ void test_TbxMbClientReadCoils_CanRead(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadCoils_CanRead ***/
+} /*** end of test_TbxMbClientReadHoldingRegs_CanRead ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client cannot read coils that are not supported by the
-**            Modbus server.
+** \brief     Tests that a Modbus client cannot read holding registers that are not
+**            supported by the Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadCoils_CannotReadUnsupported(void)
+void test_TbxMbClientReadHoldingRegs_CannotReadUnsupported(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint8_t coils[3] = { TBX_OFF, TBX_OFF, TBX_OFF };
+  uint16_t     holdingRegs[3] = { 0U, 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2137,26 +3468,34 @@ void test_TbxMbClientReadCoils_CannotReadUnsupported(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadCoil(mbServer, mbServer_ReadCoil);
+  TbxMbServerSetCallbackReadHoldingReg(mbServer, mbServer_ReadHoldingReg);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the three coils, while knowing that the third one is not supported by the 
-   * server. 
+  /* Read the three holding registers, while knowing that the third one is not supported
+   * by the server. 
    */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 3U, coils);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 3U, holdingRegs);
   /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Read coils that are not supported by Modbus server.  */
+  /* Read holding registers that are not supported by Modbus server.  */
   assertionCnt = 0;
-  result = TbxMbClientReadCoils(mbClient, 10U, 2U, 2U, coils);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40002U, 2U, holdingRegs);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Read holding registers that are not supported by Modbus server.  */
+  assertionCnt = 0;
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 39998U, 2U, holdingRegs);
   /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
@@ -2167,21 +3506,21 @@ void test_TbxMbClientReadCoils_CannotReadUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadCoils_CannotReadUnsupported ***/
+} /*** end of test_TbxMbClientReadHoldingRegs_CannotReadUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
   tTbxMbClient mbClient;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
-  uint8_t      inputs[2] = { TBX_OFF, TBX_OFF };
+  uint8_t      coils[2] = { TBX_OFF, TBX_OFF };
 
   /* Create a transport layer. */
   assertionCnt = 0;
@@ -2203,7 +3542,7 @@ void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(NULL, 10U, 10000U, 2U, inputs);
+  result = TbxMbClientWriteCoils(NULL, 10U, 0U, 2U, coils);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2212,9 +3551,9 @@ void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 0 as number of inputs to read. */
+  /* Try 0 as number of coils to write. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 0U, inputs);
+  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 0U, coils);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2223,9 +3562,9 @@ void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 2001 as number of inputs to read. */
+  /* Try 1969 as number of coils to write. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 2001U, inputs);
+  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 1969U, coils);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2234,9 +3573,9 @@ void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try NULL as the inputs data pointer. */
+  /* Try NULL as the coils data pointer. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 2U, NULL);
+  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 2U, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2248,21 +3587,21 @@ void test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams(void)
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientReadInputs_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can read inputs from a Modbus server.
+** \brief     Tests that a Modbus client can write coils to a Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadInputs_CanRead(void)
+void test_TbxMbClientWriteCoils_CanWrite(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint8_t      inputs[2] = { TBX_OFF, TBX_ON };
+  uint8_t      coils[2] = { TBX_OFF, TBX_OFF };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2284,21 +3623,43 @@ void test_TbxMbClientReadInputs_CanRead(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadInput(mbServer, mbServer_ReadInput);
+  TbxMbServerSetCallbackWriteCoil(mbServer, mbServer_WriteCoil);
+  TbxMbServerSetCallbackReadCoil(mbServer, mbServer_ReadCoil);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
-
+ 
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the two inputs supported by the server. */
+  /* Write the two coils supported by the server to ON and OFF. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 2U, inputs);
+  coils[0] = TBX_ON;
+  coils[1] = TBX_OFF;
+  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 2U, coils);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read inputs were as expected. */
-  TEST_ASSERT_EQUAL_UINT8(TBX_ON, inputs[0]);
-  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, inputs[1]);
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, coils);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read coils were as expected. */
+  TEST_ASSERT_EQUAL_UINT8(TBX_ON, coils[0]);
+  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[1]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Write the two coils supported by the server to OFF and ON. */
+  assertionCnt = 0;
+  coils[0] = TBX_OFF;
+  coils[1] = TBX_ON;
+  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 2U, coils);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, coils);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read coils were as expected. */
+  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[0]);
+  TEST_ASSERT_EQUAL_UINT8(TBX_ON, coils[1]);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -2307,22 +3668,22 @@ void test_TbxMbClientReadInputs_CanRead(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadInputs_CanRead ***/
+} /*** end of test_TbxMbClientWriteCoils_CanWrite ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client cannot read inputs that are not supported by the
+** \brief     Tests that a Modbus client cannot write coils that are not supported by the
 **            Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadInputs_CannotReadUnsupported(void)
+void test_TbxMbClientWriteCoils_CannotWriteUnsupported(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint8_t inputs[3] = { TBX_OFF, TBX_OFF, TBX_OFF };
+  uint8_t      coils[3] = { TBX_OFF, TBX_OFF, TBX_OFF };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2344,35 +3705,27 @@ void test_TbxMbClientReadInputs_CannotReadUnsupported(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadInput(mbServer, mbServer_ReadInput);
+  TbxMbServerSetCallbackWriteCoil(mbServer, mbServer_WriteCoil);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the three inputs, while knowing that the third one is not supported by the 
-   * server. 
+  /* Write the three coils, while knowing that the third one is not supported by the 
+   * server.
    */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 10000U, 3U, inputs);
-  /* Make sure the client operation reported an error. */
-  TEST_ASSERT_EQUAL(TBX_ERROR, result);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
-
-  /* Read inputs that are not supported by Modbus server.  */
-  assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 10002U, 2U, inputs);
-  /* Make sure the client operation reported an error. */
+  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 3U, coils);
+  /* Make sure the client operation repored an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Read inputs that are not supported by Modbus server.  */
+  /* Write the coils that are not supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputs(mbClient, 10U, 9998U, 2U, inputs);
-  /* Make sure the client operation reported an error. */
+  result = TbxMbClientWriteCoils(mbClient, 10U, 2U, 2U, coils);
+  /* Make sure the client operation repored an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
@@ -2382,21 +3735,21 @@ void test_TbxMbClientReadInputs_CannotReadUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadInputs_CannotReadUnsupported ***/
+} /*** end of test_TbxMbClientWriteCoils_CannotWriteUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
   tTbxMbClient mbClient;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
-  uint16_t     inputRegs[2] = { 0U, 0U };
+  uint16_t     holdingRegs[2] = { 0U, 0U };
 
   /* Create a transport layer. */
   assertionCnt = 0;
@@ -2418,7 +3771,7 @@ void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(NULL, 10U, 30000U, 2U, inputRegs);
+  result = TbxMbClientWriteHoldingRegs(NULL, 10U, 40000U, 2U, holdingRegs);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2427,9 +3780,9 @@ void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 0 as number of input registers to read. */
+  /* Try 0 as number of holding registers to write. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 0U, inputRegs);
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 0U, holdingRegs);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2438,9 +3791,9 @@ void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 126 as number of input registers to read. */
+  /* Try 124 as number of holding registers to write. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 126U, inputRegs);
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 124U, holdingRegs);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2449,9 +3802,9 @@ void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try NULL as the input registers' data pointer. */
+  /* Try NULL as the holding registers data pointer. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 2U, NULL);
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 2U, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2463,21 +3816,21 @@ void test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams(void)
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientReadInputRegs_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can read input registers from a Modbus server.
+** \brief     Tests that a Modbus client can write holding registers to a Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadInputRegs_CanRead(void)
+void test_TbxMbClientWriteHoldingRegs_CanWrite(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     inputRegs[2] = { 0U, 0U };
+  uint16_t     holdingRegs[2] = { 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2499,21 +3852,43 @@ void test_TbxMbClientReadInputRegs_CanRead(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadInputReg(mbServer, mbServer_ReadInputReg);
+  TbxMbServerSetCallbackWriteHoldingReg(mbServer, mbServer_WriteHoldingReg);
+  TbxMbServerSetCallbackReadHoldingReg(mbServer, mbServer_ReadHoldingReg);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the two input registers supported by the server. */
+  /* Write the two holding registers supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 2U, inputRegs);
+  holdingRegs[0] = 1023;
+  holdingRegs[1] = 0xA5F1;
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read holding registers were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(1023, holdingRegs[0]);
+  TEST_ASSERT_EQUAL_UINT16(0xA5F1, holdingRegs[1]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Write the two holding registers supported by the server to zero values. */
+  assertionCnt = 0;
+  holdingRegs[0] = 0x0000;
+  holdingRegs[1] = 0x0000;
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read inputs were as expected. */
-  TEST_ASSERT_EQUAL_UINT16(0x1234U, inputRegs[0]);
-  TEST_ASSERT_EQUAL_UINT16(0x5678U, inputRegs[1]);
+  /* Make sure the read holding registers were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0x0000, holdingRegs[0]);
+  TEST_ASSERT_EQUAL_UINT16(0x0000, holdingRegs[1]);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -2522,22 +3897,22 @@ void test_TbxMbClientReadInputRegs_CanRead(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadInputRegs_CanRead ***/
+} /*** end of test_TbxMbClientWriteHoldingRegs_CanWrite ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client cannot read input registers that are not
+** \brief     Tests that a Modbus client cannot write holding registers that are not
 **            supported by the Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadInputRegs_CannotReadUnsupported(void)
+void test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     inputRegs[3] = { 0U, 0U, 0U };
+  uint16_t     holdingRegs[3] = { 0U, 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2559,35 +3934,46 @@ void test_TbxMbClientReadInputRegs_CannotReadUnsupported(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadInputReg(mbServer, mbServer_ReadInputReg);
+  TbxMbServerSetCallbackWriteHoldingReg(mbServer, mbServer_WriteHoldingReg);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the three input registers, while knowing that the third one is not supported
-   * by the server. 
+  /* Write the three holding registers, while knowing that the third one is not supported
+   * by the server.
    */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 30000U, 3U, inputRegs);
-  /* Make sure the client operation reported an error. */
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 3U, holdingRegs);
+  /* Make sure the client operation repored an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Read input registers that are not supported by Modbus server.  */
+  /* Write the holding registers that are not supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 30002U, 2U, inputRegs);
-  /* Make sure the client operation reported an error. */
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40002U, 2U, holdingRegs);
+  /* Make sure the client operation repored an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Read input registers that are not supported by Modbus server.  */
+  /* Write the holding registers that are not supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadInputRegs(mbClient, 10U, 29998U, 2U, inputRegs);
-  /* Make sure the client operation reported an error. */
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 39998U, 2U, holdingRegs);
+  /* Make sure the client operation repored an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Write a value to the first holding register that is outside of the range supported
+   * by the server. 
+   */
+  assertionCnt = 0;
+  holdingRegs[0] = 1024;
+  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 1U, holdingRegs);
+  /* Make sure the client operation repored an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
@@ -2597,21 +3983,21 @@ void test_TbxMbClientReadInputRegs_CannotReadUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadInputRegs_CannotReadUnsupported ***/
+} /*** end of test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientReadFileRecord_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
   tTbxMbClient mbClient;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
-  uint16_t     holdingRegs[2] = { 0U, 0U };
+  uint16_t     records[2] = { 0U, 0U };
 
   /* Create a transport layer. */
   assertionCnt = 0;
@@ -2633,7 +4019,7 @@ void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(NULL, 10U, 40000U, 2U, holdingRegs);
+  result = TbxMbClientReadFileRecord(NULL, 10U, 1U, 0U, 2U, records);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2642,9 +4028,9 @@ void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 0 as number of holding registers to read. */
+  /* Try 0 as the file number. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 0U, holdingRegs);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 0U, 0U, 2U, records);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2653,9 +4039,9 @@ void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 126 as number of holding registers to read. */
+  /* Try 0 as number of records to read. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 126U, holdingRegs);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 0U, records);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2664,9 +4050,42 @@ void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try NULL as the holding registers' data pointer. */
+  /* Try 125 as number of records to read. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, NULL);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 125U, records);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try 122 as number of records to read, its response would not fit. */
+  assertionCnt = 0;
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 122U, records);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try records past the highest record number. */
+  assertionCnt = 0;
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 9999U, 2U, records);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try NULL as the records data pointer. */
+  assertionCnt = 0;
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 2U, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2678,21 +4097,21 @@ void test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientReadHoldingRegs_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientReadFileRecord_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can read holding registers from a Modbus server.
+** \brief     Tests that a Modbus client can read records of a file from a Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadHoldingRegs_CanRead(void)
+void test_TbxMbClientReadFileRecord_CanRead(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     holdingRegs[2] = { 0U, 0U };
+  uint16_t     records[2] = { 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2714,21 +4133,32 @@ void test_TbxMbClientReadHoldingRegs_CanRead(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadHoldingReg(mbServer, mbServer_ReadHoldingReg);
+  TbxMbServerSetCallbackReadFileRecord(mbServer, mbServer_ReadFileRecord);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the two holding registers supported by the server. */
+  /* Read the two records of the file supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 2U, records);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read inputs were as expected. */
-  TEST_ASSERT_EQUAL_UINT16(0x789AU, holdingRegs[0]);
-  TEST_ASSERT_EQUAL_UINT16(0xA51FU, holdingRegs[1]);
+  /* Make sure the read records were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0x0123U, records[0]);
+  TEST_ASSERT_EQUAL_UINT16(0xC3D2U, records[1]);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Read just the second record of the file. */
+  assertionCnt = 0;
+  records[0] = 0U;
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 1U, 1U, records);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the read record was as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0xC3D2U, records[0]);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -2737,22 +4167,22 @@ void test_TbxMbClientReadHoldingRegs_CanRead(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadHoldingRegs_CanRead ***/
+} /*** end of test_TbxMbClientReadFileRecord_CanRead ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client cannot read holding registers that are not
+** \brief     Tests that a Modbus client cannot read records of a file that are not
 **            supported by the Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientReadHoldingRegs_CannotReadUnsupported(void)
+void test_TbxMbClientReadFileRecord_CannotReadUnsupported(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     holdingRegs[3] = { 0U, 0U, 0U };
+  uint16_t     records[3] = { 0U, 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2774,34 +4204,34 @@ void test_TbxMbClientReadHoldingRegs_CannotReadUnsupported(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackReadHoldingReg(mbServer, mbServer_ReadHoldingReg);
+  TbxMbServerSetCallbackReadFileRecord(mbServer, mbServer_ReadFileRecord);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Read the three holding registers, while knowing that the third one is not supported
-   * by the server. 
+  /* Read three records, while knowing that the third one is not supported by the
+   * server.
    */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 3U, holdingRegs);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 3U, records);
   /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Read holding registers that are not supported by Modbus server.  */
+  /* Read records of a file that is not supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40002U, 2U, holdingRegs);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 2U, 0U, 2U, records);
   /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Read holding registers that are not supported by Modbus server.  */
+  /* Read records that are not supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 39998U, 2U, holdingRegs);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 2U, 2U, records);
   /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
@@ -2812,21 +4242,21 @@ void test_TbxMbClientReadHoldingRegs_CannotReadUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientReadHoldingRegs_CannotReadUnsupported ***/
+} /*** end of test_TbxMbClientReadFileRecord_CannotReadUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientWriteFileRecord_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
   tTbxMbClient mbClient;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
-  uint8_t      coils[2] = { TBX_OFF, TBX_OFF };
+  uint16_t     records[2] = { 0U, 0U };
 
   /* Create a transport layer. */
   assertionCnt = 0;
@@ -2848,7 +4278,7 @@ void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientWriteCoils(NULL, 10U, 0U, 2U, coils);
+  result = TbxMbClientWriteFileRecord(NULL, 10U, 1U, 0U, 2U, records);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2857,9 +4287,9 @@ void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 0 as number of coils to write. */
+  /* Try 0 as the file number. */
   assertionCnt = 0;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 0U, coils);
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 0U, 0U, 2U, records);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2868,9 +4298,9 @@ void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 1969 as number of coils to write. */
+  /* Try 0 as number of records to write. */
   assertionCnt = 0;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 1969U, coils);
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 0U, records);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2879,9 +4309,31 @@ void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try NULL as the coils data pointer. */
+  /* Try 123 as number of records to write. */
   assertionCnt = 0;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 2U, NULL);
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 123U, records);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try records past the highest record number. */
+  assertionCnt = 0;
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 9999U, 2U, records);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try NULL as the records data pointer. */
+  assertionCnt = 0;
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 2U, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -2893,21 +4345,21 @@ void test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams(void)
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientWriteCoils_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientWriteFileRecord_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can write coils to a Modbus server.
+** \brief     Tests that a Modbus client can write records of a file to a Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientWriteCoils_CanWrite(void)
+void test_TbxMbClientWriteFileRecord_CanWrite(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint8_t      coils[2] = { TBX_OFF, TBX_OFF };
+  uint16_t     records[2] = { 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -2929,43 +4381,43 @@ void test_TbxMbClientWriteCoils_CanWrite(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackWriteCoil(mbServer, mbServer_WriteCoil);
-  TbxMbServerSetCallbackReadCoil(mbServer, mbServer_ReadCoil);
+  TbxMbServerSetCallbackWriteFileRecord(mbServer, mbServer_WriteFileRecord);
+  TbxMbServerSetCallbackReadFileRecord(mbServer, mbServer_ReadFileRecord);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Write the two coils supported by the server to ON and OFF. */
+  /* Write the two records of the file supported by the server. */
   assertionCnt = 0;
-  coils[0] = TBX_ON;
-  coils[1] = TBX_OFF;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 2U, coils);
+  records[0] = 1023;
+  records[1] = 0xA5F1;
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 2U, records);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, coils);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 2U, records);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read coils were as expected. */
-  TEST_ASSERT_EQUAL_UINT8(TBX_ON, coils[0]);
-  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[1]);
+  /* Make sure the read records were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(1023, records[0]);
+  TEST_ASSERT_EQUAL_UINT16(0xA5F1, records[1]);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Write the two coils supported by the server to OFF and ON. */
+  /* Write the two records of the file to their original values. */
   assertionCnt = 0;
-  coils[0] = TBX_OFF;
-  coils[1] = TBX_ON;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 2U, coils);
+  records[0] = 0x0123U;
+  records[1] = 0xC3D2U;
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 2U, records);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  result = TbxMbClientReadCoils(mbClient, 10U, 0U, 2U, coils);
+  result = TbxMbClientReadFileRecord(mbClient, 10U, 1U, 0U, 2U, records);
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read coils were as expected. */
-  TEST_ASSERT_EQUAL_UINT8(TBX_OFF, coils[0]);
-  TEST_ASSERT_EQUAL_UINT8(TBX_ON, coils[1]);
+  /* Make sure the read records were as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0x0123U, records[0]);
+  TEST_ASSERT_EQUAL_UINT16(0xC3D2U, records[1]);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -2974,22 +4426,22 @@ void test_TbxMbClientWriteCoils_CanWrite(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientWriteCoils_CanWrite ***/
+} /*** end of test_TbxMbClientWriteFileRecord_CanWrite ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client cannot write coils that are not supported by the
-**            Modbus server.
+** \brief     Tests that a Modbus client cannot write records of a file that are not
+**            supported by the Modbus server.
 **
 ****************************************************************************************/
-void test_TbxMbClientWriteCoils_CannotWriteUnsupported(void)
+void test_TbxMbClientWriteFileRecord_CannotWriteUnsupported(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint8_t      coils[3] = { TBX_OFF, TBX_OFF, TBX_OFF };
+  uint16_t     records[3] = { 0U, 0U, 0U };
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -3011,27 +4463,46 @@ void test_TbxMbClientWriteCoils_CannotWriteUnsupported(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackWriteCoil(mbServer, mbServer_WriteCoil);
+  TbxMbServerSetCallbackWriteFileRecord(mbServer, mbServer_WriteFileRecord);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Write the three coils, while knowing that the third one is not supported by the 
+  /* Write three records, while knowing that the third one is not supported by the
    * server.
    */
   assertionCnt = 0;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 0U, 3U, coils);
-  /* Make sure the client operation repored an error. */
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 3U, records);
+  /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Write the coils that are not supported by the server. */
+  /* Write records of a file that is not supported by the server. */
   assertionCnt = 0;
-  result = TbxMbClientWriteCoils(mbClient, 10U, 2U, 2U, coils);
-  /* Make sure the client operation repored an error. */
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 2U, 0U, 2U, records);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Write records that are not supported by the server. */
+  assertionCnt = 0;
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 2U, 2U, records);
+  /* Make sure the client operation reported an error. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Write a value to the first record that is outside of the range supported by the
+   * server.
+   */
+  assertionCnt = 0;
+  records[0] = 1024;
+  result = TbxMbClientWriteFileRecord(mbClient, 10U, 1U, 0U, 1U, records);
+  /* Make sure the client operation reported an error. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
@@ -3041,21 +4512,23 @@ void test_TbxMbClientWriteCoils_CannotWriteUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientWriteCoils_CannotWriteUnsupported ***/
+} /*** end of test_TbxMbClientWriteFileRecord_CannotWriteUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
   tTbxMbClient mbClient;
   size_t       heapFreeBefore;
   size_t       heapFreeAfter;
-  uint16_t     holdingRegs[2] = { 0U, 0U };
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      request[1] = { 17U };
+  uint8_t      len = 1U;  
 
   /* Create a transport layer. */
   assertionCnt = 0;
@@ -3077,7 +4550,7 @@ void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(NULL, 10U, 40000U, 2U, holdingRegs);
+  result = TbxMbClientCustomFunction(NULL, 10U, request, response, &len);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -3086,9 +4559,9 @@ void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 0 as number of holding registers to write. */
+  /* Try NULL as the transmit PDU packet data. */
   assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 0U, holdingRegs);
+  result = TbxMbClientCustomFunction(mbClient, 10U, NULL, response, &len);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -3097,9 +4570,9 @@ void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try 124 as number of holding registers to write. */
+  /* Try NULL as the reception PDU packet data. */
   assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 124U, holdingRegs);
+  result = TbxMbClientCustomFunction(mbClient, 10U, request, NULL, &len);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -3108,9 +4581,9 @@ void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
-  /* Try NULL as the holding registers data pointer. */
+  /* Try NULL as the packet length. */
   assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 2U, NULL);
+  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -3122,21 +4595,26 @@ void test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams(void)
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can write holding registers to a Modbus server.
+** \brief     Tests that a Modbus client can use a custom function to extend the
+**            default supported function codes with the one for "Report Server ID" and
+**            can execute it to obtain the server's ID.
 **
 ****************************************************************************************/
-void test_TbxMbClientWriteHoldingRegs_CanWrite(void)
+void test_TbxMbClientCustomFunction_CanExecute(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     holdingRegs[2] = { 0U, 0U };
+  uint16_t     serverId = 0U;
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      request[1] = { 17U };
+  uint8_t      len = 1U;  
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -3158,43 +4636,35 @@ void test_TbxMbClientWriteHoldingRegs_CanWrite(void)
 
   /* Set the callback for the server. */
   assertionCnt = 0;
-  TbxMbServerSetCallbackWriteHoldingReg(mbServer, mbServer_WriteHoldingReg);
-  TbxMbServerSetCallbackReadHoldingReg(mbServer, mbServer_ReadHoldingReg);
+  TbxMbServerSetCallbackCustomFunction(mbServer, mbServer_ReportServerIdCallback);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Write the two holding registers supported by the server. */
-  assertionCnt = 0;
-  holdingRegs[0] = 1023;
-  holdingRegs[1] = 0xA5F1;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
-  /* Make sure the client operation was successful. */
-  TEST_ASSERT_EQUAL(TBX_OK, result);
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
-  /* Make sure the client operation was successful. */
-  TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read holding registers were as expected. */
-  TEST_ASSERT_EQUAL_UINT16(1023, holdingRegs[0]);
-  TEST_ASSERT_EQUAL_UINT16(0xA5F1, holdingRegs[1]);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
-
-  /* Write the two holding registers supported by the server to zero values. */
-  assertionCnt = 0;
-  holdingRegs[0] = 0x0000;
-  holdingRegs[1] = 0x0000;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
-  /* Make sure the client operation was successful. */
-  TEST_ASSERT_EQUAL(TBX_OK, result);
-  result = TbxMbClientReadHoldingRegs(mbClient, 10U, 40000U, 2U, holdingRegs);
+  /* Send the Report Server ID function code packet. */
+  assertionCnt = 0;
+
+  /* Transceive function code 17 - Report Server ID. */
+  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, &len);
+  if (result == TBX_OK)
+  {
+    /* Response length as expected? */
+    if (len == 5U)
+    {
+      /* Not an exception response and byte count correct? */
+      if ((response[0] == 17U) && (response[1] == 3U))
+      {
+        /* Read out the received server ID. */
+        serverId = TbxMbCommonExtractUInt16BE(&response[2]);
+      }
+    }
+  }
   /* Make sure the client operation was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read holding registers were as expected. */
-  TEST_ASSERT_EQUAL_UINT16(0x0000, holdingRegs[0]);
-  TEST_ASSERT_EQUAL_UINT16(0x0000, holdingRegs[1]);
+  /* Make sure the read server ID was as expected. */
+  TEST_ASSERT_EQUAL_UINT16(0x1234U, serverId);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -3203,22 +4673,26 @@ void test_TbxMbClientWriteHoldingRegs_CanWrite(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientWriteHoldingRegs_CanWrite ***/
+} /*** end of test_TbxMbClientCustomFunction_CanExecute ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client cannot write holding registers that are not
-**            supported by the Modbus server.
+** \brief     Tests that a Modbus client can use a custom function to extend the
+**            default supported function codes with the one for "Report Server ID", yet
+**            cannot execute it to obtain the server's ID, from a server that does not
+**            support this function code.
 **
 ****************************************************************************************/
-void test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported(void)
+void test_TbxMbClientCustomFunction_CannotExecuteUnsupported(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     holdingRegs[3] = { 0U, 0U, 0U };
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      request[1] = { 17U };
+  uint8_t      len = 1U;  
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -3238,49 +4712,27 @@ void test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported(void)
   TEST_ASSERT_NOT_NULL(mbClient);
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Set the callback for the server. */
-  assertionCnt = 0;
-  TbxMbServerSetCallbackWriteHoldingReg(mbServer, mbServer_WriteHoldingReg);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
- 
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Write the three holding registers, while knowing that the third one is not supported
-   * by the server.
-   */
-  assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 3U, holdingRegs);
-  /* Make sure the client operation repored an error. */
-  TEST_ASSERT_EQUAL(TBX_ERROR, result);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
-
-  /* Write the holding registers that are not supported by the server. */
-  assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40002U, 2U, holdingRegs);
-  /* Make sure the client operation repored an error. */
-  TEST_ASSERT_EQUAL(TBX_ERROR, result);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
-
-  /* Write the holding registers that are not supported by the server. */
+  /* Send the Report Server ID function code packet. */
   assertionCnt = 0;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 39998U, 2U, holdingRegs);
-  /* Make sure the client operation repored an error. */
-  TEST_ASSERT_EQUAL(TBX_ERROR, result);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
-  /* Write a value to the first holding register that is outside of the range supported
-   * by the server. 
+  /* Transceive function code 17 - Report Server ID. */
+  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, &len);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the client operation was successful. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  /* Make sure the response is en error packet with:
+   * - data[0] = function code + 0x80 = 145
+   * - data[1] = packet data[0] = illegal function error code = 1
+   * - data len = 2 (including function code)
    */
-  assertionCnt = 0;
-  holdingRegs[0] = 1024;
-  result = TbxMbClientWriteHoldingRegs(mbClient, 10U, 40000U, 1U, holdingRegs);
-  /* Make sure the client operation repored an error. */
-  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT8(145, response[0]);
+  TEST_ASSERT_EQUAL_UINT8(1, response[1]);
+  TEST_ASSERT_EQUAL_UINT8(2, len);
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -3289,14 +4741,14 @@ void test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported ***/
+} /*** end of test_TbxMbClientCustomFunction_CannotExecuteUnsupported ***/
 
 
 /************************************************************************************//**
 ** \brief     Tests that invalid parameters trigger an assertion and returns TBX_ERROR.
 **
 ****************************************************************************************/
-void test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams(void)
+void test_TbxMbClientCustomFunctionAsync_ShouldAssertOnInvalidParams(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtu;
@@ -3309,7 +4761,6 @@ void test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams(void)
 
   /* Create a transport layer. */
   assertionCnt = 0;
-  heapFreeBefore = TbxHeapGetFree();
   tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
                          TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
   /* Make sure a valid context was returned. */
@@ -3327,7 +4778,10 @@ void test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams(void)
 
   /* Try NULL as a client context. */
   assertionCnt = 0;
-  result = TbxMbClientCustomFunction(NULL, 10U, request, response, &len);
+  mbClientAsyncDoneCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  result = TbxMbClientCustomFunctionAsync(NULL, 10U, request, response, &len,
+                                          mbClient_AsyncDone, NULL);
   heapFreeAfter = TbxHeapGetFree();
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
@@ -3336,62 +4790,97 @@ void test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams(void)
   /* Make sure no heap memory was allocated. */
   TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
+  /* Try an invalid client context. */
+  assertionCnt = 0;
+  result = TbxMbClientCustomFunctionAsync(&invalidCtx, 10U, request, response, &len,
+                                          mbClient_AsyncDone, NULL);
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
   /* Try NULL as the transmit PDU packet data. */
   assertionCnt = 0;
-  result = TbxMbClientCustomFunction(mbClient, 10U, NULL, response, &len);
-  heapFreeAfter = TbxHeapGetFree();
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, NULL, response, &len,
+                                          mbClient_AsyncDone, NULL);
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
-  /* Make sure no heap memory was allocated. */
-  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
   /* Try NULL as the reception PDU packet data. */
   assertionCnt = 0;
-  result = TbxMbClientCustomFunction(mbClient, 10U, request, NULL, &len);
-  heapFreeAfter = TbxHeapGetFree();
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, NULL, &len,
+                                          mbClient_AsyncDone, NULL);
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
-  /* Make sure no heap memory was allocated. */
-  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
 
   /* Try NULL as the packet length. */
   assertionCnt = 0;
-  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, NULL);
-  heapFreeAfter = TbxHeapGetFree();
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, response, NULL,
+                                          mbClient_AsyncDone, NULL);
   /* Make sure an error was returned. */
   TEST_ASSERT_EQUAL(TBX_ERROR, result);
   /* Make sure an assertion was triggered. */
   TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
-  /* Make sure no heap memory was allocated. */
-  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+
+  /* Try NULL as the completion callback. */
+  assertionCnt = 0;
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, response, &len,
+                                          NULL, NULL);
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Try an invalid node address. */
+  assertionCnt = 0;
+  result = TbxMbClientCustomFunctionAsync(mbClient, 248U, request, response, &len,
+                                          mbClient_AsyncDone, NULL);
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Try a zero packet length. It lacks the function code. */
+  assertionCnt = 0;
+  len = 0U;
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, response, &len,
+                                          mbClient_AsyncDone, NULL);
+  /* Make sure an error was returned. */
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Make sure the completion callback never got called and the channel is idle. */
+  TEST_ASSERT_EQUAL_UINT32(0, mbClientAsyncDoneCnt);
+  TEST_ASSERT_EQUAL(TBX_FALSE, TbxMbClientIsBusy(mbClient));
 
   /* Free the client and transport layer. */
   TbxMbClientFree(mbClient);
   TbxMbRtuFree(tpRtu);
-} /*** end of test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams ***/
+} /*** end of test_TbxMbClientCustomFunctionAsync_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can use a custom function to extend the
-**            default supported function codes with the one for "Report Server ID" and
-**            can execute it to obtain the server's ID.
+** \brief     Tests that a Modbus client can execute the "Report Server ID" custom
+**            function asynchronously, that the channel reports being busy meanwhile and
+**            that it refuses a second asynchronous transfer while busy.
 **
 ****************************************************************************************/
-void test_TbxMbClientCustomFunction_CanExecute(void)
+void test_TbxMbClientCustomFunctionAsync_CanExecute(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
   tTbxMbTp     tpRtuClient;
   tTbxMbServer mbServer;
   tTbxMbClient mbClient;
-  uint16_t     serverId = 0U;
   uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
   uint8_t      request[1] = { 17U };
   uint8_t      len = 1U;  
+  uint8_t      len2 = 1U;  
 
   /* Create a Modbus RTU server on serial port 1. */
   assertionCnt = 0;
@@ -3412,36 +4901,38 @@ void test_TbxMbClientCustomFunction_CanExecute(void)
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
   /* Set the callback for the server. */
-  assertionCnt = 0;
   TbxMbServerSetCallbackCustomFunction(mbServer, mbServer_ReportServerIdCallback);
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
  
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Send the Report Server ID function code packet. */
+  /* Start function code 17 - Report Server ID. */
   assertionCnt = 0;
-
-  /* Transceive function code 17 - Report Server ID. */
-  result = TbxMbClientCustomFunction(mbClient, 10U, request, response, &len);
-  if (result == TBX_OK)
-  {
-    /* Response length as expected? */
-    if (len == 5U)
-    {
-      /* Not an exception response and byte count correct? */
-      if ((response[0] == 17U) && (response[1] == 3U))
-      {
-        /* Read out the received server ID. */
-        serverId = TbxMbCommonExtractUInt16BE(&response[2]);
-      }
-    }
-  }
-  /* Make sure the client operation was successful. */
+  mbClientAsyncDoneCnt = 0;
+  mbClientAsyncDoneResult = TBX_ERROR;
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, response, &len,
+                                          mbClient_AsyncDone, NULL);
+  /* Make sure the transfer was started and the channel is now busy. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the read server ID was as expected. */
-  TEST_ASSERT_EQUAL_UINT16(0x1234U, serverId);
+  TEST_ASSERT_EQUAL(TBX_TRUE, TbxMbClientIsBusy(mbClient));
+
+  /* A second asynchronous transfer should be refused, while the first is pending. */
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, response, &len2,
+                                          mbClient_AsyncDone, NULL);
+  TEST_ASSERT_EQUAL(TBX_ERROR, result);
+
+  /* Run the Modbus stack until the transfer completed. */
+  waitModbusAsyncDone();
+  /* Make sure it completed exactly once and successfully. */
+  TEST_ASSERT_EQUAL_UINT32(1, mbClientAsyncDoneCnt);
+  TEST_ASSERT_EQUAL(TBX_OK, mbClientAsyncDoneResult);
+  /* Make sure the response contains the server ID. */
+  TEST_ASSERT_EQUAL_UINT8(5U, len);
+  TEST_ASSERT_EQUAL_UINT8(17U, response[0]);
+  TEST_ASSERT_EQUAL_UINT8(3U, response[1]);
+  TEST_ASSERT_EQUAL_UINT16(0x1234U, TbxMbCommonExtractUInt16BE(&response[2]));
+  /* Make sure the channel is no longer busy. */
+  TEST_ASSERT_EQUAL(TBX_FALSE, TbxMbClientIsBusy(mbClient));
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -3450,17 +4941,16 @@ void test_TbxMbClientCustomFunction_CanExecute(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientCustomFunction_CanExecute ***/
+} /*** end of test_TbxMbClientCustomFunctionAsync_CanExecute ***/
 
 
 /************************************************************************************//**
-** \brief     Tests that a Modbus client can use a custom function to extend the
-**            default supported function codes with the one for "Report Server ID", yet
-**            cannot execute it to obtain the server's ID, from a server that does not
-**            support this function code.
+** \brief     Tests that an asynchronous transfer, started while a blocking transfer
+**            occupies the channel, is deferred and completes once the blocking transfer
+**            is done.
 **
 ****************************************************************************************/
-void test_TbxMbClientCustomFunction_CannotExecuteUnsupported(void)
+void test_TbxMbClientCustomFunctionAsync_CanDeferWhileBlocking(void)
 {
   uint8_t      result;
   tTbxMbTp     tpRtuServer;
@@ -3489,27 +4979,39 @@ void test_TbxMbClientCustomFunction_CannotExecuteUnsupported(void)
   TEST_ASSERT_NOT_NULL(mbClient);
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
+  /* Set the callback for the server, which starts the asynchronous transfer on the
+   * client, while the blocking one is still waiting for its response.
+   */
+  TbxMbServerSetCallbackCustomFunction(mbServer, mbServer_ReportServerIdAsyncCallback);
+ 
   /* Bring the Modbus stack to an operational state in the simulated environment. */
   startupModbusStack();
 
-  /* Send the Report Server ID function code packet. */
+  /* Transceive function code 17 - Report Server ID in a blocking manner. */
   assertionCnt = 0;
-
-  /* Transceive function code 17 - Report Server ID. */
+  mbClientAsyncDoneCnt = 0;
+  mbClientAsyncDoneResult = TBX_ERROR;
+  mbClientAsyncChannel = mbClient;
   result = TbxMbClientCustomFunction(mbClient, 10U, request, response, &len);
-  /* Make sure the client operation was successful. */
+  /* Make sure the blocking transfer was successful. */
   TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the client operation was successful. */
-  TEST_ASSERT_EQUAL(TBX_OK, result);
-  /* Make sure the response is en error packet with:
-   * - data[0] = function code + 0x80 = 145
-   * - data[1] = packet data[0] = illegal function error code = 1
-   * - data len = 2 (including function code)
-   */
-  /* Make sure no assertion was triggered. */
-  TEST_ASSERT_EQUAL_UINT8(145, response[0]);
-  TEST_ASSERT_EQUAL_UINT8(1, response[1]);
-  TEST_ASSERT_EQUAL_UINT8(2, len);
+  TEST_ASSERT_EQUAL_UINT8(5U, len);
+  TEST_ASSERT_EQUAL_UINT16(0x1234U, TbxMbCommonExtractUInt16BE(&response[2]));
+  /* Make sure the server callback started the asynchronous transfer. */
+  TEST_ASSERT_NULL(mbClientAsyncChannel);
+  /* Make sure the asynchronous transfer was deferred and not yet completed. */
+  TEST_ASSERT_EQUAL_UINT32(0, mbClientAsyncDoneCnt);
+  TEST_ASSERT_EQUAL(TBX_TRUE, TbxMbClientIsBusy(mbClient));
+
+  /* Run the Modbus stack until the deferred transfer completed. */
+  waitModbusAsyncDone();
+  /* Make sure it completed exactly once and successfully. */
+  TEST_ASSERT_EQUAL_UINT32(1, mbClientAsyncDoneCnt);
+  TEST_ASSERT_EQUAL(TBX_OK, mbClientAsyncDoneResult);
+  TEST_ASSERT_EQUAL_UINT8(5U, mbClientAsyncLen);
+  TEST_ASSERT_EQUAL_UINT16(0x1234U, TbxMbCommonExtractUInt16BE(&mbClientAsyncResponse[2]));
+  /* Make sure the channel is no longer busy. */
+  TEST_ASSERT_EQUAL(TBX_FALSE, TbxMbClientIsBusy(mbClient));
   /* Make sure no assertion was triggered. */
   TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
 
@@ -3518,7 +5020,108 @@ void test_TbxMbClientCustomFunction_CannotExecuteUnsupported(void)
   TbxMbServerFree(mbServer);
   TbxMbRtuFree(tpRtuClient);
   TbxMbRtuFree(tpRtuServer);
-} /*** end of test_TbxMbClientCustomFunction_CannotExecuteUnsupported ***/
+} /*** end of test_TbxMbClientCustomFunctionAsync_CanDeferWhileBlocking ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that freeing a client channel completes its pending asynchronous
+**            transfer with an error, exactly once.
+**
+****************************************************************************************/
+void test_TbxMbClientFree_ShouldCompletePendingAsync(void)
+{
+  uint8_t      result;
+  tTbxMbTp     tpRtuServer;
+  tTbxMbTp     tpRtu;
+  tTbxMbServer mbServer;
+  tTbxMbClient mbClient;
+  size_t       heapFreeBefore;
+  size_t       heapFreeAfter;
+  uint8_t      response[TBX_MB_TP_PDU_MAX_LEN]; 
+  uint8_t      request[1] = { 17U };
+  uint8_t      len = 1U;  
+
+  /* Create a Modbus RTU server on serial port 1, with a node address other than the
+   * one that the client addresses, such that the transfer stays pending.
+   */
+  assertionCnt = 0;
+  heapFreeBefore = TbxHeapGetFree();
+  tpRtuServer = TbxMbRtuCreate(20, TBX_MB_UART_PORT1, TBX_MB_UART_19200BPS, 
+                              TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbServer = TbxMbServerCreate(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(tpRtuServer);
+  TEST_ASSERT_NOT_NULL(mbServer);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Create a Modbus RTU client on serial port 2. */
+  assertionCnt = 0;
+  tpRtu = TbxMbRtuCreate(0, TBX_MB_UART_PORT2, TBX_MB_UART_19200BPS, 
+                         TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  mbClient = TbxMbClientCreate(tpRtu, 1000U, 1000U);
+  TEST_ASSERT_NOT_NULL(tpRtu);
+  TEST_ASSERT_NOT_NULL(mbClient);
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+ 
+  /* Bring the Modbus stack to an operational state in the simulated environment. */
+  startupModbusStack();
+
+  /* Start function code 17 - Report Server ID. */
+  assertionCnt = 0;
+  mbClientAsyncDoneCnt = 0;
+  mbClientAsyncDoneResult = TBX_OK;
+  result = TbxMbClientCustomFunctionAsync(mbClient, 10U, request, response, &len,
+                                          mbClient_AsyncDone, NULL);
+  /* Make sure the transfer was started. */
+  TEST_ASSERT_EQUAL(TBX_OK, result);
+  TEST_ASSERT_EQUAL(TBX_TRUE, TbxMbClientIsBusy(mbClient));
+
+  /* Free the client, while the transfer is still pending. */
+  TbxMbClientFree(mbClient);
+  /* Make sure the completion callback was called with an error and without data. */
+  TEST_ASSERT_EQUAL_UINT32(1, mbClientAsyncDoneCnt);
+  TEST_ASSERT_EQUAL(TBX_ERROR, mbClientAsyncDoneResult);
+  TEST_ASSERT_EQUAL_UINT8(0U, len);
+
+  /* Run the Modbus stack for a bit. The callback should not be called again. */
+  startupModbusStack();
+  TEST_ASSERT_EQUAL_UINT32(1, mbClientAsyncDoneCnt);
+  /* Make sure no assertion was triggered. */
+  TEST_ASSERT_EQUAL_UINT32(0, assertionCnt);
+
+  /* Free the server and transport layers. */
+  TbxMbServerFree(mbServer);
+  TbxMbRtuFree(tpRtu);
+  TbxMbRtuFree(tpRtuServer);
+  heapFreeAfter = TbxHeapGetFree();
+  /* Make sure no heap memory was allocated. */
+  TEST_ASSERT_EQUAL(heapFreeBefore, heapFreeAfter);
+} /*** end of test_TbxMbClientFree_ShouldCompletePendingAsync ***/
+
+
+/************************************************************************************//**
+** \brief     Tests that invalid parameters trigger an assertion.
+**
+****************************************************************************************/
+void test_TbxMbClientIsBusy_ShouldAssertOnInvalidParams(void)
+{
+  uint8_t result;
+
+  /* Try NULL as a client context. */
+  assertionCnt = 0;
+  result = TbxMbClientIsBusy(NULL);
+  /* Make sure the channel is not reported busy. */
+  TEST_ASSERT_EQUAL(TBX_FALSE, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+
+  /* Try an invalid client context. */
+  assertionCnt = 0;
+  result = TbxMbClientIsBusy(&invalidCtx);
+  /* Make sure the channel is not reported busy. */
+  TEST_ASSERT_EQUAL(TBX_FALSE, result);
+  /* Make sure an assertion was triggered. */
+  TEST_ASSERT_GREATER_THAN_UINT32(0, assertionCnt);
+} /*** end of test_TbxMbClientIsBusy_ShouldAssertOnInvalidParams ***/
 
 
 /************************************************************************************//**
@@ -4056,6 +5659,7 @@ int runTests(void)
   RUN_TEST(test_TbxMbCommonStoreUInt16BE_CanStore);
   /* Tests for the Modbus event API. */
   RUN_TEST(test_TbxMbEventTask_CanCall);
+  RUN_TEST(test_TbxMbEventIsIdle_ShouldReportPendingWork);
   /* Tests for the Modbus UART API. */
   RUN_TEST(test_TbxMbUartTransmitComplete_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbUartDataReceived_ShouldAssertOnInvalidParams);
@@ -4084,8 +5688,15 @@ int runTests(void)
   RUN_TEST(test_TbxMbServerSetCallbackReadHoldingReg_CanSet);
   RUN_TEST(test_TbxMbServerSetCallbackWriteHoldingReg_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbServerSetCallbackWriteHoldingReg_CanSet);
+  RUN_TEST(test_TbxMbServerSetCallbackReadFileRecord_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMbServerSetCallbackReadFileRecord_CanSet);
+  RUN_TEST(test_TbxMbServerSetCallbackWriteFileRecord_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMbServerSetCallbackWriteFileRecord_CanSet);
   RUN_TEST(test_TbxMbServerSetCallbackCustomFunction_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbServerSetCallbackCustomFunction_CanSet);
+  RUN_TEST(test_TbxMbServerFC20ReadFileRecord_CanReadSubRequests);
+  RUN_TEST(test_TbxMbServerFC20ReadFileRecord_ShouldRejectInvalidSubRequests);
+  RUN_TEST(test_TbxMbServerFC21WriteFileRecord_ShouldRejectTruncatedRecordBlock);
   /* Tests for the Modbus client API. Note that these also perform additional run-time
    * tests with an RTU server.
    */
@@ -4113,9 +5724,20 @@ int runTests(void)
   RUN_TEST(test_TbxMbClientWriteHoldingRegs_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbClientWriteHoldingRegs_CanWrite);
   RUN_TEST(test_TbxMbClientWriteHoldingRegs_CannotWriteUnsupported);
+  RUN_TEST(test_TbxMbClientReadFileRecord_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMbClientReadFileRecord_CanRead);
+  RUN_TEST(test_TbxMbClientReadFileRecord_CannotReadUnsupported);
+  RUN_TEST(test_TbxMbClientWriteFileRecord_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMbClientWriteFileRecord_CanWrite);
+  RUN_TEST(test_TbxMbClientWriteFileRecord_CannotWriteUnsupported);
   RUN_TEST(test_TbxMbClientCustomFunction_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbClientCustomFunction_CanExecute);
   RUN_TEST(test_TbxMbClientCustomFunction_CannotExecuteUnsupported);
+  RUN_TEST(test_TbxMbClientCustomFunctionAsync_ShouldAssertOnInvalidParams);
+  RUN_TEST(test_TbxMbClientCustomFunctionAsync_CanExecute);
+  RUN_TEST(test_TbxMbClientCustomFunctionAsync_CanDeferWhileBlocking);
+  RUN_TEST(test_TbxMbClientFree_ShouldCompletePendingAsync);
+  RUN_TEST(test_TbxMbClientIsBusy_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbClientDiagnostics_ShouldAssertOnInvalidParams);
   RUN_TEST(test_TbxMbClientDiagnostics_CanQueryData);
   RUN_TEST(test_TbxMbClientDiagnostics_CanClearCounters);
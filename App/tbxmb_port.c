@@ -82,6 +82,8 @@
 #include "microtbx.h"       /* MicroTBX library                   */
 #include "microtbxmodbus.h" /* MicroTBX-Modbus library            */
 #include "main.h"           /* STM32 CPU and HAL                  */
+#include "app_idle.h"       /* Main loop sleep                    */
+#include "mb_rtu_slave.h"   /* Modbus RTU slave                   */
 
 /* Select which timer to use for Modbus timing */
 #define TBXMB_TIM TIM3
@@ -89,6 +91,27 @@
 #error "You must define TBXMB_TIM: TIM1, TIM2, TIM3 or TIM4"
 #endif
 
+/** USART2 priority. It stays above TBX_CONF_CRITSECT_MASK_LEVEL, so that a critical section
+ *  never delays the reception of a byte. Therefore its callbacks must not call MicroTBX. They
+ *  queue the events, which TbxMbPortDeferredHandler( ) passes on from PendSV.
+ */
+#define TBXMB_UART_IRQ_PRIORITY  4U
+/** PendSV priority. It must be masked by the critical sections, as it calls MicroTBX.
+ */
+#define TBXMB_DEFER_IRQ_PRIORITY 5U
+/** Received bytes buffered between the USART2 ISR and PendSV. Must be a power of two.
+ */
+#define TBXMB_RX_RING_SIZE       32U
+
+_Static_assert( ( TBXMB_UART_IRQ_PRIORITY << ( 8U - __NVIC_PRIO_BITS ) ) <
+                    TBX_CONF_CRITSECT_MASK_LEVEL,
+                "USART2 must not be masked by the critical sections" );
+_Static_assert( ( TBXMB_DEFER_IRQ_PRIORITY << ( 8U - __NVIC_PRIO_BITS ) ) >=
+                    TBX_CONF_CRITSECT_MASK_LEVEL,
+                "PendSV calls MicroTBX and must be masked by the critical sections" );
+_Static_assert( ( TBXMB_RX_RING_SIZE & ( TBXMB_RX_RING_SIZE - 1U ) ) == 0U,
+                "TBXMB_RX_RING_SIZE must be a power of two" );
+
 typedef struct _driver_enable_pin {
   GPIO_TypeDef *psPort;
   uint16_t      Pin;
@@ -99,6 +122,10 @@ typedef struct {
   USART_TypeDef      *psInstance; /**< USART instance pointer.                  */
   psDrvEnPin_t        psDrvEn;    /**< Driver enable pin configuration.         */
   uint8_t             RxByte;     /**< USART single byte reception buffer.      */
+  volatile uint8_t    RxHead;     /**< Ring write index, owned by the USART ISR.  */
+  volatile uint8_t    RxTail;     /**< Ring read index, owned by PendSV.          */
+  volatile uint8_t    IsTxDone;   /**< Transmission completed, not yet reported.  */
+  uint8_t             aRxRing[ TBXMB_RX_RING_SIZE ];     /**< Received bytes.   */
 } sTbxMbPort_t, *psTbxMbPort_t;
 
 /** Function prototypes. ------------------------------------------------------------- */
@@ -198,6 +225,12 @@ void TbxMbPortUartInit( tTbxMbUartPort port, tTbxMbUartBaudrate baudrate,
     HAL_UART_RegisterCallback( phUart, HAL_UART_MSPDEINIT_CB_ID, TbxMb_HAL_UART_MspDeInit );
   } while ( 0 );
 
+  /* Reset the events of a previous session and give PendSV its priority. */
+  psPort->RxHead   = 0U;
+  psPort->RxTail   = 0U;
+  psPort->IsTxDone = TBX_FALSE;
+  HAL_NVIC_SetPriority( PendSV_IRQn, TBXMB_DEFER_IRQ_PRIORITY, 0 );
+
   /* Initialize the channel. */
   HAL_UART_Init( phUart );
   HAL_UART_RegisterCallback( phUart, HAL_UART_TX_COMPLETE_CB_ID, TbxMb_HAL_UART_TxCpltCallback );
@@ -352,7 +385,7 @@ static void TbxMb_HAL_UART_MspInit( UART_HandleTypeDef *ph ) {
                               .Mode  = GPIO_MODE_AF_PP,
                               .Speed = GPIO_SPEED_FREQ_LOW,
                           } );
-    HAL_NVIC_SetPriority( USART2_IRQn, 0, 0 );
+    HAL_NVIC_SetPriority( USART2_IRQn, TBXMB_UART_IRQ_PRIORITY, 0 );     // Never masked
     HAL_NVIC_EnableIRQ( USART2_IRQn );     // USART2 interrupt Init
   }
   return;
@@ -380,15 +413,16 @@ static void TbxMb_HAL_UART_TxCpltCallback( UART_HandleTypeDef *ph ) {
    *    Get pointer to this port structure.
    *    Check if this is the port we are looking for.
    *      Switch the hardware from transmission to reception mode.
-   *      Inform the Modbus UART module about the transmission completed event.
+   *      Queue the transmission completed event and have PendSV report it.
    *      Stop the loop, now that the port was located.
    */
   static uint8_t _PortsQntt = ( sizeof( asTbxMbPorts ) / sizeof( asTbxMbPorts[ 0 ] ) );
   for ( uint8_t _PortId = 0; _PortId < _PortsQntt; _PortId++ ) {
     psTbxMbPort_t _psPort = &asTbxMbPorts[ _PortId ];
-    if ( asTbxMbPorts[ _PortId ].phUart == ph ) {
+    if ( _psPort->phUart == ph ) {
       TbxMbPortUartDriverEnable( _PortId, TBX_OFF );
-      TbxMbUartTransmitComplete( _PortId );
+      _psPort->IsTxDone = TBX_TRUE;
+      SCB->ICSR         = SCB_ICSR_PENDSVSET_Msk;
       break;
     }
   }
@@ -406,7 +440,8 @@ static void TbxMb_HAL_UART_RxCpltCallback( UART_HandleTypeDef *ph ) {
    *    Check if this is the port we are looking for.
    *      Obtain the error code to check if any error occurred during reception.
    *      Only process the byte if no noise, framing or parity error was detected.
-   *        Inform the Modbus UART module about the newly received data byte.
+   *        Queue the byte, unless the ring is full, and have PendSV pass it on.
+   *        A dropped byte fails the CRC check of the frame.
    *      Restart reception for the next byte.
    *      Stop the loop, now that the port was located.
    */
@@ -416,7 +451,12 @@ static void TbxMb_HAL_UART_RxCpltCallback( UART_HandleTypeDef *ph ) {
     if ( _psPort->phUart == ph ) {
       uint32_t errorCode = HAL_UART_GetError( ph );
       if ( ( errorCode & ( HAL_UART_ERROR_NE | HAL_UART_ERROR_PE | HAL_UART_ERROR_FE ) ) == 0 ) {
-        TbxMbUartDataReceived( _PortId, &_psPort->RxByte, 1U );
+        uint8_t _Head = _psPort->RxHead;
+        if ( (uint8_t) ( _Head - _psPort->RxTail ) < TBXMB_RX_RING_SIZE ) {
+          _psPort->aRxRing[ _Head & ( TBXMB_RX_RING_SIZE - 1U ) ] = _psPort->RxByte;
+          _psPort->RxHead                                         = _Head + 1U;
+        }
+        SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
       }
       HAL_UART_Receive_IT( ph, &_psPort->RxByte, 1 );
       break;
@@ -452,6 +492,40 @@ static void TbxMb_HAL_UART_ErrorCallback( UART_HandleTypeDef *ph ) {
 }
 
 /**             I N T E R R U P T   S E R V I C E   R O U T I N E S                    */
+/** -------------------------------------------------------------------------------------
+ * \brief     Passes the events queued by the USART ISR on to the MicroTBX-Modbus stack.
+ * \attention Must be called from PendSV_Handler( ), which runs at TBXMB_DEFER_IRQ_PRIORITY.
+ * \details   The transmission completed event goes first, as the reply of the remote node
+ *            can only follow it. The RTU timestamps are taken here, so a critical section
+ *            delays them by at most its own length.
+ */
+void TbxMbPortDeferredHandler( void ) {
+  /**
+   *  Loop over all available ports.
+   *    Report a pending transmission completed event.
+   *    Pass on the received bytes, in the order of reception.
+   *  Wake up the main loop if anything was passed on.
+   */
+  static uint8_t _PortsQntt = ( sizeof( asTbxMbPorts ) / sizeof( asTbxMbPorts[ 0 ] ) );
+  uint8_t        _IsEvent   = TBX_FALSE;
+  for ( uint8_t _PortId = 0; _PortId < _PortsQntt; _PortId++ ) {
+    psTbxMbPort_t _psPort = &asTbxMbPorts[ _PortId ];
+    if ( _psPort->IsTxDone == TBX_TRUE ) {
+      _psPort->IsTxDone = TBX_FALSE;
+      TbxMbUartTransmitComplete( _PortId );
+      _IsEvent = TBX_TRUE;
+    }
+    while ( _psPort->RxTail != _psPort->RxHead ) {
+      uint8_t _Tail = _psPort->RxTail;
+      TbxMbUartDataReceived( _PortId, &_psPort->aRxRing[ _Tail & ( TBXMB_RX_RING_SIZE - 1U ) ], 1U );
+      _psPort->RxTail = _Tail + 1U;
+      _IsEvent        = TBX_TRUE;
+    }
+  }
+  if ( _IsEvent == TBX_TRUE ) Idle_Signal( );
+  return;
+}
+
 /** -------------------------------------------------------------------------------------
  * \brief     USARTx interrupt service routine.
  */
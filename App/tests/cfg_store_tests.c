@@ -0,0 +1,341 @@
+/***************************************************************************
+ * @file  cfg_store_tests.c
+ * @note  Host tests of the configuration store, with the Linux file backend of cfg_store.c.
+ *        The map is a small stand-in with the layout rules of sCfgMap_t, so the tests
+ *        build without the HAL. Build and run from this directory, with Unity:
+ *          gcc -I.. -I<unity>/src cfg_store_tests.c ../cfg_store.c <unity>/src/unity.c
+ *          ./a.out
+ * ************************************************************************* */
+
+#include "unity.h"
+#include "cfg_store.h"
+#include <string.h>
+
+#define TEST_CNTS_QNTT 4U
+#define TEST_BANK_HDR  8U     // sCFG_Bank_t
+#define TEST_REC_HDR   4U     // sCFG_Rec_t
+
+/**
+ * @brief Stand-in of sCfgMap_t 3.0: version and size first, CRC16 last, the fields that
+ *        3.0 added in the middle.
+ */
+typedef struct _test_map {
+  uint16_t Ver;                          //
+  uint16_t MapSize;                      //
+  uint8_t  aHead[ 22 ];                  // sMbRtuSlvCfg and sDimCfg up to aScan
+  uint8_t  aScan[ 10 ];                  // sDimCfg.aScan, new in 3.0
+  uint8_t  aMix[ 12 ];                   // sMixCfg
+  uint8_t  aDom[ 10 ];                   // sDomCfg
+  uint32_t aCnts[ TEST_CNTS_QNTT ];      // aDimCnts
+  uint8_t  aTail[ 6 ];                   // sCntCfg, sSoeCfg
+  uint16_t CRC16;                        //
+} sTestMap_t;
+
+_Static_assert( sizeof( sTestMap_t ) == offsetof( sTestMap_t, CRC16 ) + sizeof( uint16_t ),
+                "CRC16 must be the last bytes of sTestMap_t" );
+
+static const sCFG_Layout_t sLayout = {
+    .Version   = 0x0300U,
+    .MapSize   = sizeof( sTestMap_t ),
+    .ScanOff   = offsetof( sTestMap_t, aScan ),
+    .MixOff    = offsetof( sTestMap_t, aMix ),
+    .DomEndOff = offsetof( sTestMap_t, aDom ) + sizeof( ( (sTestMap_t *) 0 )->aDom ),
+    .CntsOff   = offsetof( sTestMap_t, aCnts ),
+    .CntsQntt  = TEST_CNTS_QNTT,
+};
+
+/**
+ * 2.x images: the head up to aScan, padded to sMixCfg at 28, then the 3.0 tail. 1.x images
+ * end with 16-bit counters right behind sDomCfg.
+ */
+static const sCFG_Layout_t sLayoutV2 = {
+    .Version = 0x0201U,
+    .MapSize = 28U + sizeof( sTestMap_t ) - offsetof( sTestMap_t, aMix ),
+};
+static const sCFG_Layout_t sLayoutV1 = {
+    .Version = 0x0100U,
+    .MapSize = 28U + 12U + 10U + TEST_CNTS_QNTT * sizeof( uint16_t ) + sizeof( uint16_t ),
+};
+
+static sTestMap_t sDefaults;
+
+/**
+ * @brief   Map with the defaults, each field filled with its own byte.
+ */
+static void _map_defaults( sTestMap_t *psMap ) {
+  //
+  memset( psMap, 0, sizeof( *psMap ) );
+  memset( psMap->aHead, 0x11, sizeof( psMap->aHead ) );
+  memset( psMap->aScan, 0x22, sizeof( psMap->aScan ) );
+  memset( psMap->aMix, 0x33, sizeof( psMap->aMix ) );
+  memset( psMap->aDom, 0x44, sizeof( psMap->aDom ) );
+  memset( psMap->aTail, 0x55, sizeof( psMap->aTail ) );
+  return;
+}
+
+/**
+ * @brief   Boot: load the store over the defaults.
+ */
+static eCFG_Err_t _boot( sTestMap_t *psMap ) {
+  //
+  _map_defaults( psMap );
+  return CfgStore_Load( &sLayout, (uint8_t *) psMap );
+}
+
+/**
+ * @brief   Save a map that differs from the defaults by Val in aHead and aCnts.
+ */
+static eCFG_Err_t _save( uint8_t Val ) {
+  //
+  sTestMap_t sMap;
+  _map_defaults( &sMap );
+  memset( sMap.aHead, Val, sizeof( sMap.aHead ) );
+  sMap.aCnts[ 0 ] = 0x10000U + Val;
+  return CfgStore_Save( (uint8_t *) &sMap );
+}
+
+/**
+ * @brief   Offset of the first free byte behind the records of the bank, from the tags.
+ */
+static uint32_t _free_off( uint8_t Bank ) {
+  //
+  const uint8_t *pBank = CfgFlash_Base( ) + Bank * CFG_STORE_BANK_SIZE;
+  uint32_t       Off   = TEST_BANK_HDR;
+  while ( Off + TEST_REC_HDR <= CFG_STORE_BANK_SIZE && pBank[ Off ] != 0xFFU ) {
+    uint16_t Len;
+    memcpy( &Len, pBank + Off + 2U, sizeof( Len ) );
+    Off += TEST_REC_HDR + ( ( Len + 3U ) & ~3U );
+  }
+  return Off;
+}
+
+static uint32_t _rec_size( uint16_t Len ) {
+  //
+  return TEST_REC_HDR + ( ( Len + 3U ) & ~3U );
+}
+
+void setUp( void ) {
+  //
+  CfgFlash_Erase( 0 );
+  CfgFlash_Erase( 1 );
+  _map_defaults( &sDefaults );
+  return;
+}
+
+void tearDown( void ) {
+  //
+  return;
+}
+
+void test_CfgStoreLoad_ShouldKeepDefaultsWhenEmpty( void ) {
+  //
+  sTestMap_t sMap;
+  TEST_ASSERT_EQUAL( CFG_ERR_EMPTY, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_UINT16( sLayout.Version, sMap.Ver );
+  TEST_ASSERT_EQUAL_UINT16( sizeof( sTestMap_t ), sMap.MapSize );
+  TEST_ASSERT_EQUAL_MEMORY( sDefaults.aHead, sMap.aHead, offsetof( sTestMap_t, CRC16 ) - 4U );
+}
+
+void test_CfgStoreSave_ShouldAppendAndLoadTheNewest( void ) {
+  //
+  sTestMap_t sMap;
+  _boot( &sMap );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xA1 ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xA2 ) );
+  uint32_t RecSize = _rec_size( sizeof( sTestMap_t ) );
+  TEST_ASSERT_EQUAL_UINT32( TEST_BANK_HDR + 2U * RecSize, _free_off( 0 ) );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xA2, sMap.aHead[ 0 ] );
+  TEST_ASSERT_EQUAL_UINT32( 0x100A2U, sMap.aCnts[ 0 ] );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xA3 ) );     // Appends behind the loaded one
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xA3, sMap.aHead[ 0 ] );
+  TEST_ASSERT_EQUAL_UINT32( TEST_BANK_HDR + 3U * RecSize, _free_off( 0 ) );
+}
+
+void test_CfgStoreSave_ShouldSkipTheSameImage( void ) {
+  //
+  sTestMap_t sMap;
+  _boot( &sMap );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xB1 ) );
+  uint32_t FreeOff = _free_off( 0 );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xB1 ) );
+  TEST_ASSERT_EQUAL_UINT32( FreeOff, _free_off( 0 ) );
+}
+
+void test_CfgStoreSave_ShouldSwitchBankWhenFull( void ) {
+  //
+  sTestMap_t sMap;
+  uint32_t   PerBank = ( CFG_STORE_BANK_SIZE - TEST_BANK_HDR ) / _rec_size( sizeof( sTestMap_t ) );
+  _boot( &sMap );
+  for ( uint32_t i = 0; i < PerBank; i++ ) TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( (uint8_t) i ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xFF, CfgFlash_Base( )[ CFG_STORE_BANK_SIZE ] );     // Bank 1 unused
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xC0 ) );
+  TEST_ASSERT_EQUAL_UINT32( TEST_BANK_HDR + _rec_size( sizeof( sTestMap_t ) ), _free_off( 1 ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xC0, sMap.aHead[ 0 ] );
+
+  for ( uint32_t i = 0; i < PerBank; i++ ) TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( (uint8_t) i ) );
+  TEST_ASSERT_EQUAL_UINT32( TEST_BANK_HDR + _rec_size( sizeof( sTestMap_t ) ), _free_off( 0 ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );     // Bank 0 again, with a higher sequence
+  TEST_ASSERT_EQUAL_HEX8( (uint8_t) ( PerBank - 1U ), sMap.aHead[ 0 ] );
+}
+
+void test_CfgStoreLoad_ShouldSkipATornRecordHeader( void ) {
+  //
+  sTestMap_t sMap;
+  _boot( &sMap );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xD1 ) );
+  uint32_t FreeOff = _free_off( 0 );
+  uint16_t Tag     = 0x5AC3U;     // Power cut after the tag, before the length
+  CfgFlash_Program( FreeOff, &Tag, sizeof( Tag ) );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xD1, sMap.aHead[ 0 ] );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xD2 ) );     // Not behind the torn header
+  TEST_ASSERT_EQUAL_UINT32( TEST_BANK_HDR + _rec_size( sizeof( sTestMap_t ) ), _free_off( 1 ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xD2, sMap.aHead[ 0 ] );
+}
+
+void test_CfgStoreLoad_ShouldFallBackFromATornRecord( void ) {
+  //
+  sTestMap_t sMap, sNew;
+  _boot( &sMap );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xE1 ) );
+  uint32_t FreeOff   = _free_off( 0 );
+  uint16_t aHdr[ 2 ] = { 0x5AC3U, sizeof( sTestMap_t ) };     // Power cut inside the image
+  _map_defaults( &sNew );
+  memset( sNew.aHead, 0xE2, sizeof( sNew.aHead ) );
+  CfgFlash_Program( FreeOff, aHdr, sizeof( aHdr ) );
+  CfgFlash_Program( FreeOff + sizeof( aHdr ), &sNew, sizeof( sNew ) / 2U );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xE1, sMap.aHead[ 0 ] );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xE3 ) );     // Appends behind the torn record
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xE3, sMap.aHead[ 0 ] );
+}
+
+void test_CfgStoreLoad_ShouldFallBackOnCrcError( void ) {
+  //
+  sTestMap_t sMap;
+  _boot( &sMap );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xF1 ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0xF3 ) );
+  uint8_t Bit = 0xFEU;     // Clear bit 0 of the first aHead byte of the newest record
+  CfgFlash_Program( _free_off( 0 ) - _rec_size( sizeof( sTestMap_t ) ) + TEST_REC_HDR +
+                        offsetof( sTestMap_t, aHead ),
+                    &Bit, sizeof( Bit ) );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( 0xF1, sMap.aHead[ 0 ] );
+}
+
+void test_CfgStoreLoad_ShouldFallBackToTheOlderBank( void ) {
+  //
+  sTestMap_t sMap;
+  uint32_t   PerBank = ( CFG_STORE_BANK_SIZE - TEST_BANK_HDR ) / _rec_size( sizeof( sTestMap_t ) );
+  _boot( &sMap );
+  for ( uint32_t i = 0; i < PerBank; i++ ) _save( (uint8_t) i );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _save( 0x71 ) );     // First record of bank 1
+  uint8_t Bit = 0xFEU;
+  CfgFlash_Program( CFG_STORE_BANK_SIZE + TEST_BANK_HDR + TEST_REC_HDR +
+                        offsetof( sTestMap_t, aHead ),
+                    &Bit, sizeof( Bit ) );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_HEX8( (uint8_t) ( PerBank - 1U ), sMap.aHead[ 0 ] );
+}
+
+void test_CfgStoreLoad_ShouldMigrateVersion2( void ) {
+  //
+  uint8_t aImg[ 28U + sizeof( sTestMap_t ) - offsetof( sTestMap_t, aMix ) ];
+  memset( aImg, 0x00, sizeof( aImg ) );
+  CfgStore_Load( &sLayoutV2, aImg );     // Store the 2.x image
+  memset( aImg + 4U, 0x61, sizeof( sDefaults.aHead ) );
+  memset( aImg + 28U, 0x63, sizeof( sDefaults.aMix ) );
+  memset( aImg + 28U + sizeof( sDefaults.aMix ), 0x64, sizeof( sDefaults.aDom ) );
+  uint32_t Cnt = 0x12345678U;
+  memcpy( aImg + 28U + offsetof( sTestMap_t, aCnts ) - offsetof( sTestMap_t, aMix ), &Cnt,
+          sizeof( Cnt ) );
+  memset( aImg + 28U + offsetof( sTestMap_t, aTail ) - offsetof( sTestMap_t, aMix ), 0x65,
+          sizeof( sDefaults.aTail ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, CfgStore_Save( aImg ) );
+
+  sTestMap_t sMap;
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_UINT16( sLayout.Version, sMap.Ver );
+  TEST_ASSERT_EQUAL_UINT16( sizeof( sTestMap_t ), sMap.MapSize );
+  TEST_ASSERT_EQUAL_HEX8( 0x61, sMap.aHead[ 21 ] );
+  TEST_ASSERT_EQUAL_MEMORY( sDefaults.aScan, sMap.aScan, sizeof( sMap.aScan ) );     // Default
+  TEST_ASSERT_EQUAL_HEX8( 0x63, sMap.aMix[ 0 ] );
+  TEST_ASSERT_EQUAL_HEX8( 0x64, sMap.aDom[ 9 ] );
+  TEST_ASSERT_EQUAL_UINT32( 0x12345678U, sMap.aCnts[ 0 ] );
+  TEST_ASSERT_EQUAL_HEX8( 0x65, sMap.aTail[ 5 ] );
+}
+
+void test_CfgStoreLoad_ShouldMigrateVersion1( void ) {
+  //
+  uint8_t aImg[ 28U + 12U + 10U + TEST_CNTS_QNTT * sizeof( uint16_t ) + sizeof( uint16_t ) ];
+  memset( aImg, 0x00, sizeof( aImg ) );
+  CfgStore_Load( &sLayoutV1, aImg );     // Store the 1.x image
+  memset( aImg + 4U, 0x81, sizeof( sDefaults.aHead ) );
+  memset( aImg + 28U, 0x83, sizeof( sDefaults.aMix ) );
+  memset( aImg + 28U + 12U, 0x84, sizeof( sDefaults.aDom ) );
+  for ( uint16_t i = 0; i < TEST_CNTS_QNTT; i++ ) {
+    uint16_t Cnt = 0xF000U + i;
+    memcpy( aImg + 28U + 12U + 10U + i * sizeof( Cnt ), &Cnt, sizeof( Cnt ) );
+  }
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, CfgStore_Save( aImg ) );
+
+  sTestMap_t sMap;
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_UINT16( sLayout.Version, sMap.Ver );
+  TEST_ASSERT_EQUAL_HEX8( 0x81, sMap.aHead[ 0 ] );
+  TEST_ASSERT_EQUAL_MEMORY( sDefaults.aScan, sMap.aScan, sizeof( sMap.aScan ) );
+  TEST_ASSERT_EQUAL_HEX8( 0x83, sMap.aMix[ 11 ] );
+  TEST_ASSERT_EQUAL_HEX8( 0x84, sMap.aDom[ 0 ] );
+  for ( uint16_t i = 0; i < TEST_CNTS_QNTT; i++ )
+    TEST_ASSERT_EQUAL_UINT32( 0xF000U + i, sMap.aCnts[ i ] );     // Widened to 32 bits
+  TEST_ASSERT_EQUAL_MEMORY( sDefaults.aTail, sMap.aTail, sizeof( sMap.aTail ) );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, CfgStore_Save( (uint8_t *) &sMap ) );     // Saved as 3.0
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_UINT32( 0xF003U, sMap.aCnts[ 3 ] );
+}
+
+void test_CfgStoreLoad_ShouldRejectAnotherMajorVersion( void ) {
+  //
+  static const sCFG_Layout_t sLayoutV4 = { .Version = 0x0400U, .MapSize = sizeof( sTestMap_t ) };
+  sTestMap_t                 sMap;
+  _map_defaults( &sMap );
+  CfgStore_Load( &sLayoutV4, (uint8_t *) &sMap );
+  memset( sMap.aHead, 0x91, sizeof( sMap.aHead ) );
+  TEST_ASSERT_EQUAL( CFG_ERR_NONE, CfgStore_Save( (uint8_t *) &sMap ) );
+
+  TEST_ASSERT_EQUAL( CFG_ERR_VERSION, _boot( &sMap ) );
+  TEST_ASSERT_EQUAL_MEMORY( sDefaults.aHead, sMap.aHead, sizeof( sMap.aHead ) );
+}
+
+int main( void ) {
+  //
+  UNITY_BEGIN( );
+  RUN_TEST( test_CfgStoreLoad_ShouldKeepDefaultsWhenEmpty );
+  RUN_TEST( test_CfgStoreSave_ShouldAppendAndLoadTheNewest );
+  RUN_TEST( test_CfgStoreSave_ShouldSkipTheSameImage );
+  RUN_TEST( test_CfgStoreSave_ShouldSwitchBankWhenFull );
+  RUN_TEST( test_CfgStoreLoad_ShouldSkipATornRecordHeader );
+  RUN_TEST( test_CfgStoreLoad_ShouldFallBackFromATornRecord );
+  RUN_TEST( test_CfgStoreLoad_ShouldFallBackOnCrcError );
+  RUN_TEST( test_CfgStoreLoad_ShouldFallBackToTheOlderBank );
+  RUN_TEST( test_CfgStoreLoad_ShouldMigrateVersion2 );
+  RUN_TEST( test_CfgStoreLoad_ShouldMigrateVersion1 );
+  RUN_TEST( test_CfgStoreLoad_ShouldRejectAnotherMajorVersion );
+  return UNITY_END( );
+}
@@ -60,6 +60,8 @@ void TIM4_IRQHandler(void);
 void USART2_IRQHandler(void);
 void EXTI15_10_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void EXTI4_IRQHandler(void);
+void EXTI9_5_IRQHandler(void);
 
 /* USER CODE END EFP */
 
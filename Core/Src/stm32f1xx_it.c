@@ -23,6 +23,11 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "app_ticks.h"
+#include "dig_cnt.h"
+#include "dig_soe.h"
+#include "mb_rtu_slave.h"
+#include "led_bank.h"
+#include "app_prof.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -174,7 +179,7 @@ void DebugMon_Handler(void)
 void PendSV_Handler(void)
 {
   /* USER CODE BEGIN PendSV_IRQn 0 */
-
+  TbxMbPortDeferredHandler( );
   /* USER CODE END PendSV_IRQn 0 */
   /* USER CODE BEGIN PendSV_IRQn 1 */
 
@@ -250,7 +255,8 @@ void USART2_IRQHandler(void)
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+  SOE_EXTI_IRQHandler( );
+  CNT_EXTI_IRQHandler( );
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_12);
   HAL_GPIO_EXTI_IRQHandler(B1_Pin);
@@ -261,4 +267,32 @@ void EXTI15_10_IRQHandler(void)
 
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles EXTI line4 interrupt, counted and recorded inputs only.
+  */
+void EXTI4_IRQHandler(void)
+{
+  SOE_EXTI_IRQHandler( );
+  CNT_EXTI_IRQHandler( );
+}
+
+/**
+  * @brief This function handles EXTI line[9:5] interrupts, counted and recorded inputs only.
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  SOE_EXTI_IRQHandler( );
+  CNT_EXTI_IRQHandler( );
+}
+
+/**
+  * @brief This function handles the LED bank timer interrupt, TIM2 by default.
+  */
+void LCB_TIM_IRQHandler( void )
+{
+  uint32_t Start = Prof_Start( );
+  LCB_IRQHandler( );
+  Prof_Stop( PROF_ID_LED, Start );
+}
+
 /* USER CODE END 1 */